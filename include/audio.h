@@ -29,16 +29,46 @@ public:
     Audio(std::unique_ptr<Stream> stream_to_own,
           FastFourier *fft,
           std::mutex *player_mutex,
-          std::vector<int16_t> primed_samples = {},
-          bool primed_eof = false);
+          std::vector<float> primed_samples = {},
+          bool primed_eof = false,
+          bool replaygain = false);
     ~Audio();
 
     void play(bool go);
     bool isFinished() const;
     std::unique_ptr<Stream> setStream(std::unique_ptr<Stream> new_stream,
-                                      std::vector<int16_t> primed_samples = {},
+                                      std::vector<float> primed_samples = {},
                                       bool primed_eof = false);
+    // Like setStream(), but instead of cutting to `new_stream` its head is
+    // mixed with the rest of the current stream over the configured crossfade
+    // length. The new stream becomes current at once (getCurrentStream(),
+    // getSamplesPlayed()); the outgoing one keeps decoding into a second feed
+    // until the fade completes. Falls back to setStream() when crossfading is
+    // off or there is nothing left to fade from.
+    std::unique_ptr<Stream> crossfadeTo(std::unique_ptr<Stream> new_stream,
+                                        std::vector<float> primed_samples = {},
+                                        bool primed_eof = false);
+    // 0 ms disables crossfades. Takes effect at the next crossfadeTo().
+    void setCrossfade(unsigned int ms, PsyMP3::DSP::Crossfader::Curve curve);
+    unsigned int getCrossfadeMs() const { return m_crossfade_ms.load(); }
+    bool isCrossfading() const { return (m_mix_state.load() & kMixFading) != 0; }
+    // Scale each stream by its Stream::getPlaybackGain(). Applies to audio
+    // decoded from now on; what is already queued plays out unchanged.
+    void setReplayGain(bool enabled);
 
+    // How much already-played PCM of the current stream to keep for
+    // seekInHistory(), on top of what is queued ahead. 0 disables it.
+    static constexpr unsigned int kDefaultSeekHistoryMs = 10000;
+    void setSeekHistory(unsigned int ms);
+    // Seeks to `frame` (at getRate()) by replaying PCM the current stream
+    // already decoded, without touching the stream: sample-accurate, and the
+    // decoder carries on from where it was. Returns false, changing nothing,
+    // when the frame is outside the window or a crossfade is running; the
+    // caller then seeks the usual way. Counted in the telemetry either way.
+    bool seekInHistory(uint64_t frame);
+
+    // Rate of the PCM queue and device side. Fixed for this object's lifetime:
+    // streams at another rate are resampled to it on the way in.
     int getRate() const { return m_rate; }
     int getChannels() const { return m_channels; }
     int getDeviceRate() const { return m_device_rate; }
@@ -58,17 +88,30 @@ public:
     void  setEqBandGain(int band, float db) { m_eq.setBandGain(band, db); }
     float getEqBandGain(int band) const    { return m_eq.getBandGain(band); }
 
+    // Spectrum analysis, run by the GUI thread at the display rate (never by
+    // the audio callback): pull the PCM the callback has tapped since the last
+    // call and transform the most recent FFT window. Returns false (leaving the
+    // previous spectrum in place) when nothing new was played. Callers skip it
+    // entirely while the spectrum is not on screen.
+    bool analyzeSpectrum();
+
     std::mutex& getFFTMutex() const { return m_fft_mutex; }
 
+    // Callback timing, queue depth and underrun counters since this object
+    // was created. Lock-free; safe from any thread.
+    PsyMP3::Core::AudioTelemetry::Snapshot getTelemetrySnapshot() const { return m_telemetry.snapshot(); }
+
 private:
     void setup();
     // SDL3 audio-stream "get more data" callback (pull model): assemble PCM
     // into a scratch buffer and push it with SDL_PutAudioStreamData.
     static void SDLCALL callback(void *userdata, SDL_AudioStream *stream,
                                  int additional_amount, int total_amount);
-    static void toFloat(int channels, const int16_t *in, float *out,
-                        size_t in_frames, size_t out_frames);
-    static std::pair<std::vector<int16_t>, bool> primeStream(Stream* stream, size_t max_samples);
+    static void mixToMono(int channels, const float *in, float *out,
+                          size_t in_frames, size_t out_frames);
+    static std::pair<std::vector<float>, bool> primeStream(Stream* stream, size_t max_samples);
+
+    static size_t defaultPrimeSamples(unsigned int rate, unsigned int channels);
 
     // Private unlocked versions of public methods (assumes locks are already held)
     // Lock acquisition order: m_stream_mutex before m_buffer_mutex
@@ -76,15 +119,91 @@ private:
     // to prevent deadlocks and improve performance
     bool isFinished_unlocked() const;
     std::unique_ptr<Stream> setStream_unlocked(std::unique_ptr<Stream> new_stream,
-                                               std::vector<int16_t> primed_samples,
+                                               std::vector<float> primed_samples,
                                                bool primed_eof);
     void resetBuffer_unlocked();
     uint64_t getBufferLatencyMs_unlocked() const;
+    // One decoded PCM queue. The decoder thread (and seek/track-swap on the
+    // player thread) produce under m_buffer_mutex; the SDL callback consumes
+    // lock-free and never takes that mutex, so a descheduled producer can no
+    // longer make the real-time thread wait. Seeks and swaps discard queued
+    // audio with ring.flush(), which the callback applies on its next read.
+    // Samples are float, full scale +/-1.0, matching the F32 device stream.
+    struct Feed {
+        PsyMP3::Core::SPSCRingBuffer<float> ring;
+        // Post-flush samples that did not fit because flushed data the
+        // callback has not yet skipped still holds ring space (e.g. primed PCM
+        // installed while the device is paused). Producer-side only; written
+        // into the ring first.
+        std::vector<float> overflow;
+        std::atomic<bool> overflow_pending{false}; // !overflow.empty(), for m_stream_cv
+        // Converts a stream whose rate differs from m_rate, so gapless
+        // transitions across sample rates keep the device open. Inactive (a
+        // bypass) while the stream matches.
+        PsyMP3::DSP::Resampler resampler;
+        std::vector<float> resample_out;
+        // ReplayGain applied to the stream's PCM before resampling.
+        float gain = 1.0f;
+        // The decoder is filling the ring's free space in place (a direct
+        // decode); other producers spill to `overflow` until it commits.
+        bool reserved = false;
+        // seekInHistory() re-queued the feed during that direct decode; the
+        // decode continues the stream after the replay, so it is queued
+        // behind it instead of committed in place.
+        bool requeued = false;
+    };
+    using PcmRegion = PsyMP3::Core::SPSCRingBuffer<float>::WriteRegion;
+    Feed& currentFeed_unlocked() { return m_feeds[m_primary]; }
+    const Feed& currentFeed_unlocked() const { return m_feeds[m_primary]; }
+    Feed& tailFeed_unlocked() { return m_feeds[m_primary ^ 1]; }
+    const Feed& tailFeed_unlocked() const { return m_feeds[m_primary ^ 1]; }
+
+    // Producer side of a PCM queue; m_buffer_mutex must be held.
+    void queueSamples_unlocked(Feed& feed, const float* samples, size_t count);
+    void drainOverflow_unlocked(Feed& feed);
+    size_t queuedSamples_unlocked(const Feed& feed) const;
+    size_t queuedSamples_unlocked() const { return queuedSamples_unlocked(currentFeed_unlocked()); }
+    // Queue PCM at the feed's stream rate, converting it to m_rate first
+    // when they differ; the drain variant flushes the resampler tail at EOF.
+    // Applies the feed's gain in place, so `samples` is scratch afterwards.
+    void queueDecoded_unlocked(Feed& feed, float* samples, size_t count);
+    void drainResampler_unlocked(Feed& feed);
+    void commitDirect_unlocked(Feed& feed, const PcmRegion& region, size_t count);
+    // Re-reads the stream's gain before its PCM is queued: a ChainedStream's
+    // changes from track to track.
+    void updateFeedGain_unlocked(Feed& feed, const Stream* stream);
+    // Seek history; m_buffer_mutex must be held. Everything queued for the
+    // current stream is recorded, after gain and resampling.
+    void recordHistory_unlocked(const Feed& feed, const float* samples, size_t count);
+    void configureHistory_unlocked(unsigned int rate, unsigned int channels);
+    bool seekInHistory_unlocked(uint64_t frame);
+
+    // Crossfade bookkeeping; m_buffer_mutex must be held.
+    bool tailNeedsData_unlocked() const;
+    void retireCrossfade_unlocked();  // once the callback reports the fade done
+    void cancelCrossfade_unlocked();  // seek, hard swap: drop the outgoing tail
+    // Decodes one chunk of the outgoing stream into the tail feed, if it
+    // needs one. Decoder thread only; takes m_buffer_mutex itself.
+    bool decodeTailChunk(std::vector<float>& chunk);
 
     // Decoder thread and buffer
     void decoderThreadLoop();
     std::thread m_decoder_thread;
-    std::vector<int16_t> m_buffer;
+    // Two feeds so a crossfade can play the outgoing stream's tail alongside
+    // the incoming one; outside a fade only the current feed is used. The
+    // second ring is allocated on the first crossfade.
+    Feed m_feeds[2];
+    // Index of the current stream's feed. Changed only with both
+    // m_stream_mutex and m_buffer_mutex held, so either lock suffices to
+    // read it; the callback reads it from m_mix_state instead.
+    int m_primary = 0;
+    // Decoder read-ahead: chunk size and the queue's high-water mark, tuned
+    // from measured decode cost, I/O stalls and drain rate. Guarded by
+    // m_buffer_mutex.
+    PsyMP3::Core::ReadAheadPolicy m_read_ahead;
+    // Written by the callback and decoder threads without locks (each owns
+    // its own counters), read by getTelemetrySnapshot().
+    PsyMP3::Core::AudioTelemetry m_telemetry;
     mutable std::mutex m_buffer_mutex;
     mutable std::mutex m_stream_mutex;
     std::condition_variable m_stream_cv;
@@ -95,10 +214,18 @@ private:
     std::atomic<Stream*> m_current_stream_raw_ptr; // Raw pointer for atomic access by audio callback
     FastFourier *m_fft;
     mutable std::mutex m_fft_mutex;
+    // Spectrum tap: the callback publishes the PCM it hands the device (pre-
+    // volume, pre-EQ) here and does nothing else for visuals. The analysis side
+    // is the single consumer; when it falls behind or stops calling (spectrum
+    // hidden, window minimized) the callback flushes the backlog instead of
+    // blocking, so the next analysis only sees fresh audio.
+    PsyMP3::Core::SPSCRingBuffer<float> m_tap;
+    std::vector<float> m_tap_scratch; // analysis-side: drained tap data
+    std::vector<float> m_tap_window;  // analysis-side: latest FFT window, interleaved
     std::mutex *m_player_mutex; // The mutex from the player for general state
     
-    int m_rate = 0;     // 0 until setup() succeeds; getRate()/divisors must tolerate it
-    int m_channels = 0; // 0 until setup() succeeds
+    int m_rate = 0;     // Queue format, from the first stream; setup() rejects 0
+    int m_channels = 0;
     int m_device_rate = 0;
     int m_device_channels = 0;
     SDL_AudioStream* m_stream = nullptr;  // SDL3: owns the bound playback device
@@ -107,12 +234,49 @@ private:
     std::atomic<uint64_t> m_samples_played{0};
     std::atomic<bool> m_stream_eof{false};
     // Bumped by resetBuffer() (seek). The decoder captures it before an
-    // unlocked getData() and re-checks it at commit; a decode that began before
+    // unlocked getDataFloat() and re-checks it at commit; a decode that began before
     // a seek is discarded (including its EOF latch) so a stale in-flight read
     // cannot re-set m_stream_eof after resetBuffer() just cleared it.
     std::atomic<uint64_t> m_decode_epoch{0};
 
     PsyMP3::DSP::Equalizer m_eq; // applied to the output PCM in callback()
+
+    // Crossfade. The player thread starts a fade (crossfadeTo), the decoder
+    // keeps the outgoing stream's feed topped up, the callback mixes the two
+    // and reports when the fade is over; the decoder then retires the tail.
+    static constexpr uint32_t kMixPrimaryMask = 1u; // current feed index
+    static constexpr uint32_t kMixFading = 2u;      // the other feed is the tail
+    static constexpr uint32_t kMixGenShift = 2;     // the rest: m_fade_gen
+    static constexpr uint32_t kMixGenMask = ~0u >> kMixGenShift;
+    // What the callback mixes, published in one store after the feeds are set
+    // up (fade length and curve are written before m_fade_gen is bumped). It
+    // carries the fade generation, so the callback sees a new fade together
+    // with its feeds and resets its fade position and m_samples_played on
+    // the first buffer it mixes for it.
+    std::atomic<uint32_t> m_mix_state{0};
+    std::atomic<uint32_t> m_fade_gen{0};      // wraps within kMixGenMask
+    std::atomic<uint32_t> m_fade_done_gen{0}; // callback: last fade it finished
+    std::atomic<uint64_t> m_fade_frames{0};
+    std::atomic<PsyMP3::DSP::Crossfader::Curve> m_fade_curve{PsyMP3::DSP::Crossfader::Curve::EqualPower};
+    std::atomic<unsigned int> m_crossfade_ms{0};
+    std::atomic<PsyMP3::DSP::Crossfader::Curve> m_crossfade_curve{PsyMP3::DSP::Crossfader::Curve::EqualPower};
+    // Guarded by m_buffer_mutex, like the feeds' gains it selects.
+    bool m_replaygain = false;
+    // The current stream's recent PCM, from its start or the last seek, and
+    // the replay scratch. Guarded by m_buffer_mutex.
+    PsyMP3::Core::PcmHistory m_history;
+    unsigned int m_history_ms = kDefaultSeekHistoryMs;
+    std::vector<float> m_history_replay;
+    // Outgoing stream, decoded into the tail feed by the decoder thread only
+    // (a Stream is never read from two threads). Guarded by m_buffer_mutex.
+    std::shared_ptr<Stream> m_tail_stream;
+    bool m_tail_eof = false;
+    // Callback-only fade position.
+    uint32_t m_cb_fade_gen = 0;
+    uint64_t m_cb_fade_pos = 0;
+    // The callback reads the tail feed into this. Sized to the ring by the
+    // first crossfadeTo(), before any fade publishes it; fixed after that.
+    std::vector<float> m_cb_tail_scratch;
 };
 
 #endif // AUDIO_H
@@ -33,6 +33,11 @@
  */
 struct AudioFrame {
     std::vector<int16_t> samples;    // Decoded PCM samples (16-bit signed)
+    // High-resolution payload: interleaved float32, full scale = [-1.0, 1.0).
+    // Filled instead of `samples` by codecs honouring setFloatOutput() when
+    // their source has more than 16 bits of resolution. Exactly one of the
+    // two vectors carries a frame's audio.
+    std::vector<float> float_samples;
     uint32_t sample_rate = 0;        // Sample rate of this frame
     uint16_t channels = 0;           // Number of channels
     uint64_t timestamp_samples = 0;  // Timestamp in sample units
@@ -64,17 +69,38 @@ struct AudioFrame {
     }
     
     /**
-     * @brief Get the number of bytes in this frame
+     * @brief True if the audio is carried in float_samples
+     */
+    bool isFloat() const {
+        return !float_samples.empty();
+    }
+    
+    /**
+     * @brief True if the frame carries any audio, in either format
+     */
+    bool hasSamples() const {
+        return !samples.empty() || !float_samples.empty();
+    }
+    
+    /**
+     * @brief Get the number of interleaved samples (all channels), in either format
+     */
+    size_t getSampleCount() const {
+        return isFloat() ? float_samples.size() : samples.size();
+    }
+    
+    /**
+     * @brief Get the number of bytes in this frame as 16-bit PCM
      */
     size_t getByteCount() const {
-        return samples.size() * sizeof(int16_t);
+        return getSampleCount() * sizeof(int16_t);
     }
     
     /**
      * @brief Get the number of sample frames (samples per channel)
      */
     size_t getSampleFrameCount() const {
-        return channels > 0 ? samples.size() / channels : 0;
+        return channels > 0 ? getSampleCount() / channels : 0;
     }
     
     /**
@@ -85,6 +111,30 @@ struct AudioFrame {
         return (getSampleFrameCount() * 1000ULL) / sample_rate;
     }
     
+    /**
+     * @brief Drop sample frames from the front and end of the frame
+     * 
+     * For codecs honouring MediaChunk::trim_leading_samples and
+     * trim_trailing_samples. Trimming more than the frame holds empties it.
+     */
+    void trim(size_t leading_frames, size_t trailing_frames) {
+        const size_t total = getSampleFrameCount();
+        if (leading_frames + trailing_frames >= total) {
+            samples.clear();
+            float_samples.clear();
+            return;
+        }
+        const size_t first = leading_frames * channels;
+        const size_t last = (total - trailing_frames) * channels;
+        if (isFloat()) {
+            float_samples.erase(float_samples.begin() + last, float_samples.end());
+            float_samples.erase(float_samples.begin(), float_samples.begin() + first);
+        } else {
+            samples.erase(samples.begin() + last, samples.end());
+            samples.erase(samples.begin(), samples.begin() + first);
+        }
+    }
+    
     /**
      * @brief Reserve space for samples (using pool if beneficial)
      */
@@ -103,6 +153,36 @@ struct AudioFrame {
             AudioBufferPool::getInstance().returnSampleBuffer(std::move(samples));
         }
         samples.clear();
+        float_samples.clear();
+    }
+};
+
+/**
+ * @brief What AudioCodec::decodeInto() wrote to the caller's buffer
+ */
+struct DecodedAudio {
+    size_t samples = 0;              // Interleaved samples written (all channels)
+    uint32_t sample_rate = 0;
+    uint16_t channels = 0;
+    uint64_t timestamp_samples = 0;  // Timestamp in sample units
+    
+    size_t getSampleFrameCount() const {
+        return channels > 0 ? samples / channels : 0;
+    }
+    
+    /**
+     * @brief AudioFrame::trim() for audio decoded into `data`
+     */
+    void trim(int16_t* data, size_t leading_frames, size_t trailing_frames) {
+        const size_t total = getSampleFrameCount();
+        if (leading_frames + trailing_frames >= total) {
+            samples = 0;
+            return;
+        }
+        samples = (total - leading_frames - trailing_frames) * channels;
+        if (leading_frames > 0) {
+            std::memmove(data, data + leading_frames * channels, samples * sizeof(int16_t));
+        }
     }
 };
 
@@ -135,6 +215,47 @@ public:
      */
     virtual AudioFrame decode(const MediaChunk& chunk) = 0;
     
+    /**
+     * @brief Decode a chunk into caller-owned memory
+     *
+     * Same output as decode(), as 16-bit PCM, without a per-chunk AudioFrame.
+     * Codecs that override it write straight from the decoder and allocate
+     * nothing; the default wraps decode() and copies (rounding float output).
+     *
+     * @param out Interleaved output
+     * @param capacity Samples `out` holds; at least getMaxFrameSamples() when
+     *        that is nonzero, or audio past `capacity` is lost
+     * @return Samples written and their format; samples == 0 if no output yet
+     */
+    virtual DecodedAudio decodeInto(const MediaChunk& chunk, int16_t* out, size_t capacity);
+    
+    /**
+     * @brief Most interleaved samples one decode() can produce
+     *
+     * 0 when unbounded or unknown (e.g. PCM, whose chunk sizes are up to the
+     * container). Nonzero means decodeInto() is worth calling.
+     */
+    virtual size_t getMaxFrameSamples() const { return 0; }
+    
+    /**
+     * @brief Decode several consecutive chunks
+     *
+     * Codecs whose chunks decode independently of each other may spread the
+     * batch over `threads` workers (see supportsParallelDecode()); the
+     * default decodes the chunks one after another with decode().
+     *
+     * @param chunks Input chunks, in stream order
+     * @param threads Worker count; 0 means one per core
+     * @return One frame per chunk, in chunk order
+     */
+    virtual std::vector<AudioFrame> decodeBatch(const std::vector<MediaChunk>& chunks,
+                                                unsigned threads);
+    
+    /**
+     * @brief Whether decodeBatch() can use more than one thread
+     */
+    virtual bool supportsParallelDecode() const { return false; }
+    
     /**
      * @brief Flush any remaining audio data from internal buffers
      * @return Decoded audio frame, or empty frame if no data remaining
@@ -145,7 +266,27 @@ public:
      * @brief Reset codec state (for seeking)
      */
     virtual void reset() = 0;
-    
+
+    /**
+     * @brief Whether resetForStream() can prepare this codec for another stream
+     *
+     * CodecPool keeps released codecs that return true for the next track
+     * with the same codec and parameters.
+     */
+    virtual bool supportsReuse() const { return false; }
+
+    /**
+     * @brief Reinitialize for a new stream, keeping allocated resources
+     *
+     * Afterwards the codec must behave exactly as a newly constructed and
+     * initialize()d one for `stream_info` would. Only called by CodecPool,
+     * with a stream canDecode() accepts and the same codec name, tag, sample
+     * rate, channels and bits per sample the codec was last set up for.
+     *
+     * @return false if the codec could not be reset; it is then discarded
+     */
+    virtual bool resetForStream(const StreamInfo& stream_info);
+
     /**
      * @brief Get the codec's name/type
      */
@@ -161,9 +302,21 @@ public:
      */
     const StreamInfo& getStreamInfo() const { return m_stream_info; }
     
+    /**
+     * @brief Ask for float output (AudioFrame::float_samples) where it preserves
+     *        resolution 16-bit PCM would lose
+     *
+     * A preference, not a contract: codecs that do not support it keep
+     * producing `samples`, so consumers must accept either format. Set before
+     * decoding starts (or between decode calls, on the decoding thread).
+     */
+    void setFloatOutput(bool enable) { m_float_output = enable; }
+    bool wantsFloatOutput() const { return m_float_output; }
+    
 protected:
     StreamInfo m_stream_info;
     bool m_initialized = false;
+    bool m_float_output = false;
 
 public:
     bool isInitialized() const { return m_initialized; }
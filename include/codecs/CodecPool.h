@@ -0,0 +1,116 @@
+/*
+ * CodecPool.h - Reuse of decoder instances across tracks
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef CODECPOOL_H
+#define CODECPOOL_H
+
+// No direct includes - all includes should be in psymp3.h
+
+namespace PsyMP3 {
+namespace Codec {
+
+/**
+ * @brief Keeps finished codecs so the next track of the same format can reuse one
+ *
+ * Playing an album constructs one codec per track, and for some decoders
+ * (native FLAC's multi-megabyte sample buffers and worker decoders) that is
+ * most of the cost of starting a track. DemuxedStream acquire()s its codec
+ * here and release()s it when done; a released codec whose
+ * AudioCodec::supportsReuse() is true waits idle, and the next acquire() for
+ * a stream with the same codec and parameters takes it and calls
+ * AudioCodec::resetForStream() instead of constructing and initializing a
+ * new one.
+ *
+ * Idle codecs are matched on codec name and tag, sample rate, channels and
+ * bits per sample. The pool holds at most getCapacity() of them, dropping
+ * the least recently released first. Thread-safe.
+ */
+class CodecPool {
+public:
+    static CodecPool& getInstance();
+
+    /**
+     * @brief An initialized codec for the stream, reused when one is idle
+     * @return nullptr when no codec handles the stream or it fails to initialize
+     */
+    std::unique_ptr<AudioCodec> acquire(const StreamInfo& stream_info);
+
+    /**
+     * @brief Hand a codec back once nothing decodes with it any more
+     *
+     * Codecs that cannot be reused are destroyed.
+     */
+    void release(std::unique_ptr<AudioCodec> codec);
+
+    /**
+     * @brief Destroy all idle codecs
+     */
+    void clear();
+
+    /**
+     * @brief Most idle codecs kept; 0 disables pooling
+     */
+    void setCapacity(size_t capacity);
+    size_t getCapacity() const;
+
+    struct PoolStats {
+        uint64_t acquisitions = 0;
+        uint64_t reuses = 0;           // Served by resetForStream()
+        uint64_t constructions = 0;    // Served by a new codec
+        size_t idle = 0;               // Codecs waiting in the pool
+        double reuse_rate = 0.0;       // reuses / acquisitions
+        std::chrono::microseconds construction_time{0};  // Spent creating and initializing
+        std::chrono::microseconds reuse_time{0};         // Spent in resetForStream()
+        // Estimated: per reuse, the mean construction time of that codec less
+        // what the reuse took
+        std::chrono::microseconds time_saved{0};
+    };
+    PoolStats getStats() const;
+
+private:
+    CodecPool() = default;
+
+    static constexpr size_t DEFAULT_CAPACITY = 4;
+
+    struct Key {
+        std::string codec_name;
+        uint32_t codec_tag = 0;
+        uint32_t sample_rate = 0;
+        uint16_t channels = 0;
+        uint16_t bits_per_sample = 0;
+
+        bool operator==(const Key& other) const;
+    };
+
+    struct IdleCodec {
+        Key key;
+        std::unique_ptr<AudioCodec> codec;
+    };
+
+    // Construction cost so far, per codec name
+    struct ConstructionCost {
+        uint64_t count = 0;
+        std::chrono::microseconds total{0};
+    };
+
+    static Key keyFor(const StreamInfo& stream_info);
+    std::unique_ptr<AudioCodec> takeIdle_unlocked(const Key& key);
+    void trim_unlocked(std::vector<std::unique_ptr<AudioCodec>>& evicted);
+
+    mutable std::mutex m_mutex;
+    std::deque<IdleCodec> m_idle;  // Oldest release first
+    size_t m_capacity = DEFAULT_CAPACITY;
+    std::map<std::string, ConstructionCost> m_construction_costs;
+    PoolStats m_stats;
+};
+
+} // namespace Codec
+} // namespace PsyMP3
+
+#endif // CODECPOOL_H
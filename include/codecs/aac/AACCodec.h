@@ -21,6 +21,8 @@ public:
 
     bool initialize() override;
     AudioFrame decode(const MediaChunk& chunk) override;
+    DecodedAudio decodeInto(const MediaChunk& chunk, int16_t* out, size_t capacity) override;
+    size_t getMaxFrameSamples() const override;
     AudioFrame flush() override;
     void reset() override;
     std::string getCodecName() const override { return "aac"; }
@@ -29,6 +31,8 @@ public:
 private:
     bool initialize_unlocked();
     AudioFrame decode_unlocked(const MediaChunk& chunk);
+    DecodedAudio decodeInto_unlocked(const MediaChunk& chunk, int16_t* out, size_t capacity);
+    size_t getMaxFrameSamples_unlocked() const;
     AudioFrame flush_unlocked();
     void reset_unlocked();
     void destroyDecoder_unlocked();
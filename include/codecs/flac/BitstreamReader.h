@@ -46,6 +46,14 @@ public:
     bool readUTF8(uint64_t& value);
     bool readRiceCode(int32_t& value, uint32_t rice_param);
     
+    // Batched Rice decoding for a whole partition: reads 64-bit big-endian
+    // windows straight from the buffer, counts the unary quotient with one
+    // count-leading-zeros and takes the remainder from the same window.
+    // Returns how many of `count` values were decoded; it stops early at the
+    // end of contiguous data or at a value outside the valid residual range,
+    // leaving the reader positioned for readRiceCode() to take over.
+    uint32_t readRiceCodes(int32_t* output, uint32_t count, uint32_t rice_param);
+    
     // Alignment
     bool alignToByte();
     bool isAligned() const;
@@ -81,6 +89,7 @@ private:
     bool ensureBits(uint32_t bit_count);
     uint32_t peekBits(uint32_t bit_count);
     void consumeBits(uint32_t bit_count);
+    uint64_t loadWindow(size_t byte_offset) const;
     
     // UTF-8 decoding helpers
     bool readUTF8_1byte(uint64_t& value);
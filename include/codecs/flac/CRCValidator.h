@@ -24,7 +24,8 @@ namespace FLAC {
  * CRC-8 is used for frame headers to enable quick rejection of invalid frames.
  * CRC-16 is used for complete frames to detect corruption in frame data.
  * 
- * Both CRC algorithms use precomputed lookup tables for performance.
+ * The computation itself is Core::Utility::CRC, which the demuxer shares;
+ * it picks carry-less multiply folding or slice-by-16 tables at runtime.
  */
 class CRCValidator {
 public:
@@ -122,12 +123,6 @@ public:
     uint16_t getCRC16() const;
     
 private:
-    // CRC-8 lookup table (polynomial 0x07)
-    static const uint8_t CRC8_TABLE[256];
-    
-    // CRC-16 lookup table (polynomial 0x8005)
-    static const uint16_t CRC16_TABLE[256];
-    
     // Current CRC accumulators for incremental computation
     uint8_t m_crc8;
     uint16_t m_crc16;
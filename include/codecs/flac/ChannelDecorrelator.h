@@ -60,7 +60,26 @@ public:
     bool decorrelate(int64_t** channels, uint32_t block_size,
                     uint32_t channel_count, ChannelAssignment assignment);
     
+    /**
+     * Decorrelate 32-bit channel buffers
+     * 
+     * Same as the int64_t overload, for frames whose bit depth is at most 31
+     * (side samples and reconstructed channels then fit 32 bits). Uses SSE2
+     * where available.
+     * 
+     * Requirements: 7.1-7.8, 26.1-26.8
+     */
+    bool decorrelate(int32_t** channels, uint32_t block_size,
+                    uint32_t channel_count, ChannelAssignment assignment);
+    
 private:
+    /**
+     * Shared body of both decorrelate() overloads: validation and dispatch
+     */
+    template <typename Sample>
+    bool decorrelateChannels(Sample** channels, uint32_t block_size,
+                             uint32_t channel_count, ChannelAssignment assignment);
+    
     /**
      * Decorrelate left-side stereo
      * Right = Left - Side
@@ -72,6 +91,7 @@ private:
      * Requirements: 7.2
      */
     void decorrelateLeftSide(int64_t* left, int64_t* side, uint32_t count);
+    void decorrelateLeftSide(int32_t* left, int32_t* side, uint32_t count);
     
     /**
      * Decorrelate right-side stereo
@@ -84,6 +104,7 @@ private:
      * Requirements: 7.3
      */
     void decorrelateRightSide(int64_t* side, int64_t* right, uint32_t count);
+    void decorrelateRightSide(int32_t* side, int32_t* right, uint32_t count);
     
     /**
      * Decorrelate mid-side stereo
@@ -99,6 +120,7 @@ private:
      * Requirements: 7.4, 7.5
      */
     void decorrelateMidSide(int64_t* mid, int64_t* side, uint32_t count);
+    void decorrelateMidSide(int32_t* mid, int32_t* side, uint32_t count);
     
     /**
      * Validate channel count
@@ -140,6 +140,31 @@ public:
      */
     AudioFrame decode(const MediaChunk& chunk) override;
     
+    /**
+     * @brief Decode a batch of complete FLAC frames on a worker pool
+     * 
+     * Every chunk from the demuxer is one complete frame, and frames decode
+     * independently of each other. Each worker owns a private decoder (its
+     * own BitstreamReader, SubframeDecoder and buffers) and takes the next
+     * undecoded frame until the batch is done; the frames are returned in
+     * chunk order. Sample position, statistics and the MD5 signature are
+     * updated in that order too, exactly as by decode() one frame at a time.
+     * 
+     * Meant for offline decoding (DemuxedStream::setParallelDecode()).
+     * Playback should keep calling decode(), which returns each frame as
+     * soon as it is decoded. Worker threads are created on first use, wait
+     * for the next batch between calls, and are joined by the destructor.
+     * 
+     * @param chunks Complete FLAC frames, in stream order
+     * @param threads Worker count; 0 means one per core
+     * @return One AudioFrame per chunk, empty where decode() would be empty
+     * @thread_safety Thread-safe. Uses m_state_mutex for synchronization.
+     */
+    std::vector<AudioFrame> decodeBatch(const std::vector<MediaChunk>& chunks,
+                                        unsigned threads) override;
+    
+    bool supportsParallelDecode() const override { return true; }
+    
     /**
      * @brief Flush remaining decoded samples from internal buffers
      * 
@@ -155,6 +180,15 @@ public:
      */
     void reset() override;
     
+    /**
+     * @brief Reinitialize for the next stream, keeping the sample buffers
+     *        and batch workers
+     * 
+     * @thread_safety Thread-safe. Uses multiple mutexes for synchronization.
+     */
+    bool resetForStream(const StreamInfo& stream_info) override;
+    bool supportsReuse() const override { return true; }
+    
     /**
      * @brief Get codec name identifier
      * 
@@ -299,8 +333,13 @@ private:
     
     bool initialize_unlocked();
     AudioFrame decode_unlocked(const MediaChunk& chunk);
+    std::vector<AudioFrame> decodeBatch_unlocked(const std::vector<MediaChunk>& chunks,
+                                                 unsigned threads);
+    void batchThreadLoop(size_t index);
+    void stopBatchThreads();
     AudioFrame flush_unlocked();
     void reset_unlocked();
+    bool resetForStream_unlocked(const StreamInfo& stream_info);
     bool canDecode_unlocked(const StreamInfo& stream_info) const;
     bool seek_unlocked(uint64_t target_sample);
     void setSeekTable_unlocked(const std::vector<SeekPoint>& seek_table);
@@ -484,13 +523,39 @@ private:
     static constexpr size_t INPUT_BUFFER_SIZE = 64 * 1024;  // 64KB
     
     std::vector<uint8_t> m_input_buffer;
-    // Per-channel decode buffers. int64: side subframes of decorrelated 32-bit
-    // streams hold 33-bit samples (RFC 9639 Section 9.2.2).
+    // Per-channel 64-bit decode buffers, used only by 32-bit frames: their
+    // side subframes hold 33-bit samples (RFC 9639 Section 9.2.2).
     std::vector<int64_t> m_decode_buffer[MAX_CHANNELS];
-    // Post-decorrelation narrowed samples (all values fit the frame bit depth,
-    // at most 32 bits) for SampleReconstructor and MD5Validator.
+    // Per-channel 32-bit samples for SampleReconstructor and MD5Validator.
+    // Frames of up to 31 bits decode and decorrelate here directly (the side
+    // channel's extra bit still fits); 32-bit frames are narrowed into it
+    // after decorrelation.
     std::vector<int32_t> m_narrow_buffer[MAX_CHANNELS];
     std::vector<int16_t> m_output_buffer;
+    // Interleaved float output for >16-bit sources when setFloatOutput() is on.
+    std::vector<float> m_float_output_buffer;
+    
+    // Frame bit depth of the last frame decode_unlocked() accepted; its
+    // samples are still in m_narrow_buffer. Batch decoding reads both from
+    // the workers to feed the MD5 signature in stream order.
+    uint32_t m_last_bit_depth = 0;
+    
+    // Private decoders for decodeBatch(), one per worker thread
+    std::vector<std::unique_ptr<FLACCodec>> m_batch_workers;
+    
+    // Persistent helper threads for decodeBatch(). Helper i drives
+    // m_batch_workers[i]; the calling thread drives m_batch_workers[0].
+    // Each batch bumps m_batch_generation, and the first m_batch_helpers
+    // helpers run m_batch_job and count m_batch_pending down to zero.
+    std::vector<std::thread> m_batch_threads;
+    std::mutex m_batch_mutex;
+    std::condition_variable m_batch_start_cv;
+    std::condition_variable m_batch_done_cv;
+    std::function<void(FLACCodec&)> m_batch_job;
+    uint64_t m_batch_generation = 0;
+    size_t m_batch_helpers = 0;
+    size_t m_batch_pending = 0;
+    bool m_batch_shutdown = false;
     
     // Performance statistics
     mutable FLACCodecStats m_stats;
@@ -0,0 +1,97 @@
+#ifndef PREDICTOR_KERNELS_H
+#define PREDICTOR_KERNELS_H
+
+#include <cstdint>
+
+namespace PsyMP3 {
+namespace Codec {
+namespace FLAC {
+
+/**
+ * @brief Sample reconstruction kernels for FIXED and LPC subframes
+ *
+ * Each kernel reconstructs samples[order..order+count-1] from the warm-up
+ * samples already in samples[0..order-1] and residuals[0..count-1], and
+ * clamps every sample to the subframe bit depth exactly like the scalar
+ * reference (RFC 9639 Section 9.2.5/9.2.6).
+ *
+ * SubframeDecoder picks a kernel once per subframe, after parsing the
+ * header, from:
+ * - the predictor order: orders 1-12, 16 and 32 (LPC) and 0-4 (FIXED) have
+ *   kernels with the order as a compile-time constant, so the inner product
+ *   is fully unrolled;
+ * - the accumulator width: 32-bit when bit_depth + coefficient precision +
+ *   ceil(log2(order)) <= 32 bounds every partial sum, 64-bit otherwise.
+ *
+ * The kernels are scalar on purpose: every prediction depends on the sample
+ * reconstructed just before it, and vector inner products over that history
+ * measured slower than the unrolled scalar loop.
+ *
+ * The reference implementations are the original generic loops, kept for
+ * validating the specialized kernels.
+ *
+ * Every kernel exists for int64_t and int32_t sample buffers. The int32_t
+ * variants serve frames whose subframe bit depth is at most 32 (every
+ * stream below 32 bits, side channel included); they compute exactly like
+ * the int64_t ones and only store narrower samples.
+ */
+
+/// Reconstructs an LPC subframe; same arguments as applyLPCReference()
+template <typename Sample>
+using LPCKernelT = void (*)(Sample* samples, const int32_t* residuals,
+                            const int32_t* coeffs, uint32_t count,
+                            uint32_t order, int32_t shift, uint32_t bit_depth);
+
+/// Reconstructs a FIXED subframe; same arguments as applyFixedReference()
+template <typename Sample>
+using FixedKernelT = void (*)(Sample* samples, const int32_t* residuals,
+                              uint32_t count, uint32_t order,
+                              uint32_t bit_depth);
+
+using LPCKernel = LPCKernelT<int64_t>;
+using LPCKernel32 = LPCKernelT<int32_t>;
+using FixedKernel = FixedKernelT<int64_t>;
+using FixedKernel32 = FixedKernelT<int32_t>;
+
+/**
+ * @brief Select the LPC kernel for a subframe
+ * @param order Predictor order (1-32)
+ * @param coeff_precision Quantized coefficient precision in bits (1-15)
+ * @param bit_depth Subframe bit depth (up to 33)
+ */
+LPCKernel selectLPCKernel(uint32_t order, uint32_t coeff_precision,
+                          uint32_t bit_depth);
+
+/// selectLPCKernel() for int32_t samples; bit_depth must be at most 32
+LPCKernel32 selectLPCKernel32(uint32_t order, uint32_t coeff_precision,
+                              uint32_t bit_depth);
+
+/**
+ * @brief Select the FIXED kernel for a subframe
+ * @param order Predictor order (0-4)
+ * @param bit_depth Subframe bit depth (up to 33)
+ */
+FixedKernel selectFixedKernel(uint32_t order, uint32_t bit_depth);
+
+/// selectFixedKernel() for int32_t samples; bit_depth must be at most 32
+FixedKernel32 selectFixedKernel32(uint32_t order, uint32_t bit_depth);
+
+/// Generic LPC reconstruction (64-bit accumulation, any order)
+void applyLPCReference(int64_t* samples, const int32_t* residuals,
+                       const int32_t* coeffs, uint32_t count, uint32_t order,
+                       int32_t shift, uint32_t bit_depth);
+void applyLPCReference(int32_t* samples, const int32_t* residuals,
+                       const int32_t* coeffs, uint32_t count, uint32_t order,
+                       int32_t shift, uint32_t bit_depth);
+
+/// Generic FIXED reconstruction (64-bit arithmetic, orders 0-4)
+void applyFixedReference(int64_t* samples, const int32_t* residuals,
+                         uint32_t count, uint32_t order, uint32_t bit_depth);
+void applyFixedReference(int32_t* samples, const int32_t* residuals,
+                         uint32_t count, uint32_t order, uint32_t bit_depth);
+
+} // namespace FLAC
+} // namespace Codec
+} // namespace PsyMP3
+
+#endif // PREDICTOR_KERNELS_H
@@ -39,6 +39,20 @@ public:
                           uint32_t channel_count,
                           uint32_t source_bit_depth);
     
+    /**
+     * Reconstruct samples from decoded channels to interleaved float32 output
+     * at full source resolution (full scale = [-1.0, 1.0))
+     * 
+     * Used instead of reconstructSamples() when the consumer takes float, so
+     * 17-32 bit sources skip the 16-bit downscale. Parameters and validation
+     * match reconstructSamples().
+     */
+    void reconstructSamplesFloat(float* output,
+                                 int32_t** channels,
+                                 uint32_t block_size,
+                                 uint32_t channel_count,
+                                 uint32_t source_bit_depth);
+    
 private:
     /**
      * Convert a single sample from source bit depth to 16-bit
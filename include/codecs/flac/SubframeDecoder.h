@@ -82,10 +82,28 @@ public:
     bool decodeSubframe(int64_t* output, uint32_t block_size, 
                        uint32_t bit_depth, bool is_side_channel);
     
+    /**
+     * Decode a subframe into 32-bit samples
+     *
+     * Same as the int64_t overload, for frames whose bit depth is at most 31
+     * so that side-channel samples (one extra bit) still fit.
+     *
+     * Requirements: 3, 36
+     */
+    bool decodeSubframe(int32_t* output, uint32_t block_size,
+                       uint32_t bit_depth, bool is_side_channel);
+    
 private:
     BitstreamReader* m_reader;      // Bitstream reader
     ResidualDecoder* m_residual;    // Residual decoder
     
+    /**
+     * Shared body of both decodeSubframe() overloads
+     */
+    template <typename Sample>
+    bool decodeSubframeSamples(Sample* output, uint32_t block_size,
+                               uint32_t bit_depth, bool is_side_channel);
+    
     /**
      * Parse subframe header
      * @param header Output subframe header
@@ -107,7 +125,8 @@ private:
      * 
      * Requirements: 3
      */
-    bool decodeConstant(int64_t* output, uint32_t block_size, 
+    template <typename Sample>
+    bool decodeConstant(Sample* output, uint32_t block_size, 
                        const SubframeHeader& header);
     
     /**
@@ -119,7 +138,8 @@ private:
      * 
      * Requirements: 3
      */
-    bool decodeVerbatim(int64_t* output, uint32_t block_size, 
+    template <typename Sample>
+    bool decodeVerbatim(Sample* output, uint32_t block_size, 
                        const SubframeHeader& header);
     
     /**
@@ -131,7 +151,8 @@ private:
      * 
      * Requirements: 3, 4, 35, 54
      */
-    bool decodeFixed(int64_t* output, uint32_t block_size, 
+    template <typename Sample>
+    bool decodeFixed(Sample* output, uint32_t block_size, 
                     const SubframeHeader& header);
     
     /**
@@ -143,39 +164,9 @@ private:
      * 
      * Requirements: 3, 5, 28, 35, 51, 52, 54
      */
-    bool decodeLPC(int64_t* output, uint32_t block_size, 
+    template <typename Sample>
+    bool decodeLPC(Sample* output, uint32_t block_size, 
                   const SubframeHeader& header);
-    
-    /**
-     * Apply FIXED predictor
-     * @param samples Sample buffer (warm-up samples at start, residuals follow)
-     * @param residuals Residual values
-     * @param count Number of residual samples to decode
-     * @param order Predictor order (0-4)
-     * @param bit_depth Subframe bit depth; reconstructed samples are clamped
-     *        to this range so malformed input cannot overflow the accumulator
-     *
-     * Requirements: 4, 54
-     */
-    void applyFixedPredictor(int64_t* samples, const int32_t* residuals,
-                            uint32_t count, uint32_t order, uint32_t bit_depth);
-    
-    /**
-     * Apply LPC predictor
-     * @param samples Sample buffer (warm-up samples at start, residuals follow)
-     * @param residuals Residual values
-     * @param coeffs Predictor coefficients
-     * @param count Number of residual samples to decode
-     * @param order Predictor order (1-32)
-     * @param shift Quantization level shift
-     * @param bit_depth Subframe bit depth; reconstructed samples are clamped
-     *        to this range so malformed input cannot overflow the accumulator
-     *
-     * Requirements: 5, 51, 52, 54
-     */
-    void applyLPCPredictor(int64_t* samples, const int32_t* residuals,
-                          const int32_t* coeffs, uint32_t count,
-                          uint32_t order, int32_t shift, uint32_t bit_depth);
 };
 
 } // namespace FLAC
@@ -31,14 +31,19 @@ public:
 
     bool initialize() override;
     AudioFrame decode(const MediaChunk& chunk) override;
+    DecodedAudio decodeInto(const MediaChunk& chunk, int16_t* out, size_t capacity) override;
+    size_t getMaxFrameSamples() const override { return KJMP2_SAMPLES_PER_FRAME * 2; }
     AudioFrame flush() override;
     void reset() override;
+    bool supportsReuse() const override { return true; }
+    bool resetForStream(const StreamInfo& stream_info) override;
     std::string getCodecName() const override { return "mp2"; }
     bool canDecode(const StreamInfo& stream_info) const override;
 
 private:
     bool initialize_unlocked();
     AudioFrame decode_unlocked(const MediaChunk& chunk);
+    DecodedAudio decodeInto_unlocked(const MediaChunk& chunk, int16_t* out, size_t capacity);
     void reset_unlocked();
 
     kjmp2_context_t m_decoder;
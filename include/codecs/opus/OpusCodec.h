@@ -106,7 +106,8 @@ private:
     
     // Decoding buffers
     std::vector<int16_t> m_output_buffer;
-    std::vector<float> m_float_buffer;  // For float decoding if needed
+    std::vector<float> m_float_buffer;  // libopus float output, before int16 conversion
+    std::vector<float> m_softclip_mem;  // opus_pcm_soft_clip() state, one per channel
     
     // Bounded output buffer management (Requirements 7.1, 7.2, 7.4)
     std::queue<AudioFrame> m_output_queue;
@@ -166,7 +167,7 @@ private:
     // Audio decoding (private    // Audio decoding
     AudioFrame decodeAudioPacket_unlocked(const MediaChunk& chunk);
     AudioFrame decodeAudioPacket_unlocked(const std::vector<uint8_t>& packet_data); // Legacy overload for header processing
-    void applyOutputGain_unlocked(AudioFrame& frame);
+    float outputGainFactor_unlocked() const;
     
     // Initialization methods (private unlocked methods)
     bool initialize_unlocked();
@@ -34,7 +34,12 @@ namespace PCM {
 using PsyMP3::Codec::SimplePCMCodec;
 
 /**
- * @brief Linear PCM codec (8-bit, 16-bit, 24-bit, 32-bit integer and float)
+ * @brief Linear PCM codec (8-bit, 16-bit, 24-bit, 32-bit integer, 32-bit and 64-bit float)
+ *
+ * The codec tag picks the byte order and sample type: a WAVE format tag
+ * (little-endian; IEEE float for tag 3), or for AIFF the compression type
+ * ("NONE"/"twos" big-endian, "sowt" little-endian, "fl32"/"fl64" big-endian
+ * float, also spelled "FL32"/"FL64").
  */
 class PCMCodec : public SimplePCMCodec {
 public:
@@ -49,15 +54,10 @@ protected:
     size_t getBytesPerInputSample() const override;
     
 private:
-    enum class PCMFormat {
-        PCM_8_UNSIGNED,
-        PCM_16_SIGNED,
-        PCM_24_SIGNED,
-        PCM_32_SIGNED,
-        PCM_32_FLOAT
-    } m_pcm_format;
+    PsyMP3::Core::Utility::PCMLayout m_layout;
     
     void detectPCMFormat();
+    static bool layoutFor(const StreamInfo& stream_info, PsyMP3::Core::Utility::PCMLayout& layout);
 };
 
 } // namespace PCM
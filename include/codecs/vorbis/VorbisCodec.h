@@ -205,14 +205,14 @@ private:
     // ========== Audio decoding (private unlocked methods) ==========
     AudioFrame decodeAudioPacket_unlocked(const std::vector<uint8_t>& packet_data);
     bool synthesizeBlock_unlocked();
-    void convertFloatToPCM_unlocked(float** pcm, int samples, AudioFrame& frame);
+    void convertFloatToPCM_unlocked(float** pcm, int samples, std::vector<int16_t>& output);
     
 public:
     // ========== Float to PCM conversion helpers (public for testing) ==========
     /**
      * @brief Convert a single float sample to 16-bit PCM with proper clamping
-     * @param sample Float sample in range [-1.0, 1.0]
-     * @return 16-bit signed PCM sample in range [-32768, 32767]
+     * @param sample Float sample, nominally in range [-1.0, 1.0]
+     * @return sample * 32768, rounded and saturated to [-32768, 32767]
      * 
      * Requirements: 1.5, 5.1, 5.2
      */
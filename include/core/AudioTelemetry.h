@@ -0,0 +1,135 @@
+/*
+ * AudioTelemetry.h - Lock-free timing and underrun counters for the audio pipeline.
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill II <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef PSYMP3_CORE_AUDIOTELEMETRY_H
+#define PSYMP3_CORE_AUDIOTELEMETRY_H
+
+// No direct includes - all includes should be in psymp3.h
+
+namespace PsyMP3 {
+namespace Core {
+
+// Histogram of non-negative values in power-of-two buckets: bucket 0 holds 0,
+// bucket i holds [2^(i-1), 2^i), and the last bucket everything larger. Single
+// writer: record() is a handful of relaxed loads and stores with no
+// read-modify-write, so it is safe (and cheap) on the real-time thread. Any
+// thread may read it concurrently; a reader sees each counter whole, though
+// not necessarily all of them from the same instant.
+class Log2Histogram {
+public:
+    static constexpr size_t kBuckets = 32;
+
+    struct Snapshot {
+        std::array<uint64_t, kBuckets> buckets{};
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        uint64_t max = 0;
+
+        double mean() const { return count ? static_cast<double>(sum) / count : 0.0; }
+        // Upper edge of the bucket holding the p-th fraction (0..1) of the
+        // samples, capped at max; an over-estimate by at most 2x, never an
+        // under-estimate.
+        uint64_t percentile(double p) const;
+    };
+
+    void record(uint64_t value);
+    Snapshot snapshot() const;
+    void reset();
+
+    static size_t bucketFor(uint64_t value);
+
+private:
+    std::array<std::atomic<uint64_t>, kBuckets> m_buckets{};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sum{0};
+    std::atomic<uint64_t> m_max{0};
+};
+
+// Where Audio's time goes, for telling decode, I/O and scheduling glitches
+// apart. Each thread writes only its own block (cache-line separated), so
+// nothing on the SDL callback path contends or locks:
+//   - callback block (SDL audio thread): callback duration, interval between
+//     callbacks, queued audio at entry, volume+EQ cost, underruns;
+//   - decoder block (decoder thread): Stream::getDataFloat() latency;
+//   - seek block (player thread): seeks served from the PCM history window
+//     versus those that had to seek and re-decode the stream.
+// Times are in microseconds; fill level in milliseconds of queued audio.
+// snapshot() is safe from any thread (GUI overlay, dump file).
+class AudioTelemetry {
+public:
+    struct Snapshot {
+        Log2Histogram::Snapshot callback_us;
+        Log2Histogram::Snapshot interval_us;
+        Log2Histogram::Snapshot fill_ms;
+        Log2Histogram::Snapshot dsp_us;
+        Log2Histogram::Snapshot decode_us;
+        uint64_t underruns = 0;          // callbacks that came up short while playing
+        uint64_t underrun_episodes = 0;  // runs of consecutive short callbacks
+        uint64_t underrun_us = 0;        // total time spent in those runs
+        uint64_t longest_underrun_us = 0;
+        uint64_t history_seek_hits = 0;
+        uint64_t history_seek_misses = 0;
+
+        // Multi-line human-readable report (debug dump file).
+        void writeReport(std::ostream& out) const;
+    };
+
+    // SDL callback thread, once per callback. `short_fill` is true when the
+    // callback had to pad with silence while playing; `now_us` is the
+    // callback's start on a monotonic clock.
+    void recordCallback(uint64_t now_us, uint64_t duration_us, uint64_t fill_ms,
+                        uint64_t dsp_us, bool short_fill);
+
+    // Decoder thread, once per Stream read.
+    void recordDecode(uint64_t latency_us);
+
+    // Seeking thread, once per seek.
+    void recordSeek(bool history_hit);
+
+    Snapshot snapshot() const;
+
+    // Not thread-safe: only while neither writer runs.
+    void reset();
+
+private:
+    static constexpr size_t kCacheLine = 64;
+
+    struct alignas(kCacheLine) CallbackBlock {
+        Log2Histogram duration_us;
+        Log2Histogram interval_us;
+        Log2Histogram fill_ms;
+        Log2Histogram dsp_us;
+        std::atomic<uint64_t> underruns{0};
+        std::atomic<uint64_t> underrun_episodes{0};
+        std::atomic<uint64_t> underrun_us{0};
+        std::atomic<uint64_t> longest_underrun_us{0};
+        // Callback-thread-only bookkeeping.
+        uint64_t last_start_us = 0;
+        uint64_t underrun_start_us = 0;
+        bool in_underrun = false;
+    };
+
+    struct alignas(kCacheLine) DecoderBlock {
+        Log2Histogram latency_us;
+    };
+
+    struct alignas(kCacheLine) SeekBlock {
+        std::atomic<uint64_t> history_hits{0};
+        std::atomic<uint64_t> history_misses{0};
+    };
+
+    CallbackBlock m_callback;
+    DecoderBlock m_decoder;
+    SeekBlock m_seek;
+};
+
+} // namespace Core
+} // namespace PsyMP3
+
+#endif // PSYMP3_CORE_AUDIOTELEMETRY_H
@@ -0,0 +1,72 @@
+/*
+ * LoudnessCache.h - Persistent per-file loudness measurements.
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill II <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef PSYMP3_CORE_LOUDNESSCACHE_H
+#define PSYMP3_CORE_LOUDNESSCACHE_H
+
+// No direct includes - all includes should be in psymp3.h
+
+namespace PsyMP3 {
+namespace Core {
+
+// Integrated loudness and true peak per file, so a library is scanned once.
+// Entries are keyed by path and remembered together with the file's size and
+// modification time; a file that changed since it was measured is a miss.
+//
+// Stored as a tab-separated text file (one entry per line, path last so it
+// may contain anything but a newline), rewritten through a temporary file so
+// a crash mid-save keeps the previous contents. Thread-safe: the scanner's
+// workers store results while the loader thread looks tracks up.
+class LoudnessCache {
+public:
+    struct Entry {
+        double integrated_lufs = 0.0;
+        double true_peak = 1.0; // linear
+    };
+
+    // ReplayGain 2.0 reference level.
+    static constexpr double kReferenceLufs = -18.0;
+
+    explicit LoudnessCache(std::string file_path);
+
+    // Replaces the in-memory contents with the file's; a missing or foreign
+    // file leaves the cache empty. Returns the number of entries read.
+    size_t load();
+    // Writes the cache if anything changed since the last load()/save().
+    bool save();
+
+    // The entry for `path`, if it was measured from the file as it is now.
+    std::optional<Entry> lookup(const std::string& path) const;
+    // Records a measurement of `path` as it is now (size and mtime are read
+    // here). Returns false if the file cannot be stat'ed.
+    bool store(const std::string& path, const Entry& entry);
+
+    size_t size() const;
+
+    // Linear gain bringing a track to kReferenceLufs, lowered as needed so
+    // its true peak stays at or below full scale.
+    static float playbackGain(const Entry& entry);
+
+private:
+    struct Record {
+        Entry entry;
+        uint64_t size = 0;
+        int64_t mtime = 0;
+    };
+
+    const std::string m_file_path;
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, Record> m_records;
+    bool m_dirty = false;
+};
+
+} // namespace Core
+} // namespace PsyMP3
+
+#endif // PSYMP3_CORE_LOUDNESSCACHE_H
@@ -0,0 +1,91 @@
+/*
+ * LoudnessScanner.h - Background EBU R128 loudness scanning for ReplayGain.
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill II <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef PSYMP3_CORE_LOUDNESSSCANNER_H
+#define PSYMP3_CORE_LOUDNESSSCANNER_H
+
+// No direct includes - all includes should be in psymp3.h
+
+namespace PsyMP3 {
+namespace Core {
+
+// Measures queued files on a pool of low-priority worker threads, one track
+// per worker, and records the results in a LoudnessCache. Each worker opens
+// its own Stream through the injected factory (the Player passes
+// MediaFile::open, so every format playback supports is scannable), decodes
+// it as float PCM and feeds a DSP::LoudnessMeter. Files with a valid cache
+// entry are skipped; network URIs are never scanned.
+//
+// The cache is saved whenever the queue drains and every kSaveInterval
+// tracks, so a long scan that is interrupted keeps most of its work.
+class LoudnessScanner {
+public:
+    using StreamFactory = std::function<std::unique_ptr<Stream>(const std::string&)>;
+
+    struct Progress {
+        size_t queued = 0;  // accepted by enqueue() and not yet finished
+        size_t done = 0;    // measured and stored
+        size_t failed = 0;  // could not be opened, decoded or stat'ed
+        size_t cached = 0;  // skipped: already in the cache
+        bool idle = true;   // nothing queued or in progress
+    };
+
+    static constexpr size_t kSaveInterval = 25;
+
+    // threads == 0 uses one worker per hardware thread.
+    LoudnessScanner(LoudnessCache& cache, StreamFactory open_stream, unsigned int threads = 0);
+    // Cancels pending work and joins the workers; the track in progress on
+    // each worker is abandoned.
+    ~LoudnessScanner();
+
+    LoudnessScanner(const LoudnessScanner&) = delete;
+    LoudnessScanner& operator=(const LoudnessScanner&) = delete;
+
+    // Queues the files that are not cached, queued or in progress already.
+    // Returns how many were queued.
+    size_t enqueue(const std::vector<std::string>& paths);
+    // Drops queued files and abandons those in progress.
+    void cancel();
+    // Blocks until the queue is drained and no worker is busy.
+    void waitIdle();
+
+    Progress progress() const;
+    unsigned int threadCount() const { return static_cast<unsigned int>(m_workers.size()); }
+
+    // Decodes `stream` to the end and measures it. Returns nothing for an
+    // empty or unsupported stream, or when `keep_going` turns false.
+    static std::optional<LoudnessCache::Entry> measure(Stream& stream,
+                                                       const std::function<bool()>& keep_going = {});
+
+private:
+    void workerLoop(unsigned int index);
+
+    LoudnessCache& m_cache;
+    StreamFactory m_open_stream;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_work_cv;
+    std::condition_variable m_idle_cv;
+    std::deque<std::string> m_queue;
+    std::unordered_set<std::string> m_pending; // queued or in progress
+    size_t m_active = 0;
+    size_t m_done = 0;
+    size_t m_failed = 0;
+    size_t m_cached = 0;
+    size_t m_unsaved = 0;
+    bool m_stop = false;
+    // Bumped by cancel(); a worker whose job predates it stops decoding.
+    std::atomic<uint64_t> m_generation{0};
+    std::vector<std::thread> m_workers;
+};
+
+} // namespace Core
+} // namespace PsyMP3
+
+#endif // PSYMP3_CORE_LOUDNESSSCANNER_H
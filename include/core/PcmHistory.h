@@ -0,0 +1,56 @@
+/*
+ * PcmHistory.h - Window of recently decoded PCM for seeks without re-decoding.
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill II <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef PSYMP3_CORE_PCMHISTORY_H
+#define PSYMP3_CORE_PCMHISTORY_H
+
+// No direct includes - all includes should be in psymp3.h
+
+namespace PsyMP3 {
+namespace Core {
+
+// The most recent `capacity` frames of a stream's interleaved PCM, addressed
+// by absolute frame number. Audio appends everything it queues for the
+// current stream, so the window covers both what was just played and what is
+// queued ahead of the playhead; a seek to any frame inside it can be replayed
+// from here instead of seeking and re-decoding the stream.
+//
+// Not thread-safe; Audio guards it with its buffer mutex.
+class PcmHistory {
+public:
+    // Resizes the window (0 frames disables it), keeping as much of the
+    // newest audio as still fits.
+    void configure(unsigned int channels, size_t capacity_frames);
+    // Forgets the contents; the next append() starts at `frame`.
+    void reset(uint64_t frame);
+    // Appends interleaved samples, overwriting the oldest once full.
+    void append(const float* samples, size_t count);
+
+    bool enabled() const { return !m_buffer.empty(); }
+    size_t capacityFrames() const { return m_channels ? m_buffer.size() / m_channels : 0; }
+    // First frame still held, and one past the last appended.
+    uint64_t beginFrame() const { return m_channels ? m_begin / m_channels : 0; }
+    uint64_t endFrame() const { return m_channels ? m_end / m_channels : 0; }
+
+    // Copies frames [frame, endFrame()) into `out`. False, leaving `out`
+    // untouched, when `frame` is not in [beginFrame(), endFrame()].
+    bool copyFrom(uint64_t frame, std::vector<float>& out) const;
+
+private:
+    std::vector<float> m_buffer;
+    unsigned int m_channels = 0;
+    // Absolute sample positions (frame * channels) of the held range.
+    uint64_t m_begin = 0;
+    uint64_t m_end = 0;
+};
+
+} // namespace Core
+} // namespace PsyMP3
+
+#endif // PSYMP3_CORE_PCMHISTORY_H
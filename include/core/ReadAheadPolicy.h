@@ -0,0 +1,113 @@
+/*
+ * ReadAheadPolicy.h - Self-tuning decoder read-ahead for the PCM queue.
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill II <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef PSYMP3_CORE_READAHEADPOLICY_H
+#define PSYMP3_CORE_READAHEADPOLICY_H
+
+// No direct includes - all includes should be in psymp3.h
+
+namespace PsyMP3 {
+namespace Core {
+
+// Decides how much decoded audio Audio's decoder thread keeps queued ahead of
+// the SDL callback, in milliseconds of audio rather than a fixed sample count,
+// so the same policy fits 8 kHz mono and 192 kHz 7.1.
+//
+// The decoder feeds it rolling statistics:
+//   - per-chunk decode cost (thread CPU time per second of audio produced),
+//   - per-chunk I/O stall (wall time spent blocked, i.e. wall minus CPU),
+//   - the callback's measured drain rate against the nominal rate.
+// The target is sized to ride out the worst recent refill gap: a few times
+// the slowest recent chunk (decode plus stall), stretched when decoding eats
+// most of real time or the device drains faster than nominal. Slow HTTP
+// sources and expensive codecs grow it toward max_ms; cheap local PCM settles
+// at min_ms. Peaks decay with a half-life of kPeakHalfLifeMs of decoded
+// audio, so one network hiccup does not pin the queue at its maximum.
+//
+// Not thread-safe: Audio only touches it under its buffer mutex.
+class ReadAheadPolicy {
+public:
+    struct Bounds {
+        unsigned int min_ms;
+        unsigned int max_ms;
+    };
+
+    static constexpr Bounds kLocalBounds  = {100, 750};
+    static constexpr Bounds kRemoteBounds = {250, 4000};
+
+    // Decode granularity, and the half-life of the stall/cost peaks.
+    static constexpr unsigned int kChunkMs = 20;
+    static constexpr unsigned int kPeakHalfLifeMs = 10000;
+
+    ReadAheadPolicy() = default;
+
+    // Bounds for a stream opened from `uri`: local files keep the queue short,
+    // network streams (any scheme other than file://) get room for stalls.
+    static Bounds boundsForSource(const std::string& uri);
+
+    // Decode chunk size for a format, in samples (whole frames).
+    static size_t chunkSamplesFor(unsigned int rate, unsigned int channels);
+
+    // Start over for a new stream: the queue format, its bounds, and fresh
+    // statistics (the previous stream's codec and source say nothing about
+    // this one). max_ms is capped by setCeiling().
+    void configure(unsigned int rate, unsigned int channels, Bounds bounds);
+
+    // Largest read-ahead the queue storage was sized for; later configure()
+    // calls never exceed it. 0 removes the cap.
+    void setCeiling(unsigned int max_ms);
+
+    // A decode call produced `audio_ns` of audio, spending `cpu_ns` on the
+    // decoder thread's CPU clock and `wall_ns` of wall time. Pass cpu_ns = 0
+    // where no thread clock exists; the whole call then counts as a stall.
+    void recordChunk(uint64_t audio_ns, uint64_t cpu_ns, uint64_t wall_ns);
+
+    // The callback has played `frames_played` frames in total as of `now_ns`
+    // (any monotonic clock). Idle periods (paused) and jumps backwards (seek)
+    // restart the measurement instead of skewing it.
+    void recordDrain(uint64_t frames_played, uint64_t now_ns);
+
+    unsigned int targetMs() const { return m_target_ms; }
+    Bounds bounds() const { return m_bounds; }
+    // High-water mark for the queue, in samples (whole frames).
+    size_t targetSamples() const { return msToSamples(m_target_ms); }
+    // Read-ahead at max_ms, for sizing the queue.
+    size_t maxSamples() const { return msToSamples(m_bounds.max_ms); }
+    size_t chunkSamples() const { return chunkSamplesFor(m_rate, m_channels); }
+
+    // Rolling statistics, for diagnostics.
+    double decodeCost() const { return m_cost; }          // CPU s per audio s
+    double peakStallMs() const { return m_peak_stall_ms; }
+    double peakChunkMs() const { return m_peak_chunk_ms; }
+    double drainRatio() const { return m_drain_ratio; }   // measured / nominal
+
+private:
+    size_t msToSamples(unsigned int ms) const;
+    void updateTarget();
+
+    unsigned int m_rate = 44100;
+    unsigned int m_channels = 2;
+    unsigned int m_ceiling_ms = 0;
+    Bounds m_bounds = kLocalBounds;
+    unsigned int m_target_ms = kLocalBounds.min_ms;
+
+    double m_cost = 0.0;
+    double m_peak_stall_ms = 0.0;
+    double m_peak_chunk_ms = 0.0;
+    double m_drain_ratio = 1.0;
+
+    bool m_drain_valid = false;
+    uint64_t m_drain_frames = 0;
+    uint64_t m_drain_ns = 0;
+};
+
+} // namespace Core
+} // namespace PsyMP3
+
+#endif // PSYMP3_CORE_READAHEADPOLICY_H
@@ -0,0 +1,195 @@
+/*
+ * SPSCRingBuffer.h - Lock-free single-producer/single-consumer ring buffer.
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill II <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef PSYMP3_CORE_SPSCRINGBUFFER_H
+#define PSYMP3_CORE_SPSCRINGBUFFER_H
+
+// No direct includes - all includes should be in psymp3.h
+
+namespace PsyMP3 {
+namespace Core {
+
+// Fixed-capacity ring of trivially copyable elements with exactly one producer
+// and one consumer, neither of which ever locks or allocates. Built for the
+// decoded-PCM queue between the decoder thread and the SDL audio callback.
+//
+// Indices are free-running size_t counters (wrap-safe: only their differences
+// are ever compared) masked into a power-of-two backing array. The write, read
+// and flush indices each sit on their own cache line so the two sides do not
+// false-share.
+//
+// Discarding queued data (seek / track swap) is a producer-side operation:
+// flush() publishes the current write index as a flush mark, and the consumer
+// jumps its read index forward to that mark on its next read(). The consumer
+// therefore never observes a half-reset ring, and data the producer writes
+// after the flush is kept. The space held by flushed data is reclaimed only
+// once the consumer has run, so producers must tolerate a short write().
+//
+// A producer that can generate data in place (a decoder) asks for the free
+// space with writeRegion(), fills it, and publishes it with commitWrite(),
+// saving the copy through a staging buffer. The region stays valid while the
+// consumer runs, since reading only frees more space; another producer-side
+// call before the commit invalidates it.
+//
+// "Producer" may be more than one thread as long as the callers serialize
+// themselves (Audio does so with its buffer mutex); the consumer is a single
+// thread.
+template<typename T>
+class SPSCRingBuffer {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "SPSCRingBuffer copies elements with memcpy");
+
+public:
+    SPSCRingBuffer() = default;
+    explicit SPSCRingBuffer(size_t min_capacity) { allocate(min_capacity); }
+
+    SPSCRingBuffer(const SPSCRingBuffer&) = delete;
+    SPSCRingBuffer& operator=(const SPSCRingBuffer&) = delete;
+
+    // (Re)allocate for at least `min_capacity` elements (rounded up to a power
+    // of two) and empty the ring. Not thread-safe: call only while neither the
+    // producer nor the consumer is running.
+    void allocate(size_t min_capacity)
+    {
+        size_t cap = 1;
+        while (cap < min_capacity) cap <<= 1;
+        m_data = std::make_unique<T[]>(cap);
+        m_mask = cap - 1;
+        m_write.store(0, std::memory_order_relaxed);
+        m_read.store(0, std::memory_order_relaxed);
+        m_flush.store(0, std::memory_order_relaxed);
+    }
+
+    size_t capacity() const { return m_data ? m_mask + 1 : 0; }
+
+    // Elements the consumer can still read (excludes flushed data). Exact on
+    // the consumer thread; a snapshot anywhere else.
+    size_t size() const
+    {
+        const size_t w = m_write.load(std::memory_order_acquire);
+        size_t r = m_read.load(std::memory_order_acquire);
+        const size_t f = m_flush.load(std::memory_order_acquire);
+        if (after(f, r)) r = f;
+        return w - r;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    // Producer: free slots. Flushed-but-unconsumed data still occupies space.
+    size_t writeAvailable() const
+    {
+        const size_t w = m_write.load(std::memory_order_relaxed);
+        const size_t r = m_read.load(std::memory_order_acquire);
+        return capacity() - (w - r);
+    }
+
+    // Producer: copy up to `count` elements in; returns how many fit.
+    size_t write(const T* src, size_t count)
+    {
+        if (!m_data || count == 0) return 0;
+        const size_t w = m_write.load(std::memory_order_relaxed);
+        const size_t r = m_read.load(std::memory_order_acquire);
+        const size_t n = std::min(count, capacity() - (w - r));
+        if (n == 0) return 0;
+
+        const size_t pos = w & m_mask;
+        const size_t first = std::min(n, capacity() - pos);
+        std::memcpy(&m_data[pos], src, first * sizeof(T));
+        std::memcpy(&m_data[0], src + first, (n - first) * sizeof(T));
+        m_write.store(w + n, std::memory_order_release);
+        return n;
+    }
+
+    // Free space at the write end, as up to two pieces (the second one when
+    // it wraps to the start of the backing array).
+    struct WriteRegion {
+        T* first = nullptr;
+        size_t first_count = 0;
+        T* second = nullptr;
+        size_t second_count = 0;
+        size_t size() const { return first_count + second_count; }
+    };
+
+    // Producer: up to `max_count` free elements to fill in place. Nothing is
+    // visible to the consumer until commitWrite().
+    WriteRegion writeRegion(size_t max_count)
+    {
+        WriteRegion region;
+        if (!m_data) return region;
+        const size_t w = m_write.load(std::memory_order_relaxed);
+        const size_t r = m_read.load(std::memory_order_acquire);
+        const size_t n = std::min(max_count, capacity() - (w - r));
+        const size_t pos = w & m_mask;
+        region.first = &m_data[pos];
+        region.first_count = std::min(n, capacity() - pos);
+        region.second = &m_data[0];
+        region.second_count = n - region.first_count;
+        return region;
+    }
+
+    // Producer: publish the first `count` elements of the last writeRegion(),
+    // in order (first piece, then second).
+    void commitWrite(size_t count)
+    {
+        m_write.store(m_write.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    // Producer: discard everything written so far. Takes effect on the
+    // consumer's next read(), which reports it through `flushed`.
+    void flush()
+    {
+        m_flush.store(m_write.load(std::memory_order_relaxed), std::memory_order_release);
+    }
+
+    // Consumer: copy up to `count` elements out; returns how many were read.
+    // Applies any pending flush first (even when `count` is 0) and sets
+    // *flushed when it did, so the caller can reset state tied to the old data.
+    size_t read(T* dst, size_t count, bool* flushed = nullptr)
+    {
+        if (flushed) *flushed = false;
+        if (!m_data) return 0;
+        size_t r = m_read.load(std::memory_order_relaxed);
+        const size_t f = m_flush.load(std::memory_order_acquire);
+        if (after(f, r)) {
+            r = f;
+            if (flushed) *flushed = true;
+        }
+        const size_t w = m_write.load(std::memory_order_acquire);
+        const size_t n = std::min(count, w - r);
+
+        const size_t pos = r & m_mask;
+        const size_t first = std::min(n, capacity() - pos);
+        if (n > 0) {
+            std::memcpy(dst, &m_data[pos], first * sizeof(T));
+            std::memcpy(dst + first, &m_data[0], (n - first) * sizeof(T));
+        }
+        m_read.store(r + n, std::memory_order_release);
+        return n;
+    }
+
+private:
+    // true when free-running index `a` is strictly ahead of `b`.
+    static bool after(size_t a, size_t b)
+    {
+        return static_cast<std::make_signed_t<size_t>>(a - b) > 0;
+    }
+
+    static constexpr size_t kCacheLine = 64;
+
+    alignas(kCacheLine) std::atomic<size_t> m_write{0}; // producer-owned
+    alignas(kCacheLine) std::atomic<size_t> m_read{0};  // consumer-owned
+    alignas(kCacheLine) std::atomic<size_t> m_flush{0}; // producer-published
+    alignas(kCacheLine) std::unique_ptr<T[]> m_data;
+    size_t m_mask = 0;
+};
+
+} // namespace Core
+} // namespace PsyMP3
+
+#endif // PSYMP3_CORE_SPSCRINGBUFFER_H
@@ -0,0 +1,68 @@
+/*
+ * CRC.h - FLAC CRC-8 and CRC-16 computation
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef PSYMP3_CORE_UTILITY_CRC_H
+#define PSYMP3_CORE_UTILITY_CRC_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace PsyMP3 {
+namespace Core {
+namespace Utility {
+
+/**
+ * @brief The CRCs FLAC protects its frames with (RFC 9639 Section 9.1.8, 9.3)
+ *
+ * - CRC-8, polynomial 0x07 (x^8 + x^2 + x + 1), over every frame header
+ * - CRC-16, polynomial 0x8005 (x^16 + x^15 + x^2 + 1), over every frame
+ *
+ * Both are MSB-first with no final XOR. The initial value is the running
+ * CRC, so a buffer can be processed in pieces: crc16(b, n, crc16(a, m))
+ * equals the CRC of a followed by b. It is 0 for a fresh computation.
+ *
+ * crc8() and crc16() pick the fastest implementation once, at first use:
+ * carry-less multiply folding (PCLMULQDQ) when the CPU has it and the input
+ * is long enough to amortize it, else slice-by-16 tables. The individual
+ * implementations are public for validation and benchmarking; they all
+ * return exactly what the byte-at-a-time reference returns.
+ */
+class CRC {
+public:
+    static uint8_t crc8(const uint8_t* data, size_t length, uint8_t crc = 0);
+    static uint16_t crc16(const uint8_t* data, size_t length, uint16_t crc = 0);
+
+    /// Name of the implementation crc8()/crc16() use for long inputs
+    static const char* implementation();
+
+    /// One table lookup per byte (the reference)
+    static uint8_t crc8Bytewise(const uint8_t* data, size_t length, uint8_t crc = 0);
+    static uint16_t crc16Bytewise(const uint8_t* data, size_t length, uint16_t crc = 0);
+
+    /// Eight bytes per step through eight tables
+    static uint8_t crc8Slice8(const uint8_t* data, size_t length, uint8_t crc = 0);
+    static uint16_t crc16Slice8(const uint8_t* data, size_t length, uint16_t crc = 0);
+
+    /// Sixteen bytes per step through sixteen tables
+    static uint8_t crc8Slice16(const uint8_t* data, size_t length, uint8_t crc = 0);
+    static uint16_t crc16Slice16(const uint8_t* data, size_t length, uint16_t crc = 0);
+
+    /// True when this CPU can run the carry-less multiply implementations
+    static bool hasCarrylessMultiply();
+
+    /// Carry-less multiply folding; only call when hasCarrylessMultiply()
+    static uint8_t crc8Clmul(const uint8_t* data, size_t length, uint8_t crc = 0);
+    static uint16_t crc16Clmul(const uint8_t* data, size_t length, uint16_t crc = 0);
+};
+
+} // namespace Utility
+} // namespace Core
+} // namespace PsyMP3
+
+#endif // PSYMP3_CORE_UTILITY_CRC_H
@@ -0,0 +1,100 @@
+/*
+ * PCMConvert.h - Vectorized integer, float and G.711 PCM to int16 conversion
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef PSYMP3_CORE_UTILITY_PCMCONVERT_H
+#define PSYMP3_CORE_UTILITY_PCMCONVERT_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace PsyMP3 {
+namespace Core {
+namespace Utility {
+
+/**
+ * @brief Byte layout of one PCM input sample
+ */
+enum class PCMLayout {
+    U8,     // Unsigned 8-bit, WAV
+    S8,     // Signed 8-bit, AIFF
+    S16LE,
+    S16BE,
+    S24LE,  // Packed, three bytes per sample
+    S24BE,
+    S32LE,
+    S32BE,
+    F32LE,  // IEEE float, nominally [-1, 1]
+    F32BE,
+    F64LE,
+    F64BE
+};
+
+/**
+ * @brief Linear PCM and G.711 to int16 conversion for the PCM codecs
+ *
+ * Integer samples keep their top 16 bits: 8-bit samples are scaled by 256,
+ * wider ones truncated. Float samples are clamped to [-1, 1], scaled by
+ * 32767 and truncated toward zero; NaN becomes 0. G.711 samples are looked
+ * up in the caller's 256-entry table.
+ *
+ * toInt16() and lookupToInt16() pick the fastest implementation once, at
+ * first use: AVX2 when the CPU has it, else SSE2 or NEON, else scalar. The
+ * individual implementations are public for validation and benchmarking;
+ * they all return exactly what the scalar reference returns. Input may be
+ * unaligned. Output buffers are pre-sized by the caller; nothing is
+ * allocated.
+ */
+class PCMConvert {
+public:
+    using ToInt16Fn = void (*)(const uint8_t* in, size_t samples, PCMLayout layout, int16_t* out);
+    using LookupToInt16Fn = void (*)(const uint8_t* in, size_t samples, const int16_t* table, int16_t* out);
+
+    /// Input bytes per sample of a layout
+    static size_t bytesPerSample(PCMLayout layout);
+
+    /**
+     * @brief Convert linear PCM samples to int16
+     * @param in samples * bytesPerSample(layout) bytes
+     * @param out samples int16 samples
+     */
+    static void toInt16(const uint8_t* in, size_t samples, PCMLayout layout, int16_t* out);
+
+    /**
+     * @brief Map 8-bit codes through a 256-entry table (A-law, µ-law)
+     * @param table int16 value for each code
+     */
+    static void lookupToInt16(const uint8_t* in, size_t samples, const int16_t* table, int16_t* out);
+
+    /// Name of the implementation the dispatching functions use
+    static const char* implementation();
+
+    /// One sample at a time (the reference)
+    static void toInt16Scalar(const uint8_t* in, size_t samples, PCMLayout layout, int16_t* out);
+    static void lookupToInt16Scalar(const uint8_t* in, size_t samples, const int16_t* table, int16_t* out);
+
+    /// 16 bytes per step; scalar for 24-bit samples, table lookups and where
+    /// the build has no SSE2
+    static void toInt16SSE2(const uint8_t* in, size_t samples, PCMLayout layout, int16_t* out);
+    static void lookupToInt16SSE2(const uint8_t* in, size_t samples, const int16_t* table, int16_t* out);
+
+    /// 32 bytes per step, table lookups by gather; only call when
+    /// SampleConvert::hasAVX2()
+    static void toInt16AVX2(const uint8_t* in, size_t samples, PCMLayout layout, int16_t* out);
+    static void lookupToInt16AVX2(const uint8_t* in, size_t samples, const int16_t* table, int16_t* out);
+
+    /// 16 bytes per step on AArch64; scalar elsewhere
+    static void toInt16NEON(const uint8_t* in, size_t samples, PCMLayout layout, int16_t* out);
+    static void lookupToInt16NEON(const uint8_t* in, size_t samples, const int16_t* table, int16_t* out);
+};
+
+} // namespace Utility
+} // namespace Core
+} // namespace PsyMP3
+
+#endif // PSYMP3_CORE_UTILITY_PCMCONVERT_H
@@ -0,0 +1,91 @@
+/*
+ * SampleConvert.h - Vectorized sample format conversion
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef PSYMP3_CORE_UTILITY_SAMPLECONVERT_H
+#define PSYMP3_CORE_UTILITY_SAMPLECONVERT_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace PsyMP3 {
+namespace Core {
+namespace Utility {
+
+/**
+ * @brief State for triangular (TPDF) dither, ±1 LSB
+ *
+ * The noise comes from a fixed-seed LCG, so a given state always produces
+ * the same output. Carry one state across the calls for a stream.
+ */
+struct Dither {
+    uint32_t state = 0x9E3779B9u;
+};
+
+/**
+ * @brief Float to int16 conversion for the decoders that produce float
+ *
+ * Samples are scaled by 32768 * gain, optionally dithered, rounded to
+ * nearest and saturated to [-32768, 32767]. NaN becomes 0. This matches
+ * the int16 conversion in DemuxedStream and the resampler.
+ *
+ * planarFloatToInt16() and floatToInt16() pick the fastest implementation
+ * once, at first use: AVX2 when the CPU has it, else SSE2 or NEON, else
+ * scalar. The individual implementations are public for validation and
+ * benchmarking; they all return exactly what the scalar reference returns.
+ * Output buffers are pre-sized by the caller; nothing is allocated.
+ */
+class SampleConvert {
+public:
+    using PlanarFloatToInt16Fn = void (*)(const float* const* planes, size_t frames, unsigned channels,
+                                          int16_t* out, float gain, Dither* dither);
+
+    /**
+     * @brief Interleave planar float channels into int16
+     * @param planes One pointer per channel, each with @p frames samples
+     * @param out frames * channels samples
+     * @param dither Null for no dither
+     */
+    static void planarFloatToInt16(const float* const* planes, size_t frames, unsigned channels,
+                                   int16_t* out, float gain = 1.0f, Dither* dither = nullptr);
+
+    /// Convert already-interleaved float samples to int16
+    static void floatToInt16(const float* in, size_t count, int16_t* out,
+                             float gain = 1.0f, Dither* dither = nullptr);
+
+    /// Convert one sample, without gain or dither
+    static int16_t floatToInt16(float sample);
+
+    /// Name of the implementation the dispatching functions use
+    static const char* implementation();
+
+    /// One sample at a time (the reference)
+    static void planarFloatToInt16Scalar(const float* const* planes, size_t frames, unsigned channels,
+                                         int16_t* out, float gain = 1.0f, Dither* dither = nullptr);
+
+    /// Four samples per step; scalar where the build has no SSE2
+    static void planarFloatToInt16SSE2(const float* const* planes, size_t frames, unsigned channels,
+                                       int16_t* out, float gain = 1.0f, Dither* dither = nullptr);
+
+    /// True when this CPU can run the AVX2 implementation
+    static bool hasAVX2();
+
+    /// Eight samples per step; only call when hasAVX2()
+    static void planarFloatToInt16AVX2(const float* const* planes, size_t frames, unsigned channels,
+                                       int16_t* out, float gain = 1.0f, Dither* dither = nullptr);
+
+    /// Four samples per step on AArch64; scalar elsewhere
+    static void planarFloatToInt16NEON(const float* const* planes, size_t frames, unsigned channels,
+                                       int16_t* out, float gain = 1.0f, Dither* dither = nullptr);
+};
+
+} // namespace Utility
+} // namespace Core
+} // namespace PsyMP3
+
+#endif // PSYMP3_CORE_UTILITY_SAMPLECONVERT_H
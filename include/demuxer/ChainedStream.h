@@ -36,6 +36,7 @@ public:
     // Overridden methods from Stream
     virtual void open(TagLib::String name) override; // This will be a no-op
     virtual size_t getData(size_t len, void *buf) override;
+    virtual size_t getDataFloat(size_t count, float *buf) override;
     virtual void seekTo(unsigned long pos) override;
     virtual bool eof() override;
 
@@ -45,9 +46,18 @@ public:
     virtual unsigned int getPosition() override;
     virtual unsigned long long getSPosition() override;
 
+    // Per-track playback gains, in path order (1.0 for tracks not listed).
+    // getPlaybackGain() follows the track the last read came from; a read
+    // never spans two tracks, so each chunk has exactly one gain.
+    void setTrackGains(std::vector<float> gains);
+
 private:
     bool openNextTrack();                       // assumes m_chain_mutex is held
     unsigned long long getSPosition_unlocked(); // assumes m_chain_mutex is held
+    // Shared body of getData()/getDataFloat(): `read` pulls up to n units from
+    // one inner stream. Assumes m_chain_mutex is held.
+    template<typename T, typename ReadFn>
+    size_t readChain_unlocked(T *out, size_t count, ReadFn read);
 
     // Serializes the decode path (getData) against position/seek queries from
     // the UI thread, which read/dereference m_current_stream while getData
@@ -58,6 +68,7 @@ private:
     std::vector<TagLib::String> m_paths;
     std::vector<unsigned int> m_track_lengths_ms;
     std::vector<unsigned long long> m_track_lengths_samples;
+    std::vector<float> m_track_gains;
     size_t m_current_track_index;
     std::unique_ptr<Stream> m_current_stream;
 
@@ -95,6 +95,7 @@ private:
     // Format type constants (Read using container endianness)
     static constexpr uint32_t WAVE_FOURCC = 0x45564157; // "WAVE" (read as little-endian)
     static constexpr uint32_t AIFF_FOURCC = 0x41494646; // "AIFF" (read as big-endian)
+    static constexpr uint32_t AIFC_FOURCC = 0x41494643; // "AIFC" (read as big-endian)
     
     // RIFF/WAV chunk constants (FourCC always read as Big-Endian)
     static constexpr uint32_t FMT_FOURCC  = 0x666d7420; // "fmt "
@@ -117,9 +118,12 @@ private:
     
     // AIFF compression types
     static constexpr uint32_t AIFF_NONE = 0x4E4F4E45; // "NONE"
+    static constexpr uint32_t AIFF_TWOS = 0x74776F73; // "twos" (big-endian PCM)
     static constexpr uint32_t AIFF_SOWT = 0x736F7774; // "sowt" (byte-swapped PCM)
     static constexpr uint32_t AIFF_FL32 = 0x666C3332; // "fl32" (32-bit float)
     static constexpr uint32_t AIFF_FL64 = 0x666C3634; // "fl64" (64-bit float)
+    static constexpr uint32_t AIFF_FL32_UPPER = 0x464C3332; // "FL32" (older spelling)
+    static constexpr uint32_t AIFF_FL64_UPPER = 0x464C3634; // "FL64" (older spelling)
     static constexpr uint32_t AIFF_ALAW = 0x616C6177; // "alaw"
     static constexpr uint32_t AIFF_ULAW = 0x756C6177; // "ulaw"
     
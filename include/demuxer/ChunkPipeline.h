@@ -0,0 +1,108 @@
+/*
+ * ChunkPipeline.h - Read-ahead demux stage feeding DemuxedStream's codec.
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill II <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef PSYMP3_DEMUXER_CHUNKPIPELINE_H
+#define PSYMP3_DEMUXER_CHUNKPIPELINE_H
+
+// No direct includes - all includes should be in psymp3.h
+
+namespace PsyMP3 {
+namespace Demuxer {
+
+// Runs Demuxer::readChunk() on its own thread, ahead of the codec, so that
+// I/O latency (a slow disk, an HTTP round trip) overlaps with decoding
+// instead of adding to it. Chunks travel through a bounded single-producer/
+// single-consumer slot ring; the demux thread blocks while it is full, which
+// is the backpressure.
+//
+// Every chunk carries the epoch it was read in. reposition() parks the demux
+// thread, lets the caller move the demuxer (seek, stream switch) and bumps
+// the epoch, so anything read before the move -- including a chunk the demux
+// thread is holding while it waits for room -- is dropped on the consumer
+// side rather than decoded at the wrong position.
+//
+// The consumer methods (pop, tryPop, finished, reposition) must be called
+// from one thread at a time; DemuxedStream calls them under its decode lock.
+class ChunkPipeline {
+public:
+    static constexpr size_t kCapacity = 32;
+
+    // Starts the demux thread reading `stream_id`. The demuxer must outlive
+    // the pipeline, and anything that moves it (readChunk(), seekTo()) must
+    // go through reposition(). Metadata queries (getStreams(),
+    // getStreamInfo(), getDuration(), getTag()) may still come from other
+    // threads: Demuxer documents them as safe to call concurrently once
+    // parseContainer() has completed, and each demuxer provides that with
+    // its own locking or with values fixed during parsing.
+    ChunkPipeline(Demuxer& demuxer, uint32_t stream_id);
+    // Stops and joins the demux thread.
+    ~ChunkPipeline();
+
+    ChunkPipeline(const ChunkPipeline&) = delete;
+    ChunkPipeline& operator=(const ChunkPipeline&) = delete;
+
+    // Takes the next chunk, waiting for the demux thread if it is behind.
+    // Returns false once the demuxer is exhausted and everything read has
+    // been taken, or after stop().
+    bool pop(MediaChunk& out);
+    // Takes the next chunk if one is ready.
+    bool tryPop(MediaChunk& out);
+    // True when the demuxer is exhausted and nothing read is left to take.
+    bool finished();
+
+    // Parks the demux thread, runs `action` on the demuxer, discards all
+    // read-ahead and resumes reading `stream_id` from wherever `action` left
+    // the demuxer.
+    void reposition(uint32_t stream_id, const std::function<void(Demuxer&)>& action);
+
+    // Stops and joins the demux thread. Chunks it had read stay available to
+    // tryPop(), so the caller can take over reading without losing any.
+    void stop();
+
+private:
+    struct Slot {
+        MediaChunk chunk;
+        uint64_t epoch = 0;
+    };
+    static constexpr uint64_t kNoEpoch = ~uint64_t{0};
+
+    void demuxLoop();
+    // Waits for room and publishes; false if the epoch moved on or the
+    // pipeline stopped first (the chunk is then left in `chunk`).
+    bool push(MediaChunk& chunk, uint64_t epoch);
+    bool popCurrent(MediaChunk& out);
+    void wake();
+
+    Demuxer& m_demuxer;
+
+    // Held by the demux thread around each readChunk() and by reposition().
+    std::mutex m_demux_mutex;
+    uint32_t m_stream_id;                           // guarded by m_demux_mutex
+    std::atomic<uint64_t> m_epoch{0};               // written under m_demux_mutex
+    std::atomic<uint64_t> m_end_epoch{kNoEpoch};    // epoch the demuxer ran dry in
+
+    std::array<Slot, kCapacity> m_slots;
+    alignas(64) std::atomic<size_t> m_head{0};      // consumer
+    alignas(64) std::atomic<size_t> m_tail{0};      // producer
+
+    // Sleeping only; the ring itself is lock-free.
+    std::mutex m_wait_mutex;
+    std::condition_variable m_wait_cv;
+
+    std::atomic<bool> m_stop{false};
+    // A chunk the demux thread read but could not queue before stop().
+    std::optional<MediaChunk> m_leftover;
+    uint64_t m_leftover_epoch = 0;
+    std::thread m_thread;
+};
+
+} // namespace Demuxer
+} // namespace PsyMP3
+
+#endif // PSYMP3_DEMUXER_CHUNKPIPELINE_H
@@ -56,10 +56,42 @@ public:
     /**
      * @brief Destructor
      */
-    ~DemuxedStream() override = default;
+    ~DemuxedStream() override;
+    
+    /**
+     * @brief Enable or disable the pipelined demux stage
+     * 
+     * When enabled, a ChunkPipeline reads compressed chunks ahead of the
+     * codec on its own thread, so demuxer I/O overlaps with decoding instead
+     * of stalling the audio decoder thread. Enabled automatically for HTTP
+     * sources. Chunks already read are kept across the switch.
+     */
+    void setPipelined(bool enable);
+    
+    /**
+     * @brief Whether the pipelined demux stage is active
+     */
+    bool isPipelined() const;
+    
+    /**
+     * @brief Decode batches of chunks on several threads
+     * 
+     * With codecs whose chunks decode independently
+     * (AudioCodec::supportsParallelDecode(), i.e. FLAC), up to `threads`
+     * workers then decode several frames at a time, returned in order. For
+     * headless rendering and analysis, where throughput matters more than
+     * the latency of the first frame. Playback keeps the default, 1, and
+     * decodes one frame at a time, seeks included.
+     * 
+     * @param threads Worker count; 0 means one per core, 1 turns batching off
+     */
+    void setParallelDecode(unsigned threads);
     
     // Stream interface implementation
     size_t getData(size_t len, void *buf) override;
+    size_t getDataFloat(size_t count, float *buf) override;
+    size_t getDataInto(float *first, size_t first_count,
+                       float *second, size_t second_count) override;
     void seekTo(unsigned long pos) override;
     bool eof() override;
     unsigned int getLength() override;
@@ -108,11 +140,19 @@ private:
     std::unique_ptr<AudioCodec> m_codec;
     uint32_t m_current_stream_id = 0;
     
+    // Read-ahead demux stage (see setPipelined()). Declared after m_demuxer
+    // so it is destroyed, and its thread joined, before the demuxer it reads.
+    // Guarded by m_decode_mutex.
+    std::unique_ptr<ChunkPipeline> m_pipeline;
+    
     // Bounded buffer management for memory efficiency
     std::queue<MediaChunk> m_chunk_buffer;
     std::queue<MediaChunk> m_temp_chunk_buffer;
     AudioFrame m_current_frame;
-    size_t m_current_frame_offset = 0;  // Byte offset within current frame
+    size_t m_current_frame_offset = 0;  // Sample offset within current frame
+    // Spare buffer for AudioCodec::decodeInto(). It trades places with
+    // m_current_frame's samples, so steady-state decoding reuses two buffers.
+    std::vector<int16_t> m_decode_buffer;
     
     // Thread synchronization for buffer access
     mutable std::mutex m_buffer_mutex;
@@ -129,6 +169,12 @@ private:
     size_t m_current_buffer_bytes = 0;                      // Current buffer memory usage
     size_t m_temp_buffer_bytes = 0;
     
+    // Batched decoding (see setParallelDecode()). Frames decoded ahead wait
+    // in m_decoded_frames with their chunk's granule position.
+    static constexpr size_t BATCH_FRAMES_PER_THREAD = 4;
+    unsigned m_parallel_threads = 1;
+    std::deque<std::pair<AudioFrame, uint64_t>> m_decoded_frames;
+    
     // Position tracking based on audio consumption, not packet timestamps
     uint64_t m_samples_consumed = 0;
     bool m_eof_reached = false;
@@ -159,21 +205,70 @@ private:
      */
     void fillChunkBuffer();
     
+    /**
+     * @brief Fill the chunk buffer from the pipelined demux stage; waits for
+     *        it only when nothing is buffered
+     */
+    void fillChunkBufferFromPipeline();
+    
+    /**
+     * @brief Whether the demuxer has no more chunks for the decoder
+     */
+    bool demuxerExhausted();
+    
+    /**
+     * @brief Run `action` on the demuxer with the demux stage parked, then
+     *        drop whatever it had read ahead and resume at `stream_id`
+     */
+    void repositionDemuxer(uint32_t stream_id, const std::function<void(Demuxer&)>& action);
+    
     /**
      * @brief Get next frame by decoding from buffered chunks on-demand
      */
     AudioFrame getNextFrame();
     
     /**
-     * @brief Copy data from audio frame to output buffer
-     * @param frame Source audio frame
-     * @param frame_offset Byte offset within the frame
-     * @param output_buf Destination buffer
-     * @param output_len Maximum bytes to copy
-     * @return Number of bytes actually copied
+     * @brief Decode one chunk, through decodeInto() and m_decode_buffer when
+     *        the codec supports it
+     */
+    AudioFrame decodeChunk(const MediaChunk& chunk);
+    
+    /**
+     * @brief Decode up to threads * BATCH_FRAMES_PER_THREAD buffered chunks
+     *        with AudioCodec::decodeBatch() into m_decoded_frames
+     * @return true if at least one frame was decoded
+     */
+    bool decodeBatch(unsigned threads);
+    
+    /**
+     * @brief Timestamp a decoded frame and advance the stream position
+     * @param frame Frame with samples, in decode order
+     * @param granule_position Granule position of the chunk it came from
+     */
+    void stampFrame(AudioFrame& frame, uint64_t granule_position);
+    
+    /**
+     * @brief Shared body of getData()/getDataFloat(): fill `out` from decoded
+     *        frames, converting between int16 and float frames as needed
+     * @param out Destination buffer
+     * @param count Maximum samples (all channels) to produce
+     * @return Number of samples written
+     */
+    template<typename T>
+    size_t readSamples_unlocked(T* out, size_t count);
+    
+    /**
+     * @brief Copy samples from audio frame to output buffer
+     * @param frame Source audio frame (int16 or float payload)
+     * @param frame_offset Sample offset within the frame
+     * @param output Destination buffer
+     * @param output_count Maximum samples to copy
+     * @return Number of samples actually copied
      */
-    size_t copyFrameData(const AudioFrame& frame, size_t frame_offset, 
-                         void* output_buf, size_t output_len);
+    static size_t copyFrameData(const AudioFrame& frame, size_t frame_offset,
+                                int16_t* output, size_t output_count);
+    static size_t copyFrameData(const AudioFrame& frame, size_t frame_offset,
+                                float* output, size_t output_count);
     
     /**
      * @brief Update Stream base class properties from current stream info
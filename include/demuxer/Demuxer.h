@@ -191,6 +191,8 @@ struct MediaChunk {
     bool packet_lost = false;         ///< Indicates if this chunk represents a lost packet (gap)
     bool end_of_stream = false;       ///< True when this chunk is the stream's terminal packet
     uint64_t file_offset = 0;         ///< Original file offset (used for seeking optimization)
+    uint32_t trim_leading_samples = 0;  ///< Decoded sample frames the codec drops from the front (encoder delay, seek pre-roll)
+    uint32_t trim_trailing_samples = 0; ///< Decoded sample frames the codec drops from the end (encoder padding)
     
     // Constructors
     MediaChunk() = default;
@@ -362,6 +364,8 @@ public:
     
     /**
      * @brief Get information about a specific stream
+     * 
+     * @thread_safety Safe to call concurrently after parseContainer() completes
      */
     virtual StreamInfo getStreamInfo(uint32_t stream_id) const = 0;
     
@@ -433,6 +437,8 @@ public:
     
     /**
      * @brief Get total duration of the container in milliseconds
+     * 
+     * @thread_safety Safe to call concurrently after parseContainer() completes
      */
     virtual uint64_t getDuration() const = 0;
     
@@ -448,6 +454,17 @@ public:
         return 0; // Default implementation for non-Ogg formats
     }
     
+    /**
+     * @brief Tell the demuxer which file it is reading
+     * 
+     * DemuxerFactory calls this before parseContainer() when it knows the
+     * path. Demuxers that keep per-file caches use it as their key; the
+     * default ignores it.
+     */
+    virtual void setSourcePath(const std::string& path) {
+        (void)path;
+    }
+    
     /**
      * @brief Get extracted metadata tags
      * 
@@ -30,6 +30,9 @@ public:
     // Stream interface implementation
     virtual void open(TagLib::String name) override;
     virtual size_t getData(size_t len, void *buf) override;
+    virtual size_t getDataFloat(size_t count, float *buf) override;
+    virtual size_t getDataInto(float *first, size_t first_count,
+                               float *second, size_t second_count) override;
     virtual unsigned int getLength() override;
     virtual unsigned long long getSLength() override;
     virtual unsigned int getChannels() override;
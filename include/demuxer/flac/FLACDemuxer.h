@@ -307,6 +307,15 @@ public:
     uint64_t getDuration() const override;
     uint64_t getPosition() const override;
     uint64_t getGranulePosition(uint32_t stream_id) const override;
+    
+    /**
+     * @brief Key the frame index cache on this path
+     * 
+     * When FLACSeekIndexCache has a directory, parseContainer() loads the
+     * index saved for the path and the destructor saves it back, extended
+     * with every frame read since.
+     */
+    void setSourcePath(const std::string& path) override;
 
 private:
     // ========================================================================
@@ -366,6 +375,8 @@ private:
     // m_state_mutex, not m_metadata_mutex.
     // ========================================================================
     std::vector<FLACFrameIndexEntry> m_frame_index;        ///< Cached frame positions
+    std::string m_source_path;                             ///< FLACSeekIndexCache key; empty when unknown
+    size_t m_saved_index_size = 0;                         ///< Entries already in the on-disk cache
     
     // ========================================================================
     // Private unlocked implementations (assume locks are held)
@@ -708,6 +719,14 @@ private:
      */
     void addFrameToIndex_unlocked(const FLACFrame& frame);
     
+    /**
+     * @brief Replace the frame index with the one saved for m_source_path
+     * 
+     * Entries outside the audio data, or a first or last entry that does not
+     * start with a frame sync code, discard the saved index.
+     */
+    void loadCachedFrameIndex_unlocked();
+    
     /**
      * @brief Parse frames forward from current position to target sample
      * 
@@ -889,12 +908,6 @@ private:
      * @return Current error state
      */
     bool getAtomicError() const;
-    
-    // ========================================================================
-    // CRC Lookup Tables (RFC 9639)
-    // ========================================================================
-    static const uint8_t s_crc8_table[256];   ///< CRC-8 polynomial 0x07
-    static const uint16_t s_crc16_table[256]; ///< CRC-16 polynomial 0x8005
 };
 
 } // namespace FLAC
@@ -0,0 +1,77 @@
+/*
+ * FLACSeekIndexCache.h - Persistent FLAC frame index cache
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef FLACSEEKINDEXCACHE_H
+#define FLACSEEKINDEXCACHE_H
+
+// No direct includes - all includes should be in psymp3.h
+
+namespace PsyMP3 {
+namespace Demuxer {
+namespace FLAC {
+
+/**
+ * @brief On-disk store for the frame index FLACDemuxer builds while reading
+ *
+ * A file without a SEEKTABLE is otherwise seeked by byte estimation and a
+ * resync scan on every open. With the index saved, a seek anywhere the file
+ * has been played before is one binary search and one read.
+ *
+ * Each source file gets its own cache file in the cache directory, named
+ * after a hash of its path. The cache file records the path, size and
+ * modification time of the source; a source that changed since is a miss.
+ *
+ * Layout (little-endian):
+ * - "PsyFLIdx" magic, uint32 version
+ * - uint64 source size, int64 source mtime (ns), uint32 path length, path
+ * - uint32 entry count, uint32 payload length, uint16 CRC-16 of the payload
+ * - payload: per entry, varint (offset delta << 1 | same), where "same"
+ *   means the frame follows the previous one and has its block size; when
+ *   clear, varint sample delta and varint block size follow
+ *
+ * A 4096-sample frame costs about three bytes. Files are written through a
+ * temporary file, so an interrupted save keeps the previous index.
+ *
+ * Caching is off until setDirectory() names a directory; the player points
+ * it under System::getStoragePath().
+ */
+class FLACSeekIndexCache {
+public:
+    /// Sets the cache directory (created on first save); empty disables caching
+    static void setDirectory(const std::string& directory);
+    static std::string getDirectory();
+
+    /**
+     * @brief Read the index saved for a source file
+     * @return The index, or empty if caching is off, nothing was saved, or
+     *         the source changed since
+     */
+    static std::vector<FLACFrameIndexEntry> load(const std::string& source_path);
+
+    /**
+     * @brief Save the index for a source file, replacing any previous one
+     * @param index Entries in increasing sample and file offset order
+     */
+    static bool save(const std::string& source_path,
+                     const std::vector<FLACFrameIndexEntry>& index);
+
+    /// Payload encoding, exposed for tests
+    static std::vector<uint8_t> encodeEntries(const std::vector<FLACFrameIndexEntry>& index);
+    static bool decodeEntries(const uint8_t* data, size_t size, uint32_t count,
+                              std::vector<FLACFrameIndexEntry>& index);
+
+private:
+    static std::string cacheFileFor(const std::string& source_path);
+};
+
+} // namespace FLAC
+} // namespace Demuxer
+} // namespace PsyMP3
+
+#endif // FLACSEEKINDEXCACHE_H
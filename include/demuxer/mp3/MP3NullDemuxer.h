@@ -14,6 +14,14 @@ namespace PsyMP3 {
 namespace Demuxer {
 namespace MP3 {
 
+/**
+ * @brief One frame in MP3NullDemuxer's frame index
+ */
+struct MP3FrameIndexEntry {
+    uint64_t file_offset = 0;    ///< Offset of the frame header
+    uint64_t sample_offset = 0;  ///< Decoded samples before this frame, encoder delay included
+};
+
 /**
  * @brief Null/passthrough demuxer for MP3 streams
  *
@@ -21,11 +29,25 @@ namespace MP3 {
  * all framing information. This demuxer handles ID3v2 tag skipping,
  * Xing/LAME VBR header parsing, and passes raw MP3 frame data as
  * MediaChunks for the codec to decode.
+ *
+ * Positions are exact to the sample once the frame index is built. When the
+ * demuxer knows its file's path (setSourcePath()), parseContainer() starts
+ * a background thread that scans the file through its own handle and records
+ * the offset and starting sample of every frame. seekTo() then starts
+ * decoding a few frames before the one holding the target, enough to refill
+ * the Layer III bit reservoir and the synthesis filter, and marks the chunks
+ * so the codec drops everything before the target sample. Until the scan
+ * gets there, seeks fall back to the Xing TOC or a linear estimate; a file
+ * with no TOC waits briefly for the scan instead.
+ *
+ * The LAME tag's encoder delay and padding, plus the decoder's own 529
+ * samples of delay, are trimmed the same way, so the stream starts and ends
+ * where the encoder's input did.
  */
 class MP3NullDemuxer : public Demuxer {
 public:
     explicit MP3NullDemuxer(std::unique_ptr<PsyMP3::IO::IOHandler> handler);
-    ~MP3NullDemuxer() override = default;
+    ~MP3NullDemuxer() override;
 
     bool parseContainer() override;
     std::vector<StreamInfo> getStreams() const override;
@@ -36,6 +58,11 @@ public:
     bool isEOF() const override;
     uint64_t getDuration() const override;
     uint64_t getPosition() const override;
+    uint64_t getGranulePosition(uint32_t stream_id) const override;
+    void setSourcePath(const std::string& path) override;
+
+    /// True once the background scan has indexed every frame
+    bool isFrameIndexComplete() const;
 
 private:
     // Unlocked internal methods (assume locks held)
@@ -49,6 +76,14 @@ private:
     bool parseXingHeader_unlocked(const std::vector<uint8_t>& frame_data, uint32_t sample_rate, uint16_t channels);
     bool findFrameSync_unlocked();
 
+    // Frame index
+    void startFrameIndex_unlocked();
+    void buildFrameIndex(std::string path, uint64_t start, uint64_t end);
+    void waitForFrameIndex(uint64_t decoded_target);  // m_mutex must not be held
+    bool seekWithFrameIndex_unlocked(uint64_t target_sample);
+    uint64_t getDuration_unlocked() const;
+    uint64_t toOutputSample(uint64_t decoded_sample) const;
+
     // MP3 frame header validation
     static bool isValidFrameHeader(const uint8_t header[4]);
     static uint32_t getFrameSampleRate(const uint8_t header[4]);
@@ -68,8 +103,27 @@ private:
     uint32_t m_total_bytes = 0;         // Total audio bytes (if known from Xing)
     bool m_is_vbr = false;              // VBR flag from Xing header
     std::vector<uint8_t> m_xing_toc;    // Xing TOC for VBR seeking (100 entries)
+    bool m_exact_length = false;        // m_total_frames came from the Xing header
+    uint8_t m_layer = 0;                // Layer field of the first frame
+
+    // Gapless playback and sample-exact seeks. m_current_sample counts decoded
+    // samples, so the encoder delay sits at its start.
+    uint32_t m_encoder_delay = 0;       // Decoded samples before the first real one
+    uint64_t m_gapless_end = 0;         // Decoded sample where padding starts; 0 if unknown
+    uint64_t m_trim_until = 0;          // Decoded samples before this are trimmed
+
+    std::string m_source_path;
 
     mutable std::mutex m_mutex;
+
+    // Background frame index (m_index_mutex; taken after m_mutex)
+    std::thread m_index_thread;
+    std::atomic<bool> m_index_stop{false};
+    std::atomic<bool> m_index_complete{false};
+    mutable std::mutex m_index_mutex;
+    std::condition_variable m_index_cv;
+    std::vector<MP3FrameIndexEntry> m_frame_index;
+    uint64_t m_indexed_samples = 0;     // Decoded samples up to the end of the last indexed frame
 };
 
 } // namespace MP3
@@ -0,0 +1,52 @@
+/*
+ * Crossfader.h - Gain curves and mixing kernel for track crossfades (DSP).
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill II <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef PSYMP3_DSP_CROSSFADER_H
+#define PSYMP3_DSP_CROSSFADER_H
+
+// No direct includes - all includes should be in psymp3.h
+
+namespace PsyMP3 {
+namespace DSP {
+
+// Mixes the head of the incoming track with the tail of the outgoing one
+// across a fade of `total` frames. Runs in the SDL audio callback, so it is
+// stateless, never allocates and never locks: the caller (Audio) keeps the
+// fade position.
+//
+// Curves, as functions of fade progress t in [0, 1]:
+//   - Linear: in = t, out = 1 - t. Constant amplitude sum; correlated
+//     material (the same mastering, a live album) passes through at a steady
+//     level, uncorrelated material dips about 3 dB mid-fade.
+//   - EqualPower: in = sin(t*pi/2), out = cos(t*pi/2). Constant power sum;
+//     the usual choice between unrelated tracks.
+// Gains are evaluated per frame (all channels of a frame share them) and the
+// multiply-add runs as SIMD over blocks of interleaved samples.
+class Crossfader {
+public:
+    enum class Curve { Linear, EqualPower };
+
+    // Gains at progress t (clamped to [0, 1]).
+    static void gains(Curve curve, double t, float& in_gain, float& out_gain);
+
+    // dst = incoming * in_gain + outgoing * out_gain, frame by frame, for
+    // frames [pos, pos + frame_count) of a fade `total` frames long. Frames at
+    // or past `total` take the incoming signal alone. `dst` may alias
+    // `incoming`.
+    static void mix(float* dst, const float* incoming, const float* outgoing,
+                    size_t frame_count, int channels, Curve curve,
+                    uint64_t pos, uint64_t total);
+
+    static const char* curveName(Curve curve);
+};
+
+} // namespace DSP
+} // namespace PsyMP3
+
+#endif // PSYMP3_DSP_CROSSFADER_H
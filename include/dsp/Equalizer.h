@@ -16,9 +16,16 @@ namespace PsyMP3 {
 namespace DSP {
 
 // A cascade of RBJ "peaking EQ" biquad filters, one per band, applied to
-// interleaved signed-16-bit PCM in place. Designed to run inside the SDL audio
+// interleaved float PCM (full scale +/-1.0) in place. Designed to run inside the SDL audio
 // callback: process() never allocates or locks.
 //
+// process() filters all channels of a frame together as SIMD lanes, running
+// the cascade frame by frame over the whole buffer with the playback volume
+// folded into its input. Bands at 0 dB are skipped.
+// Bands whose centre is high enough relative to the sample rate run in float;
+// low bands, whose poles sit close to z = 1 where float coefficient and state
+// rounding would be amplified into audible noise, keep double precision.
+//
 // Threading model (mirrors Audio::m_volume):
 //   - The UI thread pushes parameters via setBandGain()/setEnabled()/configure()
 //     (lock-free atomics). Each such call bumps a dirty counter.
@@ -45,15 +52,18 @@ public:
     void  setEnabled(bool on);
     bool  isEnabled() const;
 
-    // Audio thread: filter `frame_count` interleaved frames of `channels`
-    // samples in place. RT-safe. A no-op when disabled.
-    void process(int16_t* samples, size_t frame_count, int channels);
-
-    // Audio thread, and it MUST be called while holding the same lock the
-    // producers hold when they requestReset() (the PCM buffer mutex): moves a
-    // pending reset into the latched flag process() consumes. Sampling under
-    // the producers' lock ties each reset to the data queued after it — a reset
-    // armed after this buffer was drained cannot fire one buffer early.
+    // Audio thread: scale `frame_count` interleaved frames of `channels`
+    // samples by `gain` (the playback volume) and filter them, in place. The
+    // gain is folded into the first filter pass; when the EQ is disabled (or
+    // flat) only the gain is applied. RT-safe.
+    void process(float* samples, size_t frame_count, int channels, float gain = 1.0f);
+
+    // Audio thread, and it MUST be called only when the PCM queue reports that
+    // it applied a producer flush (the producers requestReset() before they
+    // flush): moves a pending reset into the latched flag process() consumes.
+    // Latching at the flush boundary ties each reset to the data queued after
+    // it — a reset armed after this buffer was drained cannot fire one buffer
+    // early.
     void latchReset();
 
     // Any thread: zero the filter history before the next process() (seek/track
@@ -64,9 +74,13 @@ public:
     static float       bandFrequency(int band);  // Hz
     static const char* bandLabel(int band);       // e.g. "60", "1k", "15k"
 
+    // True when `band` runs in float at `sample_rate` (see class comment).
+    static bool bandUsesFloat(int band, int sample_rate);
+
 private:
     struct Biquad { double b0 = 1, b1 = 0, b2 = 0, a1 = 0, a2 = 0; };
     void recompute();  // audio thread only
+    void clearHistory();
 
     static constexpr int kMaxChannels = 8;
 
@@ -79,11 +93,18 @@ private:
 
     // Audio-thread-only working state.
     Biquad   m_coeff[kNumBands];
+    bool     m_float_band[kNumBands] = {};
+    int      m_active[kNumBands] = {};    // non-identity bands, double ones first
+    int      m_num_active = 0;
     uint32_t m_last_dirty = 0;
     bool     m_reset_latched = false; // set by latchReset(), consumed by process()
     bool     m_was_enabled = false;   // prev enabled state, for rising-edge reset
-    double   m_z1[kMaxChannels][kNumBands] = {};
-    double   m_z2[kMaxChannels][kNumBands] = {};
+    // Filter history, band-major so one band's channels are contiguous lanes.
+    // A band uses the pair matching its precision.
+    alignas(32) double m_z1[kNumBands][kMaxChannels] = {};
+    alignas(32) double m_z2[kNumBands][kMaxChannels] = {};
+    alignas(32) float  m_fz1[kNumBands][kMaxChannels] = {};
+    alignas(32) float  m_fz2[kNumBands][kMaxChannels] = {};
 };
 
 } // namespace DSP
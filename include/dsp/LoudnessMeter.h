@@ -0,0 +1,94 @@
+/*
+ * LoudnessMeter.h - EBU R128 / ITU-R BS.1770 loudness and true-peak meter (DSP).
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill II <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef PSYMP3_DSP_LOUDNESSMETER_H
+#define PSYMP3_DSP_LOUDNESSMETER_H
+
+// No direct includes - all includes should be in psymp3.h
+
+namespace PsyMP3 {
+namespace DSP {
+
+// Offline programme loudness of one track, for ReplayGain-style playback
+// gain. Fed interleaved float PCM in arbitrary block sizes; the results cover
+// everything passed to process() since configure()/reset().
+//
+//   - Integrated loudness (LUFS): K-weighting (BS.1770 pre-filter shelf plus
+//     RLB high-pass, coefficients derived for the actual sample rate), 400 ms
+//     blocks at 75% overlap, channel weights 1.0 (front), 1.41 (surround), 0
+//     (LFE), then the -70 LUFS absolute and -10 LU relative gates.
+//   - True peak (linear): 4x polyphase oversampling, 12 taps per phase,
+//     BS.1770 Annex 2 style. Never below the sample peak.
+//
+// The filter state is double precision and runs all channels of a frame as
+// SIMD lanes (GCC vector extensions), like the Equalizer.
+class LoudnessMeter {
+public:
+    static constexpr int kMaxChannels = 8;
+    // Reported for a track with no block above the absolute gate (silence).
+    static constexpr double kSilenceLufs = -70.0;
+
+    LoudnessMeter();
+
+    // Resets all state. Channels beyond kMaxChannels are ignored.
+    void configure(unsigned int sample_rate, unsigned int channels);
+    void reset();
+
+    void process(const float* samples, size_t frames);
+
+    double integratedLufs() const;
+    double truePeak() const;
+    double samplePeak() const { return m_sample_peak; }
+    // Audio measured so far, in frames.
+    uint64_t frames() const { return m_frames; }
+
+    // BS.1770 weight of `channel` in a `channels`-channel WAVE/SMPTE layout.
+    static double channelWeight(int channel, int channels);
+
+private:
+    static constexpr int kLanes = 4;
+    static constexpr int kGroups = kMaxChannels / kLanes;
+    static constexpr int kPhases = 4;
+    static constexpr int kTapsPerPhase = 12;
+
+    unsigned int m_rate = 0;
+    int m_channels = 0;
+    int m_groups = 0;
+
+    // K-weighting: two biquads (shelf, high-pass), transposed direct form II.
+    double m_shelf[5] = {};
+    double m_highpass[5] = {};
+    double m_z[kGroups][4][kLanes] = {};
+    double m_weight[kMaxChannels] = {};
+
+    // 100 ms gating sub-blocks; four consecutive ones make a 400 ms block.
+    size_t m_sub_frames = 0;
+    size_t m_sub_fill = 0;
+    double m_sub_energy[kGroups][kLanes] = {};
+    double m_recent[4] = {};   // weighted energy of the last four sub-blocks
+    size_t m_recent_count = 0;
+    std::vector<double> m_block_power; // mean-square of each 400 ms block
+
+    // True-peak interpolator. Only tiles whose samples could interpolate
+    // above the peak found so far (tile max times the filter's worst-case
+    // gain) are interpolated; on typical programme that skips most of them.
+    static constexpr int kTileFrames = 64;
+    double m_fir[kPhases][kTapsPerPhase] = {};
+    double m_fir_gain = 1.0; // max over phases of sum(|tap|)
+    double m_tail[kGroups][kTapsPerPhase - 1][kLanes] = {}; // last frames of the previous tile
+    double m_true_peak = 0.0;
+    double m_sample_peak = 0.0;
+
+    uint64_t m_frames = 0;
+};
+
+} // namespace DSP
+} // namespace PsyMP3
+
+#endif // PSYMP3_DSP_LOUDNESSMETER_H
@@ -0,0 +1,104 @@
+/*
+ * Resampler.h - Polyphase windowed-sinc sample-rate converter (DSP).
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill II <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef PSYMP3_DSP_RESAMPLER_H
+#define PSYMP3_DSP_RESAMPLER_H
+
+// No direct includes - all includes should be in psymp3.h
+
+namespace PsyMP3 {
+namespace DSP {
+
+// Converts interleaved PCM (float, or signed 16-bit) from one sample rate to
+// another so an open audio device can keep playing tracks recorded at a
+// different rate (the gapless 44.1k -> 48k album transition). Sits between
+// Stream::getDataFloat() and Audio's PCM queue, on the decoder thread.
+//
+// The ratio is reduced to L/M (out/in) and realised as an L-phase polyphase
+// bank of kTaps-tap Kaiser-windowed sinc filters, each phase normalized to
+// unity DC gain. Ratios needing more than kMaxPhases phases (odd rates such as
+// 11025 -> 48000) snap each output to the nearest lower of kMaxPhases evenly
+// spaced phases, which keeps the timing error under 1/kMaxPhases of an input
+// sample. The cutoff follows the lower of the two Nyquist rates, so
+// downsampling is band-limited instead of aliasing.
+//
+// The inner product is a fixed kTaps-long float dot product, vectorized with
+// AVX2+FMA (selected at runtime on x86), SSE2 or NEON, with a scalar fallback.
+//
+// Not thread-safe: Audio only touches it under its buffer mutex. configure()
+// allocates; process() only grows its buffers up to the largest block seen.
+class Resampler {
+public:
+    static constexpr int      kTaps      = 64;
+    static constexpr unsigned kMaxPhases = 1024;
+
+    Resampler() = default;
+
+    // Rebuild the filter bank for in_rate -> out_rate and clear all history.
+    // Equal rates (or any zero argument) make the resampler inactive.
+    void configure(unsigned int in_rate, unsigned int out_rate, unsigned int channels);
+
+    bool isActive() const { return m_active; }
+    unsigned int inputRate() const { return m_in_rate; }
+    unsigned int outputRate() const { return m_out_rate; }
+
+    // Drop buffered input and restart the phase (seek / track change).
+    void reset();
+
+    // Resample `frames` interleaved frames, replacing the contents of `out`
+    // with every output frame the input so far makes computable. Output lags
+    // input by kTaps/2 input frames; drain() releases that tail at end of
+    // stream. Float output is not clamped; int16 output saturates. Use one
+    // sample type per configure().
+    void process(const float* in, size_t frames, std::vector<float>& out);
+    void process(const int16_t* in, size_t frames, std::vector<int16_t>& out);
+
+    // End of stream: flush the delayed tail into `out` (replacing its
+    // contents) and reset.
+    void drain(std::vector<float>& out);
+    void drain(std::vector<int16_t>& out);
+
+    // Name of the dot-product kernel in use ("avx2", "sse2", "neon", "scalar").
+    const char* kernelName() const;
+
+private:
+    using DotFn = float (*)(const float* x, const float* h);
+
+    void buildFilterBank();
+    template<typename T> void processImpl(const T* in, size_t frames, std::vector<T>& out);
+    template<typename T> void drainImpl(std::vector<T>& out);
+    template<typename T> void run(std::vector<T>& out);
+
+    bool         m_active = false;
+    unsigned int m_in_rate = 0;
+    unsigned int m_out_rate = 0;
+    unsigned int m_channels = 0;
+
+    // Rational step: each output frame advances the input position by M/L
+    // input frames, kept as an integer part plus a fraction in units of 1/L.
+    uint32_t m_L = 1;
+    uint32_t m_M = 1;
+    uint32_t m_step_int = 1;
+    uint32_t m_step_frac = 0;
+    uint32_t m_phases = 1;
+
+    DotFn              m_dot = nullptr;
+    std::vector<float> m_bank; // m_phases x kTaps, phase-major
+
+    // Planar float history per channel. Index 0 is the oldest frame still
+    // needed; m_pos/m_frac is the next output's position in it.
+    std::vector<std::vector<float>> m_hist;
+    size_t   m_pos = 0;
+    uint32_t m_frac = 0;
+};
+
+} // namespace DSP
+} // namespace PsyMP3
+
+#endif // PSYMP3_DSP_RESAMPLER_H
@@ -109,7 +109,7 @@ class Player
             Stream* stream;
             TagLib::String error_message;
             size_t num_chained_tracks; // How many tracks are in this stream (for playlist advancement)
-            std::vector<int16_t> primed_samples;
+            std::vector<float> primed_samples;
             bool primed_eof = false;
         };
 
@@ -229,9 +229,25 @@ class Player
         bool getPersistPlaylist() const { return m_persist_playlist; }
         void togglePersistPlaylist();
 
-        // "Show Debug" (Settings menu): gates the scale/decay/FFT-mode/FPS
+        // "Show Debug" (Settings menu): gates the scale/decay/FFT-mode/FPS/audio
         // overlay labels in the top-right corner. Persisted in psymp3.conf.
         void toggleShowDebug();
+        // Settings > "Dump Audio Telemetry": write the audio callback/underrun
+        // report to audio-telemetry.txt in the storage directory.
+        void dumpAudioTelemetry();
+        // Settings > "Crossfade": fade length (0 = off, gapless hard cut) and
+        // curve for transitions into a preloaded track. Persisted in psymp3.conf.
+        void setCrossfade(unsigned int ms, PsyMP3::DSP::Crossfader::Curve curve);
+        // Settings > "Seek History": how much played audio is kept decoded so
+        // a seek back into it is served from memory (0 = off). Persisted in
+        // psymp3.conf.
+        void setSeekHistory(unsigned int ms);
+        // Settings > "ReplayGain": play each track at the measured loudness
+        // from the loudness cache. Persisted in psymp3.conf.
+        void toggleReplayGain();
+        // Settings > "Scan Playlist Loudness": measure every playlist entry
+        // not yet in the loudness cache, in the background.
+        void scanPlaylistLoudness();
 
         // Keyboard focus traversal (Tab/Shift+Tab) across the active window's
         // controls, and Enter's fallback to that window's default button.
@@ -348,7 +364,7 @@ class Player
         
         Stream* stream = nullptr;
         std::unique_ptr<Stream> m_next_stream; // Slot for the pre-loaded next track
-        std::vector<int16_t> m_next_stream_primed_samples;
+        std::vector<float> m_next_stream_primed_samples;
         bool m_next_stream_primed_eof = false;
         size_t m_num_tracks_in_next_stream = 0; // How many playlist entries the next stream represents
         size_t m_num_tracks_in_current_stream = 0; // How many playlist entries the current stream represents
@@ -488,11 +504,18 @@ class Player
         // Unlimited FPS mode, where the fade strength is derived from measured
         // elapsed time instead of the fixed frame period. 0 = not yet primed.
         Uint32 m_unlimited_fade_last_ms = 0;
+        // True while the main window is minimized, hidden or fully occluded;
+        // spectrum analysis is skipped until it is restored/exposed again.
+        bool m_window_obscured = false;
         // Shared by setTargetFps() and loadSettings(): sets m_target_fps and
         // derives the app-loop timer state (period or unlimited watchdog).
         void applyTargetFps(int fps);
         void toggleEqualizerWindow();
         void applyEqStateToAudio();
+        void applyCrossfadeToAudio();
+        void applySeekHistoryToAudio();
+        // Playhead position (what is audible now), not the decoder's.
+        unsigned long playbackPositionMs() const;
 
         // "About PsyMP3" dialog: a single instance owned by m_random_windows.
         // Shown from the Help > About menu item and the F1 key; non-owning
@@ -514,6 +537,25 @@ class Player
         bool m_pending_shuffle = false;
         LoopMode m_pending_loop_mode = LoopMode::None;
         bool m_session_playlist_saved = false; // avoid double-saving at teardown
+        unsigned int m_crossfade_ms = 0;
+        PsyMP3::DSP::Crossfader::Curve m_crossfade_curve = PsyMP3::DSP::Crossfader::Curve::EqualPower;
+        // Set when updateState() posts an early TRACK_SEAMLESS_SWAP to start a
+        // crossfade; the swap handler consumes it.
+        bool m_crossfade_requested = false;
+        unsigned int m_seek_history_ms = Audio::kDefaultSeekHistoryMs;
+        // ReplayGain: measurements by file (loudness-cache.txt in the storage
+        // dir, read by the loader thread), and the scanner filling it, created
+        // on the first scan. m_loudness_scan_reported is cleared by a scan and
+        // set once updateState() has announced its completion.
+        bool m_replaygain_enabled = false;
+        std::unique_ptr<PsyMP3::Core::LoudnessCache> m_loudness_cache;
+        std::unique_ptr<PsyMP3::Core::LoudnessScanner> m_loudness_scanner;
+        bool m_loudness_scan_reported = true;
+        bool lookupCachedGain(const TagLib::String& path, float& gain) const;
+        void applyCachedLoudness(Stream* stream, const TagLib::String& path) const;
+        void applyCachedLoudness(ChainedStream* stream, const std::vector<TagLib::String>& paths) const;
+        void pollLoudnessScan();
+        void stopLoudnessScanner();
         int m_random_window_counter = 0;
 
         // Deferred widget deletion
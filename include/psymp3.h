@@ -108,6 +108,7 @@ inline std::ostream& operator<<(std::ostream& os, LoopMode mode) {
 #include <map>
 #include <memory>
 #include <mutex>
+#include <numeric>
 #include <shared_mutex>
 #include <queue>
 #include <random>
@@ -117,6 +118,7 @@ inline std::ostream& operator<<(std::ostream& os, LoopMode mode) {
 #include <sstream>
 #include <stack>
 #include <thread>
+#include <type_traits>
 #include <typeinfo>
 #include <unordered_map>
 #include <unordered_set>
@@ -327,6 +329,14 @@ using SDLKey = SDL_Keycode;
 #ifdef __SSE2__
 #include <emmintrin.h>
 #define HAVE_SSE2
+#if defined(__GNUC__)
+// AVX2 kernels are compiled per function with __attribute__((target)) and
+// picked at runtime, so the baseline -march stays SSE2.
+#include <immintrin.h>
+#define HAVE_AVX2_TARGET
+// Likewise PCLMULQDQ, for CRC folding.
+#define HAVE_PCLMUL_TARGET
+#endif
 #endif
 
 #ifdef __ARM_NEON
@@ -341,6 +351,9 @@ using SDLKey = SDL_Keycode;
 #include "debug.h"
 #include "core/exceptions.h"
 #include "core/utility/G711.h"
+#include "core/utility/CRC.h"
+#include "core/utility/SampleConvert.h"
+#include "core/utility/PCMConvert.h"
 #include "core/rect.h"
 using PsyMP3::Core::BadFormatException;
 using PsyMP3::Core::InvalidMediaException;
@@ -513,6 +526,8 @@ using PsyMP3::IO::StreamingManager;
 #include "codecs/AudioCodec.h"
 #include "codecs/CodecRegistry.h"
 #include "codecs/CodecRegistration.h"
+#include "codecs/CodecPool.h"
+using PsyMP3::Codec::CodecPool;
 #include "codecs/pcm/PCMCodecs.h"
 using PsyMP3::Codec::PCM::PCMCodec;
 #ifdef ENABLE_MULAW_CODEC
@@ -527,6 +542,7 @@ using PsyMP3::Codec::PCM::ALawCodec;
 #include "codecs/pcm/G722Codec.h"
 using PsyMP3::Codec::PCM::G722Codec;
 #endif
+#include "demuxer/ChunkPipeline.h"
 #include "demuxer/DemuxedStream.h"
 
 // Demuxer subsystem - Raw Audio
@@ -591,6 +607,7 @@ using PsyMP3::Codec::Opus::OpusComments;
 #include "codecs/flac/FLACRFC9639.h"
 #include "codecs/flac/FLACRFCValidator.h"
 #include "demuxer/flac/FLACDemuxer.h"
+#include "demuxer/flac/FLACSeekIndexCache.h"
 using PsyMP3::Demuxer::FLAC::FLACDemuxer;
 using PsyMP3::Demuxer::FLAC::FLACStreamInfo;
 #include "codecs/flac/FLACError.h"
@@ -598,6 +615,7 @@ using PsyMP3::Demuxer::FLAC::FLACStreamInfo;
 #include "codecs/flac/CRCValidator.h"
 #include "codecs/flac/FrameParser.h"
 #include "codecs/flac/ResidualDecoder.h"
+#include "codecs/flac/PredictorKernels.h"
 #include "codecs/flac/SubframeDecoder.h"
 #include "codecs/flac/ChannelDecorrelator.h"
 #include "codecs/flac/SampleReconstructor.h"
@@ -627,7 +645,17 @@ using PsyMP3::Core::FFTMode;
 #include "core/fft_draw.h"
 using PsyMP3::Core::FastFourier;
 #include "dsp/Equalizer.h"
+#include "dsp/Resampler.h"
+#include "dsp/Crossfader.h"
+#include "dsp/LoudnessMeter.h"
 using PsyMP3::DSP::Equalizer;
+using PsyMP3::DSP::Crossfader;
+#include "core/SPSCRingBuffer.h"
+#include "core/ReadAheadPolicy.h"
+#include "core/AudioTelemetry.h"
+#include "core/LoudnessCache.h"
+#include "core/LoudnessScanner.h"
+#include "core/PcmHistory.h"
 #include "audio.h"
 #include "core/about.h"
 using PsyMP3::Core::about_console;
@@ -81,9 +81,27 @@ class Stream
         virtual unsigned long long getSPosition(); // in samples!
         virtual unsigned int getBitrate(); // bitrate in bits per second!
         virtual size_t getData(size_t len, void *buf) = 0;
+        // Float32 read, full scale = [-1.0, 1.0). Counts are samples (all
+        // channels), not bytes. Streams that can deliver more than 16 bits of
+        // resolution override this; the default converts getData() output.
+        virtual size_t getDataFloat(size_t count, float *buf);
+        // Float read into two caller-owned pieces, such as the free space of
+        // a ring buffer that wraps: `first` is filled completely before
+        // anything goes to `second`, so the result is contiguous in the
+        // caller's order. Counts are samples. The default reads each piece
+        // with getDataFloat(); streams that can copy decoded frames out
+        // directly override it.
+        virtual size_t getDataInto(float *first, size_t first_count,
+                                   float *second, size_t second_count);
         virtual void seekTo(unsigned long pos) = 0;
         virtual bool canSeek() const;
         virtual bool eof() = 0;
+        // ReplayGain-style linear gain measured for this track (1.0 when
+        // unknown). Set by whoever opens the stream; Audio applies it to the
+        // decoded PCM while ReplayGain is enabled. A ChainedStream changes it
+        // at track boundaries while it decodes, so any thread may read it.
+        void setPlaybackGain(float gain) { m_playback_gain.store(gain, std::memory_order_relaxed); }
+        float getPlaybackGain() const { return m_playback_gain.load(std::memory_order_relaxed); }
     protected:
         void *          m_handle; // any handle type
         void *          m_buffer; // decoded audio buffer
@@ -98,6 +116,7 @@ class Stream
         long long       m_sposition; // in samples; needs to be at least 64bit.
         int             m_encoding;  // value ??? - for later use
         bool            m_eof;
+        std::atomic<float> m_playback_gain{1.0f};
         
         // Lyrics support
         std::shared_ptr<LyricsFile> m_lyrics;
@@ -243,6 +243,14 @@ class System
          * there and from the UTF-8 bytes elsewhere (the POSIX native encoding).
          */
         static std::filesystem::path pathFromUtf8(const std::string& utf8);
+        /**
+         * @brief Size and last write time (ns since the filesystem clock's
+         *        epoch) of a file named by a UTF-8 path.
+         *
+         * Caches use the pair to tell whether a file changed since they
+         * recorded it. Returns false, leaving the outputs alone, on any error.
+         */
+        static bool fileStamp(const std::string& utf8_path, uint64_t& size, int64_t& mtime);
         enum class ThreadPriority {
             Low,
             Normal,
@@ -270,6 +278,10 @@ class System
         // Implemented on Windows, Linux, FreeBSD/DragonFly and NetBSD; a no-op
         // on other platforms.
         static void pinThreadToRole(CpuRole role);
+        // CPU time consumed by the calling thread, in nanoseconds (0 where the
+        // platform has no per-thread clock). Lets the decoder tell its own
+        // decode work apart from time spent blocked on I/O.
+        static uint64_t getThreadCpuTimeNs();
         #if defined(_WIN32) // This block is for static methods
         static HWND getHwnd();
         void updateProgress(ULONGLONG now, ULONGLONG max);
@@ -49,6 +49,29 @@ bool ensureSDLAudioSubsystem()
     return init_ok || ((SDL_WasInit(SDL_INIT_AUDIO) & SDL_INIT_AUDIO) != 0);
 }
 
+PsyMP3::Core::ReadAheadPolicy::Bounds readAheadBounds(Stream* stream)
+{
+    return PsyMP3::Core::ReadAheadPolicy::boundsForSource(stream->getFilePath().to8Bit(true));
+}
+
+uint64_t steadyNowNs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint64_t steadyNowUs()
+{
+    return steadyNowNs() / 1000;
+}
+
+void scaleSamples(float* samples, size_t count, float gain)
+{
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] *= gain;
+    }
+}
+
 } // namespace
 
 /**
@@ -61,8 +84,9 @@ bool ensureSDLAudioSubsystem()
 Audio::Audio(std::unique_ptr<Stream> stream_to_own,
              FastFourier *fft,
              std::mutex *player_mutex,
-             std::vector<int16_t> primed_samples,
-             bool primed_eof)
+             std::vector<float> primed_samples,
+             bool primed_eof,
+             bool replaygain)
     : m_active(true),
       m_owned_stream(std::move(stream_to_own)),
       m_current_stream_raw_ptr(m_owned_stream.get()),
@@ -75,8 +99,38 @@ Audio::Audio(std::unique_ptr<Stream> stream_to_own,
         throw std::invalid_argument("Audio constructor called with a null stream.");
     }
     Debug::log("audio", "Audio::Audio(): ", std::dec, m_owned_stream->getRate(), "Hz, channels: ", std::dec, m_owned_stream->getChannels());
-    m_buffer.reserve(16384); // Reserve space for the buffer to avoid reallocations
-    m_buffer = std::move(primed_samples);
+    // Size the PCM queue for the read-ahead policy's maximum plus a primed
+    // track handoff stacked on top of flushed data the callback has not
+    // skipped yet, so the overflow spill is only needed in unusual cases
+    // (several swaps while the device is paused). The first stream's source
+    // picks the maximum (local files keep it short); later streams are capped
+    // to it, so same-format swaps keep this sizing valid.
+    m_read_ahead.configure(m_owned_stream->getRate(), m_owned_stream->getChannels(),
+                           readAheadBounds(m_owned_stream.get()));
+    m_read_ahead.setCeiling(m_read_ahead.bounds().max_ms);
+    const size_t prime = std::max(defaultPrimeSamples(m_owned_stream->getRate(),
+                                                      m_owned_stream->getChannels()),
+                                  primed_samples.size());
+    m_feeds[0].ring.allocate(m_read_ahead.maxSamples() + m_read_ahead.chunkSamples() + 2 * prime);
+    m_feeds[0].overflow.reserve(prime + m_read_ahead.chunkSamples());
+    // Spectrum tap: a quarter second of device audio, and never less than two
+    // FFT windows, covers a GUI frame even at low redraw rates.
+    const size_t tap_channels = m_owned_stream->getChannels();
+    const size_t fft_frames = m_fft ? static_cast<size_t>(m_fft->getFFTSize()) : 0;
+    m_tap.allocate(std::max<size_t>(static_cast<size_t>(m_owned_stream->getRate()) * tap_channels / 4,
+                                    2 * fft_frames * tap_channels));
+    m_tap_scratch.resize(m_tap.capacity());
+    // No other thread exists yet, so the producer-side lock is not needed.
+    // The feed's resampler is still a bypass; only the gain applies.
+    m_replaygain = replaygain;
+    updateFeedGain_unlocked(m_feeds[0], m_owned_stream.get());
+    // The queue format is the first stream's; setup() validates it and opens
+    // the device with it, but the history must be sized before the primed
+    // samples are queued, and in the same terms setSeekHistory() uses.
+    m_rate = static_cast<int>(m_owned_stream->getRate());
+    m_channels = static_cast<int>(m_owned_stream->getChannels());
+    configureHistory_unlocked(static_cast<unsigned int>(m_rate), static_cast<unsigned int>(m_channels));
+    queueDecoded_unlocked(m_feeds[0], primed_samples.data(), primed_samples.size());
     m_stream_eof = primed_eof;
     setup();
     m_decoder_thread = std::thread(&Audio::decoderThreadLoop, this);
@@ -151,9 +205,9 @@ void Audio::setup() {
 
     // Use m_current_stream_raw_ptr to get rate and channels
     desired.freq = m_rate = m_current_stream_raw_ptr.load()->getRate();
-    desired.format = SDL_AUDIO_S16; /* native-endian signed 16-bit */
+    desired.format = SDL_AUDIO_F32; /* native-endian 32-bit float */
     desired.channels = m_channels = m_current_stream_raw_ptr.load()->getChannels();
-    Debug::log("audio", "Audio::setup: Requested format - rate: ", desired.freq, "Hz, channels: ", desired.channels, ", format: SDL_AUDIO_S16");
+    Debug::log("audio", "Audio::setup: Requested format - rate: ", desired.freq, "Hz, channels: ", desired.channels, ", format: SDL_AUDIO_F32");
 
     // A stream reporting zero rate or channels is malformed; opening the device
     // would let the audio callback divide by zero (SIGFPE). Throw so the caller
@@ -167,8 +221,10 @@ void Audio::setup() {
 
     // SDL3: open the default playback device with our source format and attach
     // the pull callback. SDL converts from this format (m_rate, m_channels,
-    // S16) to the device's native format internally, so we always feed PCM in
+    // F32) to the device's native format internally, so we always feed PCM in
     // our own format and there is no separate "obtained" spec to reconcile.
+    // Float end to end means >16-bit sources keep their resolution and the
+    // volume/EQ stages no longer requantize to 16 bits on the way out.
     m_stream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK,
                                          &desired, callback, this);
     if (!m_stream) {
@@ -224,7 +280,7 @@ void Audio::play(bool go) {
  * @param new_stream A pointer to the new Stream object.
  */
 std::unique_ptr<Stream> Audio::setStream(std::unique_ptr<Stream> new_stream,
-                                         std::vector<int16_t> primed_samples,
+                                         std::vector<float> primed_samples,
                                          bool primed_eof)
 {
     if (new_stream && primed_samples.empty() && !primed_eof) {
@@ -240,6 +296,153 @@ std::unique_ptr<Stream> Audio::setStream(std::unique_ptr<Stream> new_stream,
     return setStream_unlocked(std::move(new_stream), std::move(primed_samples), primed_eof);
 }
 
+/**
+ * @brief Crossfades from the current stream into a new one.
+ *
+ * The current stream's queued PCM stays where it is and becomes the fade's
+ * tail; the decoder thread keeps decoding the rest of that stream into it. The
+ * new stream takes over the other feed and becomes current immediately, and
+ * the callback mixes the two over the configured length. Same format rules as
+ * setStream(): channel count must match, the rate may differ.
+ *
+ * @param new_stream The stream to fade into.
+ * @return nullptr (ownership transferred)
+ */
+std::unique_ptr<Stream> Audio::crossfadeTo(std::unique_ptr<Stream> new_stream,
+                                           std::vector<float> primed_samples,
+                                           bool primed_eof)
+{
+    if (new_stream && primed_samples.empty() && !primed_eof) {
+        auto primed = primeStream(new_stream.get(), 0);
+        primed_samples = std::move(primed.first);
+        primed_eof = primed.second;
+    }
+
+    // Lock acquisition order: m_stream_mutex before m_buffer_mutex
+    std::lock_guard<std::mutex> stream_lock(m_stream_mutex);
+    std::lock_guard<std::mutex> buffer_lock(m_buffer_mutex);
+
+    const unsigned int fade_ms = m_crossfade_ms.load();
+    // A track short enough to be primed whole would be over before the fade.
+    if (!new_stream || fade_ms == 0 || primed_eof || m_rate == 0 || !m_owned_stream ||
+        static_cast<int>(new_stream->getChannels()) != m_channels || isFinished_unlocked()) {
+        return setStream_unlocked(std::move(new_stream), std::move(primed_samples), primed_eof);
+    }
+
+    // Fading again before the last fade finished: drop the older tail.
+    cancelCrossfade_unlocked();
+
+    Feed& outgoing = currentFeed_unlocked();
+    Feed& incoming = tailFeed_unlocked();
+    if (incoming.ring.capacity() == 0) {
+        // Never read by the callback yet, so sizing it here is safe.
+        incoming.ring.allocate(outgoing.ring.capacity());
+        incoming.overflow.reserve(outgoing.overflow.capacity());
+        m_cb_tail_scratch.resize(outgoing.ring.capacity());
+    }
+    // The outgoing stream keeps decoding on the decoder thread; if it already
+    // hit EOF its whole remainder is queued and there is nothing to add.
+    m_tail_stream = m_stream_eof ? nullptr : m_owned_stream;
+    m_tail_eof = m_stream_eof;
+    m_primary ^= 1;
+
+    incoming.ring.flush();
+    incoming.overflow.clear();
+    incoming.overflow_pending = false;
+    incoming.resampler.configure(new_stream->getRate(), static_cast<unsigned int>(m_rate),
+                                 static_cast<unsigned int>(m_channels));
+    updateFeedGain_unlocked(incoming, new_stream.get());
+    m_read_ahead.configure(static_cast<unsigned int>(m_rate), static_cast<unsigned int>(m_channels),
+                           readAheadBounds(new_stream.get()));
+    m_history.reset(0);
+    queueDecoded_unlocked(incoming, primed_samples.data(), primed_samples.size());
+
+    m_owned_stream = std::shared_ptr<Stream>(std::move(new_stream));
+    m_current_stream_raw_ptr.store(m_owned_stream.get());
+    m_stream_eof = false;
+
+    // No EQ reset: the output is continuous across a fade. m_samples_played
+    // is reset by the callback when it first mixes this generation; a reset
+    // here would also count whatever it still plays from the old feed.
+    m_fade_frames.store(std::max<uint64_t>(1, static_cast<uint64_t>(fade_ms) * m_rate / 1000));
+    m_fade_curve.store(m_crossfade_curve.load());
+    const uint32_t gen = (m_fade_gen.load() + 1) & kMixGenMask;
+    m_fade_gen.store(gen);
+    m_mix_state.store(static_cast<uint32_t>(m_primary) | kMixFading | (gen << kMixGenShift),
+                      std::memory_order_release);
+    Debug::log("audio", "Audio::crossfadeTo: ", fade_ms, "ms ",
+               PsyMP3::DSP::Crossfader::curveName(m_fade_curve.load()), " crossfade");
+
+    m_stream_cv.notify_one();
+    m_buffer_cv.notify_all();
+    return nullptr;
+}
+
+/**
+ * @brief Sets the length and curve used by later crossfadeTo() calls.
+ * @param ms Fade length in milliseconds; 0 turns crossfading off.
+ * @param curve Gain curve for the fade.
+ */
+void Audio::setCrossfade(unsigned int ms, PsyMP3::DSP::Crossfader::Curve curve)
+{
+    m_crossfade_curve.store(curve);
+    m_crossfade_ms.store(ms);
+}
+
+/**
+ * @brief Turns per-stream ReplayGain on or off.
+ *
+ * Both feeds pick up their stream's gain (or unity) for PCM decoded from now
+ * on, so a toggle during a crossfade affects both sides of it.
+ * @param enabled true to apply Stream::getPlaybackGain().
+ */
+void Audio::setReplayGain(bool enabled)
+{
+    std::lock_guard<std::mutex> buffer_lock(m_buffer_mutex);
+    m_replaygain = enabled;
+    updateFeedGain_unlocked(currentFeed_unlocked(), m_owned_stream.get());
+    if (m_tail_stream) {
+        updateFeedGain_unlocked(tailFeed_unlocked(), m_tail_stream.get());
+    }
+}
+
+/**
+ * @brief Sets how much played audio seekInHistory() can return to.
+ *
+ * The window also spans the longest possible queue ahead of the playhead, so
+ * `ms` of already-played audio stay available however full the queue is.
+ * Resizing keeps the newest audio that still fits.
+ * @param ms Milliseconds of history; 0 disables history seeks.
+ */
+void Audio::setSeekHistory(unsigned int ms)
+{
+    std::lock_guard<std::mutex> buffer_lock(m_buffer_mutex);
+    m_history_ms = ms;
+    configureHistory_unlocked(static_cast<unsigned int>(m_rate), static_cast<unsigned int>(m_channels));
+}
+
+/**
+ * @brief Seeks within the current stream's already-decoded PCM.
+ *
+ * Replaces the queue with the recorded audio from `frame` onwards, which runs
+ * up to exactly where the decoder's next read will continue, so neither the
+ * stream nor its codec is involved. Sets the samples-played counter to
+ * `frame`.
+ * @param frame Target position in frames at getRate().
+ * @return true if the seek was served; false if the caller must seek the stream.
+ */
+bool Audio::seekInHistory(uint64_t frame)
+{
+    // Lock acquisition order: m_stream_mutex before m_buffer_mutex.
+    std::lock_guard<std::mutex> stream_lock(m_stream_mutex);
+    std::lock_guard<std::mutex> buffer_lock(m_buffer_mutex);
+    const bool hit = seekInHistory_unlocked(frame);
+    m_telemetry.recordSeek(hit);
+    Debug::log("audio", "Audio::seekInHistory: frame ", frame, hit ? " replayed from history" : " not in history",
+               " [", m_history.beginFrame(), ", ", m_history.endFrame(), "]");
+    return hit;
+}
+
 /**
  * @brief Checks if the audio playback for the current stream is completely finished.
  *
@@ -296,7 +499,10 @@ uint64_t Audio::getSamplesPlayed() const {
  * @param samples The new sample frame count.
  */
 void Audio::setSamplesPlayed(uint64_t samples) {
+    std::lock_guard<std::mutex> buffer_lock(m_buffer_mutex);
     m_samples_played.store(samples);
+    // After a seek: what gets queued next plays from here.
+    m_history.reset(samples);
 }
 
 /**
@@ -328,11 +534,13 @@ void Audio::decoderThreadLoop() {
     System::setThisThreadName("audio-decoder");
     System::setThreadPriority(System::ThreadPriority::High);
     System::pinThreadToRole(System::CpuRole::Decoder);
-    std::vector<int16_t> decode_chunk(4096); // Decode in 8KB chunks
-    // The high water mark prevents the decoder from reading too far ahead,
-    // which is important for responsive seeking and track changes. It defines
-    // the maximum amount of decoded audio to keep in the buffer.
-    constexpr size_t BUFFER_HIGH_WATER_MARK = 16384; // 1 sec of 48kHz stereo
+    // Sized from the queue format (m_read_ahead.chunkSamples()); a resampled
+    // stream just decodes a little more or less audio per call.
+    std::vector<float> decode_chunk;
+    // The callback drains the ring without m_buffer_mutex, so its notify can
+    // land between our predicate check and the block below. Bound every wait
+    // on the callback so such a lost wakeup costs a few ms instead of a stall.
+    constexpr auto kDrainPollInterval = std::chrono::milliseconds(5);
 
     while (m_active)
     {
@@ -344,33 +552,71 @@ void Audio::decoderThreadLoop() {
             // the loop re-enters, getData() returns 0 immediately, and the thread
             // busy-spins at 100% CPU until Player installs a new stream.
             // setStream_unlocked() clears m_stream_eof and notifies this cv.
-            m_stream_cv.wait(lock, [this] {
-                return (m_owned_stream != nullptr && !m_stream_eof) || !m_active;
+            // Spilled overflow must still reach the ring after EOF, though,
+            // and a crossfade's outgoing tail still needs decoding.
+            auto producer_work = [this] {
+                return m_feeds[0].overflow_pending || m_feeds[1].overflow_pending ||
+                       (m_mix_state.load() & kMixFading) != 0;
+            };
+            m_stream_cv.wait(lock, [&] {
+                return (m_owned_stream != nullptr && !m_stream_eof) ||
+                       producer_work() || !m_active;
             });
             if (!m_active) break;
+            if (m_owned_stream == nullptr || m_stream_eof) {
+                lock.unlock();
+                if (decodeTailChunk(decode_chunk)) {
+                    continue;
+                }
+                std::unique_lock<std::mutex> buffer_lock(m_buffer_mutex);
+                drainOverflow_unlocked(m_feeds[0]);
+                drainOverflow_unlocked(m_feeds[1]);
+                retireCrossfade_unlocked();
+                if (producer_work()) {
+                    m_buffer_cv.wait_for(buffer_lock, kDrainPollInterval);
+                }
+                continue;
+            }
             local_stream = m_owned_stream;
         }
 
         // Inner loop: Decode from the current stream until it ends.
         // Use the local_stream pointer to avoid race conditions.
         while (local_stream && m_active) {
+            bool current_wants_data = true;
             {
                 std::unique_lock<std::mutex> lock(m_buffer_mutex);
-                m_buffer_cv.wait(lock, [this] {
-                    // Backpressure: only decode when the buffer is below the high
-                    // water mark (or on shutdown). Do NOT also wake on !m_playing:
-                    // while paused nothing drains the buffer, so a !m_playing term
-                    // lets the decoder run past the mark and grow it without bound.
-                    // resetBuffer() (seek) and the SDL callback (drain) both notify
-                    // this cv, so the decoder still wakes promptly when space frees.
-                    return m_buffer.size() < BUFFER_HIGH_WATER_MARK || !m_active;
-                });
+                // Backpressure: only decode when the queue is below the
+                // read-ahead policy's high-water mark (or on shutdown). Do NOT
+                // also wake on !m_playing: while paused nothing drains the
+                // queue, so a !m_playing term lets the decoder run past the
+                // mark and grow it without bound.
+                // resetBuffer() (seek) and the SDL callback (drain) both notify
+                // this cv, so the decoder still wakes promptly when space frees.
+                // During a crossfade the outgoing stream's feed is kept at the
+                // same mark.
+                for (;;) {
+                    drainOverflow_unlocked(currentFeed_unlocked());
+                    drainOverflow_unlocked(tailFeed_unlocked());
+                    retireCrossfade_unlocked();
+                    m_read_ahead.recordDrain(m_samples_played.load(), steadyNowNs());
+                    current_wants_data = queuedSamples_unlocked() < m_read_ahead.targetSamples();
+                    if (current_wants_data || tailNeedsData_unlocked() || !m_active) break;
+                    m_buffer_cv.wait_for(lock, kDrainPollInterval);
+                }
+                decode_chunk.resize(m_read_ahead.chunkSamples());
             }
 
             if (!m_active) break;
 
-            size_t bytes_read = 0;
+            // Outgoing and incoming streams take turns, a chunk each.
+            decodeTailChunk(decode_chunk);
+            if (!current_wants_data) continue;
+
+            size_t samples_read = 0;
             bool eof = false;
+            uint64_t decode_wall_ns = 0;
+            uint64_t decode_cpu_ns = 0;
             std::shared_ptr<Stream> validated_stream;
             
             // CRITICAL SECTION: Minimize player mutex hold time
@@ -397,27 +643,52 @@ void Audio::decoderThreadLoop() {
             // END CRITICAL SECTION - player mutex released
             
             // Snapshot the decode epoch before the unlocked read so a seek that
-            // runs during getData() (which bumps the epoch under the commit
+            // runs during getDataFloat() (which bumps the epoch under the commit
             // locks) is detected below and this stale result discarded.
             uint64_t decode_epoch = m_decode_epoch.load();
 
+            // Decode straight into the current feed's free ring space when
+            // the PCM needs nothing on the way in but the gain (applied in
+            // place at commit). The feed stays reserved until the commit
+            // below, so other producers spill to its overflow meanwhile.
+            // Resampled streams, a pending spill or a ring without a whole
+            // chunk free go through decode_chunk instead.
+            Feed* direct_feed = nullptr;
+            PcmRegion region;
+            if (validated_stream) {
+                std::lock_guard<std::mutex> buffer_lock(m_buffer_mutex);
+                Feed& feed = currentFeed_unlocked();
+                if (!feed.resampler.isActive() && feed.overflow.empty()) {
+                    region = feed.ring.writeRegion(decode_chunk.size());
+                    if (region.size() == decode_chunk.size()) {
+                        feed.reserved = true;
+                        feed.requeued = false;
+                        direct_feed = &feed;
+                    }
+                }
+            }
+
             // Perform decoding WITHOUT holding player mutex (prevents GUI deadlock)
             if (validated_stream) {
-                bytes_read = validated_stream->getData(decode_chunk.size() * sizeof(int16_t), decode_chunk.data());
+                const uint64_t wall_start = steadyNowNs();
+                const uint64_t cpu_start = System::getThreadCpuTimeNs();
+                samples_read = direct_feed
+                    ? validated_stream->getDataInto(region.first, region.first_count,
+                                                    region.second, region.second_count)
+                    : validated_stream->getDataFloat(decode_chunk.size(), decode_chunk.data());
                 eof = validated_stream->eof();
+                decode_cpu_ns = System::getThreadCpuTimeNs() - cpu_start;
+                decode_wall_ns = steadyNowNs() - wall_start;
+                m_telemetry.recordDecode(decode_wall_ns / 1000);
                 
-                size_t buffer_size = 0;
-                {
-                    std::lock_guard<std::mutex> buf_lock(m_buffer_mutex);
-                    buffer_size = m_buffer.size();
-                }
-                
-                Debug::log("audio", "Audio decoder thread: getData returned ", bytes_read, " bytes, eof=", eof, 
+                const size_t buffer_size = m_feeds[m_mix_state.load() & kMixPrimaryMask].ring.size();
+
+                Debug::log("audio", "Audio decoder thread: getDataFloat returned ", samples_read, " samples, eof=", eof, 
                                    ", buffer_size=", buffer_size, " samples");
                 
-                // Check if we got 0 bytes - this could indicate various issues
-                if (bytes_read == 0) {
-                    Debug::log("audio", "Audio decoder thread: Got 0 bytes from stream, eof=", eof, 
+                // Check if we got 0 samples - this could indicate various issues
+                if (samples_read == 0) {
+                    Debug::log("audio", "Audio decoder thread: Got 0 samples from stream, eof=", eof, 
                                        ", buffer_size=", buffer_size, " samples");
                     if (eof) {
                         Debug::log("audio", "Audio decoder thread: EOF detected, final buffer size=", buffer_size, " samples");
@@ -427,10 +698,47 @@ void Audio::decoderThreadLoop() {
 
             std::lock_guard<std::mutex> stream_lock(m_stream_mutex);
             std::lock_guard<std::mutex> buffer_lock(m_buffer_mutex);
+            // A direct decode that has to be queued somewhere other than where
+            // it was decoded is copied out of the ring first.
+            auto chunk_from_region = [&](size_t count) {
+                if (direct_feed) {
+                    const size_t first = std::min(count, region.first_count);
+                    std::copy(region.first, region.first + first, decode_chunk.begin());
+                    std::copy(region.second, region.second + (count - first), decode_chunk.begin() + first);
+                }
+            };
+            if (direct_feed) {
+                direct_feed->reserved = false;
+                if (direct_feed->requeued) {
+                    // A history seek replayed audio into this feed meanwhile.
+                    chunk_from_region(samples_read);
+                    direct_feed = nullptr;
+                }
+            }
 
             if (local_stream.get() != m_owned_stream.get() ||
                 local_stream.get() != m_current_stream_raw_ptr.load()) {
-                Debug::log("audio", "Audio decoder thread: Discarding stale decode result after stream swap");
+                // A crossfade began while this chunk was decoding: it is the
+                // next piece of the outgoing tail, which decodeTailChunk()
+                // continues from, so it must not be lost.
+                if (local_stream == m_tail_stream && m_decode_epoch.load() == decode_epoch) {
+                    Feed& tail = tailFeed_unlocked();
+                    const size_t whole = samples_read - samples_read % static_cast<size_t>(m_channels);
+                    updateFeedGain_unlocked(tail, local_stream.get());
+                    if (direct_feed == &tail) {
+                        // Decoded into this very feed, which became the tail.
+                        commitDirect_unlocked(tail, region, whole);
+                    } else {
+                        chunk_from_region(whole);
+                        queueDecoded_unlocked(tail, decode_chunk.data(), whole);
+                    }
+                    if (eof) {
+                        drainResampler_unlocked(tail);
+                        m_tail_eof = true;
+                    }
+                } else {
+                    Debug::log("audio", "Audio decoder thread: Discarding stale decode result after stream swap");
+                }
                 break;
             }
 
@@ -445,9 +753,26 @@ void Audio::decoderThreadLoop() {
                 continue;
             }
 
-            if (bytes_read > 0) {
-                size_t samples_read = bytes_read / sizeof(int16_t);
-                // Keep the queue frame-aligned: a decoder returning a byte
+            // Feed the read-ahead policy. The stream's own rate gives the
+            // audio duration, whether or not it is resampled afterwards.
+            const unsigned int stream_rate = local_stream->getRate();
+            const unsigned int stream_channels = local_stream->getChannels();
+            if (stream_rate > 0 && stream_channels > 0) {
+                const unsigned int old_target = m_read_ahead.targetMs();
+                const uint64_t audio_ns = static_cast<uint64_t>(samples_read / stream_channels) *
+                                          1000000000ull / stream_rate;
+                m_read_ahead.recordChunk(audio_ns, decode_cpu_ns, decode_wall_ns);
+                const unsigned int new_target = m_read_ahead.targetMs();
+                if (new_target * 4 > old_target * 5 || new_target * 5 < old_target * 4) {
+                    Debug::log("audio", "Audio decoder thread: read-ahead target ", old_target, "ms -> ",
+                               new_target, "ms (decode cost ", m_read_ahead.decodeCost(),
+                               ", peak stall ", m_read_ahead.peakStallMs(), "ms, drain ratio ",
+                               m_read_ahead.drainRatio(), ")");
+                }
+            }
+
+            if (samples_read > 0) {
+                // Keep the queue frame-aligned: a decoder returning a sample
                 // count that is not a multiple of the frame size would
                 // channel-rotate every subsequent buffer, corrupting the EQ's
                 // per-channel state and the FFT's L/R pairing. Trim (and
@@ -458,16 +783,24 @@ void Audio::decoderThreadLoop() {
                     Debug::log("audio", "Audio decoder thread: stream returned a partial frame; trimmed ",
                                trimmed, " sample(s) to keep the queue frame-aligned");
                 }
-                m_buffer.insert(m_buffer.end(), decode_chunk.begin(), decode_chunk.begin() + samples_read);
+                updateFeedGain_unlocked(currentFeed_unlocked(), local_stream.get());
+                if (direct_feed) {
+                    // Same stream, same epoch: the feed reserved at decode
+                    // time is still the current one.
+                    commitDirect_unlocked(*direct_feed, region, samples_read);
+                } else {
+                    queueDecoded_unlocked(currentFeed_unlocked(), decode_chunk.data(), samples_read);
+                }
 
-                Debug::log("audio", "Audio decoder thread: Added ", samples_read, " samples to buffer, new buffer size=", m_buffer.size());
+                Debug::log("audio", "Audio decoder thread: Added ", samples_read, " samples to buffer, new buffer size=", queuedSamples_unlocked());
             } else {
-                Debug::log("audio", "Audio decoder thread: Got 0 bytes from stream, eof=", eof);
+                Debug::log("audio", "Audio decoder thread: Got 0 samples from stream, eof=", eof);
             }
             m_buffer_cv.notify_one();
 
             if (eof) {
-                Debug::log("audio", "Audio decoder thread: EOF detected, final buffer size=", m_buffer.size(), " samples");
+                Debug::log("audio", "Audio decoder thread: EOF detected, final buffer size=", queuedSamples_unlocked(), " samples");
+                drainResampler_unlocked(currentFeed_unlocked());
                 m_stream_eof = true;
                 break; // Exit the inner decoding loop.
             }
@@ -481,12 +814,13 @@ void Audio::decoderThreadLoop() {
  * This function is the heart of the audio playback. It runs on a high-priority
  * thread managed by SDL. Its primary job is to copy decoded audio data from the
  * internal buffer into the buffer provided by SDL. If not enough data is available,
- * it fills the remainder with silence. It also passes the audio data to the FFT
- * for processing before it's sent to the sound card.
+ * it fills the remainder with silence. It also publishes the audio data to the
+ * lock-free spectrum tap (analysed later by analyzeSpectrum() on the GUI thread)
+ * before it's sent to the sound card.
  * 
- * Note: This callback function directly manages buffer access with proper locking
- * and does not call public lock-acquiring methods to avoid deadlocks and ensure
- * real-time performance. Never call public Audio methods from within this callback.
+ * Note: This callback is the sole consumer of the lock-free PCM ring and never
+ * takes m_buffer_mutex, so a preempted decoder cannot stall it. Never call
+ * public Audio methods from within this callback.
  * 
  * @param userdata A pointer to the `Audio` instance.
  * @param buf A pointer to the hardware audio buffer to be filled.
@@ -506,108 +840,156 @@ void SDLCALL Audio::callback(void *userdata, SDL_AudioStream *stream,
 
     // SDL3 pull model: we are asked for `additional_amount` more bytes and hand
     // no output buffer. Assemble PCM into a reused thread-local scratch buffer
-    // (the same fill/FFT/volume/EQ pipeline as before) and push it to `stream`.
+    // (the same fill/tap/volume/EQ pipeline as before) and push it to `stream`.
     if (additional_amount <= 0) {
         return;
     }
-    const int len = additional_amount;
-    thread_local std::vector<uint8_t> scratch;
-    if (static_cast<int>(scratch.size()) < len) {
-        scratch.resize(static_cast<size_t>(len));
+    // The device stream is F32, so work in samples; round a stray partial
+    // sample up (SDL keeps any excess for the next request).
+    const size_t len = (static_cast<size_t>(additional_amount) + sizeof(float) - 1) / sizeof(float);
+    thread_local std::vector<float> scratch;
+    if (scratch.size() < len) {
+        scratch.resize(len);
     }
-    Uint8 *buf = scratch.data();
+    float *buf = scratch.data();
 
     Audio *self = static_cast<Audio *>(userdata);
-    size_t bytes_copied = 0;
+    const uint64_t start_us = steadyNowUs();
+    size_t samples_copied = 0;
+    size_t queued_at_entry = 0;
+    bool short_fill = false;
 
     {
-        std::lock_guard<std::mutex> lock(self->m_buffer_mutex);
         // Non-blocking: take whatever data is available immediately
         // Never block in the audio callback - causes stuttering
+        const bool draining = self->m_active && self->m_playing && self->m_channels > 0;
+        const size_t frame_samples = draining ? static_cast<size_t>(self->m_channels) : 1;
+        const size_t want = draining ? len / frame_samples * frame_samples : 0;
+
+        // read() applies a pending seek/track-swap flush even when we take no
+        // data. Latch the EQ history reset exactly at that boundary: the
+        // resetters arm it before flushing, so it lands on the first buffer of
+        // post-flush audio — never early on stale data, never a buffer late.
+        const uint32_t mix = self->m_mix_state.load(std::memory_order_acquire);
+        Feed& feed = self->m_feeds[mix & kMixPrimaryMask];
+        bool flushed = false;
+        queued_at_entry = feed.ring.size();
+        samples_copied = feed.ring.read(buf, want, &flushed);
+        short_fill = samples_copied < want;
+        if (flushed) {
+            self->m_eq.latchReset();
+        }
+        // Position follows the current (incoming) stream only, counted from
+        // zero by the first buffer of a new fade.
+        const size_t frames_played = samples_copied / frame_samples;
+        const uint32_t gen = mix >> kMixGenShift;
+        if (gen != self->m_cb_fade_gen) {
+            self->m_cb_fade_gen = gen;
+            self->m_cb_fade_pos = 0;
+            self->m_samples_played.store(0);
+        }
 
-        // Latch any pending EQ history reset while holding the same mutex the
-        // resetters (seek/track-swap) hold: a reset armed after this drain then
-        // applies to the NEXT buffer, not retroactively to this one.
-        self->m_eq.latchReset();
-
-        if (!self->m_buffer.empty() && self->m_active && self->m_playing) {
-            size_t bytes_to_copy = len;
-            size_t bytes_available = self->m_buffer.size() * sizeof(int16_t);
-            bytes_copied = std::min(bytes_to_copy, bytes_available);
-
-            if (bytes_copied > 0) {
-                memcpy(buf, self->m_buffer.data(), bytes_copied);
-                size_t samples_copied = bytes_copied / sizeof(int16_t);
-                self->m_buffer.erase(self->m_buffer.begin(), self->m_buffer.begin() + samples_copied);
-                self->m_samples_played += samples_copied / self->m_channels;
-                
-                // Only log occasionally to avoid spam
-                thread_local int callback_counter = 0;
-                if ((++callback_counter % 100 == 0)) {
-                    uint64_t current_time_ms = (self->m_samples_played * 1000) / self->m_rate;
-                    Debug::log("audio", "Audio callback: pos=", current_time_ms, "ms, copied=", bytes_copied, " bytes, buffer size now=", self->m_buffer.size(), " samples");
+        // Crossfade: mix in the outgoing stream's tail from the other feed.
+        // A missing stretch on either side is silence, so an underrun or a
+        // tail that ends early just fades against nothing.
+        if ((mix & kMixFading) && want > 0) {
+            const uint64_t total = self->m_fade_frames.load(std::memory_order_relaxed);
+            if (self->m_fade_done_gen.load(std::memory_order_relaxed) != gen) {
+                // Mixed in pieces of at most the scratch size, in case SDL asks
+                // for more than the ring holds.
+                std::vector<float>& tail_scratch = self->m_cb_tail_scratch;
+                const size_t piece_max = tail_scratch.size() / frame_samples * frame_samples;
+                Feed& tail = self->m_feeds[(mix & kMixPrimaryMask) ^ 1];
+                std::fill(buf + samples_copied, buf + want, 0.0f);
+                size_t tail_copied = 0;
+                for (size_t done = 0; done < want && piece_max > 0; ) {
+                    const size_t piece = std::min(want - done, piece_max);
+                    const size_t got = tail.ring.read(tail_scratch.data(), piece);
+                    std::fill(tail_scratch.begin() + got, tail_scratch.begin() + piece, 0.0f);
+                    const size_t frames = piece / frame_samples;
+                    PsyMP3::DSP::Crossfader::mix(buf + done, buf + done, tail_scratch.data(), frames,
+                                                 self->m_channels,
+                                                 self->m_fade_curve.load(std::memory_order_relaxed),
+                                                 self->m_cb_fade_pos, total);
+                    self->m_cb_fade_pos += frames;
+                    tail_copied += got;
+                    done += piece;
                 }
-            }
-        } else {
-            // Log buffer underruns and inactive states
-            if (self->m_active && self->m_playing) {
-                thread_local int underrun_counter = 0;
-                if (++underrun_counter % 50 == 0) {  // Log every 50th underrun to avoid spam
-                    Debug::log("audio", "Audio callback: Buffer underrun, buffer_size=", self->m_buffer.size(), " samples, active=", self->m_active, ", playing=", self->m_playing);
+                samples_copied = want;
+                short_fill = short_fill && tail_copied < want;
+                if (self->m_cb_fade_pos >= total) {
+                    self->m_fade_done_gen.store(gen, std::memory_order_release);
                 }
             }
         }
-        // If no data available, bytes_copied remains 0, and we'll fill with silence below
+
+        if (frames_played > 0) {
+            self->m_samples_played += frames_played;
+
+            // Only log occasionally to avoid spam
+            thread_local int callback_counter = 0;
+            if ((++callback_counter % 100 == 0)) {
+                uint64_t current_time_ms = (self->m_samples_played * 1000) / self->m_rate;
+                Debug::log("audio", "Audio callback: pos=", current_time_ms, "ms, copied=", samples_copied, " samples, buffer size now=", feed.ring.size(), " samples");
+            }
+        } else if (draining) {
+            // Log buffer underruns (counted in full by m_telemetry)
+            thread_local int underrun_counter = 0;
+            if (++underrun_counter % 50 == 0) {  // Log every 50th underrun to avoid spam
+                Debug::log("audio", "Audio callback: Buffer underrun, buffer_size=", feed.ring.size(), " samples, active=", self->m_active, ", playing=", self->m_playing);
+            }
+        }
+        // If no data available, samples_copied remains 0, and we'll fill with silence below
     }
     self->m_buffer_cv.notify_one(); // Notify decoder thread that there is space
 
     // Fill remaining buffer with silence if we couldn't provide enough data
-    if (bytes_copied < static_cast<size_t>(len)) {
-        SDL_memset(buf + bytes_copied, 0, len - bytes_copied);
-    }
-
-    // Perform FFT on the data we are sending to the sound card. Run it even
-    // when bytes_copied == 0 (buffer underrun): `buf` has been silence-filled
-    // above, so the FFT sees real silence and the spectrum decays instead of
-    // freezing on the last frame. (The callback only runs while the device is
-    // unpaused, i.e. during active playback.)
-    if (self->m_channels > 0) { // Always compute FFT, regardless of GUI state
-        std::lock_guard<std::mutex> lock(self->m_fft_mutex);
-        // Convert only the frames SDL actually handed us (the whole `len`-byte
-        // buffer, data + silence), never the full FFT window — SDL may negotiate
-        // a device buffer smaller than the 512-frame window we requested, and
-        // reading the window blindly would run off the end of `buf`.
-        const size_t in_frames = static_cast<size_t>(len) /
-                                 (static_cast<size_t>(self->m_channels) * sizeof(int16_t));
-        toFloat(self->m_channels, reinterpret_cast<const int16_t*>(buf),
-                self->m_fft->getTimeDom(), in_frames,
-                static_cast<size_t>(self->m_fft->getFFTSize()));
-        self->m_fft->doFFT();
-    }
-
-    // Apply volume scaling
-    float volume = self->m_volume.load();
-    if (bytes_copied > 0 && volume < 1.0f) {
-        int16_t* samples = reinterpret_cast<int16_t*>(buf);
-        size_t count = bytes_copied / sizeof(int16_t);
-        for (size_t i = 0; i < count; ++i) {
-            samples[i] = static_cast<int16_t>(samples[i] * volume);
+    if (samples_copied < len) {
+        std::fill(buf + samples_copied, buf + len, 0.0f);
+    }
+
+    // Publish what we are sending to the sound card to the spectrum tap. The
+    // transform itself runs on the GUI thread (analyzeSpectrum()), keeping its
+    // cost off this deadline. Publish even when samples_copied == 0 (buffer
+    // underrun): `buf` has been silence-filled above, so the spectrum decays
+    // instead of freezing on the last frame. Whole buffers only, so the tap
+    // stays frame-aligned; if the analysis side has not kept up (or is not
+    // running because nobody can see the spectrum), drop its backlog rather
+    // than let stale audio queue up behind it.
+    if (self->m_channels > 0) {
+        const size_t tap_samples = len / static_cast<size_t>(self->m_channels) *
+                                   static_cast<size_t>(self->m_channels);
+        if (self->m_tap.writeAvailable() >= tap_samples) {
+            self->m_tap.write(buf, tap_samples);
+        } else {
+            self->m_tap.flush();
         }
     }
 
-    // Apply the equalizer LAST, after volume scaling: at volumes below 100% the
-    // attenuation leaves headroom, so positive EQ band gains are far less likely
-    // to clip already-loud (e.g. heavily compressed) material. RT-safe: the
-    // Equalizer neither locks nor allocates in process(). Note the FFT tap above
-    // therefore sees the raw pre-EQ signal (the spectrum stays volume- and
-    // EQ-independent, as it was before the equalizer existed).
-    if (bytes_copied > 0 && self->m_channels > 0) {
-        size_t eq_frames = (bytes_copied / sizeof(int16_t)) / static_cast<size_t>(self->m_channels);
-        self->m_eq.process(reinterpret_cast<int16_t*>(buf), eq_frames, self->m_channels);
+    // Volume and equalizer, fused into one pass over the buffer: the EQ folds
+    // the volume into its first filter pass (or just scales when it is off or
+    // flat). Volume is applied at the filter input, so at volumes below 100%
+    // the attenuation leaves headroom and positive EQ band gains are far less
+    // likely to clip already-loud (e.g. heavily compressed) material. RT-safe:
+    // the Equalizer neither locks nor allocates in process(). Note the spectrum
+    // tap above therefore sees the raw pre-EQ signal (the spectrum stays
+    // volume- and EQ-independent, as it was before the equalizer existed).
+    const uint64_t dsp_start_us = steadyNowUs();
+    if (samples_copied > 0 && self->m_channels > 0) {
+        size_t eq_frames = samples_copied / static_cast<size_t>(self->m_channels);
+        self->m_eq.process(buf, eq_frames, self->m_channels, self->m_volume.load());
     }
+    const uint64_t dsp_end_us = steadyNowUs();
 
     // SDL3: hand the assembled PCM (data + any silence fill) to the stream.
-    SDL_PutAudioStreamData(stream, buf, len);
+    // SDL does the float -> device format conversion, clipping included.
+    SDL_PutAudioStreamData(stream, buf, static_cast<int>(len * sizeof(float)));
+
+    const uint64_t frame_rate = static_cast<uint64_t>(self->m_rate) *
+                                static_cast<uint64_t>(std::max(1, self->m_channels));
+    const uint64_t fill_ms = frame_rate ? queued_at_entry * 1000 / frame_rate : 0;
+    self->m_telemetry.recordCallback(start_us, steadyNowUs() - start_us, fill_ms,
+                                     dsp_end_us - dsp_start_us, short_fill);
 }
 
 /**
@@ -638,7 +1020,7 @@ float Audio::getVolume() const {
  * @return true if the stream is decoded and the buffer is empty, false otherwise.
  */
 bool Audio::isFinished_unlocked() const {
-    return m_stream_eof && m_buffer.empty();
+    return m_stream_eof && queuedSamples_unlocked() == 0;
 }
 
 /**
@@ -648,26 +1030,48 @@ bool Audio::isFinished_unlocked() const {
  * @return nullptr (ownership transferred)
  */
 std::unique_ptr<Stream> Audio::setStream_unlocked(std::unique_ptr<Stream> new_stream,
-                                                  std::vector<int16_t> primed_samples,
+                                                  std::vector<float> primed_samples,
                                                   bool primed_eof) {
     // Invariant guard: the device (and the EQ coefficients) were configured
-    // for m_rate/m_channels; callers must only swap in a matching stream (the
-    // Player's canReuseAudioForStream() enforces this). A mismatch here means
-    // wrong-speed playback and a wrong-rate EQ — make it loud instead of silent.
-    if (new_stream && (static_cast<int>(new_stream->getRate()) != m_rate ||
-                       static_cast<int>(new_stream->getChannels()) != m_channels)) {
+    // for m_channels; callers must only swap in a stream with the same channel
+    // count (the Player's canReuseAudioForStream() enforces this). A mismatch
+    // here means channel-rotated garbage — make it loud instead of silent. A
+    // different sample rate is fine: the resampler converts it to m_rate.
+    if (new_stream && static_cast<int>(new_stream->getChannels()) != m_channels) {
         Debug::log("audio", "Audio::setStream_unlocked: STREAM FORMAT MISMATCH - device is ",
-                   m_rate, "Hz/", m_channels, "ch but new stream is ",
-                   new_stream->getRate(), "Hz/", new_stream->getChannels(),
+                   m_channels, "ch but new stream is ", new_stream->getChannels(),
                    "ch; playback and EQ will be incorrect (caller bug)");
     }
 
-    m_buffer = std::move(primed_samples);
+    // A hard swap cuts any crossfade still in progress.
+    cancelCrossfade_unlocked();
+
+    // new track: clear filter history so it doesn't bleed. Armed before the
+    // flush so the callback latches it exactly at the flush boundary.
+    m_eq.requestReset();
+    Feed& feed = currentFeed_unlocked();
+    feed.ring.flush();
+    feed.overflow.clear();
+    feed.overflow_pending = false;
+    const unsigned int stream_rate = new_stream ? new_stream->getRate()
+                                                : static_cast<unsigned int>(m_rate);
+    feed.resampler.configure(stream_rate, static_cast<unsigned int>(m_rate),
+                             static_cast<unsigned int>(m_channels));
+    updateFeedGain_unlocked(feed, new_stream.get());
+    if (new_stream) {
+        m_read_ahead.configure(static_cast<unsigned int>(m_rate), static_cast<unsigned int>(m_channels),
+                               readAheadBounds(new_stream.get()));
+    }
+    m_history.reset(0);
+    queueDecoded_unlocked(feed, primed_samples.data(), primed_samples.size());
+    if (primed_eof) {
+        // The whole track was primed; the decoder will not revisit it.
+        drainResampler_unlocked(feed);
+    }
     m_owned_stream = std::shared_ptr<Stream>(std::move(new_stream));
     m_current_stream_raw_ptr.store(m_owned_stream.get());
     m_samples_played = 0;
     m_stream_eof = primed_eof;
-    m_eq.requestReset(); // new track: clear filter history so it doesn't bleed
 
     // Notify the decoder thread that a new stream is available.
     m_stream_cv.notify_one();
@@ -678,9 +1082,251 @@ std::unique_ptr<Stream> Audio::setStream_unlocked(std::unique_ptr<Stream> new_st
  * @brief Private unlocked version of resetBuffer() - assumes m_buffer_mutex is already held.
  */
 void Audio::resetBuffer_unlocked() {
-    m_buffer.clear();
-    m_samples_played = 0;
+    // A seek lands in the current stream; the outgoing tail is history.
+    cancelCrossfade_unlocked();
     m_eq.requestReset(); // seek: clear filter history to avoid a transient
+    Feed& feed = currentFeed_unlocked();
+    feed.resampler.reset();
+    feed.ring.flush();
+    feed.overflow.clear();
+    feed.overflow_pending = false;
+    m_samples_played = 0;
+    m_history.reset(0);
+}
+
+/**
+ * @brief Appends decoded PCM to a feed's queue - assumes m_buffer_mutex is already held.
+ *
+ * Anything the ring cannot take yet (flushed data the callback has not skipped
+ * still occupies it, or a direct decode holds its free space) is spilled to
+ * the feed's overflow, behind any earlier spill, and moved into the ring by
+ * the decoder thread as space frees.
+ */
+void Audio::queueSamples_unlocked(Feed& feed, const float* samples, size_t count) {
+    drainOverflow_unlocked(feed);
+    size_t written = 0;
+    if (feed.overflow.empty() && !feed.reserved) {
+        written = feed.ring.write(samples, count);
+    }
+    if (written < count) {
+        feed.overflow.insert(feed.overflow.end(), samples + written, samples + count);
+        feed.overflow_pending = true;
+    }
+}
+
+/**
+ * @brief Sets the feed's gain from its stream - assumes m_buffer_mutex is already held.
+ *
+ * Unity while ReplayGain is off or there is no stream.
+ */
+void Audio::updateFeedGain_unlocked(Feed& feed, const Stream* stream) {
+    feed.gain = (m_replaygain && stream) ? stream->getPlaybackGain() : 1.0f;
+}
+
+/**
+ * @brief Queues PCM at the feed's stream rate - assumes m_buffer_mutex is already held.
+ *
+ * The feed's ReplayGain is applied first, in place. A stream at another rate
+ * than m_rate is then converted on the way in; otherwise the samples go
+ * straight to queueSamples_unlocked().
+ */
+void Audio::queueDecoded_unlocked(Feed& feed, float* samples, size_t count) {
+    if (feed.gain != 1.0f) {
+        scaleSamples(samples, count, feed.gain);
+    }
+    if (!feed.resampler.isActive()) {
+        queueSamples_unlocked(feed, samples, count);
+        recordHistory_unlocked(feed, samples, count);
+        return;
+    }
+    feed.resampler.process(samples, count / static_cast<size_t>(m_channels), feed.resample_out);
+    queueSamples_unlocked(feed, feed.resample_out.data(), feed.resample_out.size());
+    recordHistory_unlocked(feed, feed.resample_out.data(), feed.resample_out.size());
+}
+
+/**
+ * @brief Flushes the resampler's delayed tail at end of stream - assumes m_buffer_mutex is already held.
+ */
+void Audio::drainResampler_unlocked(Feed& feed) {
+    if (!feed.resampler.isActive()) {
+        return;
+    }
+    feed.resampler.drain(feed.resample_out);
+    queueSamples_unlocked(feed, feed.resample_out.data(), feed.resample_out.size());
+    recordHistory_unlocked(feed, feed.resample_out.data(), feed.resample_out.size());
+}
+
+/**
+ * @brief Moves spilled samples into the ring - assumes m_buffer_mutex is already held.
+ */
+void Audio::drainOverflow_unlocked(Feed& feed) {
+    // Behind a direct decode's reserved region, the spill has to wait.
+    if (feed.overflow.empty() || feed.reserved) {
+        return;
+    }
+    const size_t written = feed.ring.write(feed.overflow.data(), feed.overflow.size());
+    feed.overflow.erase(feed.overflow.begin(), feed.overflow.begin() + written);
+    feed.overflow_pending = !feed.overflow.empty();
+}
+
+/**
+ * @brief Publishes a direct decode's samples - assumes m_buffer_mutex is already held.
+ *
+ * The samples were decoded into `region` (from the feed's writeRegion()) while
+ * the feed was reserved; the gain is applied in place, as
+ * queueDecoded_unlocked() would, before the callback can see them.
+ */
+void Audio::commitDirect_unlocked(Feed& feed, const PcmRegion& region, size_t count) {
+    const size_t first = std::min(count, region.first_count);
+    if (feed.gain != 1.0f) {
+        scaleSamples(region.first, first, feed.gain);
+        scaleSamples(region.second, count - first, feed.gain);
+    }
+    feed.ring.commitWrite(count);
+    recordHistory_unlocked(feed, region.first, first);
+    recordHistory_unlocked(feed, region.second, count - first);
+}
+
+/**
+ * @brief Adds queued PCM to the seek history - assumes m_buffer_mutex is already held.
+ *
+ * Only the current stream's feed is recorded; a crossfade's outgoing tail is
+ * not seekable.
+ */
+void Audio::recordHistory_unlocked(const Feed& feed, const float* samples, size_t count) {
+    if (&feed == &currentFeed_unlocked()) {
+        m_history.append(samples, count);
+    }
+}
+
+/**
+ * @brief Sizes the seek history for the queue format - assumes m_buffer_mutex is already held.
+ */
+void Audio::configureHistory_unlocked(unsigned int rate, unsigned int channels) {
+    const size_t ahead_frames = channels ? currentFeed_unlocked().ring.capacity() / channels : 0;
+    const size_t frames = m_history_ms == 0 ? 0
+        : static_cast<size_t>(static_cast<uint64_t>(m_history_ms) * rate / 1000) + ahead_frames;
+    m_history.configure(channels, frames);
+}
+
+/**
+ * @brief Body of seekInHistory() - assumes both mutexes are already held.
+ */
+bool Audio::seekInHistory_unlocked(uint64_t frame) {
+    // A fade mixes two streams; the history only has the incoming one.
+    if (!m_owned_stream || (m_mix_state.load() & kMixFading) ||
+        !m_history.copyFrom(frame, m_history_replay)) {
+        return false;
+    }
+    Feed& feed = currentFeed_unlocked();
+    m_eq.requestReset(); // as for any seek: no filter transient across the jump
+    feed.ring.flush();
+    feed.overflow.clear();
+    feed.overflow_pending = false;
+    if (feed.reserved) {
+        feed.requeued = true;
+    }
+    // Straight to the queue: the replay is already gained, resampled and
+    // recorded.
+    queueSamples_unlocked(feed, m_history_replay.data(), m_history_replay.size());
+    m_samples_played = frame;
+    // Spilled replay must reach the ring even if the stream is at EOF.
+    m_stream_cv.notify_all();
+    m_buffer_cv.notify_all();
+    return true;
+}
+
+/**
+ * @brief Samples queued in a feed (ring plus spill) - assumes m_buffer_mutex is already held.
+ */
+size_t Audio::queuedSamples_unlocked(const Feed& feed) const {
+    return feed.ring.size() + feed.overflow.size();
+}
+
+/**
+ * @brief Whether the outgoing stream of a crossfade should be decoded further
+ *        - assumes m_buffer_mutex is already held.
+ */
+bool Audio::tailNeedsData_unlocked() const {
+    return m_tail_stream && !m_tail_eof &&
+           queuedSamples_unlocked(tailFeed_unlocked()) < m_read_ahead.targetSamples();
+}
+
+/**
+ * @brief Releases the outgoing stream once the callback has finished the fade
+ *        - assumes m_buffer_mutex is already held.
+ */
+void Audio::retireCrossfade_unlocked() {
+    const uint32_t gen = m_fade_gen.load();
+    if ((m_mix_state.load() & kMixFading) == 0 || m_fade_done_gen.load(std::memory_order_acquire) != gen) {
+        return;
+    }
+    Debug::log("audio", "Audio: crossfade complete");
+    cancelCrossfade_unlocked();
+}
+
+/**
+ * @brief Stops mixing the outgoing stream and discards its queued tail -
+ *        assumes m_buffer_mutex is already held. Safe when no fade is running.
+ */
+void Audio::cancelCrossfade_unlocked() {
+    if ((m_mix_state.load() & kMixFading) == 0) {
+        return;
+    }
+    // The callback stops reading the tail as soon as it sees the bit clear;
+    // the flush lands on whatever it has not consumed, whichever comes first.
+    m_mix_state.store(static_cast<uint32_t>(m_primary) | (m_fade_gen.load() << kMixGenShift),
+                      std::memory_order_release);
+    Feed& tail = tailFeed_unlocked();
+    tail.ring.flush();
+    tail.overflow.clear();
+    tail.overflow_pending = false;
+    tail.resampler.reset();
+    m_tail_stream.reset();
+    m_tail_eof = false;
+}
+
+/**
+ * @brief Decodes the next chunk of a crossfade's outgoing stream into the tail feed.
+ *
+ * Runs on the decoder thread, interleaved with the current stream's decode,
+ * so each Stream is still only ever read by one thread. The chunk is dropped
+ * if the fade was cancelled or replaced while decoding.
+ *
+ * @return true if a chunk was decoded.
+ */
+bool Audio::decodeTailChunk(std::vector<float>& chunk) {
+    std::shared_ptr<Stream> tail;
+    uint32_t gen = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_buffer_mutex);
+        retireCrossfade_unlocked();
+        if (!tailNeedsData_unlocked()) {
+            return false;
+        }
+        tail = m_tail_stream;
+        gen = m_fade_gen.load();
+        chunk.resize(m_read_ahead.chunkSamples());
+    }
+
+    size_t samples_read = tail->getDataFloat(chunk.size(), chunk.data());
+    const bool eof = tail->eof();
+
+    std::lock_guard<std::mutex> lock(m_buffer_mutex);
+    if (m_tail_stream != tail || m_fade_gen.load() != gen) {
+        return true;
+    }
+    if (m_channels > 0) {
+        samples_read -= samples_read % static_cast<size_t>(m_channels);
+    }
+    Feed& feed = tailFeed_unlocked();
+    updateFeedGain_unlocked(feed, tail.get());
+    queueDecoded_unlocked(feed, chunk.data(), samples_read);
+    if (eof) {
+        drainResampler_unlocked(feed);
+        m_tail_eof = true;
+    }
+    return true;
 }
 
 /**
@@ -691,25 +1337,22 @@ uint64_t Audio::getBufferLatencyMs_unlocked() const {
     if (m_rate == 0 || m_channels == 0) {
         return 0;
     }
-    size_t samples_in_buffer = m_buffer.size() / m_channels;
+    size_t samples_in_buffer = queuedSamples_unlocked() / m_channels;
     return (static_cast<uint64_t>(samples_in_buffer) * 1000) / m_rate;
 }
 
-std::pair<std::vector<int16_t>, bool> Audio::primeStream(Stream* stream, size_t max_samples)
+std::pair<std::vector<float>, bool> Audio::primeStream(Stream* stream, size_t max_samples)
 {
     if (!stream) {
         return {{}, false};
     }
 
     if (max_samples == 0) {
-        const size_t samples_per_ms = static_cast<size_t>(stream->getRate()) *
-                                      static_cast<size_t>(stream->getChannels());
-        max_samples = std::max<size_t>(4096, samples_per_ms / 2);
+        max_samples = defaultPrimeSamples(stream->getRate(), stream->getChannels());
     }
 
-    std::vector<int16_t> primed_samples(max_samples);
-    const size_t bytes_read = stream->getData(max_samples * sizeof(int16_t), primed_samples.data());
-    size_t samples_read = bytes_read / sizeof(int16_t);
+    std::vector<float> primed_samples(max_samples);
+    size_t samples_read = stream->getDataFloat(max_samples, primed_samples.data());
     // Keep the primed data frame-aligned for the same reason as the decoder
     // loop: a partial trailing frame would channel-rotate everything after it.
     const size_t channels = static_cast<size_t>(stream->getChannels());
@@ -723,25 +1366,73 @@ std::pair<std::vector<int16_t>, bool> Audio::primeStream(Stream* stream, size_t
 }
 
 /**
- * @brief Converts 16-bit integer audio samples to floating-point samples for FFT processing.
+ * @brief Default amount of PCM primed before a track handoff: half a second,
+ *        and never less than one decode chunk.
+ * @return Sample count (all channels).
+ */
+size_t Audio::defaultPrimeSamples(unsigned int rate, unsigned int channels)
+{
+    const size_t samples_per_sec = static_cast<size_t>(rate) * static_cast<size_t>(channels);
+    return std::max<size_t>(PsyMP3::Core::ReadAheadPolicy::chunkSamplesFor(rate, channels),
+                            samples_per_sec / 2);
+}
+
+/**
+ * @brief Runs the spectrum FFT over the most recently played audio.
+ *
+ * Called from the GUI thread once per rendered frame, and only while the
+ * spectrum is visible. Drains everything the callback tapped since the last
+ * call, slides it into an interleaved window of the last getFFTSize() frames
+ * and transforms that window into m_fft under m_fft_mutex.
+ *
+ * @return true if the spectrum was recomputed, false if no new audio was
+ *         played (paused, or the tap was just flushed).
+ */
+bool Audio::analyzeSpectrum() {
+    if (!m_fft || m_channels <= 0) {
+        return false;
+    }
+    const size_t fft_frames = static_cast<size_t>(m_fft->getFFTSize());
+    const size_t window = fft_frames * static_cast<size_t>(m_channels);
+    if (m_tap_window.size() != window) {
+        m_tap_window.assign(window, 0.0f);
+    }
+
+    const size_t got = m_tap.read(m_tap_scratch.data(), m_tap_scratch.size());
+    if (got == 0) {
+        return false;
+    }
+    if (got >= window) {
+        std::memcpy(m_tap_window.data(), m_tap_scratch.data() + (got - window),
+                    window * sizeof(float));
+    } else {
+        std::memmove(m_tap_window.data(), m_tap_window.data() + got,
+                     (window - got) * sizeof(float));
+        std::memcpy(m_tap_window.data() + (window - got), m_tap_scratch.data(),
+                    got * sizeof(float));
+    }
+
+    std::lock_guard<std::mutex> lock(m_fft_mutex);
+    mixToMono(m_channels, m_tap_window.data(), m_fft->getTimeDom(), fft_frames, fft_frames);
+    m_fft->doFFT();
+    return true;
+}
+
+/**
+ * @brief Folds float audio frames down to the mono signal the FFT expects.
  * 
- * This function normalizes the audio data to a range of [-1.0, 1.0]. If the input
- * is stereo, it sums the left and right channels to produce a mono signal, which is
- * what the FFT algorithm expects.
+ * Mono input is copied through; stereo input is averaged, (L + R) / 2, which
+ * keeps the result in the same [-1.0, 1.0] range as the input.
  * 
  * @param channels The number of channels in the input audio (1 for mono, 2 for stereo).
- * @param in A pointer to the buffer of 16-bit signed integer input samples.
- * @param out A pointer to the destination buffer for the converted float samples.
- */
-void Audio::toFloat(int channels, const int16_t *in, float *out,
-                    size_t in_frames, size_t out_frames) {
-    const float scale_mono = 1.0f / 32768.0f;
-    const float scale_stereo = 1.0f / 65536.0f;
-
-    // Convert only as many frames as the callback actually delivered. `in` holds
-    // in_frames frames (SDL may negotiate a device buffer smaller than the FFT
-    // window), while the FFT window is out_frames. Reading the full window when
-    // in_frames < out_frames would run off the end of the SDL-owned buffer, so
+ * @param in A pointer to the interleaved float input frames.
+ * @param out A pointer to the destination buffer for the mono samples.
+ */
+void Audio::mixToMono(int channels, const float *in, float *out,
+                      size_t in_frames, size_t out_frames) {
+    // Convert only as many frames as the caller actually has. `in` holds
+    // in_frames frames, while the FFT window is out_frames. Reading the full
+    // window when in_frames < out_frames would run off the end of `in`, so
     // fill min(in_frames, out_frames) and zero the rest below.
     size_t n = 0;
     if (channels == 1 || channels == 2) {
@@ -749,85 +1440,39 @@ void Audio::toFloat(int channels, const int16_t *in, float *out,
     }
 
     if (channels == 1) {
-        // SIMD optimization for mono conversion
-        #ifdef __SSE2__
-        constexpr size_t simd_batch = 8; // Process 8 samples at once with SSE2
-        const size_t simd_end = (n / simd_batch) * simd_batch;
-
-        __m128 scale_vec = _mm_set1_ps(scale_mono);
-
-        for (size_t x = 0; x < simd_end; x += simd_batch) {
-            // Load 8 int16_t values (128 bits)
-            __m128i int16_vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&in[x]));
-
-            // Convert to two sets of 4 int32_t values
-            __m128i int32_lo = _mm_unpacklo_epi16(int16_vec, _mm_srai_epi16(int16_vec, 15));
-            __m128i int32_hi = _mm_unpackhi_epi16(int16_vec, _mm_srai_epi16(int16_vec, 15));
-
-            // Convert to float and scale
-            __m128 float_lo = _mm_mul_ps(_mm_cvtepi32_ps(int32_lo), scale_vec);
-            __m128 float_hi = _mm_mul_ps(_mm_cvtepi32_ps(int32_hi), scale_vec);
-
-            // Store results
-            _mm_storeu_ps(&out[x], float_lo);
-            _mm_storeu_ps(&out[x + 4], float_hi);
-        }
-
-        // Handle remaining samples with scalar code
-        for (size_t x = simd_end; x < n; x++) {
-            out[x] = in[x] * scale_mono;
-        }
-        #else
-        // Fallback scalar implementation
-        for (size_t x = 0; x < n; x++) {
-            out[x] = in[x] * scale_mono;
-        }
-        #endif
+        std::memcpy(out, in, n * sizeof(float));
     } else if (channels == 2) {
         // SIMD optimization for stereo to mono conversion
         #ifdef __SSE2__
         constexpr size_t simd_batch = 4; // Process 4 stereo pairs at once
         const size_t simd_end = (n / simd_batch) * simd_batch;
 
-        __m128 scale_vec = _mm_set1_ps(scale_stereo);
+        const __m128 half = _mm_set1_ps(0.5f);
 
         for (size_t x = 0; x < simd_end; x += simd_batch) {
-            // Load 8 int16_t values (4 stereo pairs, 128 bits)
-            __m128i stereo_vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&in[x * 2]));
-
-            // Convert to int32_t with sign extension
-            __m128i int32_lo = _mm_unpacklo_epi16(stereo_vec, _mm_srai_epi16(stereo_vec, 15));
-            __m128i int32_hi = _mm_unpackhi_epi16(stereo_vec, _mm_srai_epi16(stereo_vec, 15));
-
-            // Convert to float: float_lo = [L0,R0,L1,R1], float_hi = [L2,R2,L3,R3]
-            __m128 float_lo = _mm_cvtepi32_ps(int32_lo);
-            __m128 float_hi = _mm_cvtepi32_ps(int32_hi);
+            const __m128 lo = _mm_loadu_ps(&in[x * 2]);     // L0,R0,L1,R1
+            const __m128 hi = _mm_loadu_ps(&in[x * 2 + 4]); // L2,R2,L3,R3
 
             // Gather the left and right channels separately, then add, so each
-            // output is L_i + R_i. (The previous shuffle summed same-channel
-            // neighbours, producing L0+L1 / R0+R1 instead of L0+R0 / L1+R1.)
-            __m128 lefts  = _mm_shuffle_ps(float_lo, float_hi, _MM_SHUFFLE(2, 0, 2, 0)); // L0,L1,L2,L3
-            __m128 rights = _mm_shuffle_ps(float_lo, float_hi, _MM_SHUFFLE(3, 1, 3, 1)); // R0,R1,R2,R3
-            __m128 sum = _mm_add_ps(lefts, rights);                                       // L0+R0, L1+R1, L2+R2, L3+R3
-
-            // Scale and store
-            __m128 result = _mm_mul_ps(sum, scale_vec);
-            _mm_storeu_ps(&out[x], result);
+            // output is L_i + R_i.
+            const __m128 lefts  = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)); // L0,L1,L2,L3
+            const __m128 rights = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)); // R0,R1,R2,R3
+            _mm_storeu_ps(&out[x], _mm_mul_ps(_mm_add_ps(lefts, rights), half));
         }
 
         // Handle remaining samples with scalar code
         for (size_t x = simd_end; x < n; x++) {
-            out[x] = (static_cast<int32_t>(in[x * 2]) + in[(x * 2) + 1]) * scale_stereo;
+            out[x] = (in[x * 2] + in[(x * 2) + 1]) * 0.5f;
         }
         #else
         // Fallback scalar implementation
         for (size_t x = 0; x < n; x++) {
-            out[x] = (static_cast<int32_t>(in[x * 2]) + in[(x * 2) + 1]) * scale_stereo;
+            out[x] = (in[x * 2] + in[(x * 2) + 1]) * 0.5f;
         }
         #endif
     }
 
-    // Zero the unfilled tail of the FFT window (short device buffer, or an
+    // Zero the unfilled tail of the FFT window (short input, or an
     // unhandled channel count) so the transform never sees stale samples.
     for (size_t x = n; x < out_frames; x++) {
         out[x] = 0.0f;
@@ -18,6 +18,46 @@ AudioCodec::AudioCodec(const StreamInfo& stream_info)
     : m_stream_info(stream_info) {
 }
 
+std::vector<AudioFrame> AudioCodec::decodeBatch(const std::vector<MediaChunk>& chunks,
+                                                unsigned /*threads*/) {
+    std::vector<AudioFrame> frames;
+    frames.reserve(chunks.size());
+    for (const auto& chunk : chunks) {
+        frames.push_back(decode(chunk));
+    }
+    return frames;
+}
+
+bool AudioCodec::resetForStream(const StreamInfo& /*stream_info*/) {
+    return false;
+}
+
+DecodedAudio AudioCodec::decodeInto(const MediaChunk& chunk, int16_t* out, size_t capacity) {
+    AudioFrame frame = decode(chunk);
+    DecodedAudio result;
+    result.sample_rate = frame.sample_rate;
+    result.channels = frame.channels;
+    result.timestamp_samples = frame.timestamp_samples;
+    result.samples = std::min(frame.getSampleCount(), capacity);
+    if (frame.getSampleCount() > capacity) {
+        Debug::log("codec", "AudioCodec::decodeInto: ", getCodecName(), " frame of ",
+                   frame.getSampleCount(), " samples truncated to ", capacity);
+    }
+
+    if (!frame.isFloat()) {
+        std::memcpy(out, frame.samples.data(), result.samples * sizeof(int16_t));
+        return result;
+    }
+    // Round to nearest and clamp, as DemuxedStream does for 16-bit consumers
+    for (size_t i = 0; i < result.samples; ++i) {
+        const float v = frame.float_samples[i] * 32768.0f;
+        out[i] = v >= 32767.0f ? int16_t(32767)
+               : v <= -32768.0f ? int16_t(-32768)
+               : static_cast<int16_t>(std::lrint(v));
+    }
+    return result;
+}
+
 std::unique_ptr<AudioCodec> AudioCodecFactory::createCodec(const StreamInfo& stream_info) {
 #if defined(HAVE_FLAC) && defined(HAVE_OGGDEMUXER)
     // Ogg FLAC (codec_name "flac" with codec_tag 0, as set by OggDemuxer; the
@@ -0,0 +1,159 @@
+/*
+ * CodecPool.cpp - Reuse of decoder instances across tracks
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef FINAL_BUILD
+#include "psymp3.h"
+#endif // !FINAL_BUILD
+
+namespace PsyMP3 {
+namespace Codec {
+
+CodecPool& CodecPool::getInstance() {
+    static CodecPool instance;
+    return instance;
+}
+
+bool CodecPool::Key::operator==(const Key& other) const {
+    return codec_name == other.codec_name && codec_tag == other.codec_tag &&
+           sample_rate == other.sample_rate && channels == other.channels &&
+           bits_per_sample == other.bits_per_sample;
+}
+
+CodecPool::Key CodecPool::keyFor(const StreamInfo& stream_info) {
+    Key key;
+    key.codec_name = stream_info.codec_name;
+    key.codec_tag = stream_info.codec_tag;
+    key.sample_rate = stream_info.sample_rate;
+    key.channels = stream_info.channels;
+    key.bits_per_sample = stream_info.bits_per_sample;
+    return key;
+}
+
+std::unique_ptr<AudioCodec> CodecPool::acquire(const StreamInfo& stream_info) {
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    using std::chrono::steady_clock;
+
+    const Key key = keyFor(stream_info);
+    std::unique_ptr<AudioCodec> codec;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.acquisitions++;
+        codec = takeIdle_unlocked(key);
+    }
+
+    if (codec) {
+        // Reset outside the lock: it may reinitialize decoder state
+        const auto start = steady_clock::now();
+        const bool reused = codec->canDecode(stream_info) && codec->resetForStream(stream_info);
+        const auto elapsed = duration_cast<microseconds>(steady_clock::now() - start);
+        if (reused) {
+            codec->setFloatOutput(false);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.reuses++;
+            m_stats.reuse_time += elapsed;
+            auto cost = m_construction_costs.find(key.codec_name);
+            if (cost != m_construction_costs.end() && cost->second.count > 0) {
+                const auto mean = cost->second.total / cost->second.count;
+                if (mean > elapsed) {
+                    m_stats.time_saved += mean - elapsed;
+                }
+            }
+            Debug::log("codec", "[CodecPool] Reused ", key.codec_name, " codec (", key.sample_rate, " Hz, ",
+                       key.channels, " ch) in ", elapsed.count(), " us");
+            return codec;
+        }
+        Debug::log("codec", "[CodecPool] ", key.codec_name, " codec could not be reset; constructing a new one");
+        codec.reset();
+    }
+
+    const auto start = steady_clock::now();
+    codec = AudioCodecFactory::createCodec(stream_info);
+    if (!codec) {
+        return nullptr;
+    }
+    if (!codec->initialize()) {
+        Debug::log("codec", "[CodecPool] ", codec->getCodecName(), " codec failed to initialize");
+        return nullptr;
+    }
+    const auto elapsed = duration_cast<microseconds>(steady_clock::now() - start);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.constructions++;
+    m_stats.construction_time += elapsed;
+    ConstructionCost& cost = m_construction_costs[key.codec_name];
+    cost.count++;
+    cost.total += elapsed;
+    return codec;
+}
+
+void CodecPool::release(std::unique_ptr<AudioCodec> codec) {
+    if (!codec || !codec->supportsReuse()) {
+        return;
+    }
+
+    // Evicted codecs are destroyed after the lock is dropped
+    std::vector<std::unique_ptr<AudioCodec>> evicted;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    IdleCodec idle;
+    idle.key = keyFor(codec->getStreamInfo());
+    idle.codec = std::move(codec);
+    m_idle.push_back(std::move(idle));
+    trim_unlocked(evicted);
+}
+
+void CodecPool::clear() {
+    std::deque<IdleCodec> idle;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    idle.swap(m_idle);
+}
+
+void CodecPool::setCapacity(size_t capacity) {
+    std::vector<std::unique_ptr<AudioCodec>> evicted;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capacity = capacity;
+    trim_unlocked(evicted);
+}
+
+size_t CodecPool::getCapacity() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_capacity;
+}
+
+CodecPool::PoolStats CodecPool::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    PoolStats stats = m_stats;
+    stats.idle = m_idle.size();
+    stats.reuse_rate = stats.acquisitions > 0
+        ? static_cast<double>(stats.reuses) / static_cast<double>(stats.acquisitions)
+        : 0.0;
+    return stats;
+}
+
+std::unique_ptr<AudioCodec> CodecPool::takeIdle_unlocked(const Key& key) {
+    // Most recently released first: its buffers are the likeliest to be warm
+    for (auto it = m_idle.rbegin(); it != m_idle.rend(); ++it) {
+        if (it->key == key) {
+            std::unique_ptr<AudioCodec> codec = std::move(it->codec);
+            m_idle.erase(std::next(it).base());
+            return codec;
+        }
+    }
+    return nullptr;
+}
+
+void CodecPool::trim_unlocked(std::vector<std::unique_ptr<AudioCodec>>& evicted) {
+    while (m_idle.size() > m_capacity) {
+        evicted.push_back(std::move(m_idle.front().codec));
+        m_idle.pop_front();
+    }
+}
+
+} // namespace Codec
+} // namespace PsyMP3
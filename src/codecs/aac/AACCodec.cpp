@@ -38,6 +38,16 @@ AudioFrame AACCodec::decode(const MediaChunk& chunk) {
     return decode_unlocked(chunk);
 }
 
+DecodedAudio AACCodec::decodeInto(const MediaChunk& chunk, int16_t* out, size_t capacity) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return decodeInto_unlocked(chunk, out, capacity);
+}
+
+size_t AACCodec::getMaxFrameSamples() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return getMaxFrameSamples_unlocked();
+}
+
 AudioFrame AACCodec::flush() {
     std::lock_guard<std::mutex> lock(m_mutex);
     return flush_unlocked();
@@ -86,29 +96,62 @@ bool AACCodec::initialize_unlocked() {
 }
 
 AudioFrame AACCodec::decode_unlocked(const MediaChunk& chunk) {
-    if (!m_initialized || !m_decoder_initialized || !m_decoder) {
+    AudioFrame frame;
+    frame.samples.resize(getMaxFrameSamples_unlocked());
+    const DecodedAudio decoded = decodeInto_unlocked(chunk, frame.samples.data(), frame.samples.size());
+    if (decoded.samples == 0) {
         return AudioFrame();
     }
 
+    frame.samples.resize(decoded.samples);
+    frame.sample_rate = decoded.sample_rate;
+    frame.channels = decoded.channels;
+    frame.timestamp_samples = decoded.timestamp_samples;
+    if (decoded.sample_rate != 0) {
+        frame.timestamp_ms = (decoded.timestamp_samples * 1000ULL) / decoded.sample_rate;
+    }
+    return frame;
+}
+
+DecodedAudio AACCodec::decodeInto_unlocked(const MediaChunk& chunk, int16_t* out, size_t capacity) {
+    if (!m_initialized || !m_decoder_initialized || !m_decoder) {
+        return DecodedAudio();
+    }
+
     if (chunk.data.empty()) {
-        return AudioFrame();
+        return DecodedAudio();
     }
 
+    // NeAACDecDecode2() decodes straight into our buffer; a short one gets
+    // faad2's internal buffer and a copy
     NeAACDecFrameInfo frame_info = {};
-    void* decoded = NeAACDecDecode(
-        m_decoder,
-        &frame_info,
-        const_cast<unsigned char*>(chunk.data.data()),
-        static_cast<unsigned long>(chunk.data.size()));
+    const bool direct = capacity >= getMaxFrameSamples_unlocked();
+    void* decoded_buffer = out;
+    void* decoded = nullptr;
+    if (direct) {
+        decoded = NeAACDecDecode2(
+            m_decoder,
+            &frame_info,
+            const_cast<unsigned char*>(chunk.data.data()),
+            static_cast<unsigned long>(chunk.data.size()),
+            &decoded_buffer,
+            static_cast<unsigned long>(capacity * sizeof(int16_t)));
+    } else {
+        decoded = NeAACDecDecode(
+            m_decoder,
+            &frame_info,
+            const_cast<unsigned char*>(chunk.data.data()),
+            static_cast<unsigned long>(chunk.data.size()));
+    }
 
     if (frame_info.error != 0) {
-        Debug::log("aac", "AACCodec::decode_unlocked: decode error: ",
+        Debug::log("aac", "AACCodec::decodeInto_unlocked: decode error: ",
                    NeAACDecGetErrorMessage(frame_info.error));
-        return AudioFrame();
+        return DecodedAudio();
     }
 
     if (!decoded || frame_info.samples == 0 || frame_info.channels == 0 || frame_info.samplerate == 0) {
-        return AudioFrame();
+        return DecodedAudio();
     }
 
     m_sample_rate = frame_info.samplerate;
@@ -117,18 +160,21 @@ AudioFrame AACCodec::decode_unlocked(const MediaChunk& chunk) {
     m_stream_info.channels = m_channels;
     m_stream_info.bits_per_sample = 16;
 
-    AudioFrame frame;
-    frame.samples.assign(
-        static_cast<const int16_t*>(decoded),
-        static_cast<const int16_t*>(decoded) + frame_info.samples);
-    frame.sample_rate = m_sample_rate;
-    frame.channels = m_channels;
-    frame.timestamp_samples = chunk.timestamp_samples;
-    if (m_sample_rate != 0) {
-        frame.timestamp_ms = (chunk.timestamp_samples * 1000ULL) / m_sample_rate;
+    DecodedAudio result;
+    result.samples = std::min(static_cast<size_t>(frame_info.samples), capacity);
+    result.sample_rate = m_sample_rate;
+    result.channels = m_channels;
+    result.timestamp_samples = chunk.timestamp_samples;
+    if (!direct) {
+        std::memcpy(out, decoded, result.samples * sizeof(int16_t));
     }
+    return result;
+}
 
-    return frame;
+size_t AACCodec::getMaxFrameSamples_unlocked() const {
+    // 1024 samples per channel, doubled by SBR; parametric stereo turns
+    // mono into two channels
+    return 2048 * std::max<size_t>(m_channels, 2);
 }
 
 AudioFrame AACCodec::flush_unlocked() {
@@ -11,6 +11,7 @@
 #include "psymp3.h"
 #else
 #include <cstdint>
+#include <cstring>
 #include <vector>
 #include "debug.h"
 #include "codecs/flac/BitstreamReader.h"
@@ -555,6 +556,109 @@ bool BitstreamReader::readRiceCode(int32_t &value, uint32_t rice_param) {
   return true;
 }
 
+uint64_t BitstreamReader::loadWindow(size_t byte_offset) const {
+  // Eight bytes starting at byte_offset from m_head, most significant first.
+  // The caller guarantees they are valid and do not wrap.
+  uint64_t word;
+  std::memcpy(&word, m_buffer.data() + m_head + byte_offset, sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  return word;
+#else
+  return __builtin_bswap64(word);
+#endif
+}
+
+uint32_t BitstreamReader::readRiceCodes(int32_t *output, uint32_t count,
+                                        uint32_t rice_param) {
+  if (rice_param >= 32 || count == 0) {
+    return 0;
+  }
+
+  // Work on an absolute bit offset from m_head instead of the cache: the bits
+  // still in the cache are exactly those just before m_byte_position.
+  // Windows are loaded only while eight bytes remain before the end of valid
+  // data or the wrap point of the circular buffer, so there is one bounds
+  // check per window rather than per bit field.
+  size_t contiguous = m_buffer.size() - m_head;
+  size_t end_bytes = m_valid_bytes < contiguous ? m_valid_bytes : contiguous;
+  if (end_bytes < 8) {
+    return 0;
+  }
+  const size_t last_window = end_bytes - 8;
+  const uint64_t start = static_cast<uint64_t>(m_byte_position) * 8 - m_cache_bits;
+  uint64_t pos = start;
+
+  uint32_t decoded = 0;
+  while (decoded < count) {
+    uint64_t p = pos;
+    uint64_t quotient = 0;
+    uint64_t window;
+    uint32_t valid;
+    for (;;) {
+      if ((p >> 3) > last_window) {
+        goto done;
+      }
+      valid = 64 - static_cast<uint32_t>(p & 7);
+      window = loadWindow(static_cast<size_t>(p >> 3)) << (p & 7);
+      if (window != 0) {
+        break;
+      }
+      // A run of zeros longer than the window; only reachable with very
+      // large quotients, which the range check below bounds.
+      quotient += valid;
+      p += valid;
+      if (quotient >= 0xFFFFFFFFull) {
+        goto done;
+      }
+    }
+    uint32_t zeros = static_cast<uint32_t>(__builtin_clzll(window));
+    quotient += zeros;
+    p += zeros + 1;
+
+    uint64_t remainder = 0;
+    if (rice_param > 0) {
+      if (zeros + 1 + rice_param <= valid) {
+        // Remainder follows in the same window (shift in two steps: zeros
+        // + 1 can be 64).
+        remainder = ((window << zeros) << 1) >> (64 - rice_param);
+      } else {
+        if ((p >> 3) > last_window) {
+          goto done;
+        }
+        remainder = (loadWindow(static_cast<size_t>(p >> 3)) << (p & 7)) >>
+                    (64 - rice_param);
+      }
+      p += rice_param;
+    }
+
+    // Same range rule as the checked path: a folded value must fit in 32 bits
+    // and 0xFFFFFFFF (which would unfold to INT32_MIN) is forbidden. Leave
+    // such values to the checked path, which reports the error.
+    uint64_t folded = (quotient << rice_param) | remainder;
+    if (folded >= 0xFFFFFFFFull) {
+      break;
+    }
+    uint32_t u = static_cast<uint32_t>(folded);
+    output[decoded++] =
+        static_cast<int32_t>(u >> 1) ^ -static_cast<int32_t>(u & 1);
+    pos = p;
+  }
+
+done:
+  if (pos != start) {
+    // Rebuild the cache around the new position: the partial byte (if any)
+    // stays cached, everything before it is consumed.
+    m_total_bits_read += pos - start;
+    m_byte_position = static_cast<size_t>((pos + 7) >> 3);
+    m_cache_bits = static_cast<uint32_t>(m_byte_position * 8 - pos);
+    m_bit_cache = m_cache_bits
+                      ? m_buffer[m_head + m_byte_position - 1] &
+                            ((1u << m_cache_bits) - 1)
+                      : 0;
+  }
+  return decoded;
+}
+
 } // namespace FLAC
 } // namespace Codec
 } // namespace PsyMP3
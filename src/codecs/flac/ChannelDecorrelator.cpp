@@ -17,6 +17,18 @@ ChannelDecorrelator::~ChannelDecorrelator() {
 
 bool ChannelDecorrelator::decorrelate(int64_t** channels, uint32_t block_size,
                                      uint32_t channel_count, ChannelAssignment assignment) {
+    return decorrelateChannels(channels, block_size, channel_count, assignment);
+}
+
+bool ChannelDecorrelator::decorrelate(int32_t** channels, uint32_t block_size,
+                                     uint32_t channel_count, ChannelAssignment assignment) {
+    return decorrelateChannels(channels, block_size, channel_count, assignment);
+}
+
+template <typename Sample>
+bool ChannelDecorrelator::decorrelateChannels(Sample** channels, uint32_t block_size,
+                                             uint32_t channel_count,
+                                             ChannelAssignment assignment) {
     // Validate inputs
     if (!channels) {
         Debug::log("flac_codec", "ChannelDecorrelator: null channels pointer");
@@ -162,6 +174,67 @@ void ChannelDecorrelator::decorrelateMidSide(int64_t* mid, int64_t* side, uint32
     // - channels[1] (side) now contains the right channel
 }
 
+// 32-bit variants. The caller only uses them for frames of at most 31 bits,
+// where side is at most 32 bits and every result below fits int32 for a
+// valid stream. The arithmetic wraps through uint32_t so that crafted
+// streams produce garbage samples rather than signed-overflow UB; the
+// vector and scalar paths wrap identically.
+
+void ChannelDecorrelator::decorrelateLeftSide(int32_t* left, int32_t* side, uint32_t count) {
+    uint32_t i = 0;
+#ifdef HAVE_SSE2
+    for (; i + 4 <= count; i += 4) {
+        const __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left + i));
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(side + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(side + i), _mm_sub_epi32(l, s));
+    }
+#endif
+    for (; i < count; ++i) {
+        side[i] = static_cast<int32_t>(static_cast<uint32_t>(left[i]) -
+                                       static_cast<uint32_t>(side[i]));
+    }
+}
+
+void ChannelDecorrelator::decorrelateRightSide(int32_t* side, int32_t* right, uint32_t count) {
+    uint32_t i = 0;
+#ifdef HAVE_SSE2
+    for (; i + 4 <= count; i += 4) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(side + i));
+        const __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(side + i), _mm_add_epi32(r, s));
+    }
+#endif
+    for (; i < count; ++i) {
+        side[i] = static_cast<int32_t>(static_cast<uint32_t>(right[i]) +
+                                       static_cast<uint32_t>(side[i]));
+    }
+}
+
+void ChannelDecorrelator::decorrelateMidSide(int32_t* mid, int32_t* side, uint32_t count) {
+    // Same reconstruction as the int64_t version. mid2 == L + R and
+    // mid2 +/- side == 2L / 2R all fit 32 bits for a valid stream, so the
+    // wrapped sums are exact and the arithmetic shift recovers L and R.
+    uint32_t i = 0;
+#ifdef HAVE_SSE2
+    const __m128i one = _mm_set1_epi32(1);
+    for (; i + 4 <= count; i += 4) {
+        const __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mid + i));
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(side + i));
+        const __m128i m2 = _mm_or_si128(_mm_slli_epi32(m, 1), _mm_and_si128(s, one));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(mid + i),
+                         _mm_srai_epi32(_mm_add_epi32(m2, s), 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(side + i),
+                         _mm_srai_epi32(_mm_sub_epi32(m2, s), 1));
+    }
+#endif
+    for (; i < count; ++i) {
+        const uint32_t s = static_cast<uint32_t>(side[i]);
+        const uint32_t m2 = (static_cast<uint32_t>(mid[i]) << 1) | (s & 1u);
+        mid[i]  = static_cast<int32_t>(m2 + s) >> 1; // -> left
+        side[i] = static_cast<int32_t>(m2 - s) >> 1; // -> right
+    }
+}
+
 bool ChannelDecorrelator::validateChannelCount(uint32_t channel_count) const {
     // RFC 9639 supports 1-8 channels (Requirements 26.1-26.8)
     return channel_count >= 1 && channel_count <= 8;
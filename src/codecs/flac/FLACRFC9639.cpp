@@ -380,38 +380,12 @@ bool parseCodedNumberWithLogging(const uint8_t* data, uint64_t& number, size_t&
 
 uint8_t calculateCRC8(const uint8_t* data, size_t length) {
     // CRC-8 with polynomial 0x07 (x^8 + x^2 + x + 1)
-    uint8_t crc = 0;
-    
-    for (size_t i = 0; i < length; i++) {
-        crc ^= data[i];
-        for (int j = 0; j < 8; j++) {
-            if (crc & 0x80) {
-                crc = (crc << 1) ^ 0x07;
-            } else {
-                crc <<= 1;
-            }
-        }
-    }
-    
-    return crc;
+    return PsyMP3::Core::Utility::CRC::crc8(data, length);
 }
 
 uint16_t calculateCRC16(const uint8_t* data, size_t length) {
     // CRC-16 with polynomial 0x8005 (x^16 + x^15 + x^2 + 1)
-    uint16_t crc = 0;
-    
-    for (size_t i = 0; i < length; i++) {
-        crc ^= static_cast<uint16_t>(data[i]) << 8;
-        for (int j = 0; j < 8; j++) {
-            if (crc & 0x8000) {
-                crc = (crc << 1) ^ 0x8005;
-            } else {
-                crc <<= 1;
-            }
-        }
-    }
-    
-    return crc;
+    return PsyMP3::Core::Utility::CRC::crc16(data, length);
 }
 
 bool validateHeaderCRC8WithLogging(const uint8_t* data, size_t length, uint8_t expected_crc,
@@ -58,9 +58,10 @@ FLACCodec::FLACCodec(const StreamInfo& stream_info)
     // Pre-allocate buffers for performance (Requirement 65)
     m_input_buffer.reserve(INPUT_BUFFER_SIZE);  // 64KB input buffer
     
-    // Allocate per-channel decode buffers
+    // Allocate per-channel decode buffers. The 64-bit buffers only serve
+    // 32-bit streams and grow on first use.
     for (size_t i = 0; i < MAX_CHANNELS; i++) {
-        m_decode_buffer[i].reserve(MAX_BLOCK_SIZE);
+        m_narrow_buffer[i].reserve(MAX_BLOCK_SIZE);
     }
     
     // Allocate output buffer for interleaved samples
@@ -70,6 +71,9 @@ FLACCodec::FLACCodec(const StreamInfo& stream_info)
 FLACCodec::~FLACCodec() {
     Debug::log("flac_codec", "[NativeFLACCodec] Destroying native FLAC codec");
     
+    // Batch helpers never take the codec locks; join them first
+    stopBatchThreads();
+    
     // Acquire locks in documented order to ensure no operations in progress
     std::lock_guard<std::mutex> state_lock(m_state_mutex);
     std::lock_guard<std::mutex> decoder_lock(m_decoder_mutex);
@@ -141,6 +145,19 @@ AudioFrame FLACCodec::decode(const MediaChunk& chunk) {
     }
 }
 
+std::vector<AudioFrame> FLACCodec::decodeBatch(const std::vector<MediaChunk>& chunks, unsigned threads) {
+    Debug::log("flac_codec", "[NativeFLACCodec::decodeBatch] [ENTRY] Acquiring state lock for ", chunks.size(), " chunks");
+    
+    std::lock_guard<std::mutex> lock(m_state_mutex);
+    
+    try {
+        return decodeBatch_unlocked(chunks, threads);
+    } catch (const std::exception& e) {
+        Debug::log("flac_codec", "[NativeFLACCodec::decodeBatch] [EXCEPTION] ", e.what());
+        return std::vector<AudioFrame>(chunks.size());
+    }
+}
+
 AudioFrame FLACCodec::flush() {
     Debug::log("flac_codec", "[NativeFLACCodec::flush] [ENTRY] Acquiring state lock");
     
@@ -174,6 +191,25 @@ void FLACCodec::reset() {
     }
 }
 
+bool FLACCodec::resetForStream(const StreamInfo& stream_info) {
+    Debug::log("flac_codec", "[NativeFLACCodec::resetForStream] [ENTRY] Acquiring locks for reuse");
+    
+    // Acquire locks in documented order to prevent deadlocks
+    std::lock_guard<std::mutex> state_lock(m_state_mutex);
+    std::lock_guard<std::mutex> decoder_lock(m_decoder_mutex);
+    std::lock_guard<std::mutex> buffer_lock(m_buffer_mutex);
+    
+    try {
+        m_md5_validation_enabled = true;
+        bool result = resetForStream_unlocked(stream_info);
+        Debug::log("flac_codec", "[NativeFLACCodec::resetForStream] [EXIT] Returning ", result ? "success" : "failure");
+        return result;
+    } catch (const std::exception& e) {
+        Debug::log("flac_codec", "[NativeFLACCodec::resetForStream] [EXCEPTION] ", e.what());
+        return false;
+    }
+}
+
 bool FLACCodec::canDecode(const StreamInfo& stream_info) const {
     Debug::log("flac_codec", "[NativeFLACCodec::canDecode] [ENTRY] Acquiring state lock for codec: ", stream_info.codec_name);
     
@@ -222,6 +258,7 @@ FLACCodecStats FLACCodec::getStats() const {
         stats.memory_usage_bytes += m_narrow_buffer[i].capacity() * sizeof(int32_t);
     }
     stats.memory_usage_bytes += m_output_buffer.capacity() * sizeof(int16_t);
+    stats.memory_usage_bytes += m_float_output_buffer.capacity() * sizeof(float);
 
     // Add component memory estimates if available
     // (This is a basic estimate, components allocate their own memory)
@@ -362,7 +399,8 @@ bool FLACCodec::initialize_unlocked() {
         // Allocate per-channel decode buffers
         for (size_t i = 0; i < MAX_CHANNELS; i++) {
             m_decode_buffer[i].clear();
-            m_decode_buffer[i].reserve(MAX_BLOCK_SIZE);
+            m_narrow_buffer[i].clear();
+            m_narrow_buffer[i].reserve(MAX_BLOCK_SIZE);
         }
         
         // Allocate output buffer for interleaved samples
@@ -594,6 +632,11 @@ AudioFrame FLACCodec::decode_unlocked(const MediaChunk& chunk) {
         // Step 4: Decode subframes for each channel
         Debug::log("flac_codec", "[NativeFLACCodec::decode_unlocked] Decoding ", header.channels, " subframes");
         
+        // Frames of up to 31 bits decode straight into 32-bit buffers; only
+        // 32-bit frames need 64-bit ones for their 33-bit side channel.
+        const bool wide_samples = header.bit_depth > 31;
+        int32_t* channel_ptrs[MAX_CHANNELS];
+        
         for (uint32_t ch = 0; ch < header.channels; ch++) {
             // Determine if this is a side channel (needs extra bit depth)
             bool is_side_channel = false;
@@ -606,16 +649,26 @@ AudioFrame FLACCodec::decode_unlocked(const MediaChunk& chunk) {
             }
             
             // Resize decode buffer for this channel
-            m_decode_buffer[ch].resize(header.block_size);
+            m_narrow_buffer[ch].resize(header.block_size);
+            channel_ptrs[ch] = m_narrow_buffer[ch].data();
+            if (wide_samples) {
+                m_decode_buffer[ch].resize(header.block_size);
+            }
             
             // Decode subframe with error recovery (Requirement 11.3)
             Debug::log("flac_codec", "[NativeFLACCodec::decode_unlocked] Decoding subframe ", ch,
                       " (side_channel=", is_side_channel, ")");
             
-            if (!m_subframe_decoder->decodeSubframe(m_decode_buffer[ch].data(),
-                                                    header.block_size,
-                                                    header.bit_depth,
-                                                    is_side_channel)) {
+            const bool decoded = wide_samples
+                ? m_subframe_decoder->decodeSubframe(m_decode_buffer[ch].data(),
+                                                     header.block_size,
+                                                     header.bit_depth,
+                                                     is_side_channel)
+                : m_subframe_decoder->decodeSubframe(channel_ptrs[ch],
+                                                     header.block_size,
+                                                     header.bit_depth,
+                                                     is_side_channel);
+            if (!decoded) {
                 Debug::log("flac_codec", "[NativeFLACCodec::decode_unlocked] Subframe ", ch,
                           " decoding failed, discarding frame");
                 recoverFromSubframeError();
@@ -627,46 +680,63 @@ AudioFrame FLACCodec::decode_unlocked(const MediaChunk& chunk) {
         // Step 5: Apply channel decorrelation
         Debug::log("flac_codec", "[NativeFLACCodec::decode_unlocked] Applying channel decorrelation");
 
-        // Create array of channel pointers
-        int64_t* decode_ptrs[MAX_CHANNELS];
-        for (uint32_t ch = 0; ch < header.channels; ch++) {
-            decode_ptrs[ch] = m_decode_buffer[ch].data();
-        }
+        if (wide_samples) {
+            // Create array of channel pointers
+            int64_t* decode_ptrs[MAX_CHANNELS];
+            for (uint32_t ch = 0; ch < header.channels; ch++) {
+                decode_ptrs[ch] = m_decode_buffer[ch].data();
+            }
+
+            if (!m_channel_decorrelator->decorrelate(decode_ptrs, header.block_size,
+                                                     header.channels, header.channel_assignment)) {
+                Debug::log("flac_codec", "[NativeFLACCodec::decode_unlocked] Channel decorrelation failed");
+                m_state = DecoderState::DECODER_ERROR;
+                return AudioFrame();
+            }
 
-        if (!m_channel_decorrelator->decorrelate(decode_ptrs, header.block_size,
-                                                 header.channels, header.channel_assignment)) {
+            // Narrow decorrelated samples to int32 for reconstruction and MD5.
+            // After decorrelation every sample fits the frame bit depth (<= 32
+            // bits) for valid streams; clamp defensively for crafted input.
+            for (uint32_t ch = 0; ch < header.channels; ch++) {
+                for (uint32_t i = 0; i < header.block_size; i++) {
+                    int64_t s = decode_ptrs[ch][i];
+                    if (s > INT32_MAX) s = INT32_MAX;
+                    else if (s < INT32_MIN) s = INT32_MIN;
+                    channel_ptrs[ch][i] = static_cast<int32_t>(s);
+                }
+            }
+        } else if (!m_channel_decorrelator->decorrelate(channel_ptrs, header.block_size,
+                                                        header.channels, header.channel_assignment)) {
             Debug::log("flac_codec", "[NativeFLACCodec::decode_unlocked] Channel decorrelation failed");
             m_state = DecoderState::DECODER_ERROR;
             return AudioFrame();
         }
 
-        // Narrow decorrelated samples to int32 for reconstruction and MD5.
-        // After decorrelation every sample fits the frame bit depth (<= 32
-        // bits) for valid streams; clamp defensively for crafted input.
-        int32_t* channel_ptrs[MAX_CHANNELS];
-        for (uint32_t ch = 0; ch < header.channels; ch++) {
-            m_narrow_buffer[ch].resize(header.block_size);
-            for (uint32_t i = 0; i < header.block_size; i++) {
-                int64_t s = decode_ptrs[ch][i];
-                if (s > INT32_MAX) s = INT32_MAX;
-                else if (s < INT32_MIN) s = INT32_MIN;
-                m_narrow_buffer[ch][i] = static_cast<int32_t>(s);
-            }
-            channel_ptrs[ch] = m_narrow_buffer[ch].data();
-        }
-
         // Step 6: Reconstruct samples with bit depth conversion
         Debug::log("flac_codec", "[NativeFLACCodec::decode_unlocked] Reconstructing samples");
         
-        // Resize output buffer for interleaved samples
-        m_output_buffer.resize(header.block_size * header.channels);
-        
-        // Reconstruct and interleave samples
-        m_sample_reconstructor->reconstructSamples(m_output_buffer.data(),
-                                                  channel_ptrs,
-                                                  header.block_size,
-                                                  header.channels,
-                                                  header.bit_depth);
+        // A float consumer gets 17-32 bit sources at full resolution instead
+        // of the rounded 16-bit downscale; 16-bit and narrower sources gain
+        // nothing from float and stay on the int16 path.
+        const bool float_frame = m_float_output && header.bit_depth > 16;
+        if (float_frame) {
+            m_float_output_buffer.resize(header.block_size * header.channels);
+            m_sample_reconstructor->reconstructSamplesFloat(m_float_output_buffer.data(),
+                                                            channel_ptrs,
+                                                            header.block_size,
+                                                            header.channels,
+                                                            header.bit_depth);
+        } else {
+            // Resize output buffer for interleaved samples
+            m_output_buffer.resize(header.block_size * header.channels);
+            
+            // Reconstruct and interleave samples
+            m_sample_reconstructor->reconstructSamples(m_output_buffer.data(),
+                                                      channel_ptrs,
+                                                      header.block_size,
+                                                      header.channels,
+                                                      header.bit_depth);
+        }
         
         // Step 7: Validate frame footer CRC with error recovery (Requirement 11.4)
         Debug::log("flac_codec", "[NativeFLACCodec::decode_unlocked] Parsing frame footer");
@@ -755,7 +825,11 @@ AudioFrame FLACCodec::decode_unlocked(const MediaChunk& chunk) {
         frame.channels = header.channels;
         
         // Copy interleaved samples to frame
-        frame.samples = m_output_buffer;
+        if (float_frame) {
+            frame.float_samples = m_float_output_buffer;
+        } else {
+            frame.samples = m_output_buffer;
+        }
 
         // Transition back to INITIALIZED state after successful decode (Requirement 64.3)
         transitionState(DecoderState::INITIALIZED);
@@ -763,6 +837,7 @@ AudioFrame FLACCodec::decode_unlocked(const MediaChunk& chunk) {
         // Reset error counter on successful decode
         m_consecutive_errors = 0;
         m_last_error = FLACError::NONE;
+        m_last_bit_depth = header.bit_depth;
         
         Debug::log("flac_codec", "[NativeFLACCodec::decode_unlocked] Frame decoded successfully");
         return frame;
@@ -802,6 +877,171 @@ AudioFrame FLACCodec::decode_unlocked(const MediaChunk& chunk) {
     }
 }
 
+std::vector<AudioFrame> FLACCodec::decodeBatch_unlocked(const std::vector<MediaChunk>& chunks,
+                                                        unsigned threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(std::min<size_t>(threads, chunks.size()));
+    
+    // One worker, or a decoder that has to recover first: decode in place
+    if (threads <= 1 || !m_initialized || m_state != DecoderState::INITIALIZED) {
+        std::vector<AudioFrame> frames;
+        frames.reserve(chunks.size());
+        for (const auto& chunk : chunks) {
+            frames.push_back(decode_unlocked(chunk));
+        }
+        return frames;
+    }
+    
+    // Workers decode with the same stream parameters and output format but
+    // without MD5: the signature must see frames in order, so it is fed
+    // below from the samples each worker leaves behind.
+    while (m_batch_workers.size() < threads) {
+        auto worker = std::make_unique<FLACCodec>(m_stream_info);
+        worker->m_md5_validation_enabled = false;
+        if (m_has_streaminfo) {
+            worker->setStreamInfo_unlocked(m_streaminfo);
+        }
+        if (!worker->initialize_unlocked()) {
+            Debug::log("flac_codec", "[NativeFLACCodec::decodeBatch_unlocked] Worker initialization failed");
+            return std::vector<AudioFrame>(chunks.size());
+        }
+        m_batch_workers.push_back(std::move(worker));
+    }
+    
+    const bool update_md5 = m_md5_validation_enabled && m_has_streaminfo &&
+                            !MD5Validator::isZeroMD5(m_streaminfo.md5_sum);
+    
+    struct DecodedPCM {
+        std::vector<int32_t> channels[MAX_CHANNELS];
+        uint32_t bit_depth = 0;
+    };
+    std::vector<AudioFrame> frames(chunks.size());
+    std::vector<DecodedPCM> pcm(update_md5 ? chunks.size() : 0);
+    std::atomic<size_t> next_chunk{0};
+    
+    auto run = [&](FLACCodec& worker) {
+        for (size_t i = next_chunk++; i < chunks.size(); i = next_chunk++) {
+            try {
+                frames[i] = worker.decode_unlocked(chunks[i]);
+                if (update_md5 && frames[i].hasSamples()) {
+                    for (uint32_t ch = 0; ch < frames[i].channels; ch++) {
+                        pcm[i].channels[ch] = worker.m_narrow_buffer[ch];
+                    }
+                    pcm[i].bit_depth = worker.m_last_bit_depth;
+                }
+            } catch (const std::exception& e) {
+                Debug::log("flac_codec", "[NativeFLACCodec::decodeBatch_unlocked] Worker exception: ", e.what());
+                frames[i] = AudioFrame();
+            }
+        }
+    };
+    
+    for (auto& worker : m_batch_workers) {
+        worker->m_float_output = m_float_output;
+    }
+    
+    // Start any helper threads this batch needs beyond those already
+    // waiting. The calling thread is the first worker.
+    while (m_batch_threads.size() + 1 < threads) {
+        try {
+            const size_t index = m_batch_threads.size() + 1;
+            m_batch_threads.emplace_back(&FLACCodec::batchThreadLoop, this, index);
+        } catch (const std::system_error& e) {
+            // The threads already running share the remaining frames
+            Debug::log("flac_codec", "[NativeFLACCodec::decodeBatch_unlocked] Worker thread failed to start: ", e.what());
+            threads = static_cast<unsigned>(m_batch_threads.size() + 1);
+            break;
+        }
+    }
+    
+    if (threads > 1) {
+        std::lock_guard<std::mutex> batch_lock(m_batch_mutex);
+        m_batch_job = run;
+        m_batch_helpers = threads - 1;
+        m_batch_pending = threads - 1;
+        m_batch_generation++;
+    }
+    m_batch_start_cv.notify_all();
+    run(*m_batch_workers[0]);
+    {
+        std::unique_lock<std::mutex> batch_lock(m_batch_mutex);
+        m_batch_done_cv.wait(batch_lock, [this] { return m_batch_pending == 0; });
+        m_batch_job = nullptr;
+    }
+    
+    // Reassemble in stream order
+    for (size_t i = 0; i < chunks.size(); i++) {
+        m_stats.total_bytes_processed += chunks[i].data.size();
+        if (!frames[i].hasSamples()) {
+            m_stats.error_count++;
+            m_consecutive_errors++;
+            continue;
+        }
+        const size_t block_size = frames[i].getSampleFrameCount();
+        if (update_md5) {
+            const int32_t* channel_ptrs[MAX_CHANNELS];
+            for (uint32_t ch = 0; ch < frames[i].channels; ch++) {
+                channel_ptrs[ch] = pcm[i].channels[ch].data();
+            }
+            if (!m_md5_validator->update(channel_ptrs, static_cast<uint32_t>(block_size),
+                                         frames[i].channels, pcm[i].bit_depth)) {
+                Debug::log("flac_codec", "[NativeFLACCodec::decodeBatch_unlocked] MD5 update failed (warning)");
+            }
+        }
+        m_current_sample.fetch_add(block_size);
+        m_stats.frames_decoded++;
+        m_stats.samples_decoded += block_size;
+        m_consecutive_errors = 0;
+    }
+    
+    Debug::log("flac_codec", "[NativeFLACCodec::decodeBatch_unlocked] Decoded ", chunks.size(),
+              " frames on ", threads, " threads");
+    return frames;
+}
+
+void FLACCodec::batchThreadLoop(size_t index) {
+    uint64_t seen_generation = 0;
+    std::unique_lock<std::mutex> batch_lock(m_batch_mutex);
+    for (;;) {
+        m_batch_start_cv.wait(batch_lock, [&] {
+            return m_batch_shutdown || m_batch_generation != seen_generation;
+        });
+        if (m_batch_shutdown) {
+            return;
+        }
+        seen_generation = m_batch_generation;
+        if (index > m_batch_helpers) {
+            continue;
+        }
+        
+        // m_batch_job and the worker stay valid until m_batch_pending drops
+        // to zero, which only this thread's decrement below can cause
+        auto& job = m_batch_job;
+        FLACCodec& worker = *m_batch_workers[index];
+        batch_lock.unlock();
+        job(worker);
+        batch_lock.lock();
+        
+        if (--m_batch_pending == 0) {
+            m_batch_done_cv.notify_one();
+        }
+    }
+}
+
+void FLACCodec::stopBatchThreads() {
+    {
+        std::lock_guard<std::mutex> batch_lock(m_batch_mutex);
+        m_batch_shutdown = true;
+    }
+    m_batch_start_cv.notify_all();
+    for (auto& thread : m_batch_threads) {
+        thread.join();
+    }
+    m_batch_threads.clear();
+}
+
 AudioFrame FLACCodec::flush_unlocked() {
     Debug::log("flac_codec", "[NativeFLACCodec::flush_unlocked] Flushing remaining samples");
 
@@ -886,6 +1126,40 @@ void FLACCodec::reset_unlocked() {
               getStateName(m_state));
 }
 
+bool FLACCodec::resetForStream_unlocked(const StreamInfo& stream_info) {
+    Debug::log("flac_codec", "[NativeFLACCodec::resetForStream_unlocked] Reusing decoder for new stream");
+    
+    // Back to the state the constructor leaves; the buffers keep their capacity
+    AudioCodec::m_stream_info = stream_info;
+    m_stream_info = stream_info;
+    m_state = DecoderState::UNINITIALIZED;
+    m_initialized = false;
+    m_seek_table.clear();
+    m_has_seek_table = false;
+    m_streaminfo = StreamInfoMetadata();
+    m_has_streaminfo = false;
+    m_md5_invalidated_by_seek = false;
+    m_last_bit_depth = 0;
+    m_stats = FLACCodecStats();
+    m_stats.min_frame_decode_time_us = UINT64_MAX;
+    
+    // initialize_unlocked() drops the batch workers when it recovers the new
+    // STREAMINFO; set them aside and reset them for the new stream instead
+    std::vector<std::unique_ptr<FLACCodec>> workers = std::move(m_batch_workers);
+    m_batch_workers.clear();
+    if (!initialize_unlocked()) {
+        return false;
+    }
+    for (auto& worker : workers) {
+        if (!worker->resetForStream_unlocked(stream_info)) {
+            // Recreated on next use
+            return true;
+        }
+    }
+    m_batch_workers = std::move(workers);
+    return true;
+}
+
 bool FLACCodec::canDecode_unlocked(const StreamInfo& stream_info) const {
     // Check codec name (case-insensitive)
     std::string codec_lower = stream_info.codec_name;
@@ -1142,6 +1416,8 @@ void FLACCodec::setStreamInfo_unlocked(const StreamInfoMetadata& streaminfo) {
     
     m_streaminfo = streaminfo;
     m_has_streaminfo = true;
+    // Batch workers are recreated with the new STREAMINFO on next use
+    m_batch_workers.clear();
     // New stream: MD5 validation is meaningful again from its start.
     m_md5_invalidated_by_seek = false;
     
@@ -1461,6 +1737,8 @@ void FLACCodec::recoverFromMemoryError() {
     
     m_output_buffer.clear();
     m_output_buffer.shrink_to_fit();
+    m_float_output_buffer.clear();
+    m_float_output_buffer.shrink_to_fit();
     
     m_last_error = FLACError::MEMORY_ALLOCATION;
     m_state = DecoderState::DECODER_ERROR;
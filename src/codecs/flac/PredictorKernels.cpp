@@ -0,0 +1,366 @@
+/*
+ * PredictorKernels.cpp - Specialized FIXED/LPC sample reconstruction kernels
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#include "psymp3.h"
+
+namespace PsyMP3 {
+namespace Codec {
+namespace FLAC {
+
+namespace {
+
+template <typename Sample>
+void fixedReference(Sample *samples, const int32_t *residuals, uint32_t count,
+                    uint32_t order, uint32_t bit_depth) {
+  // Apply FIXED predictor formulas (Requirement 4)
+  // Samples buffer already contains warm-up samples at positions [0..order-1]
+  // We need to reconstruct samples[order..order+count-1] using
+  // residuals[0..count-1]
+
+  // For a valid stream every reconstructed sample fits the subframe bit depth,
+  // so clamping is a no-op; on crafted input it stops samples from growing
+  // without bound and overflowing the int64 accumulator (signed-overflow UB).
+  const int64_t sample_min = -(INT64_C(1) << (bit_depth - 1));
+  const int64_t sample_max = (INT64_C(1) << (bit_depth - 1)) - 1;
+
+  // Sequential decoding requirement (Requirement 54)
+  for (uint32_t i = 0; i < count; i++) {
+    // Use 64-bit arithmetic to prevent overflow for high bit-depth files
+    // (24-bit and 32-bit FLAC). Coefficients can be as large as 6 and samples
+    // can be near INT32_MAX, so intermediate products can exceed 32 bits.
+    int64_t prediction = 0;
+    uint32_t sample_idx = order + i;
+
+    switch (order) {
+    case 0:
+      // Order 0: s[i] = residual[i] (no prediction)
+      prediction = 0;
+      break;
+
+    case 1:
+      // Order 1: s[i] = residual[i] + s[i-1]
+      prediction = samples[sample_idx - 1];
+      break;
+
+    case 2:
+      // Order 2: s[i] = residual[i] + 2*s[i-1] - s[i-2]
+      prediction = 2LL * samples[sample_idx - 1] - samples[sample_idx - 2];
+      break;
+
+    case 3:
+      // Order 3: s[i] = residual[i] + 3*s[i-1] - 3*s[i-2] + s[i-3]
+      prediction = 3LL * samples[sample_idx - 1] - 3LL * samples[sample_idx - 2] +
+                   samples[sample_idx - 3];
+      break;
+
+    case 4:
+      // Order 4: s[i] = residual[i] + 4*s[i-1] - 6*s[i-2] + 4*s[i-3] - s[i-4]
+      prediction = 4LL * samples[sample_idx - 1] - 6LL * samples[sample_idx - 2] +
+                   4LL * samples[sample_idx - 3] - samples[sample_idx - 4];
+      break;
+
+    default:
+      // Should never happen - validated earlier
+      prediction = 0;
+      break;
+    }
+
+    // Reconstruct sample: s[i] = prediction + residual[i]
+    // Computed in int64: side subframes of 32-bit streams hold 33-bit
+    // values. An int32 buffer is only used when the clamped sample fits it.
+    int64_t reconstructed = prediction + residuals[i];
+    if (reconstructed < sample_min) reconstructed = sample_min;
+    else if (reconstructed > sample_max) reconstructed = sample_max;
+    samples[sample_idx] = static_cast<Sample>(reconstructed);
+  }
+}
+
+template <typename Sample>
+void lpcReference(Sample *samples, const int32_t *residuals,
+                  const int32_t *coeffs, uint32_t count, uint32_t order,
+                  int32_t shift, uint32_t bit_depth) {
+  // Apply LPC predictor (Requirement 5, 51, 52)
+  // Samples buffer already contains warm-up samples at positions [0..order-1]
+  // We need to reconstruct samples[order..order+count-1] using
+  // residuals[0..count-1]
+
+  // For a valid stream every reconstructed sample fits the subframe bit depth,
+  // so clamping is a no-op; on crafted input it stops samples from growing
+  // without bound and overflowing the int64 accumulator (signed-overflow UB).
+  const int64_t sample_min = -(INT64_C(1) << (bit_depth - 1));
+  const int64_t sample_max = (INT64_C(1) << (bit_depth - 1)) - 1;
+
+  // Sequential decoding requirement (Requirement 54)
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t sample_idx = order + i;
+
+    // Compute LPC prediction using 64-bit arithmetic to prevent overflow
+    // (Requirement 5) prediction = sum(coeff[j] * sample[n-j-1]) >> shift
+    int64_t sum = 0;
+
+    // Apply coefficients in reverse chronological order (Requirement 52)
+    // coeff[0] applies to most recent sample (sample[n-1])
+    // coeff[1] applies to second most recent sample (sample[n-2])
+    // etc.
+    for (uint32_t j = 0; j < order; j++) {
+      // Multiply coefficient with corresponding past sample. Products stay
+      // within int64: |coeff| < 2^15 and |sample| <= 2^33, so each term is
+      // < 2^48 and a 32-term sum is < 2^53.
+      sum += static_cast<int64_t>(coeffs[j]) * samples[sample_idx - j - 1];
+    }
+
+    // Apply quantization level shift (arithmetic right shift)
+    int64_t prediction = sum >> shift;
+
+    // Add residual to get reconstructed sample (stays in int64; see the
+    // FIXED path).
+    int64_t reconstructed = prediction + residuals[i];
+    if (reconstructed < sample_min) reconstructed = sample_min;
+    else if (reconstructed > sample_max) reconstructed = sample_max;
+    samples[sample_idx] = static_cast<Sample>(reconstructed);
+  }
+}
+
+// The specialized kernels below produce exactly the reference results. With
+// every sample clamped to the subframe bit depth, |sample| <= 2^(bit_depth-1)
+// and |coeff| < 2^(precision-1), so an `order`-term sum stays below
+// 2^(bit_depth + precision + ceil(log2(order)) - 2): whenever that exponent
+// is <= 30 the whole inner product fits an int32 accumulator.
+
+// Each prediction needs the sample reconstructed just before it, so the
+// loop is one long dependency chain. GCC's SLP vectorizer turns the unrolled
+// inner product into vector loads that straddle that just-stored sample;
+// the failed store-to-load forwarding makes it about twice as slow as the
+// scalar code, so the kernels opt out of it.
+#if defined(__GNUC__) && !defined(__clang__)
+#define FLAC_PREDICTOR_KERNEL \
+  __attribute__((optimize("no-tree-vectorize", "no-tree-slp-vectorize")))
+#else
+#define FLAC_PREDICTOR_KERNEL
+#endif
+
+inline int64_t clampSample(int64_t value, int64_t lo, int64_t hi) {
+  return value < lo ? lo : (value > hi ? hi : value);
+}
+
+// Order known at compile time; the inner loop unrolls completely. Low
+// orders carry the history in registers as a sliding window, so the chain
+// from one sample to the next never goes through memory; past order 4 the
+// window shuffling costs more than the store-to-load forwarding it saves.
+template <typename Sample, uint32_t Order, typename Acc>
+FLAC_PREDICTOR_KERNEL
+void lpcKernel(Sample *samples, const int32_t *residuals,
+               const int32_t *coeffs, uint32_t count, uint32_t /*order*/,
+               int32_t shift, uint32_t bit_depth) {
+  const int64_t sample_min = -(INT64_C(1) << (bit_depth - 1));
+  const int64_t sample_max = (INT64_C(1) << (bit_depth - 1)) - 1;
+  Acc c[Order];
+  for (uint32_t j = 0; j < Order; ++j) {
+    c[j] = coeffs[j];
+  }
+  Sample *out = samples + Order;
+  if (Order <= 4) {
+    // window[j] is sample n-1-j
+    Acc window[Order];
+    for (uint32_t j = 0; j < Order; ++j) {
+      window[j] = static_cast<Acc>(out[-1 - static_cast<int32_t>(j)]);
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+      Acc sum = 0;
+      for (uint32_t j = Order; j-- > 0;) {
+        sum += c[j] * window[j];
+      }
+      const int64_t sample = clampSample(
+          static_cast<int64_t>(sum >> shift) + residuals[i], sample_min,
+          sample_max);
+      out[i] = static_cast<Sample>(sample);
+      for (uint32_t j = Order - 1; j > 0; --j) {
+        window[j] = window[j - 1];
+      }
+      window[0] = static_cast<Acc>(sample);
+    }
+    return;
+  }
+  for (uint32_t i = 0; i < count; ++i) {
+    const Sample *history = out + i;
+    // Oldest sample first: the previous output, just stored, joins the sum
+    // last, keeping it off the critical path of the next prediction.
+    Acc sum = 0;
+    for (uint32_t j = Order; j-- > 0;) {
+      sum += c[j] * static_cast<Acc>(history[-1 - static_cast<int32_t>(j)]);
+    }
+    out[i] = static_cast<Sample>(clampSample(
+        static_cast<int64_t>(sum >> shift) + residuals[i], sample_min,
+        sample_max));
+  }
+}
+
+// Orders without their own instantiation, 32-bit accumulation (64-bit uses
+// the reference).
+template <typename Sample>
+FLAC_PREDICTOR_KERNEL
+void lpcKernelNarrow(Sample *samples, const int32_t *residuals,
+                     const int32_t *coeffs, uint32_t count, uint32_t order,
+                     int32_t shift, uint32_t bit_depth) {
+  const int64_t sample_min = -(INT64_C(1) << (bit_depth - 1));
+  const int64_t sample_max = (INT64_C(1) << (bit_depth - 1)) - 1;
+  Sample *out = samples + order;
+  for (uint32_t i = 0; i < count; ++i) {
+    const Sample *history = out + i;
+    int32_t sum = 0;
+    for (uint32_t j = order; j-- > 0;) {
+      sum += coeffs[j] * static_cast<int32_t>(history[-1 - static_cast<int32_t>(j)]);
+    }
+    out[i] = static_cast<Sample>(clampSample(
+        static_cast<int64_t>(sum >> shift) + residuals[i], sample_min,
+        sample_max));
+  }
+}
+
+// The last four samples are carried in locals rather than re-read from the
+// output, so the chain from one sample to the next is arithmetic only.
+template <typename Sample, uint32_t Order, typename Acc>
+FLAC_PREDICTOR_KERNEL
+void fixedKernel(Sample *samples, const int32_t *residuals, uint32_t count,
+                 uint32_t /*order*/, uint32_t bit_depth) {
+  const int64_t sample_min = -(INT64_C(1) << (bit_depth - 1));
+  const int64_t sample_max = (INT64_C(1) << (bit_depth - 1)) - 1;
+  Sample *out = samples + Order;
+  // s1 is sample n-1, s2 is n-2, ...
+  Acc s1 = Order >= 1 ? static_cast<Acc>(out[-1]) : 0;
+  Acc s2 = Order >= 2 ? static_cast<Acc>(out[-2]) : 0;
+  Acc s3 = Order >= 3 ? static_cast<Acc>(out[-3]) : 0;
+  Acc s4 = Order >= 4 ? static_cast<Acc>(out[-4]) : 0;
+  for (uint32_t i = 0; i < count; ++i) {
+    Acc prediction = 0;
+    if (Order == 1) {
+      prediction = s1;
+    } else if (Order == 2) {
+      prediction = 2 * s1 - s2;
+    } else if (Order == 3) {
+      prediction = 3 * (s1 - s2) + s3;
+    } else if (Order == 4) {
+      prediction = 4 * (s1 + s3) - 6 * s2 - s4;
+    }
+    const int64_t sample = clampSample(
+        static_cast<int64_t>(prediction) + residuals[i], sample_min, sample_max);
+    out[i] = static_cast<Sample>(sample);
+    s4 = s3;
+    s3 = s2;
+    s2 = s1;
+    s1 = static_cast<Acc>(sample);
+  }
+}
+
+template <typename Sample, typename Acc>
+LPCKernelT<Sample> specializedLPC(uint32_t order) {
+  switch (order) {
+  case 1: return lpcKernel<Sample, 1, Acc>;
+  case 2: return lpcKernel<Sample, 2, Acc>;
+  case 3: return lpcKernel<Sample, 3, Acc>;
+  case 4: return lpcKernel<Sample, 4, Acc>;
+  case 5: return lpcKernel<Sample, 5, Acc>;
+  case 6: return lpcKernel<Sample, 6, Acc>;
+  case 7: return lpcKernel<Sample, 7, Acc>;
+  case 8: return lpcKernel<Sample, 8, Acc>;
+  case 9: return lpcKernel<Sample, 9, Acc>;
+  case 10: return lpcKernel<Sample, 10, Acc>;
+  case 11: return lpcKernel<Sample, 11, Acc>;
+  case 12: return lpcKernel<Sample, 12, Acc>;
+  case 16: return lpcKernel<Sample, 16, Acc>;
+  case 32: return lpcKernel<Sample, 32, Acc>;
+  default: return nullptr;
+  }
+}
+
+template <typename Sample, typename Acc>
+FixedKernelT<Sample> specializedFixed(uint32_t order) {
+  switch (order) {
+  case 0: return fixedKernel<Sample, 0, Acc>;
+  case 1: return fixedKernel<Sample, 1, Acc>;
+  case 2: return fixedKernel<Sample, 2, Acc>;
+  case 3: return fixedKernel<Sample, 3, Acc>;
+  case 4: return fixedKernel<Sample, 4, Acc>;
+  default: return nullptr;
+  }
+}
+
+uint32_t ceilLog2(uint32_t value) {
+  uint32_t bits = 0;
+  while ((1u << bits) < value) {
+    ++bits;
+  }
+  return bits;
+}
+
+template <typename Sample>
+LPCKernelT<Sample> selectLPC(uint32_t order, uint32_t coeff_precision,
+                             uint32_t bit_depth) {
+  if (bit_depth + coeff_precision + ceilLog2(order) <= 32) {
+    LPCKernelT<Sample> kernel = specializedLPC<Sample, int32_t>(order);
+    return kernel ? kernel : lpcKernelNarrow<Sample>;
+  }
+  LPCKernelT<Sample> kernel = specializedLPC<Sample, int64_t>(order);
+  return kernel ? kernel : lpcReference<Sample>;
+}
+
+template <typename Sample>
+FixedKernelT<Sample> selectFixed(uint32_t order, uint32_t bit_depth) {
+  // The order-4 prediction is at most 16 samples' worth in magnitude.
+  FixedKernelT<Sample> kernel =
+      bit_depth + 4 <= 31 ? specializedFixed<Sample, int32_t>(order)
+                          : specializedFixed<Sample, int64_t>(order);
+  return kernel ? kernel : fixedReference<Sample>;
+}
+
+} // namespace
+
+LPCKernel selectLPCKernel(uint32_t order, uint32_t coeff_precision,
+                          uint32_t bit_depth) {
+  return selectLPC<int64_t>(order, coeff_precision, bit_depth);
+}
+
+LPCKernel32 selectLPCKernel32(uint32_t order, uint32_t coeff_precision,
+                              uint32_t bit_depth) {
+  return selectLPC<int32_t>(order, coeff_precision, bit_depth);
+}
+
+FixedKernel selectFixedKernel(uint32_t order, uint32_t bit_depth) {
+  return selectFixed<int64_t>(order, bit_depth);
+}
+
+FixedKernel32 selectFixedKernel32(uint32_t order, uint32_t bit_depth) {
+  return selectFixed<int32_t>(order, bit_depth);
+}
+
+void applyLPCReference(int64_t *samples, const int32_t *residuals,
+                       const int32_t *coeffs, uint32_t count, uint32_t order,
+                       int32_t shift, uint32_t bit_depth) {
+  lpcReference(samples, residuals, coeffs, count, order, shift, bit_depth);
+}
+
+void applyLPCReference(int32_t *samples, const int32_t *residuals,
+                       const int32_t *coeffs, uint32_t count, uint32_t order,
+                       int32_t shift, uint32_t bit_depth) {
+  lpcReference(samples, residuals, coeffs, count, order, shift, bit_depth);
+}
+
+void applyFixedReference(int64_t *samples, const int32_t *residuals,
+                         uint32_t count, uint32_t order, uint32_t bit_depth) {
+  fixedReference(samples, residuals, count, order, bit_depth);
+}
+
+void applyFixedReference(int32_t *samples, const int32_t *residuals,
+                         uint32_t count, uint32_t order, uint32_t bit_depth) {
+  fixedReference(samples, residuals, count, order, bit_depth);
+}
+
+} // namespace FLAC
+} // namespace Codec
+} // namespace PsyMP3
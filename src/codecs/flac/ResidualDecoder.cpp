@@ -190,8 +190,13 @@ bool ResidualDecoder::decodePartition(int32_t *output,
     return decodeEscapedPartition(output, info);
   }
 
+  // Batched fast path for the bulk of the partition; the per-value path
+  // below finishes whatever it leaves (buffer edges, invalid values).
+  uint32_t i = m_reader->readRiceCodes(output, info.sample_count,
+                                       info.rice_parameter);
+
   // Decode Rice-coded samples
-  for (uint32_t i = 0; i < info.sample_count; ++i) {
+  for (; i < info.sample_count; ++i) {
     int32_t value;
     if (!decodeRiceCode(value, info.rice_parameter)) {
       Debug::log("residual_decoder", "Rice decode failed at sample ", i, " of ",
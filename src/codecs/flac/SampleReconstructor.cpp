@@ -26,6 +26,37 @@ inline int32_t roundedDownshift(int32_t sample, uint32_t shift) {
                                  : -(((-s) + half) >> shift);
   return static_cast<int32_t>(rounded);
 }
+
+#ifdef HAVE_SSE2
+// convertTo16Bit() for four samples, minus the final clip (the caller's
+// saturating pack does that). Every depth reduces to a left shift (< 16
+// bits) followed by a rounded right shift (> 16 bits), one of them by zero.
+struct To16SSE2 {
+  __m128i up;    // left shift count
+  __m128i down;  // right shift count
+  __m128i half;  // rounding bias for the right shift
+
+  explicit To16SSE2(uint32_t source_bit_depth)
+      : up(_mm_cvtsi32_si128(source_bit_depth < 16 ? 16 - source_bit_depth : 0)),
+        down(_mm_cvtsi32_si128(source_bit_depth > 16 ? source_bit_depth - 16 : 0)),
+        half(_mm_set1_epi32(source_bit_depth > 16
+                                ? 1 << (source_bit_depth - 17) : 0)) {}
+
+  __m128i operator()(__m128i sample) const {
+    sample = _mm_sll_epi32(sample, up);
+    // roundedDownshift(): round the magnitude, then restore the sign. The
+    // magnitude is taken as unsigned, so INT32_MIN comes out as 2^31.
+    const __m128i sign = _mm_srai_epi32(sample, 31);
+    __m128i mag = _mm_sub_epi32(_mm_xor_si128(sample, sign), sign);
+    mag = _mm_srl_epi32(_mm_add_epi32(mag, half), down);
+    return _mm_sub_epi32(_mm_xor_si128(mag, sign), sign);
+  }
+};
+
+inline __m128i load4(const int32_t *p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+#endif
 } // namespace
 
 SampleReconstructor::SampleReconstructor() {}
@@ -161,9 +192,35 @@ void SampleReconstructor::reconstructSamples(int16_t *output,
   // Requirement 10.2: Interleave left and right channels for stereo
   // Requirement 10.3: Interleave all channels in order for multi-channel
 
-  size_t output_index = 0;
+  uint32_t first_scalar = 0;
+#ifdef HAVE_SSE2
+  // Mono and stereo, the common layouts, convert four samples per channel
+  // at a time; the saturating pack is validateAndClip().
+  const To16SSE2 to16(source_bit_depth);
+  if (channel_count == 1) {
+    const int32_t *mono = channels[0];
+    for (; first_scalar + 8 <= block_size; first_scalar += 8) {
+      const __m128i lo = to16(load4(mono + first_scalar));
+      const __m128i hi = to16(load4(mono + first_scalar + 4));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(output + first_scalar),
+                       _mm_packs_epi32(lo, hi));
+    }
+  } else if (channel_count == 2) {
+    const int32_t *left = channels[0];
+    const int32_t *right = channels[1];
+    for (; first_scalar + 4 <= block_size; first_scalar += 4) {
+      const __m128i l = to16(load4(left + first_scalar));
+      const __m128i r = to16(load4(right + first_scalar));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(output + 2 * first_scalar),
+                       _mm_packs_epi32(_mm_unpacklo_epi32(l, r),
+                                       _mm_unpackhi_epi32(l, r)));
+    }
+  }
+#endif
+
+  size_t output_index = static_cast<size_t>(first_scalar) * channel_count;
 
-  for (uint32_t sample_idx = 0; sample_idx < block_size; ++sample_idx) {
+  for (uint32_t sample_idx = first_scalar; sample_idx < block_size; ++sample_idx) {
     for (uint32_t channel_idx = 0; channel_idx < channel_count; ++channel_idx) {
       // Get the sample from this channel
       int32_t sample = channels[channel_idx][sample_idx];
@@ -187,6 +244,58 @@ void SampleReconstructor::reconstructSamples(int16_t *output,
   // Total samples output = block_size * channel_count
 }
 
+void SampleReconstructor::reconstructSamplesFloat(float *output,
+                                                  int32_t **channels,
+                                                  uint32_t block_size,
+                                                  uint32_t channel_count,
+                                                  uint32_t source_bit_depth) {
+  if (!output || !channels || block_size == 0 || channel_count == 0) {
+    return;
+  }
+  if (source_bit_depth < 4 || source_bit_depth > 32) {
+    return;
+  }
+  for (uint32_t i = 0; i < channel_count; ++i) {
+    if (!channels[i]) {
+      return;
+    }
+  }
+
+  // One exact power-of-two scale per frame: a sample of N bits maps to
+  // [-1.0, 1.0) without rounding, so nothing below the source LSB is lost
+  // (float's 24-bit mantissa holds 24-bit sources exactly).
+  const float scale = 1.0f / static_cast<float>(1ull << (source_bit_depth - 1));
+
+  uint32_t first_scalar = 0;
+#ifdef HAVE_SSE2
+  const __m128 vscale = _mm_set1_ps(scale);
+  if (channel_count == 1) {
+    for (; first_scalar + 4 <= block_size; first_scalar += 4) {
+      _mm_storeu_ps(output + first_scalar,
+                    _mm_mul_ps(_mm_cvtepi32_ps(load4(channels[0] + first_scalar)),
+                               vscale));
+    }
+  } else if (channel_count == 2) {
+    for (; first_scalar + 4 <= block_size; first_scalar += 4) {
+      const __m128 l = _mm_mul_ps(
+          _mm_cvtepi32_ps(load4(channels[0] + first_scalar)), vscale);
+      const __m128 r = _mm_mul_ps(
+          _mm_cvtepi32_ps(load4(channels[1] + first_scalar)), vscale);
+      _mm_storeu_ps(output + 2 * first_scalar, _mm_unpacklo_ps(l, r));
+      _mm_storeu_ps(output + 2 * first_scalar + 4, _mm_unpackhi_ps(l, r));
+    }
+  }
+#endif
+
+  size_t output_index = static_cast<size_t>(first_scalar) * channel_count;
+  for (uint32_t sample_idx = first_scalar; sample_idx < block_size; ++sample_idx) {
+    for (uint32_t channel_idx = 0; channel_idx < channel_count; ++channel_idx) {
+      output[output_index++] =
+          static_cast<float>(channels[channel_idx][sample_idx]) * scale;
+    }
+  }
+}
+
 } // namespace FLAC
 } // namespace Codec
 } // namespace PsyMP3
@@ -13,6 +13,33 @@ namespace PsyMP3 {
 namespace Codec {
 namespace FLAC {
 
+namespace {
+
+// Kernel selection by sample buffer type
+inline FixedKernel selectFixedKernelFor(int64_t *, uint32_t order,
+                                        uint32_t bit_depth) {
+  return selectFixedKernel(order, bit_depth);
+}
+
+inline FixedKernel32 selectFixedKernelFor(int32_t *, uint32_t order,
+                                          uint32_t bit_depth) {
+  return selectFixedKernel32(order, bit_depth);
+}
+
+inline LPCKernel selectLPCKernelFor(int64_t *, uint32_t order,
+                                    uint32_t coeff_precision,
+                                    uint32_t bit_depth) {
+  return selectLPCKernel(order, coeff_precision, bit_depth);
+}
+
+inline LPCKernel32 selectLPCKernelFor(int32_t *, uint32_t order,
+                                      uint32_t coeff_precision,
+                                      uint32_t bit_depth) {
+  return selectLPCKernel32(order, coeff_precision, bit_depth);
+}
+
+} // namespace
+
 SubframeDecoder::SubframeDecoder(BitstreamReader *reader,
                                  ResidualDecoder *residual)
     : m_reader(reader), m_residual(residual) {}
@@ -21,6 +48,24 @@ SubframeDecoder::~SubframeDecoder() {}
 
 bool SubframeDecoder::decodeSubframe(int64_t *output, uint32_t block_size,
                                      uint32_t bit_depth, bool is_side_channel) {
+  return decodeSubframeSamples(output, block_size, bit_depth, is_side_channel);
+}
+
+bool SubframeDecoder::decodeSubframe(int32_t *output, uint32_t block_size,
+                                     uint32_t bit_depth, bool is_side_channel) {
+  // A 32-bit frame's side channel carries 33-bit samples.
+  if (bit_depth > 31) {
+    Debug::log("subframe_decoder",
+               "Bit depth %u needs 64-bit sample buffers", bit_depth);
+    return false;
+  }
+  return decodeSubframeSamples(output, block_size, bit_depth, is_side_channel);
+}
+
+template <typename Sample>
+bool SubframeDecoder::decodeSubframeSamples(Sample *output, uint32_t block_size,
+                                            uint32_t bit_depth,
+                                            bool is_side_channel) {
   if (!output || block_size == 0) {
     Debug::log("subframe_decoder",
                "Invalid parameters: output=%p, block_size=%u", output,
@@ -69,8 +114,9 @@ bool SubframeDecoder::decodeSubframe(int64_t *output, uint32_t block_size,
   // unsigned type: left-shifting a negative sample is UB before C++20 and
   // trips UBSan.
   if (header.wasted_bits > 0) {
+    using Unsigned = typename std::make_unsigned<Sample>::type;
     for (uint32_t i = 0; i < block_size; i++) {
-      output[i] = static_cast<int64_t>(static_cast<uint64_t>(output[i]) << header.wasted_bits);
+      output[i] = static_cast<Sample>(static_cast<Unsigned>(output[i]) << header.wasted_bits);
     }
   }
 
@@ -186,7 +232,8 @@ bool SubframeDecoder::parseSubframeHeader(SubframeHeader &header,
 // Placeholder implementations for other methods (will be implemented in
 // subsequent subtasks)
 
-bool SubframeDecoder::decodeConstant(int64_t *output, uint32_t block_size,
+template <typename Sample>
+bool SubframeDecoder::decodeConstant(Sample *output, uint32_t block_size,
                                      const SubframeHeader &header) {
   // Read single unencoded sample at subframe bit depth (Requirement 3).
   // 64-bit read: side subframes of 32-bit streams use 33-bit samples.
@@ -201,7 +248,7 @@ bool SubframeDecoder::decodeConstant(int64_t *output, uint32_t block_size,
 
   // Replicate constant value to all block samples (Requirement 3)
   for (uint32_t i = 0; i < block_size; i++) {
-    output[i] = constant_value;
+    output[i] = static_cast<Sample>(constant_value);
   }
 
   // Note: Wasted bits padding will be applied by caller
@@ -209,7 +256,8 @@ bool SubframeDecoder::decodeConstant(int64_t *output, uint32_t block_size,
   return true;
 }
 
-bool SubframeDecoder::decodeVerbatim(int64_t *output, uint32_t block_size,
+template <typename Sample>
+bool SubframeDecoder::decodeVerbatim(Sample *output, uint32_t block_size,
                                      const SubframeHeader &header) {
   // Read unencoded samples sequentially at subframe bit depth (Requirement 3)
   Debug::log("subframe_decoder",
@@ -222,7 +270,7 @@ bool SubframeDecoder::decodeVerbatim(int64_t *output, uint32_t block_size,
       Debug::log("subframe_decoder", "Failed to read verbatim sample %u", i);
       return false;
     }
-    output[i] = sample;
+    output[i] = static_cast<Sample>(sample);
   }
 
   // Note: Wasted bits padding will be applied by caller
@@ -230,7 +278,8 @@ bool SubframeDecoder::decodeVerbatim(int64_t *output, uint32_t block_size,
   return true;
 }
 
-bool SubframeDecoder::decodeFixed(int64_t *output, uint32_t block_size,
+template <typename Sample>
+bool SubframeDecoder::decodeFixed(Sample *output, uint32_t block_size,
                                   const SubframeHeader &header) {
   uint32_t order = header.predictor_order;
 
@@ -256,6 +305,9 @@ bool SubframeDecoder::decodeFixed(int64_t *output, uint32_t block_size,
     return false;
   }
 
+  // Pick the reconstruction kernel for this order and bit depth
+  auto reconstruct = selectFixedKernelFor(output, order, header.bit_depth);
+
   // Read warm-up samples (Requirement 35)
   // These are unencoded samples at subframe bit depth (up to 33 bits for the
   // side subframe of a 32-bit stream)
@@ -265,7 +317,7 @@ bool SubframeDecoder::decodeFixed(int64_t *output, uint32_t block_size,
       Debug::log("subframe_decoder", "Failed to read warm-up sample %u", i);
       return false;
     }
-    output[i] = sample;
+    output[i] = static_cast<Sample>(sample);
   }
 
   // Decode residuals (Requirement 4)
@@ -284,8 +336,7 @@ bool SubframeDecoder::decodeFixed(int64_t *output, uint32_t block_size,
 
     if (success) {
       // Apply fixed predictor to reconstruct samples (Requirement 4, 54)
-      applyFixedPredictor(output, residuals, residual_count, order,
-                          header.bit_depth);
+      reconstruct(output, residuals, residual_count, order, header.bit_depth);
     }
 
     delete[] residuals;
@@ -299,7 +350,8 @@ bool SubframeDecoder::decodeFixed(int64_t *output, uint32_t block_size,
   return true;
 }
 
-bool SubframeDecoder::decodeLPC(int64_t *output, uint32_t block_size,
+template <typename Sample>
+bool SubframeDecoder::decodeLPC(Sample *output, uint32_t block_size,
                                 const SubframeHeader &header) {
   uint32_t order = header.predictor_order;
 
@@ -331,7 +383,7 @@ bool SubframeDecoder::decodeLPC(int64_t *output, uint32_t block_size,
       Debug::log("subframe_decoder", "Failed to read LPC warm-up sample %u", i);
       return false;
     }
-    output[i] = sample;
+    output[i] = static_cast<Sample>(sample);
   }
 
   // Parse coefficient precision (Requirement 28, 51)
@@ -368,6 +420,10 @@ bool SubframeDecoder::decodeLPC(int64_t *output, uint32_t block_size,
   Debug::log("subframe_decoder", "LPC parameters: precision=%u, shift=%d",
              coeff_precision, shift);
 
+  // Pick the reconstruction kernel for this order, precision and bit depth
+  auto reconstruct =
+      selectLPCKernelFor(output, order, coeff_precision, header.bit_depth);
+
   // Read predictor coefficients (Requirement 5, 51, 52)
   // Coefficients are read in reverse chronological order
   int32_t *coeffs = new int32_t[order];
@@ -396,8 +452,8 @@ bool SubframeDecoder::decodeLPC(int64_t *output, uint32_t block_size,
 
     if (success) {
       // Apply LPC predictor to reconstruct samples (Requirement 5, 51, 52, 54)
-      applyLPCPredictor(output, residuals, coeffs, residual_count, order,
-                        shift, header.bit_depth);
+      reconstruct(output, residuals, coeffs, residual_count, order, shift,
+                  header.bit_depth);
     }
 
     delete[] residuals;
@@ -414,119 +470,6 @@ bool SubframeDecoder::decodeLPC(int64_t *output, uint32_t block_size,
   return true;
 }
 
-void SubframeDecoder::applyFixedPredictor(int64_t *samples,
-                                          const int32_t *residuals,
-                                          uint32_t count, uint32_t order,
-                                          uint32_t bit_depth) {
-  // Apply FIXED predictor formulas (Requirement 4)
-  // Samples buffer already contains warm-up samples at positions [0..order-1]
-  // We need to reconstruct samples[order..order+count-1] using
-  // residuals[0..count-1]
-
-  // For a valid stream every reconstructed sample fits the subframe bit depth,
-  // so clamping is a no-op; on crafted input it stops samples from growing
-  // without bound and overflowing the int64 accumulator (signed-overflow UB).
-  const int64_t sample_min = -(INT64_C(1) << (bit_depth - 1));
-  const int64_t sample_max = (INT64_C(1) << (bit_depth - 1)) - 1;
-
-  // Sequential decoding requirement (Requirement 54)
-  for (uint32_t i = 0; i < count; i++) {
-    // Use 64-bit arithmetic to prevent overflow for high bit-depth files
-    // (24-bit and 32-bit FLAC). Coefficients can be as large as 6 and samples
-    // can be near INT32_MAX, so intermediate products can exceed 32 bits.
-    int64_t prediction = 0;
-    uint32_t sample_idx = order + i;
-
-    switch (order) {
-    case 0:
-      // Order 0: s[i] = residual[i] (no prediction)
-      prediction = 0;
-      break;
-
-    case 1:
-      // Order 1: s[i] = residual[i] + s[i-1]
-      prediction = samples[sample_idx - 1];
-      break;
-
-    case 2:
-      // Order 2: s[i] = residual[i] + 2*s[i-1] - s[i-2]
-      prediction = 2LL * samples[sample_idx - 1] - samples[sample_idx - 2];
-      break;
-
-    case 3:
-      // Order 3: s[i] = residual[i] + 3*s[i-1] - 3*s[i-2] + s[i-3]
-      prediction = 3LL * samples[sample_idx - 1] - 3LL * samples[sample_idx - 2] +
-                   samples[sample_idx - 3];
-      break;
-
-    case 4:
-      // Order 4: s[i] = residual[i] + 4*s[i-1] - 6*s[i-2] + 4*s[i-3] - s[i-4]
-      prediction = 4LL * samples[sample_idx - 1] - 6LL * samples[sample_idx - 2] +
-                   4LL * samples[sample_idx - 3] - samples[sample_idx - 4];
-      break;
-
-    default:
-      // Should never happen - validated earlier
-      prediction = 0;
-      break;
-    }
-
-    // Reconstruct sample: s[i] = prediction + residual[i]
-    // Samples stay in int64: side subframes of 32-bit streams hold 33-bit values
-    int64_t reconstructed = prediction + residuals[i];
-    if (reconstructed < sample_min) reconstructed = sample_min;
-    else if (reconstructed > sample_max) reconstructed = sample_max;
-    samples[sample_idx] = reconstructed;
-  }
-}
-
-void SubframeDecoder::applyLPCPredictor(int64_t *samples,
-                                        const int32_t *residuals,
-                                        const int32_t *coeffs, uint32_t count,
-                                        uint32_t order, int32_t shift,
-                                        uint32_t bit_depth) {
-  // Apply LPC predictor (Requirement 5, 51, 52)
-  // Samples buffer already contains warm-up samples at positions [0..order-1]
-  // We need to reconstruct samples[order..order+count-1] using
-  // residuals[0..count-1]
-
-  // For a valid stream every reconstructed sample fits the subframe bit depth,
-  // so clamping is a no-op; on crafted input it stops samples from growing
-  // without bound and overflowing the int64 accumulator (signed-overflow UB).
-  const int64_t sample_min = -(INT64_C(1) << (bit_depth - 1));
-  const int64_t sample_max = (INT64_C(1) << (bit_depth - 1)) - 1;
-
-  // Sequential decoding requirement (Requirement 54)
-  for (uint32_t i = 0; i < count; i++) {
-    uint32_t sample_idx = order + i;
-
-    // Compute LPC prediction using 64-bit arithmetic to prevent overflow
-    // (Requirement 5) prediction = sum(coeff[j] * sample[n-j-1]) >> shift
-    int64_t sum = 0;
-
-    // Apply coefficients in reverse chronological order (Requirement 52)
-    // coeff[0] applies to most recent sample (sample[n-1])
-    // coeff[1] applies to second most recent sample (sample[n-2])
-    // etc.
-    for (uint32_t j = 0; j < order; j++) {
-      // Multiply coefficient with corresponding past sample. Products stay
-      // within int64: |coeff| < 2^15 and |sample| <= 2^33, so each term is
-      // < 2^48 and a 32-term sum is < 2^53.
-      sum += static_cast<int64_t>(coeffs[j]) * samples[sample_idx - j - 1];
-    }
-
-    // Apply quantization level shift (arithmetic right shift)
-    int64_t prediction = sum >> shift;
-
-    // Add residual to get reconstructed sample (stays in int64; see the
-    // FIXED path).
-    int64_t reconstructed = prediction + residuals[i];
-    if (reconstructed < sample_min) reconstructed = sample_min;
-    else if (reconstructed > sample_max) reconstructed = sample_max;
-    samples[sample_idx] = reconstructed;
-  }
-}
-
 } // namespace FLAC
 } // namespace Codec
 } // namespace PsyMP3
@@ -55,6 +55,11 @@ AudioFrame MP2Codec::decode(const MediaChunk& chunk) {
     return decode_unlocked(chunk);
 }
 
+DecodedAudio MP2Codec::decodeInto(const MediaChunk& chunk, int16_t* out, size_t capacity) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return decodeInto_unlocked(chunk, out, capacity);
+}
+
 AudioFrame MP2Codec::flush() {
     return AudioFrame(); // Layer II frames are independent; nothing to drain
 }
@@ -64,6 +69,13 @@ void MP2Codec::reset() {
     reset_unlocked();
 }
 
+bool MP2Codec::resetForStream(const StreamInfo& stream_info) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stream_info = stream_info;
+    m_sample_rate = stream_info.sample_rate;
+    return initialize_unlocked();
+}
+
 bool MP2Codec::canDecode(const StreamInfo& stream_info) const {
     return stream_info.codec_type == "audio" && stream_info.codec_name == "mp2";
 }
@@ -76,22 +88,42 @@ bool MP2Codec::initialize_unlocked() {
 }
 
 AudioFrame MP2Codec::decode_unlocked(const MediaChunk& chunk) {
-    if (!m_initialized || chunk.data.size() < 4) {
+    signed short pcm[KJMP2_SAMPLES_PER_FRAME * 2];
+    const DecodedAudio decoded = decodeInto_unlocked(chunk, pcm, KJMP2_SAMPLES_PER_FRAME * 2);
+    if (decoded.samples == 0) {
         return AudioFrame();
     }
 
+    AudioFrame frame;
+    frame.samples.assign(pcm, pcm + decoded.samples);
+    frame.sample_rate = decoded.sample_rate;
+    frame.channels = decoded.channels;
+    frame.timestamp_samples = decoded.timestamp_samples;
+    if (decoded.sample_rate != 0) {
+        frame.timestamp_ms = (decoded.timestamp_samples * 1000ULL) / decoded.sample_rate;
+    }
+    return frame;
+}
+
+DecodedAudio MP2Codec::decodeInto_unlocked(const MediaChunk& chunk, int16_t* out, size_t capacity) {
+    if (!m_initialized || chunk.data.size() < 4) {
+        return DecodedAudio();
+    }
+
     // kjmp2 does no bounds checking and reads a full frame from the header's
     // computed size, so confirm the chunk actually holds that many bytes before
     // decoding (pcm==NULL returns the frame size without touching decoder state).
     unsigned long frame_size = kjmp2_decode_frame(&m_decoder, chunk.data.data(), nullptr);
     if (frame_size == 0 || frame_size > chunk.data.size()) {
-        return AudioFrame();
+        return DecodedAudio();
     }
 
-    // kjmp2 always emits 1152 interleaved stereo samples (mono is duplicated).
-    signed short pcm[KJMP2_SAMPLES_PER_FRAME * 2];
+    // kjmp2 always emits 1152 interleaved stereo samples (mono is duplicated);
+    // a short buffer takes them through the stack
+    signed short scratch[KJMP2_SAMPLES_PER_FRAME * 2];
+    signed short* pcm = capacity >= KJMP2_SAMPLES_PER_FRAME * 2 ? out : scratch;
     if (kjmp2_decode_frame(&m_decoder, chunk.data.data(), pcm) == 0) {
-        return AudioFrame();
+        return DecodedAudio();
     }
 
     int sr = kjmp2_get_sample_rate(chunk.data.data());
@@ -99,15 +131,17 @@ AudioFrame MP2Codec::decode_unlocked(const MediaChunk& chunk) {
         m_sample_rate = static_cast<uint32_t>(sr);
     }
 
-    AudioFrame frame;
-    frame.samples.assign(pcm, pcm + (KJMP2_SAMPLES_PER_FRAME * 2));
-    frame.sample_rate = m_sample_rate;
-    frame.channels = 2; // kjmp2 output is always stereo-interleaved
-    frame.timestamp_samples = chunk.timestamp_samples;
-    if (m_sample_rate != 0) {
-        frame.timestamp_ms = (chunk.timestamp_samples * 1000ULL) / m_sample_rate;
+    DecodedAudio decoded;
+    decoded.samples = KJMP2_SAMPLES_PER_FRAME * 2;
+    decoded.sample_rate = m_sample_rate;
+    decoded.channels = 2; // kjmp2 output is always stereo-interleaved
+    decoded.timestamp_samples = chunk.timestamp_samples;
+    decoded.trim(pcm, chunk.trim_leading_samples, chunk.trim_trailing_samples);
+    if (pcm != out) {
+        decoded.samples = std::min(decoded.samples, capacity);
+        std::memcpy(out, pcm, decoded.samples * sizeof(int16_t));
     }
-    return frame;
+    return decoded;
 }
 
 void MP2Codec::reset_unlocked() {
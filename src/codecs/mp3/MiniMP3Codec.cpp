@@ -37,6 +37,11 @@ AudioFrame MiniMP3Codec::decode(const MediaChunk& chunk) {
     return decode_unlocked(chunk);
 }
 
+DecodedAudio MiniMP3Codec::decodeInto(const MediaChunk& chunk, int16_t* out, size_t capacity) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return decodeInto_unlocked(chunk, out, capacity);
+}
+
 AudioFrame MiniMP3Codec::flush() {
     std::lock_guard<std::mutex> lock(m_mutex);
     return flush_unlocked();
@@ -47,6 +52,14 @@ void MiniMP3Codec::reset() {
     reset_unlocked();
 }
 
+bool MiniMP3Codec::resetForStream(const StreamInfo& stream_info) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stream_info = stream_info;
+    m_sample_rate = stream_info.sample_rate;
+    m_channels = stream_info.channels;
+    return initialize_unlocked();
+}
+
 bool MiniMP3Codec::canDecode(const StreamInfo& stream_info) const {
     return stream_info.codec_type == "audio" && stream_info.codec_name == "mp3";
 }
@@ -59,17 +72,33 @@ bool MiniMP3Codec::initialize_unlocked() {
 }
 
 AudioFrame MiniMP3Codec::decode_unlocked(const MediaChunk& chunk) {
-    if (!m_initialized) {
+    mp3d_sample_t pcm[MINIMP3_MAX_SAMPLES_PER_FRAME];
+    const DecodedAudio decoded = decodeInto_unlocked(chunk, pcm, MINIMP3_MAX_SAMPLES_PER_FRAME);
+    if (decoded.samples == 0) {
         return AudioFrame();
     }
 
-    if (chunk.data.empty()) {
-        return AudioFrame();
+    AudioFrame frame;
+    frame.samples.assign(pcm, pcm + decoded.samples);
+    frame.sample_rate = decoded.sample_rate;
+    frame.channels = decoded.channels;
+    frame.timestamp_samples = decoded.timestamp_samples;
+    if (decoded.sample_rate != 0) {
+        frame.timestamp_ms = (decoded.timestamp_samples * 1000ULL) / decoded.sample_rate;
     }
+    return frame;
+}
 
-    mp3dec_frame_info_t frame_info = {};
-    mp3d_sample_t pcm[MINIMP3_MAX_SAMPLES_PER_FRAME];
+DecodedAudio MiniMP3Codec::decodeInto_unlocked(const MediaChunk& chunk, int16_t* out, size_t capacity) {
+    if (!m_initialized || chunk.data.empty()) {
+        return DecodedAudio();
+    }
+
+    // minimp3 writes a whole frame; a short buffer takes it through the stack
+    mp3d_sample_t scratch[MINIMP3_MAX_SAMPLES_PER_FRAME];
+    mp3d_sample_t* pcm = capacity >= MINIMP3_MAX_SAMPLES_PER_FRAME ? out : scratch;
 
+    mp3dec_frame_info_t frame_info = {};
     int samples = mp3dec_decode_frame(
         &m_decoder,
         chunk.data.data(),
@@ -78,25 +107,25 @@ AudioFrame MiniMP3Codec::decode_unlocked(const MediaChunk& chunk) {
         &frame_info);
 
     if (samples == 0 || frame_info.channels == 0 || frame_info.hz == 0) {
-        return AudioFrame();
+        return DecodedAudio();
     }
 
     // Update stream info from decoded frame
     m_sample_rate = static_cast<uint32_t>(frame_info.hz);
     m_channels = static_cast<uint16_t>(frame_info.channels);
 
-    // Build AudioFrame with decoded PCM samples
-    size_t total_samples = static_cast<size_t>(samples) * frame_info.channels;
-    AudioFrame frame;
-    frame.samples.assign(pcm, pcm + total_samples);
-    frame.sample_rate = m_sample_rate;
-    frame.channels = m_channels;
-    frame.timestamp_samples = chunk.timestamp_samples;
-    if (m_sample_rate != 0) {
-        frame.timestamp_ms = (chunk.timestamp_samples * 1000ULL) / m_sample_rate;
+    DecodedAudio decoded;
+    decoded.samples = static_cast<size_t>(samples) * frame_info.channels;
+    decoded.sample_rate = m_sample_rate;
+    decoded.channels = m_channels;
+    decoded.timestamp_samples = chunk.timestamp_samples;
+    // Encoder delay/padding and seek pre-roll, as marked by MP3NullDemuxer
+    decoded.trim(pcm, chunk.trim_leading_samples, chunk.trim_trailing_samples);
+    if (pcm != out) {
+        decoded.samples = std::min(decoded.samples, capacity);
+        std::memcpy(out, pcm, decoded.samples * sizeof(int16_t));
     }
-
-    return frame;
+    return decoded;
 }
 
 AudioFrame MiniMP3Codec::flush_unlocked() {
@@ -338,6 +338,7 @@ void OpusCodec::reset()
         // Clear output buffers but don't deallocate
         m_output_buffer.clear();
         m_float_buffer.clear();
+        m_softclip_mem.clear();
         
         // Clear bounded output buffers (Requirement 7.6)
         clearOutputBuffers_unlocked();
@@ -632,10 +633,11 @@ AudioFrame OpusCodec::decodeAudioPacket_unlocked(const std::vector<uint8_t>& pac
     // Call libopus for decoding
 
     
-    // Performance Optimization: Use instance variables for frame size tracking
-    if (m_output_buffer.size() < 5760 * static_cast<size_t>(m_channels)) {
+    // Decode to float and convert once, with the header's output gain folded
+    // into the int16 conversion
+    if (m_float_buffer.size() < 5760 * static_cast<size_t>(m_channels)) {
        // Ensure buffer is large enough
-       m_output_buffer.resize(5760 * static_cast<size_t>(m_channels));
+       m_float_buffer.resize(5760 * static_cast<size_t>(m_channels));
     }
 
     int samples_decoded = 0;
@@ -643,20 +645,20 @@ AudioFrame OpusCodec::decodeAudioPacket_unlocked(const std::vector<uint8_t>& pac
     
     // Call the appropriate decoder
     if (m_use_multistream) {
-        samples_decoded = opus_multistream_decode(
+        samples_decoded = opus_multistream_decode_float(
             m_opus_ms_decoder,
             packet_data.empty() ? nullptr : packet_data.data(),
             packet_data.size(),
-            m_output_buffer.data(),
+            m_float_buffer.data(),
             decode_frame_size,
             0 // No FEC for now
         );
     } else {
-        samples_decoded = opus_decode(
+        samples_decoded = opus_decode_float(
             m_opus_decoder,
             packet_data.empty() ? nullptr : packet_data.data(),
             packet_data.size(),
-            m_output_buffer.data(),
+            m_float_buffer.data(),
             decode_frame_size,
             0 // No FEC for now
         );
@@ -675,13 +677,19 @@ AudioFrame OpusCodec::decodeAudioPacket_unlocked(const std::vector<uint8_t>& pac
     }
     
     size_t total_samples = static_cast<size_t>(samples_decoded) * m_channels;
-    if (total_samples > m_output_buffer.size()) {
-        Debug::log("opus", "Opus decoded samples (", total_samples, ") exceeds buffer size (", m_output_buffer.size(), ")");
+    if (total_samples > m_float_buffer.size()) {
+        Debug::log("opus", "Opus decoded samples (", total_samples, ") exceeds buffer size (", m_float_buffer.size(), ")");
         return frame;  // Return empty frame, don't crash
     }
     
     Debug::log("opus", "Opus decoded ", samples_decoded, " frames (", total_samples, " samples total)");
     
+    // opus_decode() soft-clips before its own int16 conversion; keep that
+    if (m_softclip_mem.size() != static_cast<size_t>(m_channels)) {
+        m_softclip_mem.assign(static_cast<size_t>(m_channels), 0.0f);
+    }
+    opus_pcm_soft_clip(m_float_buffer.data(), samples_decoded, m_channels, m_softclip_mem.data());
+    
     // Handle efficiency for variable frame sizes (Requirement 9.7)
     handleVariableFrameSizeEfficiently_unlocked(samples_decoded);
     
@@ -712,8 +720,9 @@ AudioFrame OpusCodec::decodeAudioPacket_unlocked(const std::vector<uint8_t>& pac
     frame.channels = m_channels;
 
     if (samples_to_keep > 0) {
-        frame.samples.assign(m_output_buffer.begin() + offset_samples,
-                             m_output_buffer.begin() + offset_samples + samples_to_keep);
+        frame.samples.resize(samples_to_keep);
+        Core::Utility::SampleConvert::floatToInt16(m_float_buffer.data() + offset_samples, samples_to_keep,
+                                                   frame.samples.data(), outputGainFactor_unlocked());
     }
     
     return frame;
@@ -728,11 +737,9 @@ AudioFrame OpusCodec::decodeAudioPacket_unlocked(const MediaChunk& chunk)
         AudioFrame frame = decodeAudioPacket_unlocked(empty_data);
 
         // PLC audio must go through the same post-processing as normal frames:
-        // output gain and decoded-sample accounting (pre-skip is now applied
-        // inline during decode). Skipping these played concealment frames at
-        // unattenuated volume (gain step) and undercounted m_samples_decoded,
+        // decoded-sample accounting (pre-skip and output gain are applied
+        // inline during decode). Skipping it undercounted m_samples_decoded,
         // skewing the end-of-stream trim.
-        applyOutputGain_unlocked(frame);
 
         uint64_t emitted_sample_frames = frame.getSampleFrameCount();
         if (emitted_sample_frames > 0) {
@@ -750,8 +757,6 @@ AudioFrame OpusCodec::decodeAudioPacket_unlocked(const MediaChunk& chunk)
     
     // Normal decoding
     AudioFrame frame = decodeAudioPacket_unlocked(chunk.data);
-    
-    applyOutputGain_unlocked(frame);
 
     size_t emitted_sample_frames = frame.getSampleFrameCount();
     uint64_t total_output_samples = m_samples_decoded.load() + emitted_sample_frames;
@@ -1755,43 +1760,16 @@ bool OpusCodec::initializeOpusDecoder_unlocked()
     }
 }
 
-void OpusCodec::applyOutputGain_unlocked(AudioFrame& frame)
+float OpusCodec::outputGainFactor_unlocked() const
 {
-    // Early return for zero gain case (most efficient - no processing needed)
+    // Zero gain is the common case; skip the pow
     if (m_output_gain == 0) {
-        return;
+        return 1.0f;
     }
     
-    // Early return for empty frame
-    if (frame.samples.empty()) {
-        return;
-    }
-    
-    Debug::log("opus", "Applying output gain: ", m_output_gain, " (Q7.8 format) to ", frame.samples.size(), " samples");
-    
+    // Q7.8 dB (RFC 7845 Section 5.1)
     const float gain_db = static_cast<float>(m_output_gain) / 256.0f;
-    const float gain_factor = std::pow(10.0f, gain_db / 20.0f);
-    
-    // Apply gain to all samples with proper clamping to prevent artifacts
-    for (int16_t& sample : frame.samples) {
-        // Convert to float for precise calculation
-        const float original_sample = static_cast<float>(sample);
-        const float adjusted_sample = original_sample * gain_factor;
-        
-        // Clamp to 16-bit signed integer range with proper rounding
-        // This prevents audio artifacts from overflow/underflow
-        if (adjusted_sample > 32767.0f) {
-            sample = 32767;
-        } else if (adjusted_sample < -32768.0f) {
-            sample = -32768;
-        } else {
-            // Round to nearest integer for better audio quality
-            sample = static_cast<int16_t>(adjusted_sample + (adjusted_sample >= 0.0f ? 0.5f : -0.5f));
-        }
-    }
-    
-    Debug::log("opus", "Output gain applied successfully - factor: ", gain_factor,
-              ", processed ", frame.samples.size(), " samples");
+    return std::pow(10.0f, gain_db / 20.0f);
 }
 
 bool OpusCodec::validateOpusPacket_unlocked(const std::vector<uint8_t>& packet_data)
@@ -265,10 +265,8 @@ size_t ALawCodec::convertSamples(const std::vector<uint8_t>& input_data,
     }
     
     try {
-        // Ensure output vector has sufficient capacity for optimal performance
-        // Use try-catch to handle potential memory allocation failures
-        output_samples.reserve(input_samples);
-        output_samples.clear();
+        // Size the output once; allocation failures are caught below
+        output_samples.resize(input_samples);
         
         // Convert each A-law sample to 16-bit PCM using lookup table
         // All 8-bit values (0x00-0xFF) are valid A-law inputs
@@ -276,13 +274,8 @@ size_t ALawCodec::convertSamples(const std::vector<uint8_t>& input_data,
         // Mono: [sample0, sample1, sample2, ...]
         // Stereo: [L0, R0, L1, R1, L2, R2, ...]
         // This maintains proper channel interleaving in the output
-        for (size_t i = 0; i < input_samples; ++i) {
-            const uint8_t alaw_sample = input_data[i];
-            
-            // Direct lookup - no validation needed as all 8-bit values are valid
-            const int16_t pcm_sample = ALAW_TO_PCM[alaw_sample];
-            output_samples.push_back(pcm_sample);
-        }
+        PsyMP3::Core::Utility::PCMConvert::lookupToInt16(input_data.data(), input_samples, ALAW_TO_PCM,
+                                                         output_samples.data());
         
         // Performance metrics for large conversions
         auto end_time = std::chrono::high_resolution_clock::now();
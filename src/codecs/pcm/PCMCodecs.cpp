@@ -54,6 +54,24 @@ void SimplePCMCodec::reset() {
 namespace Codec {
 namespace PCM {
 
+using PsyMP3::Core::Utility::PCMConvert;
+using PsyMP3::Core::Utility::PCMLayout;
+
+namespace {
+
+// Codec tags that name the sample layout: WAVE format tags, or the AIFF-C
+// compression type ChunkDemuxer passes for AIFF
+constexpr uint32_t PCM_TAG_WAVE_IEEE_FLOAT = 0x0003;
+constexpr uint32_t PCM_TAG_AIFF_NONE = 0x4E4F4E45; // "NONE", big-endian
+constexpr uint32_t PCM_TAG_AIFF_TWOS = 0x74776F73; // "twos", big-endian
+constexpr uint32_t PCM_TAG_AIFF_SOWT = 0x736F7774; // "sowt", little-endian
+constexpr uint32_t PCM_TAG_AIFF_FL32 = 0x666C3332; // "fl32", big-endian float
+constexpr uint32_t PCM_TAG_AIFF_FL64 = 0x666C3634; // "fl64", big-endian float
+constexpr uint32_t PCM_TAG_AIFF_FL32_UPPER = 0x464C3332; // "FL32", older spelling of "fl32"
+constexpr uint32_t PCM_TAG_AIFF_FL64_UPPER = 0x464C3634; // "FL64", older spelling of "fl64"
+
+} // namespace
+
 // PCMCodec implementation
 PCMCodec::PCMCodec(const StreamInfo& stream_info) 
     : SimplePCMCodec(stream_info) {
@@ -65,21 +83,13 @@ bool PCMCodec::canDecode(const StreamInfo& stream_info) const {
         return false;
     }
     
-    // Check supported bit depths
-    switch (stream_info.bits_per_sample) {
-        case 8:
-        case 16:
-        case 24:
-        case 32:
-            return true;
-        default:
-            return false;
-    }
+    // Check supported bit depths and sample types
+    PCMLayout layout;
+    return layoutFor(stream_info, layout);
 }
 
 size_t PCMCodec::convertSamples(const std::vector<uint8_t>& input_data, 
                                std::vector<int16_t>& output_samples) {
-    const uint8_t* input_ptr = input_data.data();
     size_t input_size = input_data.size();
     size_t bytes_per_sample = getBytesPerInputSample();
     
@@ -93,85 +103,79 @@ size_t PCMCodec::convertSamples(const std::vector<uint8_t>& input_data,
     size_t num_samples = input_size / bytes_per_sample;
     
     output_samples.resize(num_samples);
-    
-    switch (m_pcm_format) {
-        case PCMFormat::PCM_8_UNSIGNED:
-            for (size_t i = 0; i < num_samples; ++i) {
-                // Convert 8-bit unsigned to 16-bit signed. Scale by
-                // multiplication: shifting the negative half of the range
-                // left by 8 (the previous code) is UB in C++17.
-                output_samples[i] = static_cast<int16_t>((static_cast<int32_t>(input_ptr[i]) - 128) * 256);
-            }
-            break;
-            
-        case PCMFormat::PCM_16_SIGNED:
-            // Direct copy (little-endian assumed)
-            std::memcpy(output_samples.data(), input_ptr, num_samples * sizeof(int16_t));
-            break;
-            
-        case PCMFormat::PCM_24_SIGNED:
-            for (size_t i = 0; i < num_samples; ++i) {
-                // Build the 24-bit value (little-endian) in unsigned, then
-                // sign-extend from bit 23. Shifting a negative int8_t left
-                // by 16 (the previous code) is UB in C++17.
-                uint32_t raw = (static_cast<uint32_t>(input_ptr[i*3 + 2]) << 16) |
-                               (static_cast<uint32_t>(input_ptr[i*3 + 1]) << 8) |
-                                static_cast<uint32_t>(input_ptr[i*3]);
-                int32_t sample24 = (raw & 0x800000u) ? static_cast<int32_t>(raw | 0xFF000000u)
-                                                     : static_cast<int32_t>(raw);
-                output_samples[i] = static_cast<int16_t>(sample24 >> 8);
-            }
-            break;
-            
-        case PCMFormat::PCM_32_SIGNED:
-            for (size_t i = 0; i < num_samples; ++i) {
-                // Convert 32-bit to 16-bit
-                int32_t sample32;
-                std::memcpy(&sample32, &input_ptr[i*4], sizeof(int32_t));
-                output_samples[i] = static_cast<int16_t>(sample32 >> 16);
-            }
-            break;
-            
-        case PCMFormat::PCM_32_FLOAT:
-            for (size_t i = 0; i < num_samples; ++i) {
-                // Convert 32-bit float to 16-bit signed
-                float sample_float;
-                std::memcpy(&sample_float, &input_ptr[i*4], sizeof(float));
-                sample_float = std::clamp(sample_float, -1.0f, 1.0f);
-                output_samples[i] = static_cast<int16_t>(sample_float * 32767.0f);
-            }
-            break;
-    }
+    PCMConvert::toInt16(input_data.data(), num_samples, m_layout, output_samples.data());
     
     return num_samples;
 }
 
 size_t PCMCodec::getBytesPerInputSample() const {
-    return m_stream_info.bits_per_sample / 8;
+    return PCMConvert::bytesPerSample(m_layout);
 }
 
 void PCMCodec::detectPCMFormat() {
-    switch (m_stream_info.bits_per_sample) {
-        case 8:
-            m_pcm_format = PCMFormat::PCM_8_UNSIGNED;
+    if (!layoutFor(m_stream_info, m_layout)) {
+        m_layout = PCMLayout::S16LE; // Default fallback
+    }
+}
+
+bool PCMCodec::layoutFor(const StreamInfo& stream_info, PCMLayout& layout) {
+    const uint16_t bits = stream_info.bits_per_sample;
+    switch (stream_info.codec_tag) {
+        case PCM_TAG_AIFF_FL32:
+        case PCM_TAG_AIFF_FL32_UPPER:
+            layout = PCMLayout::F32BE;
+            return bits == 32;
+        case PCM_TAG_AIFF_FL64:
+        case PCM_TAG_AIFF_FL64_UPPER:
+            layout = PCMLayout::F64BE;
+            return bits == 64;
+        case PCM_TAG_AIFF_NONE:
+        case PCM_TAG_AIFF_TWOS:
+        case PCM_TAG_AIFF_SOWT: {
+            // AIFF samples are signed, 8-bit ones included
+            const bool big = stream_info.codec_tag != PCM_TAG_AIFF_SOWT;
+            switch (bits) {
+                case 8:
+                    layout = PCMLayout::S8;
+                    return true;
+                case 16:
+                    layout = big ? PCMLayout::S16BE : PCMLayout::S16LE;
+                    return true;
+                case 24:
+                    layout = big ? PCMLayout::S24BE : PCMLayout::S24LE;
+                    return true;
+                case 32:
+                    layout = big ? PCMLayout::S32BE : PCMLayout::S32LE;
+                    return true;
+                default:
+                    return false;
+            }
+        }
+        default:
             break;
+    }
+    
+    // WAVE: little-endian, unsigned when 8-bit
+    const bool is_float = stream_info.codec_tag == PCM_TAG_WAVE_IEEE_FLOAT;
+    switch (bits) {
+        case 8:
+            layout = PCMLayout::U8;
+            return true;
         case 16:
-            m_pcm_format = PCMFormat::PCM_16_SIGNED;
-            break;
+            layout = PCMLayout::S16LE;
+            return true;
         case 24:
-            m_pcm_format = PCMFormat::PCM_24_SIGNED;
-            break;
+            layout = PCMLayout::S24LE;
+            return true;
         case 32:
             // Check codec tag to distinguish between int32 and float32
-            if (m_stream_info.codec_tag == 0x0003) { // IEEE_FLOAT
-                m_pcm_format = PCMFormat::PCM_32_FLOAT;
-            } else {
-                m_pcm_format = PCMFormat::PCM_32_SIGNED;
-            }
-            break;
+            layout = is_float ? PCMLayout::F32LE : PCMLayout::S32LE;
+            return true;
+        case 64:
+            layout = PCMLayout::F64LE;
+            return is_float;
         default:
-            m_pcm_format = PCMFormat::PCM_16_SIGNED; // Default fallback
-            break;
+            return false;
     }
 }
 } // namespace PCM
@@ -760,14 +760,8 @@ bool VorbisCodec::synthesizeBlock_unlocked()
             Debug::log("vorbis", "Partial processing: ", samples_available, " samples (space limited)");
         }
         
-        // Convert float samples to 16-bit PCM (Requirement 1.5)
-        AudioFrame temp_frame;
-        convertFloatToPCM_unlocked(pcm_channels, samples_available, temp_frame);
-        
-        // Append to output buffer
-        m_output_buffer.insert(m_output_buffer.end(), 
-                               temp_frame.samples.begin(), 
-                               temp_frame.samples.end());
+        // Convert float samples to 16-bit PCM at the end of the output buffer (Requirement 1.5)
+        convertFloatToPCM_unlocked(pcm_channels, samples_available, m_output_buffer);
         
         // Tell libvorbis we consumed these samples (Requirement 2.5)
         vorbis_synthesis_read(&m_vorbis_dsp, samples_available);
@@ -848,16 +842,12 @@ void VorbisCodec::clearErrorState()
     Debug::log("vorbis", "Error state cleared");
 }
 
-void VorbisCodec::convertFloatToPCM_unlocked(float** pcm, int samples, AudioFrame& frame)
+void VorbisCodec::convertFloatToPCM_unlocked(float** pcm, int samples, std::vector<int16_t>& output)
 {
     // Convert libvorbis float output to 16-bit PCM (Requirement 1.5, 5.1, 5.2)
     // libvorbis outputs float samples in the range [-1.0, 1.0]
     // We convert to 16-bit signed PCM in the range [-32768, 32767]
     
-    frame.sample_rate = m_sample_rate;
-    frame.channels = m_channels;
-    frame.samples.clear();
-    
     // Early return for edge cases
     if (samples <= 0 || m_channels <= 0 || pcm == nullptr) {
         Debug::log("vorbis", "convertFloatToPCM_unlocked: Invalid parameters - samples=", 
@@ -865,27 +855,23 @@ void VorbisCodec::convertFloatToPCM_unlocked(float** pcm, int samples, AudioFram
         return;
     }
     
-    // Use the static interleaveChannels helper for the actual conversion
-    // This handles proper channel interleaving according to Vorbis conventions
-    // (Requirement 5.5, 5.7)
+    // Grow the output once and convert straight into the new tail
     // Handle memory allocation failures (Requirement 8.6)
+    const size_t offset = output.size();
     try {
-        interleaveChannels(pcm, samples, m_channels, frame.samples);
+        output.resize(offset + static_cast<size_t>(samples) * static_cast<size_t>(m_channels));
     } catch (const std::bad_alloc& e) {
         m_last_error = "Memory allocation failed during PCM conversion: " + std::string(e.what());
         Debug::log("vorbis", m_last_error);
         Debug::log("error", "VorbisCodec: ", m_last_error);
-        frame.samples.clear();
+        output.resize(offset);
         throw BadFormatException(m_last_error);
     }
     
-    // Verify output consistency (Requirement 5.1, 5.2, 5.3, 5.5)
-    // The number of samples should be exactly samples * channels
-    const size_t expected_samples = static_cast<size_t>(samples) * static_cast<size_t>(m_channels);
-    if (frame.samples.size() != expected_samples) {
-        Debug::log("vorbis", "WARNING: Sample count mismatch - expected ", expected_samples,
-                   " got ", frame.samples.size());
-    }
+    // Vorbis channel order is the interleaved order (Requirement 5.5, 5.7)
+    Core::Utility::SampleConvert::planarFloatToInt16(pcm, static_cast<size_t>(samples),
+                                                     static_cast<unsigned>(m_channels),
+                                                     output.data() + offset);
 }
 
 // ========== Static Float to PCM Conversion Helpers ==========
@@ -895,37 +881,11 @@ int16_t VorbisCodec::floatToInt16(float sample)
     // Convert a single float sample to 16-bit PCM with proper clamping
     // (Requirement 1.5, 5.1, 5.2)
     //
-    // libvorbis outputs float samples nominally in [-1.0, 1.0]
-    // We convert to 16-bit signed PCM in [-32768, 32767]
-    //
-    // Clamping is essential because:
-    // 1. libvorbis can produce samples slightly outside [-1.0, 1.0] due to
-    //    floating-point precision in the MDCT and windowing operations
-    // 2. Some encoders may produce slightly out-of-range values
-    // 3. Prevents integer overflow during conversion
-    
-    // Clamp to valid range first
-    if (sample > 1.0f) {
-        sample = 1.0f;
-    } else if (sample < -1.0f) {
-        sample = -1.0f;
-    }
-    
-    // Scale to 16-bit range
-    // Using 32767.0f ensures positive samples map to [0, 32767]
-    // and negative samples map to [-32767, 0]
-    // The asymmetry of int16_t (-32768 to 32767) means -1.0f maps to -32767,
-    // not -32768, which is standard practice for audio conversion
-    int32_t scaled = static_cast<int32_t>(sample * 32767.0f);
-    
-    // Final safety clamp (handles floating-point edge cases)
-    if (scaled > 32767) {
-        scaled = 32767;
-    } else if (scaled < -32768) {
-        scaled = -32768;
-    }
-    
-    return static_cast<int16_t>(scaled);
+    // libvorbis can produce samples slightly outside [-1.0, 1.0] due to
+    // floating-point precision in the MDCT and windowing operations, so
+    // the result saturates. Scaling is by 32768 with rounding to nearest,
+    // the same as every other float-to-int16 path in the player.
+    return Core::Utility::SampleConvert::floatToInt16(sample);
 }
 
 void VorbisCodec::interleaveChannels(float** pcm, int samples, int channels,
@@ -946,21 +906,15 @@ void VorbisCodec::interleaveChannels(float** pcm, int samples, int channels,
     //
     // The output is interleaved: [ch0_s0, ch1_s0, ..., chN_s0, ch0_s1, ch1_s1, ...]
     
+    output.clear();
     if (samples <= 0 || channels <= 0 || pcm == nullptr) {
         return;
     }
     
-    // Reserve exact space needed
-    const size_t total_samples = static_cast<size_t>(samples) * static_cast<size_t>(channels);
-    output.clear();
-    output.reserve(total_samples);
-    
-    // Interleave: for each sample position, output all channels in order
-    for (int i = 0; i < samples; i++) {
-        for (int ch = 0; ch < channels; ch++) {
-            output.push_back(floatToInt16(pcm[ch][i]));
-        }
-    }
+    output.resize(static_cast<size_t>(samples) * static_cast<size_t>(channels));
+    Core::Utility::SampleConvert::planarFloatToInt16(pcm, static_cast<size_t>(samples),
+                                                     static_cast<unsigned>(channels),
+                                                     output.data());
 }
 
 void VorbisCodec::handleVariableBlockSizes_unlocked(const vorbis_block* block)
@@ -0,0 +1,206 @@
+/*
+ * AudioTelemetry.cpp - Lock-free timing and underrun counters for the audio pipeline.
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill II <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#include "psymp3.h"
+
+namespace PsyMP3 {
+namespace Core {
+
+namespace {
+// Gaps longer than this between callbacks mean the device was paused, not
+// that the callback was late; they would only swamp the jitter histogram.
+constexpr uint64_t kMaxCallbackIntervalUs = 1000000;
+
+// Single-writer increment: no lock-prefixed read-modify-write needed.
+inline void bump(std::atomic<uint64_t>& counter, uint64_t by = 1)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+}
+
+void writeHistogram(std::ostream& out, const char* name, const char* unit,
+                    const Log2Histogram::Snapshot& h)
+{
+    out << name << ": n=" << h.count;
+    if (h.count) {
+        out << " mean=" << static_cast<uint64_t>(h.mean() + 0.5) << unit
+            << " p50<=" << h.percentile(0.50) << unit
+            << " p99<=" << h.percentile(0.99) << unit
+            << " max=" << h.max << unit;
+    }
+    out << "\n";
+    for (size_t i = 0; i < Log2Histogram::kBuckets; ++i) {
+        if (!h.buckets[i]) continue;
+        const uint64_t lo = i == 0 ? 0 : (uint64_t{1} << (i - 1));
+        out << "  [" << lo << ", ";
+        if (i + 1 < Log2Histogram::kBuckets) {
+            out << (uint64_t{1} << i) << ")";
+        } else {
+            out << "inf)";
+        }
+        out << " " << unit << ": " << h.buckets[i] << "\n";
+    }
+}
+} // namespace
+
+size_t Log2Histogram::bucketFor(uint64_t value)
+{
+    size_t bits = 0;
+    while (value) {
+        ++bits;
+        value >>= 1;
+    }
+    return std::min(bits, kBuckets - 1);
+}
+
+void Log2Histogram::record(uint64_t value)
+{
+    bump(m_buckets[bucketFor(value)]);
+    bump(m_count);
+    bump(m_sum, value);
+    if (value > m_max.load(std::memory_order_relaxed)) {
+        m_max.store(value, std::memory_order_relaxed);
+    }
+}
+
+Log2Histogram::Snapshot Log2Histogram::snapshot() const
+{
+    Snapshot s;
+    for (size_t i = 0; i < kBuckets; ++i) {
+        s.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+    }
+    s.count = m_count.load(std::memory_order_relaxed);
+    s.sum = m_sum.load(std::memory_order_relaxed);
+    s.max = m_max.load(std::memory_order_relaxed);
+    return s;
+}
+
+void Log2Histogram::reset()
+{
+    for (auto& b : m_buckets) {
+        b.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+uint64_t Log2Histogram::Snapshot::percentile(double p) const
+{
+    // Sum the buckets rather than trusting `count`: a concurrent snapshot may
+    // have read them at slightly different moments.
+    uint64_t total = 0;
+    for (uint64_t b : buckets) total += b;
+    if (total == 0) {
+        return 0;
+    }
+    const uint64_t rank = static_cast<uint64_t>(std::ceil(std::clamp(p, 0.0, 1.0) * total));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+        seen += buckets[i];
+        if (seen >= rank && buckets[i]) {
+            if (i == 0) return 0;
+            // No sample exceeds max, which also bounds the open-ended top bucket.
+            return i + 1 < kBuckets ? std::min(uint64_t{1} << i, max) : max;
+        }
+    }
+    return max;
+}
+
+void AudioTelemetry::recordCallback(uint64_t now_us, uint64_t duration_us, uint64_t fill_ms,
+                                    uint64_t dsp_us, bool short_fill)
+{
+    CallbackBlock& cb = m_callback;
+    cb.duration_us.record(duration_us);
+    cb.fill_ms.record(fill_ms);
+    cb.dsp_us.record(dsp_us);
+    if (cb.last_start_us != 0 && now_us > cb.last_start_us &&
+        now_us - cb.last_start_us <= kMaxCallbackIntervalUs) {
+        cb.interval_us.record(now_us - cb.last_start_us);
+    }
+    cb.last_start_us = now_us;
+
+    if (short_fill) {
+        bump(cb.underruns);
+        if (!cb.in_underrun) {
+            cb.in_underrun = true;
+            cb.underrun_start_us = now_us;
+            bump(cb.underrun_episodes);
+        }
+    } else if (cb.in_underrun) {
+        // The episode lasted from the first short callback to this full one.
+        cb.in_underrun = false;
+        const uint64_t length = now_us - cb.underrun_start_us;
+        bump(cb.underrun_us, length);
+        if (length > cb.longest_underrun_us.load(std::memory_order_relaxed)) {
+            cb.longest_underrun_us.store(length, std::memory_order_relaxed);
+        }
+    }
+}
+
+void AudioTelemetry::recordDecode(uint64_t latency_us)
+{
+    m_decoder.latency_us.record(latency_us);
+}
+
+void AudioTelemetry::recordSeek(bool history_hit)
+{
+    bump(history_hit ? m_seek.history_hits : m_seek.history_misses);
+}
+
+AudioTelemetry::Snapshot AudioTelemetry::snapshot() const
+{
+    Snapshot s;
+    s.callback_us = m_callback.duration_us.snapshot();
+    s.interval_us = m_callback.interval_us.snapshot();
+    s.fill_ms = m_callback.fill_ms.snapshot();
+    s.dsp_us = m_callback.dsp_us.snapshot();
+    s.decode_us = m_decoder.latency_us.snapshot();
+    s.underruns = m_callback.underruns.load(std::memory_order_relaxed);
+    s.underrun_episodes = m_callback.underrun_episodes.load(std::memory_order_relaxed);
+    s.underrun_us = m_callback.underrun_us.load(std::memory_order_relaxed);
+    s.longest_underrun_us = m_callback.longest_underrun_us.load(std::memory_order_relaxed);
+    s.history_seek_hits = m_seek.history_hits.load(std::memory_order_relaxed);
+    s.history_seek_misses = m_seek.history_misses.load(std::memory_order_relaxed);
+    return s;
+}
+
+void AudioTelemetry::reset()
+{
+    m_callback.duration_us.reset();
+    m_callback.interval_us.reset();
+    m_callback.fill_ms.reset();
+    m_callback.dsp_us.reset();
+    m_callback.underruns.store(0, std::memory_order_relaxed);
+    m_callback.underrun_episodes.store(0, std::memory_order_relaxed);
+    m_callback.underrun_us.store(0, std::memory_order_relaxed);
+    m_callback.longest_underrun_us.store(0, std::memory_order_relaxed);
+    m_callback.last_start_us = 0;
+    m_callback.underrun_start_us = 0;
+    m_callback.in_underrun = false;
+    m_decoder.latency_us.reset();
+    m_seek.history_hits.store(0, std::memory_order_relaxed);
+    m_seek.history_misses.store(0, std::memory_order_relaxed);
+}
+
+void AudioTelemetry::Snapshot::writeReport(std::ostream& out) const
+{
+    out << "Underruns: " << underruns << " short callbacks in " << underrun_episodes
+        << " episodes, " << underrun_us / 1000 << " ms total, longest "
+        << longest_underrun_us / 1000 << " ms\n";
+    out << "Seeks: " << history_seek_hits << " served from PCM history, "
+        << history_seek_misses << " re-decoded\n";
+    writeHistogram(out, "Callback duration", "us", callback_us);
+    writeHistogram(out, "Callback interval", "us", interval_us);
+    writeHistogram(out, "Queued audio at callback", "ms", fill_ms);
+    writeHistogram(out, "Volume+EQ cost", "us", dsp_us);
+    writeHistogram(out, "Decoder read latency", "us", decode_us);
+}
+
+} // namespace Core
+} // namespace PsyMP3
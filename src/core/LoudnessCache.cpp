@@ -0,0 +1,140 @@
+/*
+ * LoudnessCache.cpp - Persistent per-file loudness measurements.
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill II <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#include "psymp3.h"
+
+namespace PsyMP3 {
+namespace Core {
+
+namespace {
+constexpr const char* kLoudnessCacheHeader = "# PsyMP3 loudness cache v1";
+} // namespace
+
+LoudnessCache::LoudnessCache(std::string file_path)
+    : m_file_path(std::move(file_path))
+{
+}
+
+size_t LoudnessCache::load()
+{
+    std::unordered_map<std::string, Record> records;
+    std::ifstream f(System::pathFromUtf8(m_file_path));
+    std::string line;
+    if (f && std::getline(f, line) && line == kLoudnessCacheHeader) {
+        while (std::getline(f, line)) {
+            // lufs \t peak \t size \t mtime \t path
+            std::istringstream fields(line);
+            Record record;
+            std::string path;
+            if (!(fields >> record.entry.integrated_lufs >> record.entry.true_peak
+                         >> record.size >> record.mtime)) {
+                continue;
+            }
+            fields.get(); // the tab before the path
+            if (!std::getline(fields, path) || path.empty()) {
+                continue;
+            }
+            records[path] = record;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_records = std::move(records);
+    m_dirty = false;
+    Debug::log("loudness", "LoudnessCache: loaded ", m_records.size(), " entries from ", m_file_path);
+    return m_records.size();
+}
+
+bool LoudnessCache::save()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_dirty) {
+        return true;
+    }
+    const std::string tmp_path = m_file_path + ".tmp";
+    {
+        std::ofstream f(System::pathFromUtf8(tmp_path), std::ios::out | std::ios::trunc);
+        if (!f) {
+            Debug::log("loudness", "LoudnessCache: cannot write ", tmp_path);
+            return false;
+        }
+        f << kLoudnessCacheHeader << "\n" << std::setprecision(17);
+        for (const auto& [path, record] : m_records) {
+            f << record.entry.integrated_lufs << '\t' << record.entry.true_peak << '\t'
+              << record.size << '\t' << record.mtime << '\t' << path << '\n';
+        }
+        if (!f.flush()) {
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(System::pathFromUtf8(tmp_path), System::pathFromUtf8(m_file_path), ec);
+    if (ec) {
+        Debug::log("loudness", "LoudnessCache: cannot replace ", m_file_path, ": ", ec.message());
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
+
+std::optional<LoudnessCache::Entry> LoudnessCache::lookup(const std::string& path) const
+{
+    uint64_t size = 0;
+    int64_t mtime = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_records.find(path) == m_records.end()) {
+            return std::nullopt;
+        }
+    }
+    // Stat outside the lock; it may touch a slow disk.
+    if (!System::fileStamp(path, size, mtime)) {
+        return std::nullopt;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_records.find(path);
+    if (it == m_records.end() || it->second.size != size || it->second.mtime != mtime) {
+        return std::nullopt;
+    }
+    return it->second.entry;
+}
+
+bool LoudnessCache::store(const std::string& path, const Entry& entry)
+{
+    if (path.find('\n') != std::string::npos) {
+        return false;
+    }
+    Record record;
+    record.entry = entry;
+    if (!System::fileStamp(path, record.size, record.mtime)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_records[path] = record;
+    m_dirty = true;
+    return true;
+}
+
+size_t LoudnessCache::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_records.size();
+}
+
+float LoudnessCache::playbackGain(const Entry& entry)
+{
+    double gain = std::pow(10.0, (kReferenceLufs - entry.integrated_lufs) / 20.0);
+    if (entry.true_peak > 0.0) {
+        gain = std::min(gain, 1.0 / entry.true_peak);
+    }
+    return static_cast<float>(gain);
+}
+
+} // namespace Core
+} // namespace PsyMP3
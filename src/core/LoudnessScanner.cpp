@@ -0,0 +1,201 @@
+/*
+ * LoudnessScanner.cpp - Background EBU R128 loudness scanning for ReplayGain.
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill II <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#include "psymp3.h"
+
+namespace PsyMP3 {
+namespace Core {
+
+namespace {
+// Frames decoded per read; a few thousand keeps per-call overhead in the
+// codecs negligible and the buffer in L2.
+constexpr size_t kScanChunkFrames = 4096;
+
+bool isRemoteUri(const std::string& path)
+{
+    return path.find("://") != std::string::npos;
+}
+} // namespace
+
+LoudnessScanner::LoudnessScanner(LoudnessCache& cache, StreamFactory open_stream, unsigned int threads)
+    : m_cache(cache),
+      m_open_stream(std::move(open_stream))
+{
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    m_workers.reserve(threads);
+    for (unsigned int i = 0; i < threads; ++i) {
+        m_workers.emplace_back(&LoudnessScanner::workerLoop, this, i);
+    }
+}
+
+LoudnessScanner::~LoudnessScanner()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_queue.clear();
+        m_generation.fetch_add(1);
+    }
+    m_work_cv.notify_all();
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+size_t LoudnessScanner::enqueue(const std::vector<std::string>& paths)
+{
+    size_t queued = 0;
+    size_t cached = 0;
+    std::vector<std::string> fresh;
+    for (const auto& path : paths) {
+        if (path.empty() || isRemoteUri(path)) {
+            continue;
+        }
+        if (m_cache.lookup(path)) {
+            ++cached;
+            continue;
+        }
+        fresh.push_back(path);
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cached += cached;
+        for (auto& path : fresh) {
+            if (m_pending.insert(path).second) {
+                m_queue.push_back(std::move(path));
+                ++queued;
+            }
+        }
+    }
+    m_work_cv.notify_all();
+    Debug::log("loudness", "LoudnessScanner: queued ", queued, " files, ", cached, " already cached");
+    return queued;
+}
+
+void LoudnessScanner::cancel()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& path : m_queue) {
+            m_pending.erase(path);
+        }
+        m_queue.clear();
+        m_generation.fetch_add(1);
+    }
+    m_idle_cv.notify_all();
+}
+
+void LoudnessScanner::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle_cv.wait(lock, [this] { return m_queue.empty() && m_active == 0; });
+}
+
+LoudnessScanner::Progress LoudnessScanner::progress() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Progress p;
+    p.queued = m_queue.size() + m_active;
+    p.done = m_done;
+    p.failed = m_failed;
+    p.cached = m_cached;
+    p.idle = m_queue.empty() && m_active == 0;
+    return p;
+}
+
+std::optional<LoudnessCache::Entry> LoudnessScanner::measure(Stream& stream,
+                                                             const std::function<bool()>& keep_going)
+{
+    const unsigned int rate = stream.getRate();
+    const unsigned int channels = stream.getChannels();
+    if (rate == 0 || channels == 0 || channels > static_cast<unsigned int>(DSP::LoudnessMeter::kMaxChannels)) {
+        return std::nullopt;
+    }
+    DSP::LoudnessMeter meter;
+    meter.configure(rate, channels);
+    std::vector<float> chunk(kScanChunkFrames * channels);
+    while (!stream.eof()) {
+        if (keep_going && !keep_going()) {
+            return std::nullopt;
+        }
+        const size_t samples = stream.getDataFloat(chunk.size(), chunk.data());
+        if (samples == 0) {
+            break;
+        }
+        meter.process(chunk.data(), samples / channels);
+    }
+    if (meter.frames() == 0) {
+        return std::nullopt;
+    }
+    LoudnessCache::Entry entry;
+    entry.integrated_lufs = meter.integratedLufs();
+    entry.true_peak = meter.truePeak();
+    return entry;
+}
+
+void LoudnessScanner::workerLoop(unsigned int index)
+{
+    System::setThisThreadName("loudness-" + std::to_string(index));
+    System::setThreadPriority(System::ThreadPriority::Low);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_work_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+        if (m_stop) {
+            return;
+        }
+        std::string path = std::move(m_queue.front());
+        m_queue.pop_front();
+        ++m_active;
+        const uint64_t generation = m_generation.load();
+        lock.unlock();
+
+        std::optional<LoudnessCache::Entry> entry;
+        try {
+            std::unique_ptr<Stream> stream = m_open_stream(path);
+            if (stream) {
+                entry = measure(*stream, [this, generation] { return m_generation.load() == generation; });
+            }
+        } catch (const std::exception& e) {
+            Debug::log("loudness", "LoudnessScanner: cannot scan ", path, ": ", e.what());
+        }
+        const bool abandoned = m_generation.load() != generation;
+        const bool stored = !abandoned && entry && m_cache.store(path, *entry);
+        if (stored) {
+            Debug::log("loudness", "LoudnessScanner: ", path, ": ", entry->integrated_lufs,
+                       " LUFS, true peak ", entry->true_peak);
+        }
+
+        lock.lock();
+        m_pending.erase(path);
+        if (!abandoned) {
+            ++(stored ? m_done : m_failed);
+        }
+        m_unsaved += stored ? 1 : 0;
+        // Still counted as active while saving, so waitIdle() returns with
+        // the results on disk.
+        if (m_unsaved > 0 && ((m_queue.empty() && m_active == 1) || m_unsaved >= kSaveInterval)) {
+            m_unsaved = 0;
+            lock.unlock();
+            m_cache.save();
+            lock.lock();
+        }
+        --m_active;
+        if (m_queue.empty() && m_active == 0) {
+            m_idle_cv.notify_all();
+        }
+    }
+}
+
+} // namespace Core
+} // namespace PsyMP3
@@ -0,0 +1,79 @@
+/*
+ * PcmHistory.cpp - Window of recently decoded PCM for seeks without re-decoding.
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill II <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#include "psymp3.h"
+
+namespace PsyMP3 {
+namespace Core {
+
+void PcmHistory::configure(unsigned int channels, size_t capacity_frames)
+{
+    std::vector<float> kept;
+    uint64_t kept_from = 0;
+    if (channels == m_channels && enabled() && capacity_frames > 0) {
+        kept_from = std::max(beginFrame(), endFrame() - std::min<uint64_t>(endFrame(), capacity_frames));
+        copyFrom(kept_from, kept);
+    }
+    m_channels = channels;
+    m_buffer.assign(channels ? capacity_frames * channels : 0, 0.0f);
+    m_buffer.shrink_to_fit();
+    reset(kept_from);
+    append(kept.data(), kept.size());
+}
+
+void PcmHistory::reset(uint64_t frame)
+{
+    m_begin = m_end = frame * m_channels;
+}
+
+void PcmHistory::append(const float* samples, size_t count)
+{
+    const size_t capacity = m_buffer.size();
+    if (capacity == 0 || count == 0) {
+        return;
+    }
+    // Only the newest `capacity` samples can survive.
+    if (count > capacity) {
+        m_end += count - capacity;
+        samples += count - capacity;
+        count = capacity;
+    }
+    size_t pos = static_cast<size_t>(m_end % capacity);
+    const size_t first = std::min(count, capacity - pos);
+    std::copy(samples, samples + first, m_buffer.begin() + pos);
+    std::copy(samples + first, samples + count, m_buffer.begin());
+    m_end += count;
+    if (m_end - m_begin > capacity) {
+        // Keep the window frame-aligned so beginFrame() is exact.
+        m_begin = m_end - capacity;
+        m_begin += (m_channels - m_begin % m_channels) % m_channels;
+    }
+}
+
+bool PcmHistory::copyFrom(uint64_t frame, std::vector<float>& out) const
+{
+    if (!enabled()) {
+        return false;
+    }
+    const uint64_t from = frame * m_channels;
+    if (from < m_begin || from > m_end) {
+        return false;
+    }
+    const size_t capacity = m_buffer.size();
+    const size_t count = static_cast<size_t>(m_end - from);
+    const size_t pos = static_cast<size_t>(from % capacity);
+    const size_t first = std::min(count, capacity - pos);
+    out.resize(count);
+    std::copy(m_buffer.begin() + pos, m_buffer.begin() + pos + first, out.begin());
+    std::copy(m_buffer.begin(), m_buffer.begin() + (count - first), out.begin() + first);
+    return true;
+}
+
+} // namespace Core
+} // namespace PsyMP3
@@ -0,0 +1,145 @@
+/*
+ * ReadAheadPolicy.cpp - Self-tuning decoder read-ahead for the PCM queue.
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill II <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#include "psymp3.h"
+
+namespace PsyMP3 {
+namespace Core {
+
+namespace {
+// The target covers this many worst-case refill gaps...
+constexpr double kCoverFactor = 4.0;
+// ...each padded by this much decoder wake-up / scheduling latency.
+constexpr double kSchedulingSlackMs = 10.0;
+// Decode cost is smoothed per chunk with this weight, and capped when
+// stretching the target so a codec at or beyond real time cannot divide by 0.
+constexpr double kCostAlpha = 0.1;
+constexpr double kMaxCost = 0.9;
+// Drain rate is only sampled over spans at least this long, smoothed, and
+// kept within a sane band around nominal; anything faster is a seek.
+constexpr uint64_t kMinDrainSpanNs = 50'000'000;
+constexpr uint64_t kMaxDrainSpanNs = 1'000'000'000;
+constexpr double kDrainAlpha = 0.2;
+constexpr double kMinDrainRatio = 0.5;
+constexpr double kMaxDrainRatio = 4.0;
+} // namespace
+
+ReadAheadPolicy::Bounds ReadAheadPolicy::boundsForSource(const std::string& uri)
+{
+    const size_t sep = uri.find("://");
+    if (sep == std::string::npos || sep == 0) {
+        return kLocalBounds;
+    }
+    std::string scheme = uri.substr(0, sep);
+    std::transform(scheme.begin(), scheme.end(), scheme.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return scheme == "file" ? kLocalBounds : kRemoteBounds;
+}
+
+size_t ReadAheadPolicy::chunkSamplesFor(unsigned int rate, unsigned int channels)
+{
+    const size_t frames = std::max<size_t>(256, static_cast<size_t>(rate) * kChunkMs / 1000);
+    return frames * std::max(1u, channels);
+}
+
+void ReadAheadPolicy::configure(unsigned int rate, unsigned int channels, Bounds bounds)
+{
+    m_rate = rate ? rate : 44100;
+    m_channels = channels ? channels : 2;
+    if (m_ceiling_ms != 0) {
+        bounds.max_ms = std::min(bounds.max_ms, m_ceiling_ms);
+    }
+    bounds.min_ms = std::min(bounds.min_ms, bounds.max_ms);
+    m_bounds = bounds;
+
+    m_cost = 0.0;
+    m_peak_stall_ms = 0.0;
+    m_peak_chunk_ms = 0.0;
+    m_drain_ratio = 1.0;
+    m_drain_valid = false;
+    updateTarget();
+}
+
+void ReadAheadPolicy::setCeiling(unsigned int max_ms)
+{
+    m_ceiling_ms = max_ms;
+    if (m_ceiling_ms != 0 && m_bounds.max_ms > m_ceiling_ms) {
+        m_bounds.max_ms = m_ceiling_ms;
+        m_bounds.min_ms = std::min(m_bounds.min_ms, m_bounds.max_ms);
+        updateTarget();
+    }
+}
+
+void ReadAheadPolicy::recordChunk(uint64_t audio_ns, uint64_t cpu_ns, uint64_t wall_ns)
+{
+    cpu_ns = std::min(cpu_ns, wall_ns);
+    const double wall_ms = static_cast<double>(wall_ns) / 1e6;
+    const double stall_ms = static_cast<double>(wall_ns - cpu_ns) / 1e6;
+    const double audio_ms = static_cast<double>(audio_ns) / 1e6;
+
+    // Decay by how much audio passed, not by call count: EOF and short reads
+    // produce little audio and should not age the peaks as fast.
+    const double decay = std::exp2(-audio_ms / kPeakHalfLifeMs);
+    m_peak_stall_ms = std::max(stall_ms, m_peak_stall_ms * decay);
+    m_peak_chunk_ms = std::max(wall_ms, m_peak_chunk_ms * decay);
+
+    if (audio_ns > 0) {
+        const double cost = std::min(4.0, static_cast<double>(cpu_ns) / static_cast<double>(audio_ns));
+        m_cost += kCostAlpha * (cost - m_cost);
+    }
+    updateTarget();
+}
+
+void ReadAheadPolicy::recordDrain(uint64_t frames_played, uint64_t now_ns)
+{
+    if (!m_drain_valid || frames_played < m_drain_frames || now_ns < m_drain_ns) {
+        m_drain_valid = true;
+        m_drain_frames = frames_played;
+        m_drain_ns = now_ns;
+        return;
+    }
+    const uint64_t span_ns = now_ns - m_drain_ns;
+    if (span_ns < kMinDrainSpanNs) {
+        return;
+    }
+    const uint64_t frames = frames_played - m_drain_frames;
+    m_drain_frames = frames_played;
+    m_drain_ns = now_ns;
+    // Nothing played (paused, or stalled so long the span says nothing about
+    // the device rate): keep the previous estimate.
+    if (frames == 0 || span_ns > kMaxDrainSpanNs) {
+        return;
+    }
+    const double rate = static_cast<double>(frames) * 1e9 / static_cast<double>(span_ns);
+    const double ratio = rate / m_rate;
+    // Faster than any device drains: the position was moved (forward seek).
+    if (ratio > kMaxDrainRatio) {
+        return;
+    }
+    m_drain_ratio += kDrainAlpha * (std::max(ratio, kMinDrainRatio) - m_drain_ratio);
+    updateTarget();
+}
+
+size_t ReadAheadPolicy::msToSamples(unsigned int ms) const
+{
+    const size_t frames = static_cast<size_t>(m_rate) * ms / 1000;
+    return frames * m_channels;
+}
+
+void ReadAheadPolicy::updateTarget()
+{
+    const double gap_ms = m_peak_chunk_ms + kSchedulingSlackMs;
+    const double headroom = 1.0 / (1.0 - std::min(m_cost, kMaxCost));
+    const double want = kCoverFactor * gap_ms * std::max(1.0, m_drain_ratio) * headroom;
+    m_target_ms = static_cast<unsigned int>(
+        std::clamp(want, static_cast<double>(m_bounds.min_ms), static_cast<double>(m_bounds.max_ms)));
+}
+
+} // namespace Core
+} // namespace PsyMP3
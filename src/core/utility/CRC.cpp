@@ -0,0 +1,306 @@
+/*
+ * CRC.cpp - FLAC CRC-8 and CRC-16 computation
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef FINAL_BUILD
+#include "psymp3.h"
+#endif // !FINAL_BUILD
+#include "core/utility/CRC.h"
+
+namespace PsyMP3 {
+namespace Core {
+namespace Utility {
+
+namespace {
+
+// Both CRCs share one implementation, parameterized on the register width.
+// The register is kept in the low Width bits of a uint16_t; Poly omits the
+// x^Width term.
+template <unsigned Width, uint16_t Poly>
+struct CRCParams {
+    static constexpr unsigned width = Width;
+    static constexpr uint16_t mask = static_cast<uint16_t>((1u << Width) - 1);
+    static constexpr uint16_t poly = Poly;
+};
+
+using CRC8Params = CRCParams<8, 0x07>;
+using CRC16Params = CRCParams<16, 0x8005>;
+
+// tables[k][b] is the CRC of byte b followed by k zero bytes, so the CRC of
+// N bytes is the XOR of tables[N-1-i][byte i]: slice-by-N.
+struct CRCTables {
+    uint16_t tables[16][256];
+};
+
+template <typename Params>
+constexpr CRCTables makeCRCTables()
+{
+    CRCTables t{};
+    for (unsigned b = 0; b < 256; ++b) {
+        uint32_t r = b << (Params::width - 8);
+        for (int bit = 0; bit < 8; ++bit) {
+            r = (r & (1u << (Params::width - 1))) ? (r << 1) ^ Params::poly : r << 1;
+        }
+        t.tables[0][b] = static_cast<uint16_t>(r & Params::mask);
+    }
+    for (unsigned k = 1; k < 16; ++k) {
+        for (unsigned b = 0; b < 256; ++b) {
+            // Append one zero byte: the CRC register shifted left by 8 bits
+            const uint16_t prev = t.tables[k - 1][b];
+            t.tables[k][b] = static_cast<uint16_t>(
+                ((prev << 8) & Params::mask) ^
+                t.tables[0][prev >> (Params::width - 8)]);
+        }
+    }
+    return t;
+}
+
+constexpr CRCTables kCRC8Tables = makeCRCTables<CRC8Params>();
+constexpr CRCTables kCRC16Tables = makeCRCTables<CRC16Params>();
+
+template <typename Params> const CRCTables& crcTables();
+template <> const CRCTables& crcTables<CRC8Params>() { return kCRC8Tables; }
+template <> const CRCTables& crcTables<CRC16Params>() { return kCRC16Tables; }
+
+template <typename Params>
+uint16_t crcBytewise(const uint8_t* data, size_t length, uint16_t crc)
+{
+    const uint16_t* table = crcTables<Params>().tables[0];
+    for (size_t i = 0; i < length; ++i) {
+        crc = static_cast<uint16_t>(
+            ((crc << 8) & Params::mask) ^
+            table[((crc >> (Params::width - 8)) ^ data[i]) & 0xFF]);
+    }
+    return crc;
+}
+
+template <typename Params, unsigned Slice>
+uint16_t crcSliced(const uint8_t* data, size_t length, uint16_t crc)
+{
+    const CRCTables& t = crcTables<Params>();
+    while (length >= Slice) {
+        // The running CRC lines up with the first Width/8 bytes
+        uint8_t block[Slice];
+        memcpy(block, data, Slice);
+        if (Params::width == 16) {
+            block[0] ^= static_cast<uint8_t>(crc >> 8);
+            block[1] ^= static_cast<uint8_t>(crc);
+        } else {
+            block[0] ^= static_cast<uint8_t>(crc);
+        }
+        uint16_t next = 0;
+        for (unsigned i = 0; i < Slice; ++i) {
+            next ^= t.tables[Slice - 1 - i][block[i]];
+        }
+        crc = next;
+        data += Slice;
+        length -= Slice;
+    }
+    return crcBytewise<Params>(data, length, crc);
+}
+
+#ifdef HAVE_PCLMUL_TARGET
+// Carry-less multiply folding, after Intel's "Fast CRC Computation for
+// Generic Polynomials Using PCLMULQDQ Instruction". Message bytes are
+// loaded byte-reversed so each 128-bit register is a polynomial with the
+// first byte's MSB as its top coefficient. With X = H*x^64 + L,
+//   X*x^n = H*(x^(n+64) mod P) + L*(x^n mod P)   (mod P),
+// and both products stay below x^(64+Width), so a fold is two PCLMULQDQs
+// and an XOR with the next block. The folded remainder is congruent to the
+// message so far; its 16 bytes plus the tail go through the tables.
+
+// x^n mod P, as the low Width bits
+template <typename Params>
+constexpr uint64_t xPowMod(unsigned n)
+{
+    uint32_t r = 1;
+    for (unsigned i = 0; i < n; ++i) {
+        r <<= 1;
+        if (r & (1u << Params::width)) {
+            r ^= (1u << Params::width) | Params::poly;
+        }
+    }
+    return r;
+}
+
+// Multiplier pair that advances a register by N bits
+template <typename Params, unsigned N>
+__attribute__((target("pclmul,ssse3")))
+inline __m128i foldConstants()
+{
+    constexpr uint64_t high = xPowMod<Params>(N + 64);
+    constexpr uint64_t low = xPowMod<Params>(N);
+    return _mm_set_epi64x(static_cast<long long>(high), static_cast<long long>(low));
+}
+
+__attribute__((target("pclmul,ssse3")))
+inline __m128i foldCRC(__m128i x, __m128i k)
+{
+    return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x11),
+                         _mm_clmulepi64_si128(x, k, 0x00));
+}
+
+__attribute__((target("pclmul,ssse3")))
+inline __m128i reverseBytes(__m128i x)
+{
+    return _mm_shuffle_epi8(x, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                            8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+__attribute__((target("pclmul,ssse3")))
+inline __m128i loadReversed(const uint8_t* p)
+{
+    return reverseBytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+
+template <typename Params>
+__attribute__((target("pclmul,ssse3")))
+uint16_t crcClmul(const uint8_t* data, size_t length, uint16_t crc)
+{
+    // Below four blocks the setup costs more than the tables
+    if (length < 64) {
+        return crcSliced<Params, 16>(data, length, crc);
+    }
+
+    // Four independent accumulators hide the multiply latency
+    const __m128i initial =
+        _mm_set_epi64x(static_cast<long long>(static_cast<uint64_t>(crc) << (64 - Params::width)), 0);
+    __m128i x0 = _mm_xor_si128(loadReversed(data), initial);
+    __m128i x1 = loadReversed(data + 16);
+    __m128i x2 = loadReversed(data + 32);
+    __m128i x3 = loadReversed(data + 48);
+    data += 64;
+    length -= 64;
+
+    const __m128i k512 = foldConstants<Params, 512>();
+    while (length >= 64) {
+        x0 = _mm_xor_si128(foldCRC(x0, k512), loadReversed(data));
+        x1 = _mm_xor_si128(foldCRC(x1, k512), loadReversed(data + 16));
+        x2 = _mm_xor_si128(foldCRC(x2, k512), loadReversed(data + 32));
+        x3 = _mm_xor_si128(foldCRC(x3, k512), loadReversed(data + 48));
+        data += 64;
+        length -= 64;
+    }
+
+    const __m128i k128 = foldConstants<Params, 128>();
+    __m128i x = _mm_xor_si128(
+        _mm_xor_si128(foldCRC(x0, foldConstants<Params, 384>()),
+                      foldCRC(x1, foldConstants<Params, 256>())),
+        _mm_xor_si128(foldCRC(x2, k128), x3));
+    while (length >= 16) {
+        x = _mm_xor_si128(foldCRC(x, k128), loadReversed(data));
+        data += 16;
+        length -= 16;
+    }
+
+    uint8_t remainder[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(remainder), reverseBytes(x));
+    crc = crcSliced<Params, 16>(remainder, sizeof(remainder), 0);
+    return crcBytewise<Params>(data, length, crc);
+}
+#endif
+
+struct CRCKernels {
+    uint8_t (*crc8)(const uint8_t*, size_t, uint8_t);
+    uint16_t (*crc16)(const uint8_t*, size_t, uint16_t);
+    const char* name;
+};
+
+CRCKernels selectCRCKernels()
+{
+#ifdef HAVE_PCLMUL_TARGET
+    if (CRC::hasCarrylessMultiply()) {
+        return {CRC::crc8Clmul, CRC::crc16Clmul, "pclmul"};
+    }
+#endif
+    return {CRC::crc8Slice16, CRC::crc16Slice16, "slice16"};
+}
+
+const CRCKernels& crcKernels()
+{
+    static const CRCKernels kernels = selectCRCKernels();
+    return kernels;
+}
+
+} // namespace
+
+uint8_t CRC::crc8(const uint8_t* data, size_t length, uint8_t crc)
+{
+    return crcKernels().crc8(data, length, crc);
+}
+
+uint16_t CRC::crc16(const uint8_t* data, size_t length, uint16_t crc)
+{
+    return crcKernels().crc16(data, length, crc);
+}
+
+const char* CRC::implementation()
+{
+    return crcKernels().name;
+}
+
+uint8_t CRC::crc8Bytewise(const uint8_t* data, size_t length, uint8_t crc)
+{
+    return static_cast<uint8_t>(crcBytewise<CRC8Params>(data, length, crc));
+}
+
+uint16_t CRC::crc16Bytewise(const uint8_t* data, size_t length, uint16_t crc)
+{
+    return crcBytewise<CRC16Params>(data, length, crc);
+}
+
+uint8_t CRC::crc8Slice8(const uint8_t* data, size_t length, uint8_t crc)
+{
+    return static_cast<uint8_t>(crcSliced<CRC8Params, 8>(data, length, crc));
+}
+
+uint16_t CRC::crc16Slice8(const uint8_t* data, size_t length, uint16_t crc)
+{
+    return crcSliced<CRC16Params, 8>(data, length, crc);
+}
+
+uint8_t CRC::crc8Slice16(const uint8_t* data, size_t length, uint8_t crc)
+{
+    return static_cast<uint8_t>(crcSliced<CRC8Params, 16>(data, length, crc));
+}
+
+uint16_t CRC::crc16Slice16(const uint8_t* data, size_t length, uint16_t crc)
+{
+    return crcSliced<CRC16Params, 16>(data, length, crc);
+}
+
+bool CRC::hasCarrylessMultiply()
+{
+#ifdef HAVE_PCLMUL_TARGET
+    return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+#else
+    return false;
+#endif
+}
+
+uint8_t CRC::crc8Clmul(const uint8_t* data, size_t length, uint8_t crc)
+{
+#ifdef HAVE_PCLMUL_TARGET
+    return static_cast<uint8_t>(crcClmul<CRC8Params>(data, length, crc));
+#else
+    return crc8Slice16(data, length, crc);
+#endif
+}
+
+uint16_t CRC::crc16Clmul(const uint8_t* data, size_t length, uint16_t crc)
+{
+#ifdef HAVE_PCLMUL_TARGET
+    return crcClmul<CRC16Params>(data, length, crc);
+#else
+    return crc16Slice16(data, length, crc);
+#endif
+}
+
+} // namespace Utility
+} // namespace Core
+} // namespace PsyMP3
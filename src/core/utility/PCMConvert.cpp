@@ -0,0 +1,725 @@
+/*
+ * PCMConvert.cpp - Vectorized integer, float and G.711 PCM to int16 conversion
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef FINAL_BUILD
+#include "psymp3.h"
+#endif // !FINAL_BUILD
+#include "core/utility/PCMConvert.h"
+
+namespace PsyMP3 {
+namespace Core {
+namespace Utility {
+
+namespace {
+
+// Widening the table for a gather, or splitting it into byte planes for a
+// NEON table lookup, costs about as much as converting this many samples
+constexpr size_t kTableLookupMinSamples = 256;
+
+int16_t pcmWord(uint8_t high, uint8_t low)
+{
+    return static_cast<int16_t>(static_cast<uint16_t>((high << 8) | low));
+}
+
+uint32_t pcmLoad32(const uint8_t* p, bool big_endian)
+{
+    if (big_endian) {
+        return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+    }
+    return (uint32_t(p[3]) << 24) | (uint32_t(p[2]) << 16) | (uint32_t(p[1]) << 8) | uint32_t(p[0]);
+}
+
+uint64_t pcmLoad64(const uint8_t* p, bool big_endian)
+{
+    const uint64_t first = pcmLoad32(p, big_endian);
+    const uint64_t second = pcmLoad32(p + 4, big_endian);
+    return big_endian ? (first << 32) | second : (second << 32) | first;
+}
+
+int16_t pcmFloatSample(float v)
+{
+    if (!(v == v)) {
+        return 0;
+    }
+    return static_cast<int16_t>(std::clamp(v, -1.0f, 1.0f) * 32767.0f);
+}
+
+int16_t pcmDoubleSample(double v)
+{
+    if (!(v == v)) {
+        return 0;
+    }
+    return static_cast<int16_t>(std::clamp(v, -1.0, 1.0) * 32767.0);
+}
+
+bool isBigEndianLayout(PCMLayout layout)
+{
+    switch (layout) {
+        case PCMLayout::S16BE:
+        case PCMLayout::S24BE:
+        case PCMLayout::S32BE:
+        case PCMLayout::F32BE:
+        case PCMLayout::F64BE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// A kernel converts as many leading samples as it has a fast path for and
+// returns the count; the scalar kernel finishes the rest.
+struct ScalarPCMKernel {
+    static size_t toInt16(const uint8_t* in, size_t samples, PCMLayout layout, int16_t* out)
+    {
+        const bool big = isBigEndianLayout(layout);
+        switch (layout) {
+            case PCMLayout::U8:
+                for (size_t i = 0; i < samples; ++i) {
+                    out[i] = static_cast<int16_t>((static_cast<int32_t>(in[i]) - 128) * 256);
+                }
+                break;
+            case PCMLayout::S8:
+                for (size_t i = 0; i < samples; ++i) {
+                    out[i] = static_cast<int16_t>(static_cast<int8_t>(in[i]) * 256);
+                }
+                break;
+            case PCMLayout::S16LE:
+            case PCMLayout::S16BE:
+                for (size_t i = 0; i < samples; ++i) {
+                    const uint8_t* p = in + 2 * i;
+                    out[i] = big ? pcmWord(p[0], p[1]) : pcmWord(p[1], p[0]);
+                }
+                break;
+            case PCMLayout::S24LE:
+            case PCMLayout::S24BE:
+                // The top 16 of the 24 bits
+                for (size_t i = 0; i < samples; ++i) {
+                    const uint8_t* p = in + 3 * i;
+                    out[i] = big ? pcmWord(p[0], p[1]) : pcmWord(p[2], p[1]);
+                }
+                break;
+            case PCMLayout::S32LE:
+            case PCMLayout::S32BE:
+                for (size_t i = 0; i < samples; ++i) {
+                    const uint8_t* p = in + 4 * i;
+                    out[i] = big ? pcmWord(p[0], p[1]) : pcmWord(p[3], p[2]);
+                }
+                break;
+            case PCMLayout::F32LE:
+            case PCMLayout::F32BE:
+                for (size_t i = 0; i < samples; ++i) {
+                    const uint32_t bits = pcmLoad32(in + 4 * i, big);
+                    float v;
+                    std::memcpy(&v, &bits, sizeof(v));
+                    out[i] = pcmFloatSample(v);
+                }
+                break;
+            case PCMLayout::F64LE:
+            case PCMLayout::F64BE:
+                for (size_t i = 0; i < samples; ++i) {
+                    const uint64_t bits = pcmLoad64(in + 8 * i, big);
+                    double v;
+                    std::memcpy(&v, &bits, sizeof(v));
+                    out[i] = pcmDoubleSample(v);
+                }
+                break;
+        }
+        return samples;
+    }
+
+    static size_t lookupToInt16(const uint8_t* in, size_t samples, const int16_t* table, int16_t* out)
+    {
+        for (size_t i = 0; i < samples; ++i) {
+            out[i] = table[in[i]];
+        }
+        return samples;
+    }
+};
+
+template <typename Kernel>
+void convertPCM(const uint8_t* in, size_t samples, PCMLayout layout, int16_t* out)
+{
+    const size_t done = Kernel::toInt16(in, samples, layout, out);
+    ScalarPCMKernel::toInt16(in + done * PCMConvert::bytesPerSample(layout), samples - done, layout, out + done);
+}
+
+template <typename Kernel>
+void lookupPCM(const uint8_t* in, size_t samples, const int16_t* table, int16_t* out)
+{
+    const size_t done = Kernel::lookupToInt16(in, samples, table, out);
+    ScalarPCMKernel::lookupToInt16(in + done, samples - done, table, out + done);
+}
+
+#if defined(HAVE_AVX2_TARGET) || (defined(HAVE_NEON) && defined(__aarch64__))
+// Byte shuffles, per 16 bytes; -1 selects zero
+alignas(16) constexpr int8_t kSwapBytes16[16] = {1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14};
+alignas(16) constexpr int8_t kSwapBytes32[16] = {3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12};
+alignas(16) constexpr int8_t kSwapBytes64[16] = {7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8};
+// The top 16 bits of four packed samples, as int16 in the low 8 bytes
+alignas(16) constexpr int8_t kTop16Of24LE[16] = {1, 2, 4, 5, 7, 8, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1};
+alignas(16) constexpr int8_t kTop16Of24BE[16] = {1, 0, 4, 3, 7, 6, 10, 9, -1, -1, -1, -1, -1, -1, -1, -1};
+alignas(16) constexpr int8_t kTop16Of32LE[16] = {2, 3, 6, 7, 10, 11, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1};
+alignas(16) constexpr int8_t kTop16Of32BE[16] = {1, 0, 5, 4, 9, 8, 13, 12, -1, -1, -1, -1, -1, -1, -1, -1};
+#endif
+
+#ifdef HAVE_SSE2
+__m128i loadPCMSSE2(const uint8_t* p)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+void storePCMSSE2(int16_t* p, __m128i v)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+
+// SSE2 has no byte shuffle: swap within words, then reorder the words
+__m128i swapBytes16SSE2(__m128i v)
+{
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+__m128i swapBytes32SSE2(__m128i v)
+{
+    v = swapBytes16SSE2(v);
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xB1), 0xB1);
+}
+
+__m128i swapBytes64SSE2(__m128i v)
+{
+    v = swapBytes16SSE2(v);
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0x1B), 0x1B);
+}
+
+// Zero NaN, clamp to [-1, 1], scale and truncate, as pcmFloatSample()
+__m128i truncateFloatsSSE2(__m128 v)
+{
+    v = _mm_and_ps(v, _mm_cmpord_ps(v, v));
+    v = _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+    return _mm_cvttps_epi32(_mm_mul_ps(v, _mm_set1_ps(32767.0f)));
+}
+
+// Two doubles to int32 in the low half, as pcmDoubleSample()
+__m128i truncateDoublesSSE2(__m128d v)
+{
+    v = _mm_and_pd(v, _mm_cmpord_pd(v, v));
+    v = _mm_min_pd(_mm_max_pd(v, _mm_set1_pd(-1.0)), _mm_set1_pd(1.0));
+    return _mm_cvttpd_epi32(_mm_mul_pd(v, _mm_set1_pd(32767.0)));
+}
+
+__m128d loadDoublesSSE2(const uint8_t* p, bool big)
+{
+    const __m128i v = loadPCMSSE2(p);
+    return _mm_castsi128_pd(big ? swapBytes64SSE2(v) : v);
+}
+
+struct SSE2PCMKernel {
+    static size_t toInt16(const uint8_t* in, size_t samples, PCMLayout layout, int16_t* out)
+    {
+        const bool big = isBigEndianLayout(layout);
+        size_t i = 0;
+        switch (layout) {
+            case PCMLayout::U8:
+            case PCMLayout::S8: {
+                // Unpacking under a zero byte scales by 256
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i bias = _mm_set1_epi8(layout == PCMLayout::U8 ? static_cast<char>(0x80) : 0);
+                for (; i + 16 <= samples; i += 16) {
+                    const __m128i v = _mm_xor_si128(loadPCMSSE2(in + i), bias);
+                    storePCMSSE2(out + i, _mm_unpacklo_epi8(zero, v));
+                    storePCMSSE2(out + i + 8, _mm_unpackhi_epi8(zero, v));
+                }
+                break;
+            }
+            case PCMLayout::S16LE:
+            case PCMLayout::S16BE:
+                for (; i + 8 <= samples; i += 8) {
+                    const __m128i v = loadPCMSSE2(in + 2 * i);
+                    storePCMSSE2(out + i, big ? swapBytes16SSE2(v) : v);
+                }
+                break;
+            case PCMLayout::S32LE:
+            case PCMLayout::S32BE:
+                for (; i + 8 <= samples; i += 8) {
+                    __m128i a = loadPCMSSE2(in + 4 * i);
+                    __m128i b = loadPCMSSE2(in + 4 * i + 16);
+                    if (big) {
+                        // The top bytes land in the low word; move them up
+                        a = _mm_slli_epi32(swapBytes16SSE2(a), 16);
+                        b = _mm_slli_epi32(swapBytes16SSE2(b), 16);
+                    }
+                    storePCMSSE2(out + i, _mm_packs_epi32(_mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16)));
+                }
+                break;
+            case PCMLayout::F32LE:
+            case PCMLayout::F32BE:
+                for (; i + 8 <= samples; i += 8) {
+                    __m128i a = loadPCMSSE2(in + 4 * i);
+                    __m128i b = loadPCMSSE2(in + 4 * i + 16);
+                    if (big) {
+                        a = swapBytes32SSE2(a);
+                        b = swapBytes32SSE2(b);
+                    }
+                    storePCMSSE2(out + i, _mm_packs_epi32(truncateFloatsSSE2(_mm_castsi128_ps(a)),
+                                                          truncateFloatsSSE2(_mm_castsi128_ps(b))));
+                }
+                break;
+            case PCMLayout::F64LE:
+            case PCMLayout::F64BE:
+                for (; i + 8 <= samples; i += 8) {
+                    const uint8_t* p = in + 8 * i;
+                    __m128i quads[2];
+                    for (int q = 0; q < 2; ++q, p += 32) {
+                        quads[q] = _mm_unpacklo_epi64(truncateDoublesSSE2(loadDoublesSSE2(p, big)),
+                                                      truncateDoublesSSE2(loadDoublesSSE2(p + 16, big)));
+                    }
+                    storePCMSSE2(out + i, _mm_packs_epi32(quads[0], quads[1]));
+                }
+                break;
+            default:
+                // 24-bit samples need a byte shuffle
+                break;
+        }
+        return i;
+    }
+
+    // A table lookup has no SSE2 form; computing G.711 arithmetically in
+    // 16-bit lanes measured slower than the scalar table
+    static size_t lookupToInt16(const uint8_t*, size_t, const int16_t*, int16_t*)
+    {
+        return 0;
+    }
+};
+#endif
+
+#ifdef HAVE_AVX2_TARGET
+__attribute__((target("avx2")))
+__m256i laneShuffleAVX2(const int8_t* mask)
+{
+    return _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(mask)));
+}
+
+__attribute__((target("avx2")))
+__m256i loadPCMAVX2(const uint8_t* p)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+// Joins the int16 in the low 8 bytes of each lane of a (samples 0-3, 4-7)
+// and b (8-11, 12-15) into sixteen samples in order
+__attribute__((target("avx2")))
+__m256i joinLowHalvesAVX2(__m256i a, __m256i b)
+{
+    return _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), 0xD8);
+}
+
+__attribute__((target("avx2")))
+__m256i truncateFloatsAVX2(__m256 v)
+{
+    v = _mm256_and_ps(v, _mm256_cmp_ps(v, v, _CMP_ORD_Q));
+    v = _mm256_min_ps(_mm256_max_ps(v, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
+    return _mm256_cvttps_epi32(_mm256_mul_ps(v, _mm256_set1_ps(32767.0f)));
+}
+
+__attribute__((target("avx2")))
+__m128i truncateDoublesAVX2(__m256d v)
+{
+    v = _mm256_and_pd(v, _mm256_cmp_pd(v, v, _CMP_ORD_Q));
+    v = _mm256_min_pd(_mm256_max_pd(v, _mm256_set1_pd(-1.0)), _mm256_set1_pd(1.0));
+    return _mm256_cvttpd_epi32(_mm256_mul_pd(v, _mm256_set1_pd(32767.0)));
+}
+
+struct AVX2PCMKernel {
+    __attribute__((target("avx2")))
+    static size_t toInt16(const uint8_t* in, size_t samples, PCMLayout layout, int16_t* out)
+    {
+        const bool big = isBigEndianLayout(layout);
+        size_t i = 0;
+        switch (layout) {
+            case PCMLayout::U8:
+            case PCMLayout::S8: {
+                const __m128i bias = _mm_set1_epi8(layout == PCMLayout::U8 ? static_cast<char>(0x80) : 0);
+                for (; i + 16 <= samples; i += 16) {
+                    const __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), bias);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                                        _mm256_slli_epi16(_mm256_cvtepu8_epi16(v), 8));
+                }
+                break;
+            }
+            case PCMLayout::S16LE:
+            case PCMLayout::S16BE: {
+                const __m256i swap = laneShuffleAVX2(kSwapBytes16);
+                for (; i + 16 <= samples; i += 16) {
+                    const __m256i v = loadPCMAVX2(in + 2 * i);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), big ? _mm256_shuffle_epi8(v, swap) : v);
+                }
+                break;
+            }
+            case PCMLayout::S24LE:
+            case PCMLayout::S24BE: {
+                // Four samples (12 bytes) per lane, so each 16-byte load
+                // reads 4 bytes past its samples
+                const __m256i top = laneShuffleAVX2(big ? kTop16Of24BE : kTop16Of24LE);
+                for (; (i + 16) * 3 + 4 <= samples * 3; i += 16) {
+                    const uint8_t* p = in + 3 * i;
+                    __m256i halves[2];
+                    for (int h = 0; h < 2; ++h, p += 24) {
+                        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 12));
+                        halves[h] = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), top);
+                    }
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), joinLowHalvesAVX2(halves[0], halves[1]));
+                }
+                break;
+            }
+            case PCMLayout::S32LE:
+            case PCMLayout::S32BE: {
+                const __m256i top = laneShuffleAVX2(big ? kTop16Of32BE : kTop16Of32LE);
+                for (; i + 16 <= samples; i += 16) {
+                    const __m256i a = _mm256_shuffle_epi8(loadPCMAVX2(in + 4 * i), top);
+                    const __m256i b = _mm256_shuffle_epi8(loadPCMAVX2(in + 4 * i + 32), top);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), joinLowHalvesAVX2(a, b));
+                }
+                break;
+            }
+            case PCMLayout::F32LE:
+            case PCMLayout::F32BE: {
+                const __m256i swap = laneShuffleAVX2(kSwapBytes32);
+                for (; i + 16 <= samples; i += 16) {
+                    __m256i a = loadPCMAVX2(in + 4 * i);
+                    __m256i b = loadPCMAVX2(in + 4 * i + 32);
+                    if (big) {
+                        a = _mm256_shuffle_epi8(a, swap);
+                        b = _mm256_shuffle_epi8(b, swap);
+                    }
+                    // packs works within lanes; the permute puts the halves in order
+                    const __m256i packed = _mm256_packs_epi32(truncateFloatsAVX2(_mm256_castsi256_ps(a)),
+                                                              truncateFloatsAVX2(_mm256_castsi256_ps(b)));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permute4x64_epi64(packed, 0xD8));
+                }
+                break;
+            }
+            case PCMLayout::F64LE:
+            case PCMLayout::F64BE: {
+                const __m256i swap = laneShuffleAVX2(kSwapBytes64);
+                for (; i + 8 <= samples; i += 8) {
+                    __m256i a = loadPCMAVX2(in + 8 * i);
+                    __m256i b = loadPCMAVX2(in + 8 * i + 32);
+                    if (big) {
+                        a = _mm256_shuffle_epi8(a, swap);
+                        b = _mm256_shuffle_epi8(b, swap);
+                    }
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                                     _mm_packs_epi32(truncateDoublesAVX2(_mm256_castsi256_pd(a)),
+                                                     truncateDoublesAVX2(_mm256_castsi256_pd(b))));
+                }
+                break;
+            }
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2")))
+    static size_t lookupToInt16(const uint8_t* in, size_t samples, const int16_t* table, int16_t* out)
+    {
+        if (samples < kTableLookupMinSamples) {
+            return 0;
+        }
+        // Gathers read 32-bit elements
+        alignas(32) int32_t wide[256];
+        for (size_t k = 0; k < 256; k += 8) {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(wide + k),
+                               _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table + k))));
+        }
+        size_t i = 0;
+        for (; i + 16 <= samples; i += 16) {
+            const __m128i codes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            const __m256i a = _mm256_i32gather_epi32(wide, _mm256_cvtepu8_epi32(codes), 4);
+            const __m256i b = _mm256_i32gather_epi32(wide, _mm256_cvtepu8_epi32(_mm_srli_si128(codes, 8)), 4);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                                _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8));
+        }
+        return i;
+    }
+};
+#endif
+
+#if defined(HAVE_NEON) && defined(__aarch64__)
+uint8x16_t laneShuffleNEON(const int8_t* mask)
+{
+    return vreinterpretq_u8_s8(vld1q_s8(mask));
+}
+
+// vcvtq truncates toward zero
+int32x4_t truncateFloatsNEON(float32x4_t v)
+{
+    v = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(v), vceqq_f32(v, v)));
+    v = vminq_f32(vmaxq_f32(v, vdupq_n_f32(-1.0f)), vdupq_n_f32(1.0f));
+    return vcvtq_s32_f32(vmulq_f32(v, vdupq_n_f32(32767.0f)));
+}
+
+int32x2_t truncateDoublesNEON(float64x2_t v)
+{
+    v = vreinterpretq_f64_u64(vandq_u64(vreinterpretq_u64_f64(v), vceqq_f64(v, v)));
+    v = vminq_f64(vmaxq_f64(v, vdupq_n_f64(-1.0)), vdupq_n_f64(1.0));
+    return vmovn_s64(vcvtq_s64_f64(vmulq_f64(v, vdupq_n_f64(32767.0))));
+}
+
+struct NEONPCMKernel {
+    static size_t toInt16(const uint8_t* in, size_t samples, PCMLayout layout, int16_t* out)
+    {
+        const bool big = isBigEndianLayout(layout);
+        size_t i = 0;
+        switch (layout) {
+            case PCMLayout::U8:
+            case PCMLayout::S8: {
+                const uint8x16_t bias = vdupq_n_u8(layout == PCMLayout::U8 ? 0x80 : 0);
+                for (; i + 16 <= samples; i += 16) {
+                    const uint8x16_t v = veorq_u8(vld1q_u8(in + i), bias);
+                    vst1q_s16(out + i, vreinterpretq_s16_u16(vshll_n_u8(vget_low_u8(v), 8)));
+                    vst1q_s16(out + i + 8, vreinterpretq_s16_u16(vshll_high_n_u8(v, 8)));
+                }
+                break;
+            }
+            case PCMLayout::S16LE:
+            case PCMLayout::S16BE:
+                for (; i + 8 <= samples; i += 8) {
+                    const uint8x16_t v = vld1q_u8(in + 2 * i);
+                    vst1q_s16(out + i, vreinterpretq_s16_u8(big ? vrev16q_u8(v) : v));
+                }
+                break;
+            case PCMLayout::S24LE:
+            case PCMLayout::S24BE:
+                // De-interleave into byte planes, re-interleave the top two
+                for (; i + 16 <= samples; i += 16) {
+                    const uint8x16x3_t planes = vld3q_u8(in + 3 * i);
+                    uint8x16x2_t words;
+                    words.val[0] = planes.val[1];
+                    words.val[1] = big ? planes.val[0] : planes.val[2];
+                    vst2q_u8(reinterpret_cast<uint8_t*>(out + i), words);
+                }
+                break;
+            case PCMLayout::S32LE:
+            case PCMLayout::S32BE: {
+                const uint8x16_t top = laneShuffleNEON(big ? kTop16Of32BE : kTop16Of32LE);
+                for (; i + 8 <= samples; i += 8) {
+                    const uint8x16_t a = vqtbl1q_u8(vld1q_u8(in + 4 * i), top);
+                    const uint8x16_t b = vqtbl1q_u8(vld1q_u8(in + 4 * i + 16), top);
+                    vst1q_u8(reinterpret_cast<uint8_t*>(out + i), vcombine_u8(vget_low_u8(a), vget_low_u8(b)));
+                }
+                break;
+            }
+            case PCMLayout::F32LE:
+            case PCMLayout::F32BE:
+                for (; i + 8 <= samples; i += 8) {
+                    uint8x16_t a = vld1q_u8(in + 4 * i);
+                    uint8x16_t b = vld1q_u8(in + 4 * i + 16);
+                    if (big) {
+                        a = vrev32q_u8(a);
+                        b = vrev32q_u8(b);
+                    }
+                    vst1q_s16(out + i, vcombine_s16(vmovn_s32(truncateFloatsNEON(vreinterpretq_f32_u8(a))),
+                                                    vmovn_s32(truncateFloatsNEON(vreinterpretq_f32_u8(b)))));
+                }
+                break;
+            case PCMLayout::F64LE:
+            case PCMLayout::F64BE:
+                for (; i + 4 <= samples; i += 4) {
+                    uint8x16_t a = vld1q_u8(in + 8 * i);
+                    uint8x16_t b = vld1q_u8(in + 8 * i + 16);
+                    if (big) {
+                        a = vrev64q_u8(a);
+                        b = vrev64q_u8(b);
+                    }
+                    const int32x4_t words = vcombine_s32(truncateDoublesNEON(vreinterpretq_f64_u8(a)),
+                                                         truncateDoublesNEON(vreinterpretq_f64_u8(b)));
+                    vst1_s16(out + i, vmovn_s32(words));
+                }
+                break;
+        }
+        return i;
+    }
+
+    // The table split into low and high byte planes, 64 entries per
+    // register quad; out-of-range indices leave vqtbx lanes unchanged
+    static size_t lookupToInt16(const uint8_t* in, size_t samples, const int16_t* table, int16_t* out)
+    {
+        if (samples < kTableLookupMinSamples) {
+            return 0;
+        }
+        uint8_t low_bytes[256];
+        uint8_t high_bytes[256];
+        for (size_t k = 0; k < 256; ++k) {
+            const uint16_t value = static_cast<uint16_t>(table[k]);
+            low_bytes[k] = static_cast<uint8_t>(value);
+            high_bytes[k] = static_cast<uint8_t>(value >> 8);
+        }
+        uint8x16x4_t low[4];
+        uint8x16x4_t high[4];
+        for (int q = 0; q < 4; ++q) {
+            for (int r = 0; r < 4; ++r) {
+                low[q].val[r] = vld1q_u8(low_bytes + 64 * q + 16 * r);
+                high[q].val[r] = vld1q_u8(high_bytes + 64 * q + 16 * r);
+            }
+        }
+        const uint8x16_t quarter = vdupq_n_u8(64);
+        size_t i = 0;
+        for (; i + 16 <= samples; i += 16) {
+            uint8x16_t index = vld1q_u8(in + i);
+            uint8x16x2_t words;
+            words.val[0] = vqtbl4q_u8(low[0], index);
+            words.val[1] = vqtbl4q_u8(high[0], index);
+            for (int q = 1; q < 4; ++q) {
+                index = vsubq_u8(index, quarter);
+                words.val[0] = vqtbx4q_u8(words.val[0], low[q], index);
+                words.val[1] = vqtbx4q_u8(words.val[1], high[q], index);
+            }
+            vst2q_u8(reinterpret_cast<uint8_t*>(out + i), words);
+        }
+        return i;
+    }
+};
+#endif
+
+struct PCMConvertKernels {
+    PCMConvert::ToInt16Fn toInt16;
+    PCMConvert::LookupToInt16Fn lookupToInt16;
+    const char* name;
+};
+
+PCMConvertKernels selectPCMConvertKernels()
+{
+#ifdef HAVE_AVX2_TARGET
+    if (SampleConvert::hasAVX2()) {
+        return {PCMConvert::toInt16AVX2, PCMConvert::lookupToInt16AVX2, "avx2"};
+    }
+#endif
+#if defined(HAVE_SSE2)
+    return {PCMConvert::toInt16SSE2, PCMConvert::lookupToInt16SSE2, "sse2"};
+#elif defined(HAVE_NEON) && defined(__aarch64__)
+    return {PCMConvert::toInt16NEON, PCMConvert::lookupToInt16NEON, "neon"};
+#else
+    return {PCMConvert::toInt16Scalar, PCMConvert::lookupToInt16Scalar, "scalar"};
+#endif
+}
+
+const PCMConvertKernels& pcmConvertKernels()
+{
+    static const PCMConvertKernels kernels = selectPCMConvertKernels();
+    return kernels;
+}
+
+} // namespace
+
+size_t PCMConvert::bytesPerSample(PCMLayout layout)
+{
+    switch (layout) {
+        case PCMLayout::U8:
+        case PCMLayout::S8:
+            return 1;
+        case PCMLayout::S16LE:
+        case PCMLayout::S16BE:
+            return 2;
+        case PCMLayout::S24LE:
+        case PCMLayout::S24BE:
+            return 3;
+        case PCMLayout::S32LE:
+        case PCMLayout::S32BE:
+        case PCMLayout::F32LE:
+        case PCMLayout::F32BE:
+            return 4;
+        case PCMLayout::F64LE:
+        case PCMLayout::F64BE:
+            return 8;
+    }
+    return 1;
+}
+
+void PCMConvert::toInt16(const uint8_t* in, size_t samples, PCMLayout layout, int16_t* out)
+{
+    pcmConvertKernels().toInt16(in, samples, layout, out);
+}
+
+void PCMConvert::lookupToInt16(const uint8_t* in, size_t samples, const int16_t* table, int16_t* out)
+{
+    pcmConvertKernels().lookupToInt16(in, samples, table, out);
+}
+
+const char* PCMConvert::implementation()
+{
+    return pcmConvertKernels().name;
+}
+
+void PCMConvert::toInt16Scalar(const uint8_t* in, size_t samples, PCMLayout layout, int16_t* out)
+{
+    ScalarPCMKernel::toInt16(in, samples, layout, out);
+}
+
+void PCMConvert::lookupToInt16Scalar(const uint8_t* in, size_t samples, const int16_t* table, int16_t* out)
+{
+    ScalarPCMKernel::lookupToInt16(in, samples, table, out);
+}
+
+void PCMConvert::toInt16SSE2(const uint8_t* in, size_t samples, PCMLayout layout, int16_t* out)
+{
+#ifdef HAVE_SSE2
+    convertPCM<SSE2PCMKernel>(in, samples, layout, out);
+#else
+    toInt16Scalar(in, samples, layout, out);
+#endif
+}
+
+void PCMConvert::lookupToInt16SSE2(const uint8_t* in, size_t samples, const int16_t* table, int16_t* out)
+{
+#ifdef HAVE_SSE2
+    lookupPCM<SSE2PCMKernel>(in, samples, table, out);
+#else
+    lookupToInt16Scalar(in, samples, table, out);
+#endif
+}
+
+void PCMConvert::toInt16AVX2(const uint8_t* in, size_t samples, PCMLayout layout, int16_t* out)
+{
+#ifdef HAVE_AVX2_TARGET
+    convertPCM<AVX2PCMKernel>(in, samples, layout, out);
+#else
+    toInt16SSE2(in, samples, layout, out);
+#endif
+}
+
+void PCMConvert::lookupToInt16AVX2(const uint8_t* in, size_t samples, const int16_t* table, int16_t* out)
+{
+#ifdef HAVE_AVX2_TARGET
+    lookupPCM<AVX2PCMKernel>(in, samples, table, out);
+#else
+    lookupToInt16SSE2(in, samples, table, out);
+#endif
+}
+
+void PCMConvert::toInt16NEON(const uint8_t* in, size_t samples, PCMLayout layout, int16_t* out)
+{
+#if defined(HAVE_NEON) && defined(__aarch64__)
+    convertPCM<NEONPCMKernel>(in, samples, layout, out);
+#else
+    toInt16Scalar(in, samples, layout, out);
+#endif
+}
+
+void PCMConvert::lookupToInt16NEON(const uint8_t* in, size_t samples, const int16_t* table, int16_t* out)
+{
+#if defined(HAVE_NEON) && defined(__aarch64__)
+    lookupPCM<NEONPCMKernel>(in, samples, table, out);
+#else
+    lookupToInt16Scalar(in, samples, table, out);
+#endif
+}
+
+} // namespace Utility
+} // namespace Core
+} // namespace PsyMP3
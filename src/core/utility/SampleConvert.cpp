@@ -0,0 +1,412 @@
+/*
+ * SampleConvert.cpp - Vectorized sample format conversion
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef FINAL_BUILD
+#include "psymp3.h"
+#endif // !FINAL_BUILD
+#include "core/utility/SampleConvert.h"
+
+namespace PsyMP3 {
+namespace Core {
+namespace Utility {
+
+namespace {
+
+constexpr float kInt16Scale = 32768.0f;
+
+// Samples per block of dither noise or gathered channels. Even, so stereo
+// blocks hold whole frames; 8 KiB of stack between the two buffers.
+constexpr size_t kConvertBlockSamples = 1024;
+
+int16_t saturateRound(float v)
+{
+    if (!(v == v)) {
+        return 0;
+    }
+    if (v >= 32767.0f) {
+        return 32767;
+    }
+    if (v <= -32768.0f) {
+        return -32768;
+    }
+    return static_cast<int16_t>(std::lrint(v));
+}
+
+constexpr uint32_t kDitherMul = 1664525u;
+constexpr uint32_t kDitherAdd = 1013904223u;
+
+// Eight LCG steps as one: x -> mul * x + add
+struct LCGStep {
+    uint32_t mul;
+    uint32_t add;
+};
+
+constexpr LCGStep lcgStep8()
+{
+    LCGStep step{1, 0};
+    for (int i = 0; i < 8; ++i) {
+        step = {step.mul * kDitherMul, step.add * kDitherMul + kDitherAdd};
+    }
+    return step;
+}
+
+constexpr LCGStep kDitherStep8 = lcgStep8();
+
+float ditherUniform(uint32_t x)
+{
+    return static_cast<float>(x >> 8) * (1.0f / 16777216.0f);
+}
+
+// TPDF noise of ±1 LSB, in input units: the difference of two uniforms per
+// sample, drawn in order from one LCG. Eight interleaved lanes step the LCG
+// eight places at a time, which breaks the multiply chain but draws the
+// same sequence. Every implementation reads the noise from this buffer and
+// adds it before scaling, so no multiply feeds an add that the compiler
+// could fuse in one implementation and not another.
+void fillDitherNoise(Dither& dither, float lsb, float* noise, size_t count)
+{
+    uint32_t lanes[8];
+    uint32_t last = dither.state;
+    uint32_t state = dither.state;
+    for (uint32_t& lane : lanes) {
+        state = state * kDitherMul + kDitherAdd;
+        lane = state;
+    }
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        for (size_t k = 0; k < 4; ++k) {
+            noise[i + k] = (ditherUniform(lanes[2 * k]) - ditherUniform(lanes[2 * k + 1])) * lsb;
+        }
+        last = lanes[7];
+        for (uint32_t& lane : lanes) {
+            lane = lane * kDitherStep8.mul + kDitherStep8.add;
+        }
+    }
+    for (size_t used = 0; i < count; ++i, used += 2) {
+        noise[i] = (ditherUniform(lanes[used]) - ditherUniform(lanes[used + 1])) * lsb;
+        last = lanes[used + 1];
+    }
+    dither.state = last;
+}
+
+// A kernel converts contiguous samples, (in + noise) * scale, and
+// interleaves a stereo pair the same way. The driver below splits the
+// input into blocks and gathers more than two channels into one.
+struct ScalarConvertKernel {
+    static void convert(const float* in, const float* noise, size_t count, float scale, int16_t* out)
+    {
+        for (size_t i = 0; i < count; ++i) {
+            const float x = noise ? in[i] + noise[i] : in[i];
+            out[i] = saturateRound(x * scale);
+        }
+    }
+
+    static void interleaveStereo(const float* left, const float* right, const float* noise, size_t frames,
+                                 float scale, int16_t* out)
+    {
+        for (size_t i = 0; i < frames; ++i) {
+            const float l = noise ? left[i] + noise[2 * i] : left[i];
+            const float r = noise ? right[i] + noise[2 * i + 1] : right[i];
+            out[2 * i] = saturateRound(l * scale);
+            out[2 * i + 1] = saturateRound(r * scale);
+        }
+    }
+};
+
+template <typename Kernel>
+void convertPlanar(const float* const* planes, size_t frames, unsigned channels, int16_t* out,
+                   float gain, Dither* dither)
+{
+    if (channels == 0 || frames == 0) {
+        return;
+    }
+    const float scale = kInt16Scale * gain;
+    const bool dithered = dither && scale != 0.0f;
+    const size_t total = frames * channels;
+    float noise[kConvertBlockSamples];
+    float gathered[kConvertBlockSamples];
+    size_t frame = 0;
+    unsigned channel = 0;
+
+    for (size_t done = 0; done < total;) {
+        const size_t count = std::min(kConvertBlockSamples, total - done);
+        const float* block_noise = nullptr;
+        if (dithered) {
+            fillDitherNoise(*dither, 1.0f / scale, noise, count);
+            block_noise = noise;
+        }
+        if (channels == 1) {
+            Kernel::convert(planes[0] + done, block_noise, count, scale, out + done);
+        } else if (channels == 2) {
+            Kernel::interleaveStereo(planes[0] + done / 2, planes[1] + done / 2, block_noise, count / 2,
+                                     scale, out + done);
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                gathered[i] = planes[channel][frame];
+                if (++channel == channels) {
+                    channel = 0;
+                    ++frame;
+                }
+            }
+            Kernel::convert(gathered, block_noise, count, scale, out + done);
+        }
+        done += count;
+    }
+}
+
+#ifdef HAVE_SSE2
+// Zero NaN, clamp to the int16 range and round to nearest. The clamp keeps
+// cvtps from turning large values into INT32_MIN.
+__m128i roundToInt32SSE2(__m128 v)
+{
+    v = _mm_and_ps(v, _mm_cmpord_ps(v, v));
+    v = _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(-32768.0f)), _mm_set1_ps(32767.0f));
+    return _mm_cvtps_epi32(v);
+}
+
+__m128i convertPairSSE2(__m128 a, __m128 b, const float* noise, __m128 scale)
+{
+    if (noise) {
+        a = _mm_add_ps(a, _mm_loadu_ps(noise));
+        b = _mm_add_ps(b, _mm_loadu_ps(noise + 4));
+    }
+    return _mm_packs_epi32(roundToInt32SSE2(_mm_mul_ps(a, scale)), roundToInt32SSE2(_mm_mul_ps(b, scale)));
+}
+
+struct SSE2ConvertKernel {
+    static void convert(const float* in, const float* noise, size_t count, float scale, int16_t* out)
+    {
+        const __m128 vscale = _mm_set1_ps(scale);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m128i packed = convertPairSSE2(_mm_loadu_ps(in + i), _mm_loadu_ps(in + i + 4),
+                                                   noise ? noise + i : nullptr, vscale);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+        }
+        ScalarConvertKernel::convert(in + i, noise ? noise + i : nullptr, count - i, scale, out + i);
+    }
+
+    static void interleaveStereo(const float* left, const float* right, const float* noise, size_t frames,
+                                 float scale, int16_t* out)
+    {
+        const __m128 vscale = _mm_set1_ps(scale);
+        size_t i = 0;
+        for (; i + 4 <= frames; i += 4) {
+            const __m128 l = _mm_loadu_ps(left + i);
+            const __m128 r = _mm_loadu_ps(right + i);
+            const __m128i packed = convertPairSSE2(_mm_unpacklo_ps(l, r), _mm_unpackhi_ps(l, r),
+                                                   noise ? noise + 2 * i : nullptr, vscale);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), packed);
+        }
+        ScalarConvertKernel::interleaveStereo(left + i, right + i, noise ? noise + 2 * i : nullptr,
+                                              frames - i, scale, out + 2 * i);
+    }
+};
+#endif
+
+#ifdef HAVE_AVX2_TARGET
+__attribute__((target("avx2")))
+__m256i roundToInt32AVX2(__m256 v)
+{
+    v = _mm256_and_ps(v, _mm256_cmp_ps(v, v, _CMP_ORD_Q));
+    v = _mm256_min_ps(_mm256_max_ps(v, _mm256_set1_ps(-32768.0f)), _mm256_set1_ps(32767.0f));
+    return _mm256_cvtps_epi32(v);
+}
+
+// packs works within 128-bit lanes; the permute puts the halves in order
+__attribute__((target("avx2")))
+__m256i convertPairAVX2(__m256 a, __m256 b, const float* noise, __m256 scale)
+{
+    if (noise) {
+        a = _mm256_add_ps(a, _mm256_loadu_ps(noise));
+        b = _mm256_add_ps(b, _mm256_loadu_ps(noise + 8));
+    }
+    const __m256i packed = _mm256_packs_epi32(roundToInt32AVX2(_mm256_mul_ps(a, scale)),
+                                              roundToInt32AVX2(_mm256_mul_ps(b, scale)));
+    return _mm256_permute4x64_epi64(packed, 0xD8);
+}
+
+struct AVX2ConvertKernel {
+    __attribute__((target("avx2")))
+    static void convert(const float* in, const float* noise, size_t count, float scale, int16_t* out)
+    {
+        const __m256 vscale = _mm256_set1_ps(scale);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const __m256i packed = convertPairAVX2(_mm256_loadu_ps(in + i), _mm256_loadu_ps(in + i + 8),
+                                                   noise ? noise + i : nullptr, vscale);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), packed);
+        }
+        ScalarConvertKernel::convert(in + i, noise ? noise + i : nullptr, count - i, scale, out + i);
+    }
+
+    __attribute__((target("avx2")))
+    static void interleaveStereo(const float* left, const float* right, const float* noise, size_t frames,
+                                 float scale, int16_t* out)
+    {
+        const __m256 vscale = _mm256_set1_ps(scale);
+        size_t i = 0;
+        for (; i + 8 <= frames; i += 8) {
+            const __m256 l = _mm256_loadu_ps(left + i);
+            const __m256 r = _mm256_loadu_ps(right + i);
+            // unpack interleaves within lanes: frames 0,1,4,5 and 2,3,6,7
+            const __m256 lo = _mm256_unpacklo_ps(l, r);
+            const __m256 hi = _mm256_unpackhi_ps(l, r);
+            const __m256i packed = convertPairAVX2(_mm256_permute2f128_ps(lo, hi, 0x20),
+                                                   _mm256_permute2f128_ps(lo, hi, 0x31),
+                                                   noise ? noise + 2 * i : nullptr, vscale);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i), packed);
+        }
+        ScalarConvertKernel::interleaveStereo(left + i, right + i, noise ? noise + 2 * i : nullptr,
+                                              frames - i, scale, out + 2 * i);
+    }
+};
+#endif
+
+#if defined(HAVE_NEON) && defined(__aarch64__)
+// vcvtnq rounds to nearest even and maps NaN, which max/min pass through, to 0
+int16x8_t convertPairNEON(float32x4_t a, float32x4_t b, const float* noise, float32x4_t scale)
+{
+    if (noise) {
+        a = vaddq_f32(a, vld1q_f32(noise));
+        b = vaddq_f32(b, vld1q_f32(noise + 4));
+    }
+    const float32x4_t lo = vdupq_n_f32(-32768.0f);
+    const float32x4_t hi = vdupq_n_f32(32767.0f);
+    const int32x4_t ia = vcvtnq_s32_f32(vminq_f32(vmaxq_f32(vmulq_f32(a, scale), lo), hi));
+    const int32x4_t ib = vcvtnq_s32_f32(vminq_f32(vmaxq_f32(vmulq_f32(b, scale), lo), hi));
+    return vcombine_s16(vqmovn_s32(ia), vqmovn_s32(ib));
+}
+
+struct NEONConvertKernel {
+    static void convert(const float* in, const float* noise, size_t count, float scale, int16_t* out)
+    {
+        const float32x4_t vscale = vdupq_n_f32(scale);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            vst1q_s16(out + i, convertPairNEON(vld1q_f32(in + i), vld1q_f32(in + i + 4),
+                                               noise ? noise + i : nullptr, vscale));
+        }
+        ScalarConvertKernel::convert(in + i, noise ? noise + i : nullptr, count - i, scale, out + i);
+    }
+
+    static void interleaveStereo(const float* left, const float* right, const float* noise, size_t frames,
+                                 float scale, int16_t* out)
+    {
+        const float32x4_t vscale = vdupq_n_f32(scale);
+        size_t i = 0;
+        for (; i + 4 <= frames; i += 4) {
+            const float32x4x2_t zipped = vzipq_f32(vld1q_f32(left + i), vld1q_f32(right + i));
+            vst1q_s16(out + 2 * i, convertPairNEON(zipped.val[0], zipped.val[1],
+                                                   noise ? noise + 2 * i : nullptr, vscale));
+        }
+        ScalarConvertKernel::interleaveStereo(left + i, right + i, noise ? noise + 2 * i : nullptr,
+                                              frames - i, scale, out + 2 * i);
+    }
+};
+#endif
+
+struct SampleConvertKernels {
+    SampleConvert::PlanarFloatToInt16Fn planarFloatToInt16;
+    const char* name;
+};
+
+SampleConvertKernels selectSampleConvertKernels()
+{
+#ifdef HAVE_AVX2_TARGET
+    if (SampleConvert::hasAVX2()) {
+        return {SampleConvert::planarFloatToInt16AVX2, "avx2"};
+    }
+#endif
+#if defined(HAVE_SSE2)
+    return {SampleConvert::planarFloatToInt16SSE2, "sse2"};
+#elif defined(HAVE_NEON) && defined(__aarch64__)
+    return {SampleConvert::planarFloatToInt16NEON, "neon"};
+#else
+    return {SampleConvert::planarFloatToInt16Scalar, "scalar"};
+#endif
+}
+
+const SampleConvertKernels& sampleConvertKernels()
+{
+    static const SampleConvertKernels kernels = selectSampleConvertKernels();
+    return kernels;
+}
+
+} // namespace
+
+void SampleConvert::planarFloatToInt16(const float* const* planes, size_t frames, unsigned channels,
+                                       int16_t* out, float gain, Dither* dither)
+{
+    sampleConvertKernels().planarFloatToInt16(planes, frames, channels, out, gain, dither);
+}
+
+void SampleConvert::floatToInt16(const float* in, size_t count, int16_t* out, float gain, Dither* dither)
+{
+    sampleConvertKernels().planarFloatToInt16(&in, count, 1, out, gain, dither);
+}
+
+int16_t SampleConvert::floatToInt16(float sample)
+{
+    return saturateRound(sample * kInt16Scale);
+}
+
+const char* SampleConvert::implementation()
+{
+    return sampleConvertKernels().name;
+}
+
+void SampleConvert::planarFloatToInt16Scalar(const float* const* planes, size_t frames, unsigned channels,
+                                             int16_t* out, float gain, Dither* dither)
+{
+    convertPlanar<ScalarConvertKernel>(planes, frames, channels, out, gain, dither);
+}
+
+void SampleConvert::planarFloatToInt16SSE2(const float* const* planes, size_t frames, unsigned channels,
+                                           int16_t* out, float gain, Dither* dither)
+{
+#ifdef HAVE_SSE2
+    convertPlanar<SSE2ConvertKernel>(planes, frames, channels, out, gain, dither);
+#else
+    planarFloatToInt16Scalar(planes, frames, channels, out, gain, dither);
+#endif
+}
+
+bool SampleConvert::hasAVX2()
+{
+#ifdef HAVE_AVX2_TARGET
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+void SampleConvert::planarFloatToInt16AVX2(const float* const* planes, size_t frames, unsigned channels,
+                                           int16_t* out, float gain, Dither* dither)
+{
+#ifdef HAVE_AVX2_TARGET
+    convertPlanar<AVX2ConvertKernel>(planes, frames, channels, out, gain, dither);
+#else
+    planarFloatToInt16SSE2(planes, frames, channels, out, gain, dither);
+#endif
+}
+
+void SampleConvert::planarFloatToInt16NEON(const float* const* planes, size_t frames, unsigned channels,
+                                           int16_t* out, float gain, Dither* dither)
+{
+#if defined(HAVE_NEON) && defined(__aarch64__)
+    convertPlanar<NEONConvertKernel>(planes, frames, channels, out, gain, dither);
+#else
+    planarFloatToInt16Scalar(planes, frames, channels, out, gain, dither);
+#endif
+}
+
+} // namespace Utility
+} // namespace Core
+} // namespace PsyMP3
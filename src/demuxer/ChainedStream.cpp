@@ -154,20 +154,46 @@ void ChainedStream::open([[maybe_unused]] TagLib::String name)
 size_t ChainedStream::getData(size_t len, void *buf)
 {
     std::lock_guard<std::mutex> lock(m_chain_mutex);
-    char *current_buf = static_cast<char *>(buf);
-    size_t bytes_remaining = len;
-    size_t total_bytes_read = 0;
+    return readChain_unlocked(static_cast<char *>(buf), len,
+                              [](Stream *stream, char *dst, size_t n) {
+                                  return stream->getData(n, dst);
+                              });
+}
+
+/**
+ * @brief Float counterpart of getData(); counts are samples, not bytes.
+ *
+ * Forwards to each track's getDataFloat() so high-resolution tracks keep
+ * their resolution across the chain.
+ */
+size_t ChainedStream::getDataFloat(size_t count, float *buf)
+{
+    std::lock_guard<std::mutex> lock(m_chain_mutex);
+    return readChain_unlocked(buf, count,
+                              [](Stream *stream, float *dst, size_t n) {
+                                  return stream->getDataFloat(n, dst);
+                              });
+}
+
+template<typename T, typename ReadFn>
+size_t ChainedStream::readChain_unlocked(T *out, size_t count, ReadFn read)
+{
+    size_t remaining = count;
+    size_t total_read = 0;
 
-    while (bytes_remaining > 0) {
+    while (remaining > 0) {
         if (!m_current_stream) {
             // No current stream, we've reached the end of the chain.
             break;
         }
 
-        size_t bytes_read_this_call = m_current_stream->getData(bytes_remaining, current_buf);
-        total_bytes_read += bytes_read_this_call;
-        current_buf += bytes_read_this_call;
-        bytes_remaining -= bytes_read_this_call;
+        // m_current_track_index is one past the open track
+        const size_t track = m_current_track_index - 1;
+        setPlaybackGain(track < m_track_gains.size() ? m_track_gains[track] : 1.0f);
+
+        size_t read_this_call = read(m_current_stream.get(), out + total_read, remaining);
+        total_read += read_this_call;
+        remaining -= read_this_call;
 
         if (m_current_stream->eof()) {
             // Current track finished, try to open the next one.
@@ -175,11 +201,16 @@ size_t ChainedStream::getData(size_t len, void *buf)
                 // No more tracks in the chain, we are done.
                 break;
             }
+            // Stop at the boundary so the caller applies each track's gain
+            // to its own samples only.
+            if (total_read > 0) {
+                break;
+            }
         }
 
         // If getData returned less than requested but we are not at EOF (e.g. buffer underrun),
         // we should break to avoid a tight loop. The caller will call again.
-        if (bytes_read_this_call == 0 && !m_current_stream->eof()) {
+        if (read_this_call == 0 && m_current_stream && !m_current_stream->eof()) {
             break;
         }
     }
@@ -190,7 +221,22 @@ size_t ChainedStream::getData(size_t len, void *buf)
         m_position = (m_sposition * 1000) / m_rate;
     }
 
-    return total_bytes_read;
+    return total_read;
+}
+
+/**
+ * @brief Sets the playback gain of each track in the chain.
+ *
+ * Called by the loader before the stream is handed to Audio. The gain of the
+ * track being read is published through getPlaybackGain().
+ * @param gains Linear gains in path order; missing entries mean 1.0.
+ */
+void ChainedStream::setTrackGains(std::vector<float> gains)
+{
+    std::lock_guard<std::mutex> lock(m_chain_mutex);
+    m_track_gains = std::move(gains);
+    const size_t track = m_current_track_index > 0 ? m_current_track_index - 1 : 0;
+    setPlaybackGain(track < m_track_gains.size() ? m_track_gains[track] : 1.0f);
 }
 
 /**
@@ -44,6 +44,10 @@ bool ChunkDemuxer::parseContainer() {
         
         // Read form type using detected endianness
         m_form_type = readChunkValue<uint32_t>();
+        if (m_form_type == AIFC_FOURCC) {
+            // AIFF-C uses the same chunks; COMM adds the compression type
+            m_form_type = AIFF_FOURCC;
+        }
         
         Debug::log("chunk", "ChunkDemuxer: Container=0x", std::hex, m_container_fourcc, 
                    ", Form=0x", m_form_type, std::dec, ", BigEndian=", m_big_endian);
@@ -196,6 +200,11 @@ std::vector<StreamInfo> ChunkDemuxer::getStreams() const {
         info.codec_type = "audio";
         info.codec_name = getCodecName(audio_data);
         info.codec_tag = audio_data.format_tag;
+        if (m_form_type == AIFF_FOURCC && audio_data.format_tag == WAVE_FORMAT_PCM) {
+            // The compression type tells PCMCodec the byte order and
+            // whether the samples are float
+            info.codec_tag = audio_data.compression_type;
+        }
         info.sample_rate = audio_data.sample_rate;
         info.channels = audio_data.channels;
         info.bits_per_sample = audio_data.bits_per_sample;
@@ -527,11 +536,14 @@ std::string ChunkDemuxer::formatTagToCodecName(uint16_t format_tag) const {
 std::string ChunkDemuxer::aiffCompressionToCodecName(uint32_t compression) const {
     switch (compression) {
         case AIFF_NONE:
+        case AIFF_TWOS:
             return "pcm";
         case AIFF_SOWT:
             return "pcm"; // Byte-swapped PCM
         case AIFF_FL32:
         case AIFF_FL64:
+        case AIFF_FL32_UPPER:
+        case AIFF_FL64_UPPER:
             return "pcm"; // Float PCM
         case AIFF_ALAW:
             return "alaw";
@@ -588,9 +600,12 @@ bool ChunkDemuxer::parseAiffCommon(const Chunk& chunk) {
     // Convert compression to format tag for compatibility
     switch (stream_data.compression_type) {
         case AIFF_NONE:
+        case AIFF_TWOS:
         case AIFF_SOWT:
         case AIFF_FL32:
         case AIFF_FL64:
+        case AIFF_FL32_UPPER:
+        case AIFF_FL64_UPPER:
             stream_data.format_tag = WAVE_FORMAT_PCM;
             break;
         case AIFF_ALAW:
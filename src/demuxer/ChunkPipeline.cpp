@@ -0,0 +1,220 @@
+/*
+ * ChunkPipeline.cpp - Read-ahead demux stage feeding DemuxedStream's codec.
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill II <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#include "psymp3.h"
+
+namespace PsyMP3 {
+namespace Demuxer {
+
+namespace {
+// Consecutive empty reads, without the demuxer reporting EOF, after which the
+// stream is treated as ended; DemuxedStream gives up on empty frames at the
+// same count.
+constexpr size_t kMaxEmptyChunkReads = 32;
+// Pause between such reads, so a demuxer that is briefly starved (a network
+// stall) is not spun on.
+constexpr auto kEmptyChunkRetryInterval = std::chrono::milliseconds(2);
+} // namespace
+
+ChunkPipeline::ChunkPipeline(Demuxer& demuxer, uint32_t stream_id)
+    : m_demuxer(demuxer),
+      m_stream_id(stream_id)
+{
+    m_thread = std::thread(&ChunkPipeline::demuxLoop, this);
+}
+
+ChunkPipeline::~ChunkPipeline()
+{
+    stop();
+}
+
+void ChunkPipeline::stop()
+{
+    m_stop.store(true);
+    wake();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void ChunkPipeline::wake()
+{
+    // Taking the mutex orders the state change before any waiter's predicate
+    // check, so no wakeup is lost.
+    { std::lock_guard<std::mutex> lock(m_wait_mutex); }
+    m_wait_cv.notify_all();
+}
+
+void ChunkPipeline::demuxLoop()
+{
+    System::setThisThreadName("demux-readahead");
+    System::setThreadPriority(System::ThreadPriority::High);
+
+    uint64_t empty_epoch = kNoEpoch;
+    size_t empty_reads = 0;
+    while (!m_stop.load()) {
+        MediaChunk chunk;
+        uint64_t epoch;
+        bool ended = false;
+        {
+            std::lock_guard<std::mutex> lock(m_demux_mutex);
+            epoch = m_epoch.load();
+            ended = m_end_epoch.load() == epoch;
+            if (!ended) {
+                if (!m_demuxer.isEOF()) {
+                    chunk = m_demuxer.readChunk(m_stream_id);
+                }
+                if (chunk.isValid()) {
+                    empty_reads = 0;
+                } else {
+                    if (empty_epoch != epoch) {
+                        empty_epoch = epoch;
+                        empty_reads = 0;
+                    }
+                    ended = m_demuxer.isEOF() || ++empty_reads >= kMaxEmptyChunkReads;
+                    if (ended) {
+                        // Release: every chunk of this epoch is published first.
+                        m_end_epoch.store(epoch, std::memory_order_release);
+                        Debug::log("demux", "ChunkPipeline: demuxer exhausted (epoch ", epoch, ")");
+                    }
+                }
+            }
+        }
+
+        if (chunk.isValid()) {
+            if (!push(chunk, epoch) && m_stop.load() && m_epoch.load() == epoch) {
+                m_leftover = std::move(chunk);
+                m_leftover_epoch = epoch;
+            }
+            continue;
+        }
+
+        wake(); // a consumer may be waiting for the end
+        std::unique_lock<std::mutex> lock(m_wait_mutex);
+        const auto moved_on = [this, epoch] { return m_stop.load() || m_epoch.load() != epoch; };
+        if (ended) {
+            m_wait_cv.wait(lock, moved_on);
+        } else {
+            m_wait_cv.wait_for(lock, kEmptyChunkRetryInterval, moved_on);
+        }
+    }
+}
+
+bool ChunkPipeline::push(MediaChunk& chunk, uint64_t epoch)
+{
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    {
+        std::unique_lock<std::mutex> lock(m_wait_mutex);
+        m_wait_cv.wait(lock, [this, tail, epoch] {
+            return tail - m_head.load(std::memory_order_acquire) < kCapacity
+                || m_stop.load() || m_epoch.load() != epoch;
+        });
+    }
+    if (m_stop.load() || m_epoch.load() != epoch) {
+        return false;
+    }
+    Slot& slot = m_slots[tail % kCapacity];
+    slot.chunk = std::move(chunk);
+    slot.epoch = epoch;
+    m_tail.store(tail + 1, std::memory_order_release);
+    wake();
+    return true;
+}
+
+bool ChunkPipeline::popCurrent(MediaChunk& out)
+{
+    const uint64_t epoch = m_epoch.load();
+    size_t head = m_head.load(std::memory_order_relaxed);
+    while (head != m_tail.load(std::memory_order_acquire)) {
+        Slot& slot = m_slots[head % kCapacity];
+        const bool current = slot.epoch == epoch;
+        if (current) {
+            out = std::move(slot.chunk);
+        }
+        slot.chunk = MediaChunk{}; // a stale chunk's buffer goes now, not on reuse
+        m_head.store(++head, std::memory_order_release);
+        wake();
+        if (current) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ChunkPipeline::pop(MediaChunk& out)
+{
+    while (true) {
+        if (popCurrent(out)) {
+            return true;
+        }
+        if (m_end_epoch.load(std::memory_order_acquire) == m_epoch.load()) {
+            return popCurrent(out);
+        }
+        if (m_stop.load()) {
+            return tryPop(out);
+        }
+        std::unique_lock<std::mutex> lock(m_wait_mutex);
+        m_wait_cv.wait(lock, [this] {
+            return m_head.load() != m_tail.load()
+                || m_end_epoch.load() == m_epoch.load() || m_stop.load();
+        });
+    }
+}
+
+bool ChunkPipeline::tryPop(MediaChunk& out)
+{
+    if (popCurrent(out)) {
+        return true;
+    }
+    // Only once stop() has joined the demux thread is the leftover ours.
+    if (!m_thread.joinable() && m_leftover && m_leftover_epoch == m_epoch.load()) {
+        out = std::move(*m_leftover);
+        m_leftover.reset();
+        return true;
+    }
+    return false;
+}
+
+bool ChunkPipeline::finished()
+{
+    if (m_end_epoch.load(std::memory_order_acquire) != m_epoch.load()) {
+        return false;
+    }
+    // Drop stale chunks so only this epoch's count.
+    const uint64_t epoch = m_epoch.load();
+    size_t head = m_head.load(std::memory_order_relaxed);
+    while (head != m_tail.load(std::memory_order_acquire)) {
+        Slot& slot = m_slots[head % kCapacity];
+        if (slot.epoch == epoch) {
+            return false;
+        }
+        slot.chunk = MediaChunk{};
+        m_head.store(++head, std::memory_order_release);
+    }
+    wake();
+    return true;
+}
+
+void ChunkPipeline::reposition(uint32_t stream_id, const std::function<void(Demuxer&)>& action)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_demux_mutex);
+        if (action) {
+            action(m_demuxer);
+        }
+        m_stream_id = stream_id;
+        m_epoch.fetch_add(1);
+    }
+    m_leftover.reset();
+    wake();
+    Debug::log("demux", "ChunkPipeline: repositioned, epoch ", m_epoch.load());
+}
+
+} // namespace Demuxer
+} // namespace PsyMP3
@@ -27,6 +27,64 @@ DemuxedStream::DemuxedStream(std::unique_ptr<IOHandler> handler, const TagLib::S
     if (!initializeWithHandler(std::move(handler))) {
         throw InvalidMediaException("Failed to initialize demuxed stream for: " + path);
     }
+    // Network reads stall for a round trip; keep them off the decode path.
+    if (MediaFactory::isHttpUri(path.to8Bit(true))) {
+        setPipelined(true);
+    }
+}
+
+DemuxedStream::~DemuxedStream() {
+    // Nothing decodes any more; the next track of this format can take it
+    CodecPool::getInstance().release(std::move(m_codec));
+}
+
+void DemuxedStream::setPipelined(bool enable) {
+    std::lock_guard<std::mutex> decode_lock(m_decode_mutex);
+    if (enable == static_cast<bool>(m_pipeline) || !m_demuxer) {
+        return;
+    }
+    if (enable) {
+        // Chunks already in m_chunk_buffer were read first and are decoded
+        // first; the pipeline continues from the demuxer's position.
+        m_pipeline = std::make_unique<ChunkPipeline>(*m_demuxer, m_current_stream_id);
+    } else {
+        // Take back what the demux stage read ahead, or it would be skipped.
+        m_pipeline->stop();
+        std::lock_guard<std::mutex> lock(m_buffer_mutex);
+        MediaChunk chunk;
+        while (m_pipeline->tryPop(chunk)) {
+            m_current_buffer_bytes += chunk.data.size();
+            m_chunk_buffer.push(std::move(chunk));
+        }
+        m_pipeline.reset();
+    }
+    Debug::log("demux", "DemuxedStream: pipelined demux ", enable ? "enabled" : "disabled");
+}
+
+bool DemuxedStream::isPipelined() const {
+    std::lock_guard<std::mutex> decode_lock(m_decode_mutex);
+    return static_cast<bool>(m_pipeline);
+}
+
+void DemuxedStream::setParallelDecode(unsigned threads) {
+    std::lock_guard<std::mutex> decode_lock(m_decode_mutex);
+    m_parallel_threads = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+    Debug::log("demux", "DemuxedStream: parallel decode on ", m_parallel_threads, " threads");
+}
+
+bool DemuxedStream::demuxerExhausted() {
+    if (m_pipeline) {
+        return m_pipeline->finished();
+    }
+    return !m_demuxer || m_demuxer->isEOF();
+}
+
+void DemuxedStream::repositionDemuxer(uint32_t stream_id, const std::function<void(Demuxer&)>& action) {
+    if (m_pipeline) {
+        m_pipeline->reposition(stream_id, action);
+    } else if (action) {
+        action(*m_demuxer);
+    }
 }
 
 bool DemuxedStream::initialize() {
@@ -115,16 +173,16 @@ bool DemuxedStream::setupCodec() {
         return false;
     }
     
-    m_codec = AudioCodecFactory::createCodec(stream_info);
+    // The previous stream's codec may serve this one; either way it goes back
+    // to the pool, and the pool hands out an initialized codec or none.
+    CodecPool::getInstance().release(std::move(m_codec));
+    m_codec = CodecPool::getInstance().acquire(stream_info);
     if (!m_codec) {
-        Debug::log("demux", "DemuxedStream::setupCodec() failed: createCodec returned nullptr for codec_name=", stream_info.codec_name);
+        Debug::log("demux", "DemuxedStream::setupCodec() failed: no codec initialized for codec_name=", stream_info.codec_name);
         return false;
     }
-    Debug::log("demux", "DemuxedStream::setupCodec() codec created, type=", m_codec->getCodecName());
-    
-    bool init_result = m_codec->initialize();
-    Debug::log("demux", "DemuxedStream::setupCodec() codec->initialize() returned ", init_result);
-    return init_result;
+    Debug::log("demux", "DemuxedStream::setupCodec() codec ready, type=", m_codec->getCodecName());
+    return true;
 }
 
 void DemuxedStream::updateStreamProperties() {
@@ -146,35 +204,68 @@ size_t DemuxedStream::getData(size_t len, void *buf) {
     // Serialize the entire decode path against seekTo so a concurrent seek
     // cannot clear m_current_frame / the chunk buffers mid-decode.
     std::lock_guard<std::mutex> decode_lock(m_decode_mutex);
+    return readSamples_unlocked(static_cast<int16_t*>(buf), len / sizeof(int16_t)) * sizeof(int16_t);
+}
+
+size_t DemuxedStream::getDataFloat(size_t count, float *buf) {
+    std::lock_guard<std::mutex> decode_lock(m_decode_mutex);
+    // A float consumer can take the codec's full resolution; ask for it. Codecs
+    // that cannot provide it keep producing int16 frames, converted below.
+    if (m_codec && !m_codec->wantsFloatOutput()) {
+        m_codec->setFloatOutput(true);
+    }
+    return readSamples_unlocked(buf, count);
+}
+
+size_t DemuxedStream::getDataInto(float *first, size_t first_count,
+                                  float *second, size_t second_count) {
+    // One decode-lock hold for both pieces, and frames are copied straight
+    // into the caller's memory (Audio passes its ring's free space).
+    std::lock_guard<std::mutex> decode_lock(m_decode_mutex);
+    if (m_codec && !m_codec->wantsFloatOutput()) {
+        m_codec->setFloatOutput(true);
+    }
+    size_t done = readSamples_unlocked(first, first_count);
+    if (done == first_count && second_count > 0) {
+        done += readSamples_unlocked(second, second_count);
+    }
+    return done;
+}
+
+template<typename T>
+size_t DemuxedStream::readSamples_unlocked(T* out, size_t count) {
     if (m_eof_reached || !m_codec) {
         return 0;
     }
     
-    uint8_t* output_buf = static_cast<uint8_t*>(buf);
-    size_t bytes_written = 0;
+    size_t samples_written = 0;
     size_t consecutive_empty_frames = 0;
     
-    while (bytes_written < len && !m_eof_reached) {
+    while (samples_written < count && !m_eof_reached) {
         // If we have a current frame with remaining data, use it
-        if (m_current_frame_offset < m_current_frame.getByteCount()) {
-            size_t bytes_copied = copyFrameData(m_current_frame, m_current_frame_offset,
-                                               output_buf + bytes_written, len - bytes_written);
-            bytes_written += bytes_copied;
-            m_current_frame_offset += bytes_copied;
+        if (m_current_frame_offset < m_current_frame.getSampleCount()) {
+            size_t samples_copied = copyFrameData(m_current_frame, m_current_frame_offset,
+                                                  out + samples_written, count - samples_written);
+            samples_written += samples_copied;
+            m_current_frame_offset += samples_copied;
             
             // Note: m_samples_consumed is now updated when we get new frames,
             // not when we copy data to output buffer
             continue;
         }
         
-        // Need a new frame - decode on-demand from buffered chunks
+        // Need a new frame - decode on-demand from buffered chunks. The spent
+        // frame's buffer goes back for the next decodeInto().
+        if (m_current_frame.samples.capacity() > m_decode_buffer.capacity()) {
+            m_decode_buffer.swap(m_current_frame.samples);
+        }
         m_current_frame = getNextFrame();
         m_current_frame_offset = 0;
         
         // Note: m_samples_consumed is now updated inside getNextFrame() 
         // based on granule positions or incremental counting
         
-        if (m_current_frame.samples.empty()) {
+        if (!m_current_frame.hasSamples()) {
             // Empty frame could be from header processing or actual EOF
             // Check if we have more chunks to process before declaring EOF
             size_t buffer_size = 0;
@@ -182,8 +273,9 @@ size_t DemuxedStream::getData(size_t len, void *buf) {
                 std::lock_guard<std::mutex> lock(m_buffer_mutex);
                 buffer_size = m_chunk_buffer.size();
             }
+            const bool demuxer_eof = demuxerExhausted();
             Debug::log("demux", "DemuxedStream::getData: Empty frame - chunk_buffer.size()=", buffer_size, 
-                               ", demuxer.isEOF()=", m_demuxer ? m_demuxer->isEOF() : true);
+                               ", demuxer.isEOF()=", demuxer_eof);
             
             // Try to get more chunks before declaring EOF
             fillChunkBuffer();
@@ -203,7 +295,7 @@ size_t DemuxedStream::getData(size_t len, void *buf) {
                 break;
             }
             
-            if (buffer_empty && m_demuxer && m_demuxer->isEOF()) {
+            if (buffer_empty && demuxerExhausted()) {
                 // Truly at EOF - no more chunks and demuxer is done
                 // Use current position from frame timestamps, not sample counter
                 uint64_t current_time_ms = static_cast<uint64_t>(m_position);
@@ -213,7 +305,7 @@ size_t DemuxedStream::getData(size_t len, void *buf) {
                 m_eof_reached = true;
                 m_eof = true;
                 break;
-            } else if (buffer_empty && m_demuxer && !m_demuxer->isEOF()) {
+            } else if (buffer_empty) {
                 // No chunks buffered but demuxer has more data - this shouldn't happen in normal operation
                 Debug::log("demux", "DemuxedStream::getData: Buffer empty but demuxer has more data - unexpected condition");
                 continue;
@@ -231,10 +323,23 @@ size_t DemuxedStream::getData(size_t len, void *buf) {
     // Position is updated when we process new frames (see above)
     // Don't recalculate based on sample counting as it can drift
     
-    return bytes_written;
+    return samples_written;
 }
 
 AudioFrame DemuxedStream::getNextFrame() {
+    // Batch only when asked to; playback stays on the one-frame path
+    if (m_decoded_frames.empty() && m_parallel_threads > 1 &&
+        m_codec && m_codec->supportsParallelDecode()) {
+        decodeBatch(m_parallel_threads);
+    }
+    if (!m_decoded_frames.empty()) {
+        AudioFrame frame = std::move(m_decoded_frames.front().first);
+        const uint64_t granule_position = m_decoded_frames.front().second;
+        m_decoded_frames.pop_front();
+        stampFrame(frame, granule_position);
+        return frame;
+    }
+    
     // Ensure we have buffered chunks to decode from
     fillChunkBuffer();
     
@@ -245,8 +350,6 @@ AudioFrame DemuxedStream::getNextFrame() {
     }
     Debug::log("demux", "DemuxedStream::getNextFrame: After fillChunkBuffer, buffer size=", buffer_size_after_fill);
     
-    Debug::log("demux", "DemuxedStream::getNextFrame: chunk_buffer size=", buffer_size_after_fill, 
-                   ", demuxer EOF=", m_demuxer ? m_demuxer->isEOF() : true);
     
     // Thread-safe access to chunk buffer
     MediaChunk chunk;
@@ -284,38 +387,10 @@ AudioFrame DemuxedStream::getNextFrame() {
             }
         }
         
-        AudioFrame frame = m_codec->decode(chunk);
-        if (!frame.samples.empty()) {
-            if (m_codec->getCodecName() == "opus") {
-                if (chunk.granule_position != 0 && chunk.granule_position != static_cast<uint64_t>(-1)) {
-                    m_samples_consumed = frame.timestamp_samples + frame.getSampleFrameCount();
-                } else {
-                    frame.timestamp_samples = m_samples_consumed;
-                    m_samples_consumed += frame.getSampleFrameCount();
-                }
-            } else {
-                // Correct timestamp calculation for non-Opus Ogg codecs.
-                // For Ogg Vorbis, granule position is only valid on the last packet of each page.
-                if (chunk.granule_position != 0 && chunk.granule_position != static_cast<uint64_t>(-1)) {
-                    frame.timestamp_samples = chunk.granule_position - frame.getSampleFrameCount();
-                    m_samples_consumed = chunk.granule_position;
-                } else {
-                    frame.timestamp_samples = m_samples_consumed;
-                    m_samples_consumed += frame.getSampleFrameCount();
-                }
-            }
-            frame.timestamp_ms = (m_rate > 0) ? (frame.timestamp_samples * 1000) / m_rate : 0;
-
-            // Advance the reported stream position from the decoded frame's
-            // timestamp. Previously m_position/m_sposition were written only by
-            // updateStreamProperties() (0) and seekTo() (target), so
-            // getPosition()/getSPosition() were frozen during playback — which
-            // also made the seek-error monitor compare a seek target against
-            // itself and broke keyboard-seek origin and Winamp IPC position.
-            m_position = static_cast<int>(frame.timestamp_ms);
-            m_sposition = frame.timestamp_samples;
-
-            Debug::log("demux", "DemuxedStream: On-demand decoded frame with ", frame.samples.size(), " samples. Timestamp: ", frame.timestamp_ms, "ms");
+        AudioFrame frame = decodeChunk(chunk);
+        if (frame.hasSamples()) {
+            stampFrame(frame, chunk.granule_position);
+            Debug::log("demux", "DemuxedStream: On-demand decoded frame with ", frame.getSampleCount(), " samples. Timestamp: ", frame.timestamp_ms, "ms");
             return frame;
         } else {
             Debug::log("demux", "DemuxedStream: Codec returned empty frame for chunk size=", chunk_size);
@@ -325,11 +400,11 @@ AudioFrame DemuxedStream::getNextFrame() {
     }
     
     // If we reach here and demuxer is at EOF, flush codec
-    if (m_demuxer && m_demuxer->isEOF() && m_codec) {
+    if (m_codec && demuxerExhausted()) {
         Debug::log("demux", "DemuxedStream: Attempting to flush codec");
         AudioFrame frame = m_codec->flush();
-        if (!frame.samples.empty()) {
-            Debug::log("demux", "DemuxedStream: Flushed frame with ", frame.samples.size(), " samples");
+        if (frame.hasSamples()) {
+            Debug::log("demux", "DemuxedStream: Flushed frame with ", frame.getSampleCount(), " samples");
             return frame;
         }
     }
@@ -338,7 +413,101 @@ AudioFrame DemuxedStream::getNextFrame() {
     return AudioFrame{}; // Empty frame
 }
 
+bool DemuxedStream::decodeBatch(unsigned threads) {
+    const size_t batch_size = threads * BATCH_FRAMES_PER_THREAD;
+    std::vector<MediaChunk> chunks;
+    chunks.reserve(batch_size);
+    while (chunks.size() < batch_size) {
+        fillChunkBuffer();
+        std::lock_guard<std::mutex> lock(m_buffer_mutex);
+        if (m_chunk_buffer.empty()) {
+            break;
+        }
+        while (!m_chunk_buffer.empty() && chunks.size() < batch_size) {
+            m_current_buffer_bytes -= m_chunk_buffer.front().data.size();
+            chunks.push_back(std::move(m_chunk_buffer.front()));
+            m_chunk_buffer.pop();
+        }
+    }
+    if (chunks.empty()) {
+        return false;
+    }
+    
+    std::vector<AudioFrame> frames = m_codec->decodeBatch(chunks, threads);
+    for (size_t i = 0; i < frames.size() && i < chunks.size(); ++i) {
+        if (frames[i].hasSamples()) {
+            m_decoded_frames.emplace_back(std::move(frames[i]), chunks[i].granule_position);
+        }
+    }
+    Debug::log("demux", "DemuxedStream: Batch decoded ", m_decoded_frames.size(), " of ",
+               chunks.size(), " chunks on ", threads, " threads");
+    return !m_decoded_frames.empty();
+}
+
+AudioFrame DemuxedStream::decodeChunk(const MediaChunk& chunk) {
+    const size_t max_samples = m_codec->getMaxFrameSamples();
+    if (max_samples == 0) {
+        return m_codec->decode(chunk);
+    }
+
+    // Once m_decode_buffer and m_current_frame have each grown to a frame,
+    // this allocates nothing
+    if (m_decode_buffer.size() < max_samples) {
+        m_decode_buffer.resize(max_samples);
+    }
+    const DecodedAudio decoded = m_codec->decodeInto(chunk, m_decode_buffer.data(), m_decode_buffer.size());
+    AudioFrame frame;
+    if (decoded.samples == 0) {
+        return frame;
+    }
+    m_decode_buffer.resize(decoded.samples);
+    frame.samples.swap(m_decode_buffer);
+    frame.sample_rate = decoded.sample_rate;
+    frame.channels = decoded.channels;
+    frame.timestamp_samples = decoded.timestamp_samples;
+    if (decoded.sample_rate != 0) {
+        frame.timestamp_ms = (decoded.timestamp_samples * 1000ULL) / decoded.sample_rate;
+    }
+    return frame;
+}
+
+void DemuxedStream::stampFrame(AudioFrame& frame, uint64_t granule_position) {
+    if (m_codec->getCodecName() == "opus") {
+        if (granule_position != 0 && granule_position != static_cast<uint64_t>(-1)) {
+            m_samples_consumed = frame.timestamp_samples + frame.getSampleFrameCount();
+        } else {
+            frame.timestamp_samples = m_samples_consumed;
+            m_samples_consumed += frame.getSampleFrameCount();
+        }
+    } else {
+        // Correct timestamp calculation for non-Opus Ogg codecs.
+        // For Ogg Vorbis, granule position is only valid on the last packet of each page.
+        if (granule_position != 0 && granule_position != static_cast<uint64_t>(-1)) {
+            frame.timestamp_samples = granule_position - frame.getSampleFrameCount();
+            m_samples_consumed = granule_position;
+        } else {
+            frame.timestamp_samples = m_samples_consumed;
+            m_samples_consumed += frame.getSampleFrameCount();
+        }
+    }
+    frame.timestamp_ms = (m_rate > 0) ? (frame.timestamp_samples * 1000) / m_rate : 0;
+
+    // Advance the reported stream position from the decoded frame's
+    // timestamp. Previously m_position/m_sposition were written only by
+    // updateStreamProperties() (0) and seekTo() (target), so
+    // getPosition()/getSPosition() were frozen during playback — which
+    // also made the seek-error monitor compare a seek target against
+    // itself and broke keyboard-seek origin and Winamp IPC position.
+    m_position = static_cast<int>(frame.timestamp_ms);
+    m_sposition = frame.timestamp_samples;
+}
+
 void DemuxedStream::fillChunkBuffer() {
+    if (m_pipeline) {
+        fillChunkBufferFromPipeline();
+        return;
+    }
+    
     // Use simple bounded buffering with memory pressure awareness
     size_t max_chunks = MAX_CHUNK_BUFFER_SIZE;
     size_t max_bytes = MAX_CHUNK_BUFFER_BYTES;
@@ -399,20 +568,62 @@ void DemuxedStream::fillChunkBuffer() {
     }
 }
 
-size_t DemuxedStream::copyFrameData(const AudioFrame& frame, size_t frame_offset, 
-                                   void* output_buf, size_t output_len) {
-    size_t frame_bytes = frame.getByteCount();
-    if (frame_offset >= frame_bytes) {
+void DemuxedStream::fillChunkBufferFromPipeline() {
+    // The demux stage is already bounded; this only hands its chunks to the
+    // decode loop. Waiting is limited to an empty buffer, where the old path
+    // would have blocked in readChunk() anyway.
+    std::lock_guard<std::mutex> lock(m_buffer_mutex);
+    MediaChunk chunk;
+    while (m_chunk_buffer.size() < MAX_CHUNK_BUFFER_SIZE) {
+        const bool got = m_chunk_buffer.empty() ? m_pipeline->pop(chunk) : m_pipeline->tryPop(chunk);
+        if (!got) {
+            break;
+        }
+        m_current_buffer_bytes += chunk.data.size();
+        m_chunk_buffer.push(std::move(chunk));
+    }
+}
+
+size_t DemuxedStream::copyFrameData(const AudioFrame& frame, size_t frame_offset,
+                                    int16_t* output, size_t output_count) {
+    const size_t available = frame.getSampleCount();
+    if (frame_offset >= available) {
         return 0;
     }
-    
-    size_t bytes_available = frame_bytes - frame_offset;
-    size_t bytes_to_copy = std::min(bytes_available, output_len);
-    
-    const uint8_t* frame_data = reinterpret_cast<const uint8_t*>(frame.samples.data());
-    std::memcpy(output_buf, frame_data + frame_offset, bytes_to_copy);
-    
-    return bytes_to_copy;
+    const size_t n = std::min(available - frame_offset, output_count);
+
+    if (!frame.isFloat()) {
+        std::memcpy(output, frame.samples.data() + frame_offset, n * sizeof(int16_t));
+        return n;
+    }
+    // A 16-bit consumer of a high-resolution frame: round to nearest and clamp.
+    const float* src = frame.float_samples.data() + frame_offset;
+    for (size_t i = 0; i < n; ++i) {
+        const float v = src[i] * 32768.0f;
+        output[i] = v >= 32767.0f ? int16_t(32767)
+                  : v <= -32768.0f ? int16_t(-32768)
+                  : static_cast<int16_t>(std::lrint(v));
+    }
+    return n;
+}
+
+size_t DemuxedStream::copyFrameData(const AudioFrame& frame, size_t frame_offset,
+                                    float* output, size_t output_count) {
+    const size_t available = frame.getSampleCount();
+    if (frame_offset >= available) {
+        return 0;
+    }
+    const size_t n = std::min(available - frame_offset, output_count);
+
+    if (frame.isFloat()) {
+        std::memcpy(output, frame.float_samples.data() + frame_offset, n * sizeof(float));
+        return n;
+    }
+    const int16_t* src = frame.samples.data() + frame_offset;
+    for (size_t i = 0; i < n; ++i) {
+        output[i] = src[i] * (1.0f / 32768.0f);
+    }
+    return n;
 }
 
 void DemuxedStream::seekTo(unsigned long pos) {
@@ -437,9 +648,19 @@ void DemuxedStream::seekTo(unsigned long pos) {
         m_current_frame = AudioFrame{};
         m_current_frame_offset = 0;
     }
+    m_decoded_frames.clear();
     
-    // Seek demuxer
-    if (!m_demuxer->seekTo(pos)) {
+    // Seek demuxer. With the pipelined demux stage this also discards its
+    // read-ahead: chunks read before the seek carry an older epoch.
+    bool seeked = false;
+    uint64_t granule_position = 0;
+    repositionDemuxer(m_current_stream_id, [&](Demuxer& demuxer) {
+        seeked = demuxer.seekTo(pos);
+        if (seeked) {
+            granule_position = demuxer.getGranulePosition(m_current_stream_id);
+        }
+    });
+    if (!seeked) {
         // Handle seek failure if necessary
         return;
     }
@@ -461,7 +682,7 @@ void DemuxedStream::seekTo(unsigned long pos) {
     m_sposition = (static_cast<uint64_t>(pos) * m_rate) / 1000;
     
     // CRITICAL: Sync sample counter with demuxer's granule position after seek
-    m_samples_consumed = m_demuxer->getGranulePosition(m_current_stream_id);
+    m_samples_consumed = granule_position;
     
     m_eof = false;
     m_eof_reached = false;
@@ -550,11 +771,13 @@ bool DemuxedStream::switchToStream(uint32_t stream_id) {
     }
     m_current_frame = AudioFrame{};
     m_current_frame_offset = 0;
+    m_decoded_frames.clear();
     // The new stream is not at EOF; clear the latches seekTo also resets.
     m_eof_reached = false;
     m_eof = false;
 
-    // Update stream ID
+    // Update stream ID (and restart any read-ahead on the new stream)
+    repositionDemuxer(stream_id, {});
     m_current_stream_id = stream_id;
     
     // Setup new codec. Codec initialization throws on a malformed configuration
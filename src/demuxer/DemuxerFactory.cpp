@@ -216,6 +216,7 @@ std::unique_ptr<Demuxer> DemuxerFactory::createDemuxer(std::unique_ptr<IOHandler
             return nullptr;
         }
         
+        demuxer->setSourcePath(file_path);
         Debug::log("demuxer", "DemuxerFactory: Successfully created demuxer for format: ", format_id, " (file: ", file_path, ")");
         return demuxer;
         
@@ -49,6 +49,23 @@ size_t ModernStream::getData(size_t len, void *buf) {
     return m_demuxed_stream->getData(len, buf);
 }
 
+size_t ModernStream::getDataFloat(size_t count, float *buf) {
+    if (!m_opened || !m_demuxed_stream) {
+        return 0;
+    }
+
+    return m_demuxed_stream->getDataFloat(count, buf);
+}
+
+size_t ModernStream::getDataInto(float *first, size_t first_count,
+                                 float *second, size_t second_count) {
+    if (!m_opened || !m_demuxed_stream) {
+        return 0;
+    }
+
+    return m_demuxed_stream->getDataInto(first, first_count, second, second_count);
+}
+
 unsigned int ModernStream::getLength() {
     if (!m_opened || !m_demuxed_stream) {
         return 0;
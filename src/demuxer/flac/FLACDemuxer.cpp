@@ -40,15 +40,30 @@ FLACDemuxer::~FLACDemuxer()
 {
     FLAC_DEBUG("Destructor called");
     
-    // Acquire locks to ensure no operations in progress
-    std::lock_guard<std::mutex> state_lock(m_state_mutex);
-    std::lock_guard<std::mutex> metadata_lock(m_metadata_mutex);
+    std::string source_path;
+    std::vector<FLACFrameIndexEntry> index;
+    {
+        // Acquire locks to ensure no operations in progress
+        std::lock_guard<std::mutex> state_lock(m_state_mutex);
+        std::lock_guard<std::mutex> metadata_lock(m_metadata_mutex);
+        
+        // Take the index if it grew since loading; it is written below,
+        // after the locks are released
+        if (!m_source_path.empty() && m_frame_index.size() > m_saved_index_size) {
+            source_path = m_source_path;
+            index = std::move(m_frame_index);
+        }
+        
+        // Clear metadata
+        m_seektable.clear();
+        m_vorbis_comments.clear();
+        m_pictures.clear();
+        m_frame_index.clear();
+    }
     
-    // Clear metadata
-    m_seektable.clear();
-    m_vorbis_comments.clear();
-    m_pictures.clear();
-    m_frame_index.clear();
+    if (!index.empty()) {
+        FLACSeekIndexCache::save(source_path, index);
+    }
 }
 
 
@@ -128,6 +143,12 @@ uint64_t FLACDemuxer::getGranulePosition(uint32_t stream_id) const
     return getAtomicCurrentSample();
 }
 
+void FLACDemuxer::setSourcePath(const std::string& path)
+{
+    std::lock_guard<std::mutex> state_lock(m_state_mutex);
+    m_source_path = path;
+}
+
 
 // ============================================================================
 // Private Unlocked Implementations (assume locks are held)
@@ -279,6 +300,8 @@ bool FLACDemuxer::parseContainer_unlocked()
     updateCurrentSample_unlocked(0);
     updateEOF_unlocked(false);
     
+    loadCachedFrameIndex_unlocked();
+    
     FLAC_DEBUG("Container parsing complete");
     FLAC_DEBUG("  Sample rate: ", m_streaminfo.sample_rate, " Hz");
     FLAC_DEBUG("  Channels: ", static_cast<int>(m_streaminfo.channels));
@@ -4186,52 +4209,6 @@ uint64_t FLACDemuxer::msToSamples(uint64_t ms) const
 // CRC-8 Validation (RFC 9639 Section 9.1.8)
 // ============================================================================
 
-/**
- * CRC-8 lookup table for frame header validation
- * 
- * RFC 9639 Section 9.1.8 specifies:
- * - Polynomial: x^8 + x^2 + x + 1 (0x07)
- * - Initial value: 0
- * - No final XOR
- * 
- * This table is pre-computed for the polynomial 0x07 to enable fast
- * byte-at-a-time CRC calculation.
- */
-const uint8_t FLACDemuxer::s_crc8_table[256] = {
-    0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15,
-    0x38, 0x3F, 0x36, 0x31, 0x24, 0x23, 0x2A, 0x2D,
-    0x70, 0x77, 0x7E, 0x79, 0x6C, 0x6B, 0x62, 0x65,
-    0x48, 0x4F, 0x46, 0x41, 0x54, 0x53, 0x5A, 0x5D,
-    0xE0, 0xE7, 0xEE, 0xE9, 0xFC, 0xFB, 0xF2, 0xF5,
-    0xD8, 0xDF, 0xD6, 0xD1, 0xC4, 0xC3, 0xCA, 0xCD,
-    0x90, 0x97, 0x9E, 0x99, 0x8C, 0x8B, 0x82, 0x85,
-    0xA8, 0xAF, 0xA6, 0xA1, 0xB4, 0xB3, 0xBA, 0xBD,
-    0xC7, 0xC0, 0xC9, 0xCE, 0xDB, 0xDC, 0xD5, 0xD2,
-    0xFF, 0xF8, 0xF1, 0xF6, 0xE3, 0xE4, 0xED, 0xEA,
-    0xB7, 0xB0, 0xB9, 0xBE, 0xAB, 0xAC, 0xA5, 0xA2,
-    0x8F, 0x88, 0x81, 0x86, 0x93, 0x94, 0x9D, 0x9A,
-    0x27, 0x20, 0x29, 0x2E, 0x3B, 0x3C, 0x35, 0x32,
-    0x1F, 0x18, 0x11, 0x16, 0x03, 0x04, 0x0D, 0x0A,
-    0x57, 0x50, 0x59, 0x5E, 0x4B, 0x4C, 0x45, 0x42,
-    0x6F, 0x68, 0x61, 0x66, 0x73, 0x74, 0x7D, 0x7A,
-    0x89, 0x8E, 0x87, 0x80, 0x95, 0x92, 0x9B, 0x9C,
-    0xB1, 0xB6, 0xBF, 0xB8, 0xAD, 0xAA, 0xA3, 0xA4,
-    0xF9, 0xFE, 0xF7, 0xF0, 0xE5, 0xE2, 0xEB, 0xEC,
-    0xC1, 0xC6, 0xCF, 0xC8, 0xDD, 0xDA, 0xD3, 0xD4,
-    0x69, 0x6E, 0x67, 0x60, 0x75, 0x72, 0x7B, 0x7C,
-    0x51, 0x56, 0x5F, 0x58, 0x4D, 0x4A, 0x43, 0x44,
-    0x19, 0x1E, 0x17, 0x10, 0x05, 0x02, 0x0B, 0x0C,
-    0x21, 0x26, 0x2F, 0x28, 0x3D, 0x3A, 0x33, 0x34,
-    0x4E, 0x49, 0x40, 0x47, 0x52, 0x55, 0x5C, 0x5B,
-    0x76, 0x71, 0x78, 0x7F, 0x6A, 0x6D, 0x64, 0x63,
-    0x3E, 0x39, 0x30, 0x37, 0x22, 0x25, 0x2C, 0x2B,
-    0x06, 0x01, 0x08, 0x0F, 0x1A, 0x1D, 0x14, 0x13,
-    0xAE, 0xA9, 0xA0, 0xA7, 0xB2, 0xB5, 0xBC, 0xBB,
-    0x96, 0x91, 0x98, 0x9F, 0x8A, 0x8D, 0x84, 0x83,
-    0xDE, 0xD9, 0xD0, 0xD7, 0xC2, 0xC5, 0xCC, 0xCB,
-    0xE6, 0xE1, 0xE8, 0xEF, 0xFA, 0xFD, 0xF4, 0xF3
-};
-
 /**
  * @brief Calculate CRC-8 checksum for frame header per RFC 9639 Section 9.1.8
  * 
@@ -4249,16 +4226,10 @@ const uint8_t FLACDemuxer::s_crc8_table[256] = {
  */
 uint8_t FLACDemuxer::calculateCRC8(const uint8_t* data, size_t length)
 {
+    // Requirement 10.1: Polynomial 0x07
     // Requirement 10.2: Initialize CRC to 0
-    uint8_t crc = 0;
-    
-    // Requirement 10.1: Use polynomial 0x07 via lookup table
     // Requirement 10.3: Cover all frame header bytes except CRC itself
-    for (size_t i = 0; i < length; ++i) {
-        crc = s_crc8_table[crc ^ data[i]];
-    }
-    
-    return crc;
+    return PsyMP3::Core::Utility::CRC::crc8(data, length);
 }
 
 /**
@@ -4330,56 +4301,6 @@ bool FLACDemuxer::validateFrameHeaderCRC_unlocked(const uint8_t* header_data, si
 // CRC-16 Implementation (RFC 9639 Section 9.3)
 // ============================================================================
 
-/**
- * @brief CRC-16 lookup table for polynomial 0x8005 (x^16 + x^15 + x^2 + x^0)
- * 
- * Per RFC 9639 Section 9.3:
- * - Polynomial: x^16 + x^15 + x^2 + x^0 = 0x8005
- * - Initial value: 0
- * - No final XOR
- * 
- * This table is pre-computed for the polynomial 0x8005 to enable fast
- * byte-at-a-time CRC calculation.
- * 
- * Note: The CRC-16 used by FLAC is a bit-reversed version of the standard
- * CRC-16-IBM. The polynomial 0x8005 when processed MSB-first produces
- * this lookup table.
- */
-const uint16_t FLACDemuxer::s_crc16_table[256] = {
-    0x0000, 0x8005, 0x800F, 0x000A, 0x801B, 0x001E, 0x0014, 0x8011,
-    0x8033, 0x0036, 0x003C, 0x8039, 0x0028, 0x802D, 0x8027, 0x0022,
-    0x8063, 0x0066, 0x006C, 0x8069, 0x0078, 0x807D, 0x8077, 0x0072,
-    0x0050, 0x8055, 0x805F, 0x005A, 0x804B, 0x004E, 0x0044, 0x8041,
-    0x80C3, 0x00C6, 0x00CC, 0x80C9, 0x00D8, 0x80DD, 0x80D7, 0x00D2,
-    0x00F0, 0x80F5, 0x80FF, 0x00FA, 0x80EB, 0x00EE, 0x00E4, 0x80E1,
-    0x00A0, 0x80A5, 0x80AF, 0x00AA, 0x80BB, 0x00BE, 0x00B4, 0x80B1,
-    0x8093, 0x0096, 0x009C, 0x8099, 0x0088, 0x808D, 0x8087, 0x0082,
-    0x8183, 0x0186, 0x018C, 0x8189, 0x0198, 0x819D, 0x8197, 0x0192,
-    0x01B0, 0x81B5, 0x81BF, 0x01BA, 0x81AB, 0x01AE, 0x01A4, 0x81A1,
-    0x01E0, 0x81E5, 0x81EF, 0x01EA, 0x81FB, 0x01FE, 0x01F4, 0x81F1,
-    0x81D3, 0x01D6, 0x01DC, 0x81D9, 0x01C8, 0x81CD, 0x81C7, 0x01C2,
-    0x0140, 0x8145, 0x814F, 0x014A, 0x815B, 0x015E, 0x0154, 0x8151,
-    0x8173, 0x0176, 0x017C, 0x8179, 0x0168, 0x816D, 0x8167, 0x0162,
-    0x8123, 0x0126, 0x012C, 0x8129, 0x0138, 0x813D, 0x8137, 0x0132,
-    0x0110, 0x8115, 0x811F, 0x011A, 0x810B, 0x010E, 0x0104, 0x8101,
-    0x8303, 0x0306, 0x030C, 0x8309, 0x0318, 0x831D, 0x8317, 0x0312,
-    0x0330, 0x8335, 0x833F, 0x033A, 0x832B, 0x032E, 0x0324, 0x8321,
-    0x0360, 0x8365, 0x836F, 0x036A, 0x837B, 0x037E, 0x0374, 0x8371,
-    0x8353, 0x0356, 0x035C, 0x8359, 0x0348, 0x834D, 0x8347, 0x0342,
-    0x03C0, 0x83C5, 0x83CF, 0x03CA, 0x83DB, 0x03DE, 0x03D4, 0x83D1,
-    0x83F3, 0x03F6, 0x03FC, 0x83F9, 0x03E8, 0x83ED, 0x83E7, 0x03E2,
-    0x83A3, 0x03A6, 0x03AC, 0x83A9, 0x03B8, 0x83BD, 0x83B7, 0x03B2,
-    0x0390, 0x8395, 0x839F, 0x039A, 0x838B, 0x038E, 0x0384, 0x8381,
-    0x0280, 0x8285, 0x828F, 0x028A, 0x829B, 0x029E, 0x0294, 0x8291,
-    0x82B3, 0x02B6, 0x02BC, 0x82B9, 0x02A8, 0x82AD, 0x82A7, 0x02A2,
-    0x82E3, 0x02E6, 0x02EC, 0x82E9, 0x02F8, 0x82FD, 0x82F7, 0x02F2,
-    0x02D0, 0x82D5, 0x82DF, 0x02DA, 0x82CB, 0x02CE, 0x02C4, 0x82C1,
-    0x8243, 0x0246, 0x024C, 0x8249, 0x0258, 0x825D, 0x8257, 0x0252,
-    0x0270, 0x8275, 0x827F, 0x027A, 0x826B, 0x026E, 0x0264, 0x8261,
-    0x0220, 0x8225, 0x822F, 0x022A, 0x823B, 0x023E, 0x0234, 0x8231,
-    0x8213, 0x0216, 0x021C, 0x8219, 0x0208, 0x820D, 0x8207, 0x0202
-};
-
 /**
  * @brief Calculate CRC-16 checksum for frame data per RFC 9639 Section 9.3
  * 
@@ -4398,16 +4319,10 @@ const uint16_t FLACDemuxer::s_crc16_table[256] = {
  */
 uint16_t FLACDemuxer::calculateCRC16(const uint8_t* data, size_t length)
 {
+    // Requirement 11.2: Polynomial 0x8005
     // Requirement 11.3: Initialize CRC to 0
-    uint16_t crc = 0;
-    
-    // Requirement 11.2: Use polynomial 0x8005 via lookup table
     // Requirement 11.4: Cover entire frame from sync code to end of subframes
-    for (size_t i = 0; i < length; ++i) {
-        crc = (crc << 8) ^ s_crc16_table[(crc >> 8) ^ data[i]];
-    }
-    
-    return crc;
+    return PsyMP3::Core::Utility::CRC::crc16(data, length);
 }
 
 /**
@@ -5106,29 +5021,77 @@ void FLACDemuxer::addFrameToIndex_unlocked(const FLACFrame& frame)
         return;
     }
     
-    // Check if this frame is already in the index (avoid duplicates)
-    if (!m_frame_index.empty()) {
-        const auto& last = m_frame_index.back();
-        if (last.file_offset == frame.file_offset) {
+    // Frames normally extend the end of the index; after a seek they fill
+    // the gap between entries that were read (or loaded from the cache)
+    // earlier, so insert in sample order.
+    auto it = m_frame_index.end();
+    if (!m_frame_index.empty() && frame.sample_offset <= m_frame_index.back().sample_offset) {
+        it = std::lower_bound(m_frame_index.begin(), m_frame_index.end(), frame.sample_offset,
+                              [](const FLACFrameIndexEntry& entry, uint64_t sample) {
+                                  return entry.sample_offset < sample;
+                              });
+        if (it->sample_offset == frame.sample_offset) {
             return;  // Already indexed
         }
-        
-        // Ensure frames are added in order
-        if (frame.sample_offset < last.sample_offset) {
-            FLAC_DEBUG("[addFrameToIndex] Warning: Frame at sample ", frame.sample_offset,
-                       " is out of order (last indexed: ", last.sample_offset, ")");
-            return;
-        }
+    }
+    
+    // File order must agree with sample order
+    if ((it != m_frame_index.end() && it->file_offset <= frame.file_offset) ||
+        (it != m_frame_index.begin() && std::prev(it)->file_offset >= frame.file_offset)) {
+        FLAC_DEBUG("[addFrameToIndex] Warning: Frame at sample ", frame.sample_offset,
+                   " (offset ", frame.file_offset, ") is out of order with its neighbours");
+        return;
     }
     
     // Add to index
-    m_frame_index.emplace_back(frame.sample_offset, frame.file_offset, frame.block_size);
+    m_frame_index.insert(it, FLACFrameIndexEntry(frame.sample_offset, frame.file_offset, frame.block_size));
     
     FLAC_DEBUG("[addFrameToIndex] Added frame to index: sample=", frame.sample_offset,
                ", file_offset=", frame.file_offset, ", block_size=", frame.block_size,
                " (total indexed: ", m_frame_index.size(), ")");
 }
 
+void FLACDemuxer::loadCachedFrameIndex_unlocked()
+{
+    if (m_source_path.empty()) {
+        return;
+    }
+    
+    std::vector<FLACFrameIndexEntry> index = FLACSeekIndexCache::load(m_source_path);
+    if (index.empty()) {
+        return;
+    }
+    
+    const uint64_t audio_end = m_audio_data_end ? m_audio_data_end : m_file_size;
+    if (index.front().file_offset < m_audio_data_offset || index.back().file_offset >= audio_end ||
+        (m_streaminfo.total_samples > 0 && index.back().sample_offset >= m_streaminfo.total_samples)) {
+        FLAC_DEBUG("[loadCachedFrameIndex] Cached index does not fit the audio data, ignoring it");
+        return;
+    }
+    
+    // Spot-check both ends for a frame sync code (RFC 9639 Section 9.1)
+    const off_t saved_pos = m_handler->tell();
+    bool synced = true;
+    for (const FLACFrameIndexEntry* entry : {&index.front(), &index.back()}) {
+        uint8_t sync[2] = {0, 0};
+        if (m_handler->seek(static_cast<off_t>(entry->file_offset), SEEK_SET) != 0 ||
+            m_handler->read(sync, 1, 2) != 2 ||
+            sync[0] != 0xFF || (sync[1] & 0xFE) != 0xF8) {
+            synced = false;
+            break;
+        }
+    }
+    m_handler->seek(saved_pos, SEEK_SET);
+    if (!synced) {
+        FLAC_DEBUG("[loadCachedFrameIndex] Cached index does not point at frames, ignoring it");
+        return;
+    }
+    
+    m_frame_index = std::move(index);
+    m_saved_index_size = m_frame_index.size();
+    FLAC_DEBUG("[loadCachedFrameIndex] Loaded ", m_frame_index.size(), " cached frame positions");
+}
+
 /**
  * @brief Parse frames forward from current position to target sample
  * 
@@ -0,0 +1,298 @@
+/*
+ * FLACSeekIndexCache.cpp - Persistent FLAC frame index cache
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#include "psymp3.h"
+
+namespace PsyMP3 {
+namespace Demuxer {
+namespace FLAC {
+
+namespace {
+
+constexpr char kSeekIndexMagic[8] = {'P', 's', 'y', 'F', 'L', 'I', 'd', 'x'};
+constexpr uint32_t kSeekIndexVersion = 1;
+// Magic, version, size, mtime, path length
+constexpr size_t kSeekIndexHeaderSize = 8 + 4 + 8 + 8 + 4;
+// Entry count, payload length, payload CRC
+constexpr size_t kSeekIndexTableHeaderSize = 4 + 4 + 2;
+// Several hours of 16-sample frames; anything bigger is not ours
+constexpr uint64_t kSeekIndexMaxFileSize = 64u << 20;
+
+std::mutex s_seek_index_mutex;
+std::string s_seek_index_directory;
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool getVarint(const uint8_t*& p, const uint8_t* end, uint64_t& value)
+{
+    value = 0;
+    for (unsigned shift = 0; shift < 64 && p < end; shift += 7) {
+        const uint8_t byte = *p++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+void putLE(std::vector<uint8_t>& out, T value)
+{
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        out.push_back(static_cast<uint8_t>(static_cast<uint64_t>(value) >> (8 * i)));
+    }
+}
+
+template <typename T>
+T getLE(const uint8_t* p)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<uint64_t>(p[i]) << (8 * i);
+    }
+    return static_cast<T>(value);
+}
+
+// Per process and thread, so concurrent saves never write the same file
+std::string tempPathFor(const std::string& cache_path)
+{
+#ifdef _WIN32
+    const unsigned long pid = GetCurrentProcessId();
+#else
+    const unsigned long pid = static_cast<unsigned long>(getpid());
+#endif
+    std::ostringstream name;
+    name << cache_path << '.' << pid << '-' << std::this_thread::get_id() << ".tmp";
+    return name.str();
+}
+
+} // namespace
+
+void FLACSeekIndexCache::setDirectory(const std::string& directory)
+{
+    std::lock_guard<std::mutex> lock(s_seek_index_mutex);
+    s_seek_index_directory = directory;
+}
+
+std::string FLACSeekIndexCache::getDirectory()
+{
+    std::lock_guard<std::mutex> lock(s_seek_index_mutex);
+    return s_seek_index_directory;
+}
+
+std::string FLACSeekIndexCache::cacheFileFor(const std::string& source_path)
+{
+    const std::string directory = getDirectory();
+    if (directory.empty() || source_path.empty()) {
+        return {};
+    }
+    // FNV-1a; the path stored in the file settles collisions
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (unsigned char c : source_path) {
+        hash = (hash ^ c) * 0x100000001B3ull;
+    }
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.idx", static_cast<unsigned long long>(hash));
+    return directory + "/" + name;
+}
+
+std::vector<uint8_t> FLACSeekIndexCache::encodeEntries(const std::vector<FLACFrameIndexEntry>& index)
+{
+    std::vector<uint8_t> out;
+    out.reserve(index.size() * 3 + 16);
+    uint64_t prev_sample = 0;
+    uint64_t prev_offset = 0;
+    uint32_t prev_block = 0;
+    for (const auto& entry : index) {
+        const bool same = prev_block != 0 &&
+                          entry.sample_offset == prev_sample + prev_block &&
+                          entry.block_size == prev_block;
+        putVarint(out, ((entry.file_offset - prev_offset) << 1) | (same ? 1 : 0));
+        if (!same) {
+            putVarint(out, entry.sample_offset - prev_sample);
+            putVarint(out, entry.block_size);
+        }
+        prev_sample = entry.sample_offset;
+        prev_offset = entry.file_offset;
+        prev_block = entry.block_size;
+    }
+    return out;
+}
+
+bool FLACSeekIndexCache::decodeEntries(const uint8_t* data, size_t size, uint32_t count,
+                                       std::vector<FLACFrameIndexEntry>& index)
+{
+    index.clear();
+    // Every entry takes at least one byte
+    if (count > size) {
+        return false;
+    }
+    index.reserve(count);
+
+    const uint8_t* p = data;
+    const uint8_t* end = data + size;
+    uint64_t sample = 0;
+    uint64_t offset = 0;
+    uint32_t block = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint64_t word = 0;
+        if (!getVarint(p, end, word)) {
+            return false;
+        }
+        const uint64_t offset_delta = word >> 1;
+        uint64_t sample_delta = block;
+        if (!(word & 1)) {
+            uint64_t block_size = 0;
+            if (!getVarint(p, end, sample_delta) || !getVarint(p, end, block_size) ||
+                block_size == 0 || block_size > 65535) {
+                return false;
+            }
+            block = static_cast<uint32_t>(block_size);
+        } else if (block == 0) {
+            return false;
+        }
+        // Both positions must strictly increase
+        if (i > 0 && (offset_delta == 0 || sample_delta == 0)) {
+            return false;
+        }
+        if (offset_delta > UINT64_MAX - offset || sample_delta > UINT64_MAX - sample) {
+            return false;
+        }
+        offset += offset_delta;
+        sample += sample_delta;
+        index.emplace_back(sample, offset, block);
+    }
+    return p == end;
+}
+
+std::vector<FLACFrameIndexEntry> FLACSeekIndexCache::load(const std::string& source_path)
+{
+    std::vector<FLACFrameIndexEntry> index;
+    const std::string cache_path = cacheFileFor(source_path);
+    uint64_t source_size = 0;
+    int64_t source_mtime = 0;
+    if (cache_path.empty() || !System::fileStamp(source_path, source_size, source_mtime)) {
+        return index;
+    }
+
+    // The whole cache file in one read
+    std::error_code ec;
+    const std::filesystem::path fs_path = System::pathFromUtf8(cache_path);
+    const auto cache_size = std::filesystem::file_size(fs_path, ec);
+    if (ec || cache_size < kSeekIndexHeaderSize || cache_size > kSeekIndexMaxFileSize) {
+        return index;
+    }
+    std::vector<uint8_t> bytes(static_cast<size_t>(cache_size));
+    {
+        std::ifstream f(fs_path, std::ios::in | std::ios::binary);
+        if (!f || !f.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+            return index;
+        }
+    }
+
+    const uint8_t* p = bytes.data();
+    const uint8_t* end = p + bytes.size();
+    if (memcmp(p, kSeekIndexMagic, sizeof(kSeekIndexMagic)) != 0 ||
+        getLE<uint32_t>(p + 8) != kSeekIndexVersion) {
+        return index;
+    }
+    if (getLE<uint64_t>(p + 12) != source_size || getLE<int64_t>(p + 20) != source_mtime) {
+        Debug::log("flac", "[FLACSeekIndexCache] ", source_path, " changed since its index was saved");
+        return index;
+    }
+    const uint32_t path_length = getLE<uint32_t>(p + 28);
+    p += kSeekIndexHeaderSize;
+    if (static_cast<size_t>(end - p) < static_cast<size_t>(path_length) + kSeekIndexTableHeaderSize ||
+        source_path.compare(0, std::string::npos, reinterpret_cast<const char*>(p), path_length) != 0) {
+        return index;
+    }
+    p += path_length;
+
+    const uint32_t count = getLE<uint32_t>(p);
+    const uint32_t payload_length = getLE<uint32_t>(p + 4);
+    const uint16_t payload_crc = getLE<uint16_t>(p + 8);
+    p += kSeekIndexTableHeaderSize;
+    if (static_cast<size_t>(end - p) != payload_length ||
+        Core::Utility::CRC::crc16(p, payload_length) != payload_crc ||
+        !decodeEntries(p, payload_length, count, index)) {
+        Debug::log("flac", "[FLACSeekIndexCache] Discarding corrupt index ", cache_path);
+        index.clear();
+        return index;
+    }
+
+    Debug::log("flac", "[FLACSeekIndexCache] Loaded ", index.size(), " frames for ", source_path);
+    return index;
+}
+
+bool FLACSeekIndexCache::save(const std::string& source_path,
+                              const std::vector<FLACFrameIndexEntry>& index)
+{
+    const std::string cache_path = cacheFileFor(source_path);
+    uint64_t source_size = 0;
+    int64_t source_mtime = 0;
+    if (cache_path.empty() || index.empty() || index.size() > UINT32_MAX ||
+        !System::fileStamp(source_path, source_size, source_mtime)) {
+        return false;
+    }
+    for (size_t i = 1; i < index.size(); ++i) {
+        if (index[i].sample_offset <= index[i - 1].sample_offset ||
+            index[i].file_offset <= index[i - 1].file_offset) {
+            return false;
+        }
+    }
+
+    const std::vector<uint8_t> payload = encodeEntries(index);
+    std::vector<uint8_t> bytes;
+    bytes.reserve(kSeekIndexHeaderSize + source_path.size() + kSeekIndexTableHeaderSize + payload.size());
+    bytes.insert(bytes.end(), kSeekIndexMagic, kSeekIndexMagic + sizeof(kSeekIndexMagic));
+    putLE<uint32_t>(bytes, kSeekIndexVersion);
+    putLE<uint64_t>(bytes, source_size);
+    putLE<int64_t>(bytes, source_mtime);
+    putLE<uint32_t>(bytes, static_cast<uint32_t>(source_path.size()));
+    bytes.insert(bytes.end(), source_path.begin(), source_path.end());
+    putLE<uint32_t>(bytes, static_cast<uint32_t>(index.size()));
+    putLE<uint32_t>(bytes, static_cast<uint32_t>(payload.size()));
+    putLE<uint16_t>(bytes, Core::Utility::CRC::crc16(payload.data(), payload.size()));
+    bytes.insert(bytes.end(), payload.begin(), payload.end());
+
+    std::error_code ec;
+    const std::filesystem::path fs_path = System::pathFromUtf8(cache_path);
+    std::filesystem::create_directories(fs_path.parent_path(), ec);
+    const std::filesystem::path tmp_path = System::pathFromUtf8(tempPathFor(cache_path));
+    {
+        std::ofstream f(tmp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!f || !f.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size())) ||
+            !f.flush()) {
+            Debug::log("flac", "[FLACSeekIndexCache] Cannot write ", cache_path);
+            return false;
+        }
+    }
+    std::filesystem::rename(tmp_path, fs_path, ec);
+    if (ec) {
+        Debug::log("flac", "[FLACSeekIndexCache] Cannot replace ", cache_path, ": ", ec.message());
+        std::filesystem::remove(tmp_path, ec);
+        return false;
+    }
+
+    Debug::log("flac", "[FLACSeekIndexCache] Saved ", index.size(), " frames (", payload.size(),
+               " bytes) for ", source_path);
+    return true;
+}
+
+} // namespace FLAC
+} // namespace Demuxer
+} // namespace PsyMP3
@@ -49,10 +49,29 @@ static constexpr uint32_t s_bitrates_v2_l1[16] = {
 // The 2-bit layer field: 3 = Layer I, 2 = Layer II, 1 = Layer III (0 reserved).
 enum : uint8_t { MP3_LAYER_III = 1, MP3_LAYER_II = 2, MP3_LAYER_I = 3 };
 
+// Samples every Layer III decoder outputs before the encoder's first one
+static constexpr uint32_t s_decoder_delay = 529;
+
+// Layer III main data may start up to 511 bytes back, in earlier frames'
+// main data. A frame's main data is what follows its header, CRC and side
+// information (at most 4 + 2 + 32 bytes).
+static constexpr uint64_t s_max_reservoir_bytes = 511;
+static constexpr uint64_t s_max_frame_overhead = 38;
+
+// How long a seek in a file without a TOC waits for the index scan
+static constexpr auto s_index_wait = std::chrono::milliseconds(1000);
+
 MP3NullDemuxer::MP3NullDemuxer(std::unique_ptr<PsyMP3::IO::IOHandler> handler)
     : Demuxer(std::move(handler)) {
 }
 
+MP3NullDemuxer::~MP3NullDemuxer() {
+    m_index_stop.store(true);
+    if (m_index_thread.joinable()) {
+        m_index_thread.join();
+    }
+}
+
 bool MP3NullDemuxer::parseContainer() {
     std::lock_guard<std::mutex> lock(m_mutex);
     return parseContainer_unlocked();
@@ -80,6 +99,23 @@ MediaChunk MP3NullDemuxer::readChunk(uint32_t /*stream_id*/) {
 }
 
 bool MP3NullDemuxer::seekTo(uint64_t timestamp_ms) {
+    // With no TOC the fallback is a linear guess that can be seconds off in
+    // VBR files, so give the index scan a moment to reach the target. Wait
+    // without m_mutex: position and duration queries must not stall on it.
+    bool wait_for_index = false;
+    uint64_t decoded_target = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_parsed && m_stream_info.sample_rate != 0 && m_xing_toc.empty() &&
+            m_index_thread.joinable()) {
+            decoded_target = (timestamp_ms * m_stream_info.sample_rate) / 1000 + m_encoder_delay;
+            wait_for_index = m_gapless_end == 0 || decoded_target < m_gapless_end;
+        }
+    }
+    if (wait_for_index) {
+        waitForFrameIndex(decoded_target);
+    }
+
     std::lock_guard<std::mutex> lock(m_mutex);
     return seekTo_unlocked(timestamp_ms);
 }
@@ -90,7 +126,7 @@ bool MP3NullDemuxer::isEOF() const {
 
 uint64_t MP3NullDemuxer::getDuration() const {
     std::lock_guard<std::mutex> lock(m_mutex);
-    return m_duration_ms;
+    return getDuration_unlocked();
 }
 
 uint64_t MP3NullDemuxer::getPosition() const {
@@ -98,6 +134,22 @@ uint64_t MP3NullDemuxer::getPosition() const {
     return m_position_ms;
 }
 
+uint64_t MP3NullDemuxer::getGranulePosition(uint32_t /*stream_id*/) const {
+    // DemuxedStream re-bases its sample counter from this after a seek: the
+    // first sample the codec will output, past any trimmed pre-roll.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return toOutputSample(std::max(m_current_sample, m_trim_until));
+}
+
+void MP3NullDemuxer::setSourcePath(const std::string& path) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_source_path = path;
+}
+
+bool MP3NullDemuxer::isFrameIndexComplete() const {
+    return m_index_complete.load();
+}
+
 // --- Internal methods (assume lock held) ---
 
 bool MP3NullDemuxer::parseContainer_unlocked() {
@@ -137,6 +189,8 @@ bool MP3NullDemuxer::parseContainer_unlocked() {
 
     m_parsed = true;
     m_eof_flag.store(false);
+    m_trim_until = m_encoder_delay;
+    startFrameIndex_unlocked();
     Debug::log("mp3demux", "MP3NullDemuxer: Parsed MP3 stream - ",
                m_stream_info.sample_rate, " Hz, ", m_stream_info.channels, " ch, ",
                m_duration_ms, " ms duration");
@@ -221,6 +275,7 @@ bool MP3NullDemuxer::parseFirstFrame_unlocked() {
         // Set up stream info. Route Layer II to the dedicated mp2 (kjmp2) codec;
         // Layer III (and, for lack of a Layer I decoder, Layer I) stay "mp3".
         uint8_t frame_layer = (header[1] >> 1) & 0x03;
+        m_layer = frame_layer;
         m_stream_info.stream_id = 1;
         m_stream_info.codec_type = "audio";
         m_stream_info.codec_name = (frame_layer == MP3_LAYER_II) ? "mp2" : "mp3";
@@ -309,6 +364,7 @@ bool MP3NullDemuxer::parseXingHeader_unlocked(const std::vector<uint8_t>& frame_
         // Calculate total samples and duration
         uint32_t samples_per_frame = is_mpeg1 ? 1152 : 576;
         m_total_samples = static_cast<uint64_t>(m_total_frames) * samples_per_frame;
+        m_exact_length = true;
         if (sample_rate > 0) {
             m_duration_ms = (m_total_samples * 1000ULL) / sample_rate;
             m_stream_info.duration_ms = m_duration_ms;
@@ -339,6 +395,33 @@ bool MP3NullDemuxer::parseXingHeader_unlocked(const std::vector<uint8_t>& frame_
         pos += 100;
     }
 
+    // Quality field
+    if (flags & 0x08) {
+        pos += 4;
+    }
+
+    // LAME extension (also written by FFmpeg as "Lavc"): 9-byte encoder
+    // string, then the 12-bit encoder delay and padding at byte 21
+    if (pos + 24 <= frame_data.size() && frame_data[pos] != 0) {
+        const uint32_t delay = (static_cast<uint32_t>(frame_data[pos + 21]) << 4) |
+                               (frame_data[pos + 22] >> 4);
+        const uint32_t padding = (static_cast<uint32_t>(frame_data[pos + 22] & 0x0F) << 8) |
+                                 frame_data[pos + 23];
+        m_encoder_delay = delay + s_decoder_delay;
+        if (m_exact_length && m_total_samples > static_cast<uint64_t>(delay) + padding) {
+            // The decoder delay moves the end as well; padding shorter than
+            // it leaves the end where the last frame does
+            m_gapless_end = std::min(m_total_samples, m_total_samples - padding + s_decoder_delay);
+            m_total_samples -= static_cast<uint64_t>(delay) + padding;
+            if (sample_rate > 0) {
+                m_duration_ms = (m_total_samples * 1000ULL) / sample_rate;
+                m_stream_info.duration_ms = m_duration_ms;
+                m_stream_info.duration_samples = m_total_samples;
+            }
+        }
+        Debug::log("mp3demux", "MP3NullDemuxer: Encoder delay ", delay, ", padding ", padding);
+    }
+
     Debug::log("mp3demux", "MP3NullDemuxer: Found ", (is_xing ? "Xing" : "Info"), " header - ",
                m_total_frames, " frames, ", m_total_bytes, " bytes, ",
                m_duration_ms, " ms");
@@ -438,19 +521,27 @@ MediaChunk MP3NullDemuxer::readChunk_unlocked() {
         }
     }
 
-    // Build MediaChunk
+    // Build MediaChunk. Samples before m_trim_until (encoder delay, seek
+    // pre-roll) and past m_gapless_end (padding) are the codec's to drop.
+    uint32_t samples = getFrameSamples(header);
+    const uint64_t frame_end = m_current_sample + samples;
     MediaChunk chunk;
     chunk.stream_id = 1;
     chunk.data = std::move(frame_data);
-    chunk.timestamp_samples = m_current_sample;
     chunk.file_offset = frame_offset;
     chunk.is_keyframe = true;
+    if (m_trim_until > m_current_sample) {
+        chunk.trim_leading_samples = static_cast<uint32_t>(std::min<uint64_t>(m_trim_until - m_current_sample, samples));
+    }
+    if (m_gapless_end > 0 && frame_end > m_gapless_end) {
+        chunk.trim_trailing_samples = static_cast<uint32_t>(std::min<uint64_t>(frame_end - m_gapless_end, samples));
+    }
+    chunk.timestamp_samples = toOutputSample(m_current_sample + chunk.trim_leading_samples);
 
     // Advance position tracking
-    uint32_t samples = getFrameSamples(header);
-    m_current_sample += samples;
+    m_current_sample = frame_end;
     if (m_stream_info.sample_rate > 0) {
-        m_position_ms = (m_current_sample * 1000ULL) / m_stream_info.sample_rate;
+        m_position_ms = (toOutputSample(m_current_sample) * 1000ULL) / m_stream_info.sample_rate;
     }
 
     // Check for EOF
@@ -466,13 +557,27 @@ MediaChunk MP3NullDemuxer::readChunk_unlocked() {
 bool MP3NullDemuxer::seekTo_unlocked(uint64_t timestamp_ms) {
     if (!m_parsed || m_stream_info.sample_rate == 0) return false;
 
+    const uint64_t target_sample = (timestamp_ms * m_stream_info.sample_rate) / 1000;
+    if (seekWithFrameIndex_unlocked(target_sample)) {
+        m_eof_flag.store(false);
+        m_position_ms = timestamp_ms;
+        return true;
+    }
+
     // Clamp to valid range
-    if (timestamp_ms >= m_duration_ms) {
+    if (timestamp_ms >= getDuration_unlocked()) {
         m_eof_flag.store(true);
         return false;
     }
 
     m_eof_flag.store(false);
+    if (timestamp_ms == 0) {
+        m_handler->seek(static_cast<off_t>(m_data_start_offset), SEEK_SET);
+        m_current_sample = 0;
+        m_trim_until = m_encoder_delay;
+        m_position_ms = 0;
+        return true;
+    }
     uint64_t audio_data_size = m_data_end_offset - m_data_start_offset;
 
     // Use Xing TOC for VBR seeking if available
@@ -503,12 +608,172 @@ bool MP3NullDemuxer::seekTo_unlocked(uint64_t timestamp_ms) {
         m_handler->seek(static_cast<off_t>(m_data_start_offset), SEEK_SET);
     }
 
-    // Update position tracking
-    m_current_sample = (timestamp_ms * m_stream_info.sample_rate) / 1000;
+    // Update position tracking. The estimate lands on some frame near the
+    // target; treat it as the target.
+    m_current_sample = target_sample + m_encoder_delay;
+    m_trim_until = m_encoder_delay;
     m_position_ms = timestamp_ms;
     return true;
 }
 
+uint64_t MP3NullDemuxer::getDuration_unlocked() const {
+    // Without a Xing frame count the duration is a CBR estimate; the
+    // finished index knows better
+    if (!m_exact_length && m_index_complete.load() && m_stream_info.sample_rate > 0) {
+        std::lock_guard<std::mutex> lock(m_index_mutex);
+        return (toOutputSample(m_indexed_samples) * 1000ULL) / m_stream_info.sample_rate;
+    }
+    return m_duration_ms;
+}
+
+uint64_t MP3NullDemuxer::toOutputSample(uint64_t decoded_sample) const {
+    return decoded_sample > m_encoder_delay ? decoded_sample - m_encoder_delay : 0;
+}
+
+// --- Frame index ---
+
+void MP3NullDemuxer::startFrameIndex_unlocked() {
+    if (m_source_path.empty() || m_index_thread.joinable()) {
+        return;
+    }
+    try {
+        m_index_thread = std::thread(&MP3NullDemuxer::buildFrameIndex, this, m_source_path,
+                                     m_data_start_offset, m_data_end_offset);
+    } catch (const std::system_error& e) {
+        Debug::log("mp3demux", "MP3NullDemuxer: Cannot start frame index thread: ", e.what());
+    }
+}
+
+void MP3NullDemuxer::buildFrameIndex(std::string path, uint64_t start, uint64_t end) {
+    // A handle of our own, so the scan never moves the playback position
+    std::unique_ptr<PsyMP3::IO::IOHandler> handler;
+    try {
+        handler = std::make_unique<PsyMP3::IO::File::FileIOHandler>(TagLib::String(path, TagLib::String::UTF8));
+    } catch (const std::exception& e) {
+        Debug::log("mp3demux", "MP3NullDemuxer: No frame index for ", path, ": ", e.what());
+        return;
+    }
+    if (handler->seek(static_cast<off_t>(start), SEEK_SET) != 0) {
+        return;
+    }
+
+    // Walk the frames like readChunk_unlocked() does: a frame's header, then
+    // its size; a bad header or a free-format frame resyncs on the next valid
+    // header. Frames are read in blocks and published in batches.
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+    std::vector<uint8_t> buffer;
+    std::vector<MP3FrameIndexEntry> batch;
+    uint64_t buffer_offset = start;  // File offset of buffer[0]
+    uint64_t pos = start;
+    uint64_t sample = 0;
+    bool at_eof = false;
+
+    auto publish = [&]() {
+        std::lock_guard<std::mutex> lock(m_index_mutex);
+        m_frame_index.insert(m_frame_index.end(), batch.begin(), batch.end());
+        m_indexed_samples = sample;
+        batch.clear();
+        m_index_cv.notify_all();
+    };
+
+    while (!m_index_stop.load() && pos < end) {
+        // Keep a whole frame (at most 4096 bytes) ahead of pos in the buffer
+        if (!at_eof && pos + 4096 > buffer_offset + buffer.size()) {
+            publish();
+            buffer.erase(buffer.begin(), buffer.begin() + static_cast<ptrdiff_t>(pos - buffer_offset));
+            buffer_offset = pos;
+            const size_t old_size = buffer.size();
+            buffer.resize(old_size + BLOCK_SIZE);
+            const size_t got = handler->read(buffer.data() + old_size, 1, BLOCK_SIZE);
+            buffer.resize(old_size + got);
+            at_eof = got < BLOCK_SIZE;
+        }
+        const uint8_t* header = buffer.data() + (pos - buffer_offset);
+        const uint64_t available = buffer_offset + buffer.size() - pos;
+        if (available < 4) {
+            break;
+        }
+        if (!isValidFrameHeader(header)) {
+            ++pos;
+            continue;
+        }
+        const uint32_t frame_size = getFrameSize(header);
+        if (frame_size == 0 || frame_size > 4096) {
+            pos += 4;
+            continue;
+        }
+        if (frame_size > available) {
+            break;  // Truncated last frame; readChunk_unlocked() stops there too
+        }
+        batch.push_back({pos, sample});
+        sample += getFrameSamples(header);
+        pos += frame_size;
+    }
+
+    publish();
+    if (!m_index_stop.load()) {
+        std::lock_guard<std::mutex> lock(m_index_mutex);
+        m_index_complete.store(true);
+        m_index_cv.notify_all();
+        Debug::log("mp3demux", "MP3NullDemuxer: Indexed ", m_frame_index.size(), " frames, ",
+                   sample, " samples");
+    }
+}
+
+void MP3NullDemuxer::waitForFrameIndex(uint64_t decoded_target) {
+    // The scan covers a whole file in well under a second
+    std::unique_lock<std::mutex> lock(m_index_mutex);
+    m_index_cv.wait_for(lock, s_index_wait, [&] {
+        return m_index_complete.load() || m_index_stop.load() || m_indexed_samples > decoded_target;
+    });
+}
+
+bool MP3NullDemuxer::seekWithFrameIndex_unlocked(uint64_t target_sample) {
+    const uint64_t decoded_target = target_sample + m_encoder_delay;
+    if (m_gapless_end > 0 && decoded_target >= m_gapless_end) {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(m_index_mutex);
+    if (m_frame_index.empty() || m_indexed_samples <= decoded_target) {
+        return false;
+    }
+
+    // Frame k holds the target
+    auto it = std::upper_bound(m_frame_index.begin(), m_frame_index.end(), decoded_target,
+                               [](uint64_t sample, const MP3FrameIndexEntry& entry) {
+                                   return sample < entry.sample_offset;
+                               });
+    const size_t k = static_cast<size_t>(it - m_frame_index.begin()) - 1;
+
+    // Decode from frame j: frame k-1 refills the synthesis filter and
+    // IMDCT overlap, and in Layer III the frames before it refill the bit
+    // reservoir frame k-1 may draw on
+    size_t j = k;
+    if (j > 0) {
+        --j;
+        if (m_layer == MP3_LAYER_III) {
+            uint64_t reservoir = 0;
+            while (j > 0 && reservoir < s_max_reservoir_bytes) {
+                --j;
+                const uint64_t size = m_frame_index[j + 1].file_offset - m_frame_index[j].file_offset;
+                reservoir += size > s_max_frame_overhead ? size - s_max_frame_overhead : 0;
+            }
+        }
+    }
+    const MP3FrameIndexEntry entry = m_frame_index[j];
+    lock.unlock();
+
+    if (m_handler->seek(static_cast<off_t>(entry.file_offset), SEEK_SET) != 0) {
+        return false;
+    }
+    m_current_sample = entry.sample_offset;
+    m_trim_until = decoded_target;
+    Debug::log("mp3demux", "MP3NullDemuxer: Index seek to sample ", target_sample, " in frame ", k,
+               ", decoding from frame ", j);
+    return true;
+}
+
 // --- Static frame header helpers ---
 
 bool MP3NullDemuxer::isValidFrameHeader(const uint8_t header[4]) {
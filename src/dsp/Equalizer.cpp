@@ -23,12 +23,168 @@ constexpr const char* kBandLabel[Equalizer::kNumBands] = {"60", "150", "400", "1
 // response rather than isolated bumps.
 constexpr double kQ = 1.0;
 
+// Bands with w0 = 2*pi*f0/sr below this keep double coefficients and state.
+// Roundoff in a TDF-II section is amplified roughly by 1/w0^2; at this bound
+// float's ~-144 dB rounding floor stays under 16-bit resolution (-96 dB).
+constexpr double kMinFloatW0 = 2.0 * kPi / 128.0;
+
+// Snap filter history below this to zero: ~400 dB below full scale, far past
+// audibility, and well above both the float and double denormal thresholds.
+constexpr double kDenormalFloor = 1e-20;
+
 inline float clampDb(float db)
 {
     if (db < Equalizer::kMinGainDb) return Equalizer::kMinGainDb;
     if (db > Equalizer::kMaxGainDb) return Equalizer::kMaxGainDb;
     return db;
 }
+
+// Filter history is stored band-major with this many channel slots per band.
+constexpr int kEqStateStride = 8;
+
+// The active cascade, gathered by Equalizer::process(): `num_double` bands in
+// double precision followed by `num_float` bands in float, each with its
+// coefficients (b0, b1, b2, a1, a2) and a pointer to its history.
+struct EqCascade {
+    int num_double = 0;
+    int num_float = 0;
+    double kd[Equalizer::kNumBands][5];
+    float kf[Equalizer::kNumBands][5];
+    double* zd1[Equalizer::kNumBands];
+    double* zd2[Equalizer::kNumBands];
+    float* zf1[Equalizer::kNumBands];
+    float* zf2[Equalizer::kNumBands];
+};
+
+// Runs the whole cascade frame by frame over an interleaved buffer of C
+// channels, scaling the input by `gain` (the playback volume) on the way in.
+// The channels of a frame are filtered together as lanes; each band is a
+// transposed direct form II section. Band b of the next frame can start as
+// soon as band b of this one is done, so the core overlaps successive frames
+// down the cascade instead of waiting on one recursion at a time.
+#if defined(__GNUC__)
+// GCC/Clang vector extensions: lowered to SSE2/AVX or NEON for the target
+// without per-ISA code. Channel counts between the vector widths use a wider
+// vector with idle lanes, which costs nothing extra on the same instructions.
+template<typename T, int C>
+struct EqLanes {
+    static constexpr int N = C <= 2 ? 2 : (C <= 4 ? 4 : 8);
+    typedef T Vec __attribute__((vector_size(sizeof(T) * N)));
+};
+
+template<int C>
+void eqCascade(float* samples, size_t frame_count, float gain, const EqCascade& q)
+{
+    using VD = typename EqLanes<double, C>::Vec;
+    using VF = typename EqLanes<float, C>::Vec;
+    const int nd = q.num_double;
+    const int nf = q.num_float;
+
+    // Coefficients broadcast across lanes, history gathered into lanes.
+    VD kd[Equalizer::kNumBands][5], d1[Equalizer::kNumBands], d2[Equalizer::kNumBands];
+    VF kf[Equalizer::kNumBands][5], f1[Equalizer::kNumBands], f2[Equalizer::kNumBands];
+    for (int i = 0; i < nd; ++i) {
+        for (int j = 0; j < 5; ++j) kd[i][j] = VD{} + q.kd[i][j];
+        d1[i] = VD{}; d2[i] = VD{};
+        for (int c = 0; c < C; ++c) { d1[i][c] = q.zd1[i][c]; d2[i][c] = q.zd2[i][c]; }
+    }
+    for (int i = 0; i < nf; ++i) {
+        for (int j = 0; j < 5; ++j) kf[i][j] = VF{} + q.kf[i][j];
+        f1[i] = VF{}; f2[i] = VF{};
+        for (int c = 0; c < C; ++c) { f1[i][c] = q.zf1[i][c]; f2[i][c] = q.zf2[i][c]; }
+    }
+    const double g = gain;
+
+    for (size_t f = 0; f < frame_count; ++f) {
+        float* frame = samples + f * C;
+        VF in = {};
+        std::memcpy(&in, frame, C * sizeof(float));
+        VD xd = __builtin_convertvector(in, VD) * g;
+        for (int i = 0; i < nd; ++i) {
+            const VD y = kd[i][0] * xd + d1[i];
+            d1[i] = kd[i][1] * xd - kd[i][3] * y + d2[i];
+            d2[i] = kd[i][2] * xd - kd[i][4] * y;
+            xd = y;
+        }
+        VF xf = __builtin_convertvector(xd, VF);
+        for (int i = 0; i < nf; ++i) {
+            const VF y = kf[i][0] * xf + f1[i];
+            f1[i] = kf[i][1] * xf - kf[i][3] * y + f2[i];
+            f2[i] = kf[i][2] * xf - kf[i][4] * y;
+            xf = y;
+        }
+        std::memcpy(frame, &xf, C * sizeof(float));
+    }
+
+    for (int i = 0; i < nd; ++i) {
+        for (int c = 0; c < C; ++c) { q.zd1[i][c] = d1[i][c]; q.zd2[i][c] = d2[i][c]; }
+    }
+    for (int i = 0; i < nf; ++i) {
+        for (int c = 0; c < C; ++c) { q.zf1[i][c] = f1[i][c]; q.zf2[i][c] = f2[i][c]; }
+    }
+}
+#else
+template<int C>
+void eqCascade(float* samples, size_t frame_count, float gain, const EqCascade& q)
+{
+    for (size_t f = 0; f < frame_count; ++f) {
+        float* frame = samples + f * C;
+        for (int c = 0; c < C; ++c) {
+            double xd = static_cast<double>(frame[c]) * gain;
+            for (int i = 0; i < q.num_double; ++i) {
+                const double* k = q.kd[i];
+                const double y = k[0] * xd + q.zd1[i][c];
+                q.zd1[i][c] = k[1] * xd - k[3] * y + q.zd2[i][c];
+                q.zd2[i][c] = k[2] * xd - k[4] * y;
+                xd = y;
+            }
+            float xf = static_cast<float>(xd);
+            for (int i = 0; i < q.num_float; ++i) {
+                const float* k = q.kf[i];
+                const float y = k[0] * xf + q.zf1[i][c];
+                q.zf1[i][c] = k[1] * xf - k[3] * y + q.zf2[i][c];
+                q.zf2[i][c] = k[2] * xf - k[4] * y;
+                xf = y;
+            }
+            frame[c] = xf;
+        }
+    }
+}
+#endif
+
+// Instantiate the cascade per channel count so the lane loops fully unroll.
+void eqCascadeDispatch(float* samples, size_t frame_count, int channels, float gain,
+                       const EqCascade& q)
+{
+    switch (channels) {
+    case 1: eqCascade<1>(samples, frame_count, gain, q); break;
+    case 2: eqCascade<2>(samples, frame_count, gain, q); break;
+    case 3: eqCascade<3>(samples, frame_count, gain, q); break;
+    case 4: eqCascade<4>(samples, frame_count, gain, q); break;
+    case 5: eqCascade<5>(samples, frame_count, gain, q); break;
+    case 6: eqCascade<6>(samples, frame_count, gain, q); break;
+    case 7: eqCascade<7>(samples, frame_count, gain, q); break;
+    case 8: eqCascade<8>(samples, frame_count, gain, q); break;
+    default: break;
+    }
+}
+
+// Run once per buffer. During in-track digital silence the IIR history decays
+// geometrically into the denormal range, where x86 multiplies can cost 50-150x
+// normal cycles: a CPU spike inside the TimeCritical callback.
+template<typename T>
+void eqFlushDenormals(T* z, int channels)
+{
+    for (int c = 0; c < channels; ++c) {
+        if (std::fabs(z[c]) < static_cast<T>(kDenormalFloor)) z[c] = 0;
+    }
+}
+
+void eqApplyGain(float* samples, size_t count, float gain)
+{
+    if (gain == 1.0f) return;
+    for (size_t i = 0; i < count; ++i) samples[i] *= gain;
+}
 } // namespace
 
 Equalizer::Equalizer()
@@ -78,6 +234,24 @@ bool Equalizer::isEnabled() const   { return m_enabled.load(std::memory_order_re
 
 void Equalizer::requestReset() { m_reset_pending.store(true, std::memory_order_release); }
 
+bool Equalizer::bandUsesFloat(int band, int sample_rate)
+{
+    if (band < 0 || band >= kNumBands || sample_rate <= 0) return false;
+    return 2.0 * kPi * kBandFreq[band] / sample_rate >= kMinFloatW0;
+}
+
+void Equalizer::clearHistory()
+{
+    for (int b = 0; b < kNumBands; ++b) {
+        for (int c = 0; c < kMaxChannels; ++c) {
+            m_z1[b][c] = 0.0;
+            m_z2[b][c] = 0.0;
+            m_fz1[b][c] = 0.0f;
+            m_fz2[b][c] = 0.0f;
+        }
+    }
+}
+
 void Equalizer::latchReset()
 {
     if (m_reset_pending.exchange(false, std::memory_order_acquire)) {
@@ -90,6 +264,9 @@ void Equalizer::recompute()
     int sr = m_sample_rate.load(std::memory_order_relaxed);
     if (sr <= 0) sr = 44100;
 
+    int num_double = 0;
+    int float_bands[kNumBands];
+    int num_float = 0;
     for (int b = 0; b < kNumBands; ++b) {
         Biquad& q = m_coeff[b];
         double f0 = kBandFreq[b];
@@ -100,11 +277,15 @@ void Equalizer::recompute()
         // must be zeroed too: TDF-II would otherwise flush the stale z1/z2 into
         // the next two output samples (an audible click after a large boost).
         // recompute() runs on the audio thread, which owns the history — safe.
+        // An identity band is also dropped from the active list: process()
+        // skips it outright.
         if (gain_db == 0.0 || f0 >= 0.45 * sr) {
             q = Biquad{};
             for (int c = 0; c < kMaxChannels; ++c) {
-                m_z1[c][b] = 0.0;
-                m_z2[c][b] = 0.0;
+                m_z1[b][c] = 0.0;
+                m_z2[b][c] = 0.0;
+                m_fz1[b][c] = 0.0f;
+                m_fz2[b][c] = 0.0f;
             }
             continue;
         }
@@ -123,11 +304,28 @@ void Equalizer::recompute()
 
         q.b0 = b0 / a0; q.b1 = b1 / a0; q.b2 = b2 / a0;
         q.a1 = a1 / a0; q.a2 = a2 / a0;
+
+        // Precision depends only on the rate, so a gain change never moves a
+        // running band between the double and float history.
+        m_float_band[b] = bandUsesFloat(b, sr);
+        if (m_float_band[b]) {
+            float_bands[num_float++] = b;
+        } else {
+            m_active[num_double++] = b;
+        }
     }
+
+    // The bands are linear and time-invariant, so their order in the cascade
+    // does not change the result; run the double ones first.
+    for (int i = 0; i < num_float; ++i) m_active[num_double + i] = float_bands[i];
+    m_num_active = num_double + num_float;
 }
 
-void Equalizer::process(int16_t* samples, size_t frame_count, int channels)
+void Equalizer::process(float* samples, size_t frame_count, int channels, float gain)
 {
+    if (!samples || channels <= 0) return;
+    const size_t sample_count = frame_count * static_cast<size_t>(channels);
+
     const bool enabled = m_enabled.load(std::memory_order_relaxed);
     // Reset history on the disabled->enabled rising edge, detected here on the
     // audio thread. process() early-returns while disabled, freezing z1/z2 with
@@ -136,53 +334,66 @@ void Equalizer::process(int16_t* samples, size_t frame_count, int channels)
     // (rather than arming a reset from setEnabled) makes it immune to any
     // interleaving with the UI thread's enable toggle.
     if (enabled && !m_was_enabled) {
-        for (int c = 0; c < kMaxChannels; ++c)
-            for (int b = 0; b < kNumBands; ++b) { m_z1[c][b] = 0.0; m_z2[c][b] = 0.0; }
+        clearHistory();
     }
     m_was_enabled = enabled;
-    if (!enabled) return;
-    if (!samples || channels <= 0 || channels > kMaxChannels) return;
+    if (!enabled || channels > kMaxChannels) {
+        eqApplyGain(samples, sample_count, gain);
+        return;
+    }
 
-    // Consume only the flag latched under the producers' lock (latchReset());
+    // Consume only the flag latched at the queue's flush boundary (latchReset());
     // reading m_reset_pending here directly would let a reset armed after this
     // buffer was drained apply to the pre-reset data it was not meant for.
     if (m_reset_latched) {
         m_reset_latched = false;
-        for (int c = 0; c < kMaxChannels; ++c)
-            for (int b = 0; b < kNumBands; ++b) { m_z1[c][b] = 0.0; m_z2[c][b] = 0.0; }
+        clearHistory();
     }
 
     uint32_t d = m_dirty.load(std::memory_order_acquire);
     if (d != m_last_dirty) { recompute(); m_last_dirty = d; }
 
-    for (size_t f = 0; f < frame_count; ++f) {
-        for (int c = 0; c < channels; ++c) {
-            double s = static_cast<double>(samples[f * channels + c]);
-            // Cascade the bands (transposed direct form II per biquad).
-            for (int b = 0; b < kNumBands; ++b) {
-                const Biquad& q = m_coeff[b];
-                double y = q.b0 * s + m_z1[c][b];
-                m_z1[c][b] = q.b1 * s - q.a1 * y + m_z2[c][b];
-                m_z2[c][b] = q.b2 * s - q.a2 * y;
-                s = y;
-            }
-            if (s >  32767.0) s =  32767.0;
-            if (s < -32768.0) s = -32768.0;
-            samples[f * channels + c] = static_cast<int16_t>(std::lround(s));
-        }
+    if (m_num_active == 0) {
+        eqApplyGain(samples, sample_count, gain);
+        return;
     }
 
-    // Snap decayed filter state to true zero once per buffer. During in-track
-    // digital silence the IIR history decays geometrically into the double
-    // denormal range, where x86 multiplies can cost 50-150x normal cycles —
-    // a CPU spike inside this TimeCritical callback. 1e-20 is ~120 dB below
-    // one LSB, far past audibility, and well above the denormal threshold.
-    for (int c = 0; c < channels; ++c) {
-        for (int b = 0; b < kNumBands; ++b) {
-            if (std::fabs(m_z1[c][b]) < 1e-20) m_z1[c][b] = 0.0;
-            if (std::fabs(m_z2[c][b]) < 1e-20) m_z2[c][b] = 0.0;
+    static_assert(kMaxChannels == kEqStateStride, "history layout");
+    EqCascade cascade;
+    for (int i = 0; i < m_num_active; ++i) {
+        const int b = m_active[i];
+        const Biquad& q = m_coeff[b];
+        if (m_float_band[b]) {
+            const int j = cascade.num_float++;
+            cascade.kf[j][0] = static_cast<float>(q.b0);
+            cascade.kf[j][1] = static_cast<float>(q.b1);
+            cascade.kf[j][2] = static_cast<float>(q.b2);
+            cascade.kf[j][3] = static_cast<float>(q.a1);
+            cascade.kf[j][4] = static_cast<float>(q.a2);
+            cascade.zf1[j] = m_fz1[b];
+            cascade.zf2[j] = m_fz2[b];
+        } else {
+            const int j = cascade.num_double++;
+            cascade.kd[j][0] = q.b0; cascade.kd[j][1] = q.b1; cascade.kd[j][2] = q.b2;
+            cascade.kd[j][3] = q.a1; cascade.kd[j][4] = q.a2;
+            cascade.zd1[j] = m_z1[b];
+            cascade.zd2[j] = m_z2[b];
         }
     }
+
+    // The volume rides on the filter input. No clamp: a boost past full scale
+    // is left for the device conversion to saturate, and the float path keeps
+    // the headroom.
+    eqCascadeDispatch(samples, frame_count, channels, gain, cascade);
+
+    for (int i = 0; i < cascade.num_double; ++i) {
+        eqFlushDenormals(cascade.zd1[i], channels);
+        eqFlushDenormals(cascade.zd2[i], channels);
+    }
+    for (int i = 0; i < cascade.num_float; ++i) {
+        eqFlushDenormals(cascade.zf1[i], channels);
+        eqFlushDenormals(cascade.zf2[i], channels);
+    }
 }
 
 } // namespace DSP
@@ -0,0 +1,300 @@
+/*
+ * LoudnessMeter.cpp - EBU R128 / ITU-R BS.1770 loudness and true-peak meter (DSP).
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill II <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#include "psymp3.h"
+
+namespace PsyMP3 {
+namespace DSP {
+
+namespace {
+constexpr double kLoudnessPi = 3.14159265358979323846;
+constexpr double kLoudnessOffset = -0.691; // BS.1770: L = -0.691 + 10 log10(power)
+constexpr double kRelativeGateLu = -10.0;
+
+// Four channels of a frame, one per lane. GCC/Clang vector extensions give
+// SSE2/AVX/NEON code without per-ISA paths; other compilers get a plain loop.
+#if defined(__GNUC__)
+typedef double LmVec __attribute__((vector_size(32)));
+inline LmVec lmMax(LmVec a, LmVec b) { return a > b ? a : b; }
+#else
+struct LmVec {
+    double v[4];
+    LmVec operator+(const LmVec& o) const { LmVec r; for (int i = 0; i < 4; ++i) r.v[i] = v[i] + o.v[i]; return r; }
+    LmVec operator-(const LmVec& o) const { LmVec r; for (int i = 0; i < 4; ++i) r.v[i] = v[i] - o.v[i]; return r; }
+    LmVec operator*(const LmVec& o) const { LmVec r; for (int i = 0; i < 4; ++i) r.v[i] = v[i] * o.v[i]; return r; }
+};
+inline LmVec lmMax(LmVec a, LmVec b) { LmVec r; for (int i = 0; i < 4; ++i) r.v[i] = std::max(a.v[i], b.v[i]); return r; }
+#endif
+
+inline LmVec lmLoad(const double* p) { LmVec v; std::memcpy(&v, p, sizeof v); return v; }
+inline void lmStore(double* p, LmVec v) { std::memcpy(p, &v, sizeof v); }
+inline LmVec lmSplat(double x) { LmVec v; double a[4] = {x, x, x, x}; std::memcpy(&v, a, sizeof v); return v; }
+
+double lmPowerToLufs(double power)
+{
+    return kLoudnessOffset + 10.0 * std::log10(power);
+}
+
+double lmLufsToPower(double lufs)
+{
+    return std::pow(10.0, (lufs - kLoudnessOffset) / 10.0);
+}
+} // namespace
+
+LoudnessMeter::LoudnessMeter()
+{
+    configure(48000, 2);
+}
+
+void LoudnessMeter::configure(unsigned int sample_rate, unsigned int channels)
+{
+    m_rate = sample_rate > 0 ? sample_rate : 48000;
+    m_channels = std::clamp(static_cast<int>(channels), 1, kMaxChannels);
+    m_groups = (m_channels + kLanes - 1) / kLanes;
+    for (int c = 0; c < kMaxChannels; ++c) {
+        m_weight[c] = c < m_channels ? channelWeight(c, m_channels) : 0.0;
+    }
+
+    // K-weighting, stage 1: high shelf (+4 dB above ~1.5 kHz). Derived for
+    // any rate from the analog prototype of the BS.1770 48 kHz coefficients.
+    const double rate = static_cast<double>(m_rate);
+    {
+        const double f0 = 1681.974450955533;
+        const double gain_db = 3.999843853973347;
+        const double q = 0.7071752369554196;
+        const double k = std::tan(kLoudnessPi * f0 / rate);
+        const double vh = std::pow(10.0, gain_db / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+        m_shelf[0] = (vh + vb * k / q + k * k) / a0;
+        m_shelf[1] = 2.0 * (k * k - vh) / a0;
+        m_shelf[2] = (vh - vb * k / q + k * k) / a0;
+        m_shelf[3] = 2.0 * (k * k - 1.0) / a0;
+        m_shelf[4] = (1.0 - k / q + k * k) / a0;
+    }
+    // Stage 2: RLB high-pass at ~38 Hz.
+    {
+        const double f0 = 38.13547087602444;
+        const double q = 0.5003270373238773;
+        const double k = std::tan(kLoudnessPi * f0 / rate);
+        const double a0 = 1.0 + k / q + k * k;
+        m_highpass[0] = 1.0;
+        m_highpass[1] = -2.0;
+        m_highpass[2] = 1.0;
+        m_highpass[3] = 2.0 * (k * k - 1.0) / a0;
+        m_highpass[4] = (1.0 - k / q + k * k) / a0;
+    }
+
+    // True-peak interpolator: a Blackman-windowed sinc cut off at the input
+    // Nyquist, split into four phases. Each phase is normalized to unity DC
+    // gain, so interpolated peaks of low-frequency material are not biased.
+    constexpr int kTaps = kPhases * kTapsPerPhase;
+    const double centre = (kTaps - 1) / 2.0;
+    double proto[kTaps];
+    for (int n = 0; n < kTaps; ++n) {
+        const double x = (n - centre) / kPhases;
+        const double sinc = x == 0.0 ? 1.0 : std::sin(kLoudnessPi * x) / (kLoudnessPi * x);
+        const double w = 0.42 - 0.5 * std::cos(2.0 * kLoudnessPi * (n + 0.5) / kTaps) +
+                         0.08 * std::cos(4.0 * kLoudnessPi * (n + 0.5) / kTaps);
+        proto[n] = sinc * w;
+    }
+    m_fir_gain = 0.0;
+    for (int p = 0; p < kPhases; ++p) {
+        double sum = 0.0;
+        for (int k = 0; k < kTapsPerPhase; ++k) sum += proto[k * kPhases + p];
+        // Stored reversed: tap j multiplies the j-th oldest sample in the window.
+        double gain = 0.0;
+        for (int k = 0; k < kTapsPerPhase; ++k) {
+            m_fir[p][kTapsPerPhase - 1 - k] = proto[k * kPhases + p] / sum;
+            gain += std::fabs(m_fir[p][kTapsPerPhase - 1 - k]);
+        }
+        m_fir_gain = std::max(m_fir_gain, gain);
+    }
+
+    m_sub_frames = std::max<size_t>(1, (m_rate + 5) / 10);
+    reset();
+}
+
+void LoudnessMeter::reset()
+{
+    std::memset(m_z, 0, sizeof m_z);
+    std::memset(m_sub_energy, 0, sizeof m_sub_energy);
+    std::memset(m_recent, 0, sizeof m_recent);
+    std::memset(m_tail, 0, sizeof m_tail);
+    m_sub_fill = 0;
+    m_recent_count = 0;
+    m_block_power.clear();
+    m_true_peak = 0.0;
+    m_sample_peak = 0.0;
+    m_frames = 0;
+}
+
+double LoudnessMeter::channelWeight(int channel, int channels)
+{
+    // WAVE/SMPTE order: L R C LFE Ls Rs (5.1), L R C LFE Lb Rb Ls Rs (7.1),
+    // L R C Ls Rs (5.0). Surrounds count +1.5 dB, the LFE not at all.
+    if (channels == 6 || channels == 8) {
+        if (channel == 3) return 0.0;
+        if (channel >= 4) return 1.41;
+    } else if (channels == 5 && channel >= 3) {
+        return 1.41;
+    }
+    return 1.0;
+}
+
+void LoudnessMeter::process(const float* samples, size_t frames)
+{
+    if (!samples || frames == 0) {
+        return;
+    }
+    const size_t ch = static_cast<size_t>(m_channels);
+    const LmVec s0 = lmSplat(m_shelf[0]), s1 = lmSplat(m_shelf[1]), s2 = lmSplat(m_shelf[2]);
+    const LmVec sa1 = lmSplat(m_shelf[3]), sa2 = lmSplat(m_shelf[4]);
+    const LmVec h0 = lmSplat(m_highpass[0]), h1 = lmSplat(m_highpass[1]), h2 = lmSplat(m_highpass[2]);
+    const LmVec ha1 = lmSplat(m_highpass[3]), ha2 = lmSplat(m_highpass[4]);
+    LmVec fir[kPhases][kTapsPerPhase];
+    for (int p = 0; p < kPhases; ++p) {
+        for (int k = 0; k < kTapsPerPhase; ++k) fir[p][k] = lmSplat(m_fir[p][k]);
+    }
+
+    constexpr int kHistory = kTapsPerPhase - 1;
+    const double skip_gain_sq = m_fir_gain * m_fir_gain;
+
+    size_t done = 0;
+    while (done < frames) {
+        // Run up to the next 100 ms sub-block boundary, one lane group at a
+        // time: the groups are independent, so their state stays in registers.
+        const size_t n = std::min(frames - done, m_sub_frames - m_sub_fill);
+        const float* in = samples + done * ch;
+        for (int g = 0; g < m_groups; ++g) {
+            const int first = g * kLanes;
+            const int lanes = std::min(kLanes, m_channels - first);
+            LmVec z1 = lmLoad(m_z[g][0]), z2 = lmLoad(m_z[g][1]);
+            LmVec z3 = lmLoad(m_z[g][2]), z4 = lmLoad(m_z[g][3]);
+            LmVec energy = lmLoad(m_sub_energy[g]);
+            LmVec peak = lmSplat(0.0);
+            LmVec true_peak = lmSplat(m_true_peak * m_true_peak);
+
+            // The tile plus the frames before it that its interpolation reads.
+            LmVec window[kHistory + kTileFrames];
+            for (int h = 0; h < kHistory; ++h) window[h] = lmLoad(m_tail[g][h]);
+
+            for (size_t tile = 0; tile < n; tile += kTileFrames) {
+                const size_t count = std::min<size_t>(kTileFrames, n - tile);
+                LmVec tile_peak = peak;
+                for (size_t f = 0; f < count; ++f) {
+                    double lane[kLanes] = {0.0, 0.0, 0.0, 0.0};
+                    const float* frame = in + (tile + f) * ch + first;
+                    for (int l = 0; l < lanes; ++l) lane[l] = frame[l];
+                    const LmVec x = lmLoad(lane);
+                    window[kHistory + f] = x;
+
+                    const LmVec y = s0 * x + z1;
+                    z1 = s1 * x - sa1 * y + z2;
+                    z2 = s2 * x - sa2 * y;
+                    const LmVec k = h0 * y + z3;
+                    z3 = h1 * y - ha1 * k + z4;
+                    z4 = h2 * y - ha2 * k;
+                    energy = energy + k * k;
+                    tile_peak = lmMax(tile_peak, x * x);
+                }
+                for (int h = 0; h < kHistory; ++h) tile_peak = lmMax(tile_peak, window[h] * window[h]);
+                peak = lmMax(peak, tile_peak);
+
+                // |interpolated| <= window max * sum(|tap|): skip the tile
+                // unless some lane could beat its current true peak.
+                double tp[kLanes], bound[kLanes];
+                lmStore(tp, true_peak);
+                lmStore(bound, tile_peak);
+                bool interpolate = false;
+                for (int l = 0; l < lanes; ++l) {
+                    interpolate = interpolate || bound[l] * skip_gain_sq > tp[l];
+                }
+                if (interpolate) {
+                    for (size_t f = 0; f < count; ++f) {
+                        const LmVec* w = window + f;
+                        for (int p = 0; p < kPhases; ++p) {
+                            LmVec acc = fir[p][0] * w[0];
+                            for (int t = 1; t < kTapsPerPhase; ++t) acc = acc + fir[p][t] * w[t];
+                            true_peak = lmMax(true_peak, acc * acc);
+                        }
+                    }
+                }
+                for (int h = 0; h < kHistory; ++h) window[h] = window[count + h];
+            }
+            for (int h = 0; h < kHistory; ++h) lmStore(m_tail[g][h], window[h]);
+
+            lmStore(m_z[g][0], z1);
+            lmStore(m_z[g][1], z2);
+            lmStore(m_z[g][2], z3);
+            lmStore(m_z[g][3], z4);
+            lmStore(m_sub_energy[g], energy);
+            double pk[kLanes], tp[kLanes];
+            lmStore(pk, peak);
+            lmStore(tp, true_peak);
+            for (int l = 0; l < lanes; ++l) {
+                m_sample_peak = std::max(m_sample_peak, std::sqrt(pk[l]));
+                m_true_peak = std::max(m_true_peak, std::sqrt(tp[l]));
+            }
+        }
+        m_sub_fill += n;
+        m_frames += n;
+        done += n;
+
+        if (m_sub_fill == m_sub_frames) {
+            double weighted = 0.0;
+            for (int c = 0; c < m_channels; ++c) {
+                weighted += m_weight[c] * m_sub_energy[c / kLanes][c % kLanes];
+            }
+            std::memset(m_sub_energy, 0, sizeof m_sub_energy);
+            m_sub_fill = 0;
+            std::memmove(m_recent, m_recent + 1, 3 * sizeof(double));
+            m_recent[3] = weighted;
+            if (++m_recent_count >= 4) {
+                const double sum = m_recent[0] + m_recent[1] + m_recent[2] + m_recent[3];
+                m_block_power.push_back(sum / (4.0 * static_cast<double>(m_sub_frames)));
+            }
+        }
+    }
+}
+
+double LoudnessMeter::integratedLufs() const
+{
+    const double absolute_gate = lmLufsToPower(kSilenceLufs);
+    double sum = 0.0;
+    size_t count = 0;
+    for (double p : m_block_power) {
+        if (p > absolute_gate) {
+            sum += p;
+            ++count;
+        }
+    }
+    if (count == 0) {
+        return kSilenceLufs;
+    }
+    const double relative_gate = lmLufsToPower(lmPowerToLufs(sum / count) + kRelativeGateLu);
+    const double gate = std::max(absolute_gate, relative_gate);
+    sum = 0.0;
+    count = 0;
+    for (double p : m_block_power) {
+        if (p > gate) {
+            sum += p;
+            ++count;
+        }
+    }
+    return count ? lmPowerToLufs(sum / count) : kSilenceLufs;
+}
+
+double LoudnessMeter::truePeak() const
+{
+    return std::max(m_true_peak, m_sample_peak);
+}
+
+} // namespace DSP
+} // namespace PsyMP3
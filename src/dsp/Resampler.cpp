@@ -0,0 +1,311 @@
+/*
+ * Resampler.cpp - Polyphase windowed-sinc sample-rate converter (DSP) implementation.
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill II <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#include "psymp3.h"
+
+namespace PsyMP3 {
+namespace DSP {
+
+namespace {
+constexpr double kSincPi = 3.14159265358979323846;
+
+// Filter design. With 64 taps a Kaiser beta of 8.6 gives ~85 dB of stopband
+// rejection over a ~0.085*fs transition band; placing the cutoff at 0.91 of the
+// lower Nyquist keeps 44.1k material flat to ~18 kHz while the band edge still
+// lands below the Nyquist of the slower side.
+constexpr double kKaiserBeta = 8.6;
+constexpr double kCutoff     = 0.91;
+constexpr int    kHalfTaps   = Resampler::kTaps / 2;
+
+// Zeroth-order modified Bessel function of the first kind (Kaiser window).
+double besselI0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    const double q = x * x / 4.0;
+    for (int k = 1; k < 64; ++k) {
+        term *= q / (static_cast<double>(k) * k);
+        sum += term;
+        if (term < sum * 1e-17) break;
+    }
+    return sum;
+}
+
+#if !defined(HAVE_SSE2) && !defined(HAVE_NEON)
+float dotScalar(const float* x, const float* h)
+{
+    float a0 = 0.0f, a1 = 0.0f, a2 = 0.0f, a3 = 0.0f;
+    for (int i = 0; i < Resampler::kTaps; i += 4) {
+        a0 += x[i] * h[i];
+        a1 += x[i + 1] * h[i + 1];
+        a2 += x[i + 2] * h[i + 2];
+        a3 += x[i + 3] * h[i + 3];
+    }
+    return (a0 + a1) + (a2 + a3);
+}
+#endif
+
+#ifdef HAVE_SSE2
+float dotSSE2(const float* x, const float* h)
+{
+    __m128 a0 = _mm_setzero_ps();
+    __m128 a1 = _mm_setzero_ps();
+    __m128 a2 = _mm_setzero_ps();
+    __m128 a3 = _mm_setzero_ps();
+    for (int i = 0; i < Resampler::kTaps; i += 16) {
+        a0 = _mm_add_ps(a0, _mm_mul_ps(_mm_loadu_ps(x + i),      _mm_loadu_ps(h + i)));
+        a1 = _mm_add_ps(a1, _mm_mul_ps(_mm_loadu_ps(x + i + 4),  _mm_loadu_ps(h + i + 4)));
+        a2 = _mm_add_ps(a2, _mm_mul_ps(_mm_loadu_ps(x + i + 8),  _mm_loadu_ps(h + i + 8)));
+        a3 = _mm_add_ps(a3, _mm_mul_ps(_mm_loadu_ps(x + i + 12), _mm_loadu_ps(h + i + 12)));
+    }
+    __m128 s = _mm_add_ps(_mm_add_ps(a0, a1), _mm_add_ps(a2, a3));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x55));
+    return _mm_cvtss_f32(s);
+}
+#endif
+
+#ifdef HAVE_AVX2_TARGET
+// Compiled for AVX2+FMA regardless of the baseline -march; only called after
+// the runtime CPU check in configure().
+__attribute__((target("avx2,fma")))
+float dotAVX2(const float* x, const float* h)
+{
+    __m256 a0 = _mm256_setzero_ps();
+    __m256 a1 = _mm256_setzero_ps();
+    for (int i = 0; i < Resampler::kTaps; i += 16) {
+        a0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i),     _mm256_loadu_ps(h + i),     a0);
+        a1 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(h + i + 8), a1);
+    }
+    const __m256 s8 = _mm256_add_ps(a0, a1);
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(s8), _mm256_extractf128_ps(s8, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x55));
+    return _mm_cvtss_f32(s);
+}
+#endif
+
+#ifdef HAVE_NEON
+float dotNEON(const float* x, const float* h)
+{
+    float32x4_t a0 = vdupq_n_f32(0.0f);
+    float32x4_t a1 = vdupq_n_f32(0.0f);
+    float32x4_t a2 = vdupq_n_f32(0.0f);
+    float32x4_t a3 = vdupq_n_f32(0.0f);
+    for (int i = 0; i < Resampler::kTaps; i += 16) {
+        a0 = vmlaq_f32(a0, vld1q_f32(x + i),      vld1q_f32(h + i));
+        a1 = vmlaq_f32(a1, vld1q_f32(x + i + 4),  vld1q_f32(h + i + 4));
+        a2 = vmlaq_f32(a2, vld1q_f32(x + i + 8),  vld1q_f32(h + i + 8));
+        a3 = vmlaq_f32(a3, vld1q_f32(x + i + 12), vld1q_f32(h + i + 12));
+    }
+    const float32x4_t s = vaddq_f32(vaddq_f32(a0, a1), vaddq_f32(a2, a3));
+    const float32x2_t p = vadd_f32(vget_low_f32(s), vget_high_f32(s));
+    return vget_lane_f32(vpadd_f32(p, p), 0);
+}
+#endif
+
+struct Kernel { float (*fn)(const float*, const float*); const char* name; };
+
+Kernel selectKernel()
+{
+#ifdef HAVE_AVX2_TARGET
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return {dotAVX2, "avx2"};
+    }
+#endif
+#if defined(HAVE_SSE2)
+    return {dotSSE2, "sse2"};
+#elif defined(HAVE_NEON)
+    return {dotNEON, "neon"};
+#else
+    return {dotScalar, "scalar"};
+#endif
+}
+
+// Float output passes through unclamped (the pipeline keeps headroom until
+// the device); int16 output rounds and saturates.
+template<typename T> T toOutput(float v);
+
+template<> inline float toOutput<float>(float v)
+{
+    return v;
+}
+
+template<> inline int16_t toOutput<int16_t>(float v)
+{
+    if (v >= 32767.0f) return 32767;
+    if (v <= -32768.0f) return -32768;
+    return static_cast<int16_t>(std::lrint(v));
+}
+} // namespace
+
+void Resampler::configure(unsigned int in_rate, unsigned int out_rate, unsigned int channels)
+{
+    m_in_rate = in_rate;
+    m_out_rate = out_rate;
+    m_channels = channels;
+    m_active = in_rate != 0 && out_rate != 0 && channels != 0 && in_rate != out_rate;
+    m_bank.clear();
+    m_hist.clear();
+    if (!m_active) {
+        return;
+    }
+
+    const unsigned int g = std::gcd(in_rate, out_rate);
+    m_L = out_rate / g;
+    m_M = in_rate / g;
+    m_step_int = m_M / m_L;
+    m_step_frac = m_M % m_L;
+    m_phases = std::min<uint32_t>(m_L, kMaxPhases);
+    m_dot = selectKernel().fn;
+
+    buildFilterBank();
+    m_hist.assign(channels, std::vector<float>());
+    reset();
+
+    Debug::log("dsp", "Resampler: ", in_rate, "Hz -> ", out_rate, "Hz (", m_L, "/", m_M,
+               ", ", m_phases, " phases, ", kernelName(), " kernel)");
+}
+
+void Resampler::buildFilterBank()
+{
+    const double cutoff = kCutoff * std::min(1.0, static_cast<double>(m_out_rate) / m_in_rate);
+    const double i0_beta = besselI0(kKaiserBeta);
+    m_bank.assign(static_cast<size_t>(m_phases) * kTaps, 0.0f);
+
+    for (uint32_t p = 0; p < m_phases; ++p) {
+        // Tap j of phase p weighs the input frame (j - (kHalfTaps - 1) - frac)
+        // input periods away from the output instant.
+        const double frac = static_cast<double>(p) / m_phases;
+        double taps[kTaps];
+        double sum = 0.0;
+        for (int j = 0; j < kTaps; ++j) {
+            const double x = static_cast<double>(j - (kHalfTaps - 1)) - frac;
+            const double arg = cutoff * x;
+            const double sinc = (arg == 0.0) ? 1.0 : std::sin(kSincPi * arg) / (kSincPi * arg);
+            const double r = std::min(1.0, std::fabs(x) / kHalfTaps);
+            const double window = besselI0(kKaiserBeta * std::sqrt(1.0 - r * r)) / i0_beta;
+            taps[j] = cutoff * sinc * window;
+            sum += taps[j];
+        }
+        float* dst = &m_bank[static_cast<size_t>(p) * kTaps];
+        for (int j = 0; j < kTaps; ++j) {
+            dst[j] = static_cast<float>(taps[j] / sum);
+        }
+    }
+}
+
+void Resampler::reset()
+{
+    // Prime each channel with kHalfTaps - 1 frames of silence so the first
+    // output is centred on the first input frame.
+    for (auto& h : m_hist) {
+        h.assign(kHalfTaps - 1, 0.0f);
+    }
+    m_pos = 0;
+    m_frac = 0;
+}
+
+template<typename T>
+void Resampler::processImpl(const T* in, size_t frames, std::vector<T>& out)
+{
+    if (!m_active) {
+        out.assign(in, in + frames * m_channels);
+        return;
+    }
+    for (unsigned int c = 0; c < m_channels; ++c) {
+        std::vector<float>& h = m_hist[c];
+        const size_t base = h.size();
+        h.resize(base + frames);
+        const T* src = in + c;
+        for (size_t i = 0; i < frames; ++i, src += m_channels) {
+            h[base + i] = static_cast<float>(*src);
+        }
+    }
+    run(out);
+}
+
+void Resampler::process(const float* in, size_t frames, std::vector<float>& out)
+{
+    processImpl(in, frames, out);
+}
+
+void Resampler::process(const int16_t* in, size_t frames, std::vector<int16_t>& out)
+{
+    processImpl(in, frames, out);
+}
+
+template<typename T>
+void Resampler::drainImpl(std::vector<T>& out)
+{
+    if (!m_active) {
+        out.clear();
+        return;
+    }
+    // kHalfTaps frames of silence let every output up to the last input frame
+    // see a full window; run() stops before producing any past it.
+    for (auto& h : m_hist) {
+        h.resize(h.size() + kHalfTaps, 0.0f);
+    }
+    run(out);
+    reset();
+}
+
+void Resampler::drain(std::vector<float>& out)
+{
+    drainImpl(out);
+}
+
+void Resampler::drain(std::vector<int16_t>& out)
+{
+    drainImpl(out);
+}
+
+template<typename T>
+void Resampler::run(std::vector<T>& out)
+{
+    out.clear();
+    const size_t len = m_hist[0].size();
+    if (m_pos + kTaps <= len) {
+        const size_t estimate = ((len - kTaps - m_pos) * m_L) / m_M + 2;
+        out.reserve(estimate * m_channels);
+    }
+
+    while (m_pos + kTaps <= len) {
+        const uint32_t phase = (m_phases == m_L)
+            ? m_frac
+            : static_cast<uint32_t>((static_cast<uint64_t>(m_frac) * m_phases) / m_L);
+        const float* h = &m_bank[static_cast<size_t>(phase) * kTaps];
+        for (unsigned int c = 0; c < m_channels; ++c) {
+            out.push_back(toOutput<T>(m_dot(m_hist[c].data() + m_pos, h)));
+        }
+        m_pos += m_step_int;
+        m_frac += m_step_frac;
+        if (m_frac >= m_L) {
+            m_frac -= m_L;
+            ++m_pos;
+        }
+    }
+
+    // Discard history no future output can reach. When downsampling, m_pos may
+    // already point past the buffered input; carry the remainder over.
+    const size_t consumed = std::min(m_pos, len);
+    for (auto& h : m_hist) {
+        h.erase(h.begin(), h.begin() + static_cast<std::ptrdiff_t>(consumed));
+    }
+    m_pos -= consumed;
+}
+
+const char* Resampler::kernelName() const
+{
+    return selectKernel().name;
+}
+
+} // namespace DSP
+} // namespace PsyMP3
@@ -137,14 +137,25 @@ enum Win32MenuId : unsigned int {
 } // namespace
 #endif // _WIN32
 
+constexpr unsigned int kMinResampleTargetRate = 44100;
+
 bool canReuseAudioForStream(const Audio* audio, Stream* stream)
 {
     if (!audio || !stream) {
         return false;
     }
 
-    return static_cast<unsigned int>(audio->getRate()) == stream->getRate() &&
-           static_cast<unsigned int>(audio->getChannels()) == stream->getChannels();
+    if (static_cast<unsigned int>(audio->getChannels()) != stream->getChannels()) {
+        return false;
+    }
+    // Audio resamples a stream at another rate to its own, so the device stays
+    // open (and the transition gapless) across 44.1k/48k/96k albums. Only
+    // reopen when the device rate is below CD quality and the new stream has
+    // more bandwidth than that: a session that began on an 8/22 kHz voice file
+    // should not squeeze every later album through it.
+    const unsigned int device_rate = static_cast<unsigned int>(audio->getRate());
+    return device_rate == stream->getRate() ||
+           device_rate >= std::min(stream->getRate(), kMinResampleTargetRate);
 }
 
 TagLib::String toUtf8TagString(const std::string& text)
@@ -207,16 +218,15 @@ size_t getPrimeSampleCount(Stream* stream)
     return std::max<size_t>(4096, samples_per_half_second);
 }
 
-std::pair<std::vector<int16_t>, bool> primeLoadedStream(Stream* stream)
+std::pair<std::vector<float>, bool> primeLoadedStream(Stream* stream)
 {
     if (!stream) {
         return {{}, false};
     }
 
     const size_t prime_samples = getPrimeSampleCount(stream);
-    std::vector<int16_t> primed_samples(prime_samples);
-    const size_t bytes_read = stream->getData(prime_samples * sizeof(int16_t), primed_samples.data());
-    primed_samples.resize(bytes_read / sizeof(int16_t));
+    std::vector<float> primed_samples(prime_samples);
+    primed_samples.resize(stream->getDataFloat(prime_samples, primed_samples.data()));
     return {std::move(primed_samples), stream->eof()};
 }
 
@@ -580,6 +590,14 @@ Player::Player() : m_rng(std::random_device{}()) {
     m_automated_test_mode = false;
     m_automated_test_track_count = 0;
     m_show_mpris_errors = true;
+    // Before the loader thread, which looks every track up in it.
+    m_loudness_cache = std::make_unique<PsyMP3::Core::LoudnessCache>(
+        System::getStoragePath().to8Bit(true) + "/loudness-cache.txt");
+    m_loudness_cache->load();
+#ifdef HAVE_FLAC
+    PsyMP3::Demuxer::FLAC::FLACSeekIndexCache::setDirectory(
+        System::getStoragePath().to8Bit(true) + "/flac-index");
+#endif
     m_loader_thread = std::thread(&Player::loaderThreadLoop, this);
     
     // Initialize Last.fm scrobbling
@@ -614,6 +632,7 @@ Player::~Player() {
 
     // Stop audio first to join decoder threads before deleting other members
     audio.reset();
+    stopLoudnessScanner();
 
     // Notify all windows that the application is shutting down
     if (ApplicationWidget::isInitialized()) {
@@ -810,7 +829,7 @@ void Player::loaderThreadLoop() {
         Stream* new_stream = nullptr;
         TagLib::String error_msg;
         size_t num_chained = 1;
-        std::vector<int16_t> primed_samples;
+        std::vector<float> primed_samples;
         bool primed_eof = false;
 
         try {
@@ -822,12 +841,16 @@ void Player::loaderThreadLoop() {
                 case LoadRequestType::PlayNow:
                 case LoadRequestType::Preload:
                     stream_holder = MediaFile::open(request.path);
+                    applyCachedLoudness(stream_holder.get(), request.path);
                     num_chained = 1;
                     break;
-                case LoadRequestType::PreloadChained:
-                    stream_holder = std::make_unique<ChainedStream>(request.paths);
+                case LoadRequestType::PreloadChained: {
+                    auto chained = std::make_unique<ChainedStream>(request.paths);
+                    applyCachedLoudness(chained.get(), request.paths);
+                    stream_holder = std::move(chained);
                     num_chained = request.paths.size();
                     break;
+                }
             }
 
             if (stream_holder) {
@@ -915,6 +938,7 @@ void Player::handleTrackSeamlessSwapEvent() {
     // load is already in flight; do nothing rather than destroying the live
     // Audio and throwing in the Audio constructor on a null stream (which would
     // also desync the playlist via handleUnplayableTrack).
+    const bool crossfade = std::exchange(m_crossfade_requested, false);
     if (!m_next_stream) {
         Debug::log("audio", "Player::handleTrackSeamlessSwapEvent(): m_next_stream is null, skipping swap");
         return;
@@ -932,9 +956,20 @@ void Player::handleTrackSeamlessSwapEvent() {
                                             fft.get(),
                                             mutex.get(),
                                             std::move(m_next_stream_primed_samples),
-                                            m_next_stream_primed_eof);
+                                            m_next_stream_primed_eof,
+                                            m_replaygain_enabled);
             audio->setVolume(m_volume);
             applyEqStateToAudio();
+            applyCrossfadeToAudio();
+            applySeekHistoryToAudio();
+        } else if (crossfade) {
+            // Posted early by updateState(): the current track is still
+            // playing its last seconds, which Audio mixes into the new one.
+            Debug::log("audio", "Starting crossfade stream transition.");
+            auto owned_stream = std::move(m_next_stream);
+            audio->crossfadeTo(std::move(owned_stream),
+                               std::move(m_next_stream_primed_samples),
+                               m_next_stream_primed_eof);
         } else {
             // Same audio format, can seamlessly switch streams
             Debug::log("audio", "Performing seamless stream transition.");
@@ -2124,17 +2159,24 @@ void Player::seekToInternal(unsigned long pos, bool monitor_seek_errors)
         const unsigned long previous_pos_ms = stream->getPosition();
         const unsigned long total_len_ms = stream->getLength();
 
-        if (audio) {
-            audio->resetBuffer();
-            // Widen before multiplying: pos is unsigned long (32-bit on LLP64
-            // Windows and ILP32 targets), so pos*rate wraps past ~97 s at
-            // 44.1 kHz and corrupts the samples-played counter that drives the
-            // position readout. Match the uint64_t pattern used below.
-            audio->setSamplesPlayed((static_cast<uint64_t>(pos) * audio->getRate()) / 1000);
+        // A target still in the decoded-PCM window (a short jump back, or
+        // ahead into what is queued) is replayed from memory; the stream is
+        // not touched, so there is nothing for the seek monitor to check.
+        const bool from_history = audio && audio->getRate() > 0 &&
+            audio->seekInHistory((static_cast<uint64_t>(pos) * audio->getRate()) / 1000);
+        if (!from_history) {
+            if (audio) {
+                audio->resetBuffer();
+                // Widen before multiplying: pos is unsigned long (32-bit on LLP64
+                // Windows and ILP32 targets), so pos*rate wraps past ~97 s at
+                // 44.1 kHz and corrupts the samples-played counter that drives the
+                // position readout. Match the uint64_t pattern used below.
+                audio->setSamplesPlayed((static_cast<uint64_t>(pos) * audio->getRate()) / 1000);
+            }
+            stream->seekTo(pos);
         }
-        stream->seekTo(pos);
 
-        if (monitor_seek_errors) {
+        if (monitor_seek_errors && !from_history) {
             const unsigned long actual_pos_ms = stream->getPosition();
             const bool stream_eof = stream->eof();
             const bool audio_finished = audio ? audio->isFinished() : false;
@@ -2307,6 +2349,7 @@ void Player::renderOverlay(Stream* current_stream, unsigned long current_pos_ms)
 void Player::updateState(Stream*& current_stream, unsigned long& current_pos_ms, unsigned long& total_len_ms, TagLib::String& artist, TagLib::String& title)
 {
     // Don't clear the graph surface - widgets will draw their own backgrounds
+    pollLoudnessScan();
 
     // Copy data from stream object while locked
     if (audio && audio->getCurrentStream()) {
@@ -2348,8 +2391,10 @@ void Player::updateState(Stream*& current_stream, unsigned long& current_pos_ms,
         // preloading so track-end routes through nextTrack()'s stop logic.
         const bool may_advance = playlist &&
             (m_loop_mode == LoopMode::All || !playlist->advanceWouldWrap(1));
+        // A crossfade needs the next track in hand before the fade starts.
+        const unsigned long preload_lead_ms = std::max(10000ul, m_crossfade_ms + 5000ul);
         if (!m_next_stream && !m_preloading_track && total_len_ms > 0 &&
-            (total_len_ms - current_pos_ms) < 10000 && playlist && may_advance) {
+            (total_len_ms - current_pos_ms) < preload_lead_ms && playlist && may_advance) {
 
             // Look ahead for sequences of short tracks and automatically chain
             // them. This scan walks sequential playlist indices, which only
@@ -2404,8 +2449,26 @@ void Player::updateState(Stream*& current_stream, unsigned long& current_pos_ms,
             }
         }
 
-        // Update spectrum data in the widget - it will render itself via the widget tree
-        if (m_spectrum_widget && audio) {
+        // Crossfade: swap to the preloaded track while this one still has
+        // the fade length to play; Audio mixes the two. Only where the swap
+        // keeps the device (a reopen would cut anyway) and both tracks are
+        // long enough to hold a whole fade. Otherwise track end swaps as usual.
+        if (m_next_stream && !m_crossfade_requested && m_crossfade_ms > 0 &&
+            state == PlayerState::Playing && m_loop_mode != LoopMode::One &&
+            m_seek_direction == 0 && total_len_ms > 2ul * m_crossfade_ms &&
+            m_next_stream->getLength() > 2ul * m_crossfade_ms &&
+            current_pos_ms + m_crossfade_ms >= total_len_ms &&
+            canReuseAudioForStream(audio.get(), m_next_stream.get())) {
+            m_crossfade_requested = true;
+            synthesizeUserEvent(TRACK_SEAMLESS_SWAP, nullptr, nullptr);
+        }
+
+        // Update spectrum data in the widget - it will render itself via the widget tree.
+        // The FFT runs here, at the display rate, on the audio the callback
+        // tapped since the last frame; skip it (and the widget update) entirely
+        // while nobody can see the result.
+        if (m_spectrum_widget && audio && m_spectrum_widget->isVisible() && !m_window_obscured) {
+            audio->analyzeSpectrum();
             std::lock_guard<std::mutex> fft_lock(audio->getFFTMutex());
             float *spectrum = fft->getFFT();
             // Use 320 bands like the original renderSpectrum (first 320 of 512 FFT values)
@@ -2582,6 +2645,14 @@ bool Player::updateGUI()
             auto it = m_labels.find("fps");
             if (it != m_labels.end() && m_show_debug)
                 it->second->setText("FPS: " + std::to_string(fps));
+            if (m_show_debug && audio) {
+                const auto telemetry = audio->getTelemetrySnapshot();
+                char cb_buf[32];
+                snprintf(cb_buf, sizeof(cb_buf), "CB p99: %.2f ms",
+                         telemetry.callback_us.percentile(0.99) / 1000.0);
+                m_labels.at("audio_cb")->setText(cb_buf);
+                m_labels.at("audio_xrun")->setText("Underruns: " + std::to_string(telemetry.underrun_episodes));
+            }
             fps_window_start = now;
             fps_frame_count = 0;
         }
@@ -2809,7 +2880,7 @@ bool Player::handleKeyPress(const SDL_keysym& keysym)
         case SDLK_LEFT:
             // On the initial key press, capture the current position to seek from.
             if (m_seek_direction == 0 && stream) {
-                m_seek_position_ms = stream->getPosition();
+                m_seek_position_ms = playbackPositionMs();
             }
             m_seek_direction = 1;
             if (!m_seek_left_indicator) {
@@ -2829,7 +2900,7 @@ bool Player::handleKeyPress(const SDL_keysym& keysym)
         case SDLK_RIGHT:
             // On the initial key press, capture the current position to seek from.
             if (m_seek_direction == 0 && stream) {
-                m_seek_position_ms = stream->getPosition();
+                m_seek_position_ms = playbackPositionMs();
             }
             m_seek_direction = 2;
             if (!m_seek_right_indicator) {
@@ -3271,6 +3342,8 @@ bool Player::Initialize(const PlayerOptions& options) {
     add_label(app_widget,     "decay",    Rect(525, MenuBarWidget::BAR_H + 15, 115, 16));
     add_label(app_widget,     "fft_mode", Rect(525, MenuBarWidget::BAR_H + 30, 115, 16));
     add_label(app_widget,     "fps",      Rect(525, MenuBarWidget::BAR_H + 45, 115, 16));
+    add_label(app_widget,     "audio_cb", Rect(525, MenuBarWidget::BAR_H + 60, 115, 16));
+    add_label(app_widget,     "audio_xrun", Rect(525, MenuBarWidget::BAR_H + 75, 115, 16));
 
     app_widget.addChild(std::move(hud_panel));
 
@@ -3393,11 +3466,45 @@ bool Player::Initialize(const PlayerOptions& options) {
             MI::sep(),
             fps_item("Unlimited", 0),
         }));
+        auto crossfade_item = [this](const char* label, unsigned int ms) {
+            return MI::leaf(label,
+                [this, ms]{ setCrossfade(ms, m_crossfade_curve); },
+                [this, ms]{ return m_crossfade_ms == ms; });
+        };
+        auto crossfade_curve_item = [this](const char* label, Crossfader::Curve curve) {
+            return MI::leaf(label,
+                [this, curve]{ setCrossfade(m_crossfade_ms, curve); },
+                [this, curve]{ return m_crossfade_curve == curve; });
+        };
+        settings_items.push_back(MI::sub("Crossfade", {
+            crossfade_item("Off", 0),
+            crossfade_item("2 seconds", 2000),
+            crossfade_item("5 seconds", 5000),
+            crossfade_item("10 seconds", 10000),
+            MI::sep(),
+            crossfade_curve_item("Equal power", Crossfader::Curve::EqualPower),
+            crossfade_curve_item("Linear", Crossfader::Curve::Linear),
+        }));
+        auto seek_history_item = [this](const char* label, unsigned int ms) {
+            return MI::leaf(label,
+                [this, ms]{ setSeekHistory(ms); },
+                [this, ms]{ return m_seek_history_ms == ms; });
+        };
+        settings_items.push_back(MI::sub("Seek History", {
+            seek_history_item("Off", 0),
+            seek_history_item("5 seconds", 5000),
+            seek_history_item("10 seconds", 10000),
+            seek_history_item("30 seconds", 30000),
+        }));
+        settings_items.push_back(MI::leaf("&ReplayGain", [this]{ toggleReplayGain(); },
+            [this]{ return m_replaygain_enabled; }));
+        settings_items.push_back(MI::leaf("Scan Playlist &Loudness", [this]{ scanPlaylistLoudness(); }));
         settings_items.push_back(MI::sep());
         settings_items.push_back(MI::leaf("2x &Zoom", [this]{ toggleZoom(); },
             [this]{ return screen && screen->getLogicalScale() == 2; }, "G"));
         settings_items.push_back(MI::leaf("Show &Debug", [this]{ toggleShowDebug(); },
             [this]{ return m_show_debug; }));
+        settings_items.push_back(MI::leaf("Dump Audio &Telemetry", [this]{ dumpAudioTelemetry(); }));
         menu_bar->addMenu("&Settings", std::move(settings_items));
 
         // Help: the About dialog (also on F1).
@@ -3505,10 +3612,22 @@ void Player::EventLoop() {
             // SDL3: window events are distinct top-level types (no SDL_WINDOWEVENT
             // wrapper). Route the ones that require a window-surface refresh;
             // handleWindowEvent ignores the rest.
+            case SDL_EVENT_WINDOW_MINIMIZED:
+            case SDL_EVENT_WINDOW_HIDDEN:
+            case SDL_EVENT_WINDOW_OCCLUDED:
+                m_window_obscured = true;
+                break;
+            case SDL_EVENT_WINDOW_RESTORED:
+                m_window_obscured = false;
+                synthesizeUserEvent(RUN_GUI_ITERATION, nullptr, nullptr);
+                break;
             case SDL_EVENT_WINDOW_EXPOSED:
             case SDL_EVENT_WINDOW_RESIZED:
             case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
             case SDL_EVENT_WINDOW_SHOWN:
+                if (event.type == SDL_EVENT_WINDOW_EXPOSED || event.type == SDL_EVENT_WINDOW_SHOWN) {
+                    m_window_obscured = false;
+                }
                 if (handleWindowEvent(event.window)) {
                     synthesizeUserEvent(RUN_GUI_ITERATION, nullptr, nullptr);
                 }
@@ -3770,6 +3889,7 @@ void Player::Cleanup() {
     if (m_playlist_populator_thread.joinable()) {
         m_playlist_populator_thread.join();
     }
+    stopLoudnessScanner();
 
     // Save the session playlist (if the option is on) now that the populator has
     // finished and the playlist is complete, while it's all still alive.
@@ -4257,6 +4377,162 @@ void Player::applyEqStateToAudio()
     audio->setEqEnabled(m_eq_enabled);
 }
 
+void Player::applyCrossfadeToAudio()
+{
+    if (!audio) return;
+    audio->setCrossfade(m_crossfade_ms, m_crossfade_curve);
+}
+
+void Player::applySeekHistoryToAudio()
+{
+    if (!audio) return;
+    audio->setSeekHistory(m_seek_history_ms);
+}
+
+void Player::setSeekHistory(unsigned int ms)
+{
+    m_seek_history_ms = ms;
+    applySeekHistoryToAudio();
+    saveSettings(); // persist the setting itself immediately
+    showToast(ms == 0 ? std::string("Seek History: Off")
+                      : "Seek History: " + std::to_string(ms / 1000) + " s");
+}
+
+unsigned long Player::playbackPositionMs() const
+{
+    // The decoder runs ahead of the device, and a seek served from the PCM
+    // history leaves the stream where it was, so the stream's own position is
+    // only a fallback.
+    if (audio && audio->getRate() > 0) {
+        return static_cast<unsigned long>((audio->getSamplesPlayed() * 1000) / audio->getRate());
+    }
+    return stream ? stream->getPosition() : 0;
+}
+
+void Player::setCrossfade(unsigned int ms, Crossfader::Curve curve)
+{
+    m_crossfade_ms = ms;
+    m_crossfade_curve = curve;
+    applyCrossfadeToAudio();
+    saveSettings(); // persist the setting itself immediately
+    if (ms == 0) {
+        showToast("Crossfade: Off");
+    } else {
+        showToast("Crossfade: " + std::to_string(ms / 1000) + " s, " + Crossfader::curveName(curve));
+    }
+}
+
+void Player::toggleReplayGain()
+{
+    m_replaygain_enabled = !m_replaygain_enabled;
+    if (audio) audio->setReplayGain(m_replaygain_enabled);
+    saveSettings(); // persist the setting itself immediately
+    if (m_replaygain_enabled && m_loudness_cache && m_loudness_cache->size() == 0) {
+        showToast("ReplayGain: On (use Scan Playlist Loudness to measure tracks)");
+    } else {
+        showToast(m_replaygain_enabled ? "ReplayGain: On" : "ReplayGain: Off");
+    }
+}
+
+/**
+ * @brief Looks up a track's playback gain in the loudness cache.
+ *
+ * @return false, leaving `gain` alone, for tracks that were never measured
+ *         (or changed since).
+ */
+bool Player::lookupCachedGain(const TagLib::String& path, float& gain) const
+{
+    if (!m_loudness_cache) return false;
+    auto entry = m_loudness_cache->lookup(path.to8Bit(true));
+    if (!entry) return false;
+    gain = PsyMP3::Core::LoudnessCache::playbackGain(*entry);
+    Debug::log("loudness", "Cached loudness for ", path.to8Bit(true), ": ", entry->integrated_lufs,
+               " LUFS, gain ", gain);
+    return true;
+}
+
+/**
+ * @brief Sets a freshly opened stream's playback gain from the loudness cache.
+ *
+ * Called on the loader thread. Tracks that were never measured (or changed
+ * since) keep unity gain. The gain is recorded whether or not ReplayGain is
+ * on; Audio decides whether to apply it.
+ */
+void Player::applyCachedLoudness(Stream* stream, const TagLib::String& path) const
+{
+    float gain = 1.0f;
+    if (stream && lookupCachedGain(path, gain)) {
+        stream->setPlaybackGain(gain);
+    }
+}
+
+/**
+ * @brief Gives each track of a gapless chain its cached playback gain.
+ *
+ * Same rules as for a single stream; the chain switches gains as it moves
+ * from track to track.
+ */
+void Player::applyCachedLoudness(ChainedStream* stream, const std::vector<TagLib::String>& paths) const
+{
+    if (!stream || !m_loudness_cache) return;
+    std::vector<float> gains(paths.size(), 1.0f);
+    for (size_t i = 0; i < paths.size(); i++) {
+        lookupCachedGain(paths[i], gains[i]);
+    }
+    stream->setTrackGains(std::move(gains));
+}
+
+void Player::scanPlaylistLoudness()
+{
+    if (!playlist || !m_loudness_cache) {
+        showToast("Loudness scan: playlist is empty");
+        return;
+    }
+    std::vector<std::string> paths;
+    for (const auto& info : playlist->snapshot()) {
+        paths.push_back(info.path.to8Bit(true));
+    }
+    if (paths.empty()) {
+        showToast("Loudness scan: playlist is empty");
+        return;
+    }
+    if (!m_loudness_scanner) {
+        m_loudness_scanner = std::make_unique<PsyMP3::Core::LoudnessScanner>(
+            *m_loudness_cache,
+            [](const std::string& path) { return MediaFile::open(TagLib::String(path, TagLib::String::UTF8)); });
+    }
+    const size_t queued = m_loudness_scanner->enqueue(paths);
+    if (queued == 0 && m_loudness_scanner->progress().idle) {
+        showToast("Loudness scan: all tracks already measured");
+        return;
+    }
+    m_loudness_scan_reported = false;
+    showToast("Loudness scan: " + std::to_string(queued) + " tracks on " +
+              std::to_string(m_loudness_scanner->threadCount()) + " threads");
+}
+
+// Announces a finished scan; called every frame from updateState().
+void Player::pollLoudnessScan()
+{
+    if (m_loudness_scan_reported || !m_loudness_scanner) return;
+    const auto progress = m_loudness_scanner->progress();
+    if (!progress.idle) return;
+    m_loudness_scan_reported = true;
+    std::string message = "Loudness scan done: " + std::to_string(progress.done) + " measured";
+    if (progress.failed > 0) {
+        message += ", " + std::to_string(progress.failed) + " failed";
+    }
+    showToast(message);
+}
+
+// Joins the scanner's workers (abandoning tracks in progress) and keeps what
+// they measured.
+void Player::stopLoudnessScanner()
+{
+    m_loudness_scanner.reset();
+    if (m_loudness_cache) m_loudness_cache->save();
+}
+
 namespace {
 std::string settingsFilePath()
 {
@@ -4319,6 +4595,19 @@ void Player::loadSettings()
                 // 0 = Unlimited (self-driving GUI loop, see applyTargetFps).
                 applyTargetFps(std::clamp(static_cast<int>(v), 0, 1000));
             }
+        } else if (key == "crossfade_ms") {
+            if (parseSettingDouble(value, v)) {
+                m_crossfade_ms = static_cast<unsigned int>(std::clamp(v, 0.0, 30000.0));
+            }
+        } else if (key == "seek_history_ms") {
+            if (parseSettingDouble(value, v)) {
+                m_seek_history_ms = static_cast<unsigned int>(std::clamp(v, 0.0, 60000.0));
+            }
+        } else if (key == "replaygain") {
+            m_replaygain_enabled = (value == "1" || value == "true");
+        } else if (key == "crossfade_curve") {
+            m_crossfade_curve = (value == "linear") ? Crossfader::Curve::Linear
+                                                    : Crossfader::Curve::EqualPower;
         } else if (key.rfind("eq_band_", 0) == 0) {
             try {
                 size_t used = 0;
@@ -4357,6 +4646,10 @@ void Player::saveSettings() const
     f << "loop_mode=" << static_cast<int>(getLoopMode()) << "\n";
     f << "persist_playlist=" << (m_persist_playlist ? 1 : 0) << "\n";
     f << "show_debug=" << (m_show_debug ? 1 : 0) << "\n";
+    f << "crossfade_ms=" << m_crossfade_ms << "\n";
+    f << "crossfade_curve=" << (m_crossfade_curve == Crossfader::Curve::Linear ? "linear" : "equal_power") << "\n";
+    f << "replaygain=" << (m_replaygain_enabled ? 1 : 0) << "\n";
+    f << "seek_history_ms=" << m_seek_history_ms << "\n";
     for (size_t i = 0; i < m_eq_gains.size(); ++i)
         f << "eq_band_" << i << "=" << m_eq_gains[i] << "\n";
 }
@@ -4394,12 +4687,14 @@ void Player::applyDebugLabels()
         m_labels.at("scale")->setText("log scale = " + std::to_string(scalefactor));
         m_labels.at("decay")->setText(decay_buf);
         m_labels.at("fft_mode")->setText("FFT Mode: " + fft->getFFTModeName());
-        // The FPS label repopulates on its next one-second measurement tick.
+        // The FPS and audio labels repopulate on the next one-second tick.
     } else {
         m_labels.at("scale")->setText("");
         m_labels.at("decay")->setText("");
         m_labels.at("fft_mode")->setText("");
         m_labels.at("fps")->setText("");
+        m_labels.at("audio_cb")->setText("");
+        m_labels.at("audio_xrun")->setText("");
     }
 }
 
@@ -4488,6 +4783,26 @@ void Player::toggleShowDebug()
     showToast(m_show_debug ? "Show Debug: On" : "Show Debug: Off");
 }
 
+void Player::dumpAudioTelemetry()
+{
+    if (!audio) {
+        showToast("Audio telemetry: nothing playing");
+        return;
+    }
+    System::createStoragePath(); // Ensure the directory exists before writing.
+    const TagLib::String path = System::getStoragePath() + "/audio-telemetry.txt";
+    std::ofstream out(System::pathFromUtf8(path.to8Bit(true)));
+    if (!out) {
+        showToast("Audio telemetry: could not write " + path.to8Bit(true));
+        return;
+    }
+    out << "PsyMP3 " PSYMP3_VERSION " audio telemetry\n";
+    out << "Queue: " << audio->getRate() << " Hz, " << audio->getChannels() << " channels; device "
+        << audio->getDeviceRate() << " Hz, " << audio->getDeviceChannels() << " channels\n";
+    audio->getTelemetrySnapshot().writeReport(out);
+    showToast("Audio telemetry written to audio-telemetry.txt");
+}
+
 void Player::toggleEqualizerWindow()
 {
     if (m_eq_window) {
@@ -4954,7 +5269,7 @@ void Player::handleTrackLoadSuccessEvent(TrackLoadResult* result) {
     m_skip_attempts = 0; // Reset skip counter on a successful load.
     Stream* new_stream = result->stream;
     m_num_tracks_in_current_stream = result->num_chained_tracks;
-    std::vector<int16_t> primed_samples = std::move(result->primed_samples);
+    std::vector<float> primed_samples = std::move(result->primed_samples);
     const bool primed_eof = result->primed_eof;
     delete result; // Free the result struct
 
@@ -4994,9 +5309,12 @@ void Player::handleTrackLoadSuccessEvent(TrackLoadResult* result) {
                                             fft.get(),
                                             mutex.get(),
                                             std::move(primed_samples),
-                                            primed_eof);
+                                            primed_eof,
+                                            m_replaygain_enabled);
             audio->setVolume(m_volume);
             applyEqStateToAudio();
+            applyCrossfadeToAudio();
+            applySeekHistoryToAudio();
         } else {
             Debug::log("audio", "Track load reusing existing Audio device.");
             audio->setStream(std::move(owned_new_stream), std::move(primed_samples), primed_eof);
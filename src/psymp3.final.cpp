@@ -16,6 +16,9 @@
 // ============================================================================
 #include "audio.cpp"
 #include "dsp/Equalizer.cpp"
+#include "dsp/Resampler.cpp"
+#include "dsp/Crossfader.cpp"
+#include "dsp/LoudnessMeter.cpp"
 #include "core/about.cpp"
 #include "core/compression/LZ77.cpp"
 #include "core/fft.cpp"
@@ -30,6 +33,11 @@
 #include "debug.cpp"
 #include "core/exceptions.cpp"
 #include "core/lyrics.cpp"
+#include "core/ReadAheadPolicy.cpp"
+#include "core/AudioTelemetry.cpp"
+#include "core/LoudnessCache.cpp"
+#include "core/LoudnessScanner.cpp"
+#include "core/PcmHistory.cpp"
 #include "main.cpp"
 #include "mediafile.cpp"
 #include "player.cpp"
@@ -44,6 +52,9 @@
 #include "core/utility/Base64.cpp"
 #include "core/utility/UTF8Util.cpp"
 #include "core/utility/XMLUtil.cpp"
+#include "core/utility/CRC.cpp"
+#include "core/utility/SampleConvert.cpp"
+#include "core/utility/PCMConvert.cpp"
 #include "core/utility/utility.cpp"
 
 // ============================================================================
@@ -71,6 +82,7 @@
 // ============================================================================
 #include "demuxer/ChainedStream.cpp"
 #include "demuxer/ChunkDemuxer.cpp"
+#include "demuxer/ChunkPipeline.cpp"
 #include "demuxer/DemuxedStream.cpp"
 #include "demuxer/Demuxer.cpp"
 #include "demuxer/DemuxerExtensibility.cpp"
@@ -103,6 +115,7 @@
 #include "codecs/AudioCodec.cpp"
 #include "codecs/CodecRegistration.cpp"
 #include "codecs/CodecRegistry.cpp"
+#include "codecs/CodecPool.cpp"
 
 // Codec - PCM (always built)
 #include "codecs/pcm/PCMCodecs.cpp"
@@ -174,6 +187,7 @@
 #ifdef HAVE_FLAC
 // FLAC Demuxer (always needed for FLAC container)
 #include "demuxer/flac/FLACDemuxer.cpp"
+#include "demuxer/flac/FLACSeekIndexCache.cpp"
 
 // FLAC Codec support files
 #include "codecs/flac/FLACPerformanceBenchmark.cpp"
@@ -191,6 +205,7 @@
 #include "codecs/flac/ResidualDecoder.cpp"
 #include "codecs/flac/SampleReconstructor.cpp"
 #include "codecs/flac/SubframeDecoder.cpp"
+#include "codecs/flac/PredictorKernels.cpp"
 #endif // HAVE_FLAC
 
 // ============================================================================
@@ -409,6 +409,56 @@ unsigned int Stream::getEncoding()
     return 0;
 }
 
+/**
+ * @brief Reads decoded audio as 32-bit float samples.
+ *
+ * The default implementation reads 16-bit PCM through getData() in small
+ * blocks and scales it to [-1.0, 1.0). Streams whose decoders produce more
+ * than 16 bits of resolution override this to skip the 16-bit stage.
+ * @param count Maximum number of samples (all channels) to read.
+ * @param buf Destination for at least `count` floats.
+ * @return The number of samples written.
+ */
+size_t Stream::getDataFloat(size_t count, float *buf)
+{
+    constexpr size_t kBlockSamples = 1024;
+    int16_t block[kBlockSamples];
+    size_t done = 0;
+    while (done < count) {
+        const size_t want = std::min(kBlockSamples, count - done);
+        const size_t got = getData(want * sizeof(int16_t), block) / sizeof(int16_t);
+        for (size_t i = 0; i < got; ++i) {
+            buf[done + i] = block[i] * (1.0f / 32768.0f);
+        }
+        done += got;
+        if (got < want) {
+            break;
+        }
+    }
+    return done;
+}
+
+/**
+ * @brief Reads decoded float samples into two destination pieces.
+ *
+ * The default implementation calls getDataFloat() for `first` and, only if
+ * that filled it, again for `second`.
+ * @param first First destination piece.
+ * @param first_count Samples `first` can take.
+ * @param second Second destination piece, written after `first` is full.
+ * @param second_count Samples `second` can take (may be 0).
+ * @return The number of samples written across both pieces.
+ */
+size_t Stream::getDataInto(float *first, size_t first_count,
+                           float *second, size_t second_count)
+{
+    size_t done = getDataFloat(first_count, first);
+    if (done == first_count && second_count > 0) {
+        done += getDataFloat(second_count, second);
+    }
+    return done;
+}
+
 /**
  * @brief Checks if the stream supports seeking.
  *
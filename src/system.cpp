@@ -564,6 +564,23 @@ std::filesystem::path System::pathFromUtf8(const std::string& utf8) {
 #endif
 }
 
+bool System::fileStamp(const std::string& utf8_path, uint64_t& size, int64_t& mtime) {
+  std::error_code ec;
+  const std::filesystem::path fs_path = pathFromUtf8(utf8_path);
+  const auto file_size = std::filesystem::file_size(fs_path, ec);
+  if (ec) {
+    return false;
+  }
+  const auto write_time = std::filesystem::last_write_time(fs_path, ec);
+  if (ec) {
+    return false;
+  }
+  size = static_cast<uint64_t>(file_size);
+  mtime = static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      write_time.time_since_epoch()).count());
+  return true;
+}
+
 #ifdef _WIN32
 /**
  * @brief Returns the Win32 `HWND` of the SDL application window (Windows only).
@@ -977,6 +994,38 @@ void System::pinThreadToRole([[maybe_unused]] CpuRole role) {
 #endif // PSYMP3_HAVE_AFFINITY
 }
 
+/**
+ * @brief Returns the CPU time the calling thread has consumed.
+ *
+ * Uses the per-thread CPU clock (`CLOCK_THREAD_CPUTIME_ID`) on POSIX and
+ * `GetThreadTimes()` on Windows, whose resolution is only the scheduler tick;
+ * callers smoothing over many calls still get a usable average there.
+ *
+ * @return Nanoseconds of user plus system time, or 0 if unsupported.
+ */
+uint64_t System::getThreadCpuTimeNs() {
+#if defined(_WIN32)
+  FILETIME creation, exit, kernel, user;
+  if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+    return 0;
+  }
+  ULARGE_INTEGER k, u;
+  k.LowPart = kernel.dwLowDateTime;
+  k.HighPart = kernel.dwHighDateTime;
+  u.LowPart = user.dwLowDateTime;
+  u.HighPart = user.dwHighDateTime;
+  return (k.QuadPart + u.QuadPart) * 100; // 100 ns units
+#elif defined(CLOCK_THREAD_CPUTIME_ID)
+  struct timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+    return 0;
+  }
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+#else
+  return 0;
+#endif
+}
+
 /**
  * @brief Locks the process's virtual address space into RAM.
  *
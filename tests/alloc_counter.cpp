@@ -0,0 +1,67 @@
+/*
+ * alloc_counter.cpp - Heap allocation counting for benchmarks and tools
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#include "alloc_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+thread_local uint64_t t_count = 0;
+thread_local uint64_t t_bytes = 0;
+std::atomic<uint64_t> g_count{0};
+std::atomic<uint64_t> g_bytes{0};
+} // namespace
+
+namespace AllocCounter {
+
+uint64_t threadCount() { return t_count; }
+uint64_t threadBytes() { return t_bytes; }
+uint64_t totalCount() { return g_count.load(std::memory_order_relaxed); }
+uint64_t totalBytes() { return g_bytes.load(std::memory_order_relaxed); }
+
+} // namespace AllocCounter
+
+void* operator new(std::size_t size)
+{
+    ++t_count;
+    t_bytes += size;
+    g_count.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
@@ -0,0 +1,32 @@
+/*
+ * alloc_counter.h - Heap allocation counting for benchmarks and tools
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#include <cstdint>
+
+/**
+ * @brief Counts every operator new in the process
+ *
+ * Linking alloc_counter.cpp into a program replaces the global operator
+ * new/delete with counting versions. Counts are kept per thread as well as
+ * process-wide, so a worker can attribute allocations to the work it did
+ * between two reads of threadCount().
+ */
+namespace AllocCounter {
+
+uint64_t threadCount();
+uint64_t threadBytes();
+uint64_t totalCount();
+uint64_t totalBytes();
+
+} // namespace AllocCounter
+
+#endif // ALLOC_COUNTER_H
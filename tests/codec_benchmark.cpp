@@ -0,0 +1,1155 @@
+/*
+ * codec_benchmark.cpp - Decode-throughput benchmark for every registered codec
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ *
+ * Generates deterministic synthetic inputs in memory for each codec this
+ * build can encode -- PCM (int and float), A-law, µ-law and FLAC always,
+ * Vorbis, Opus and G.722 when their libraries are present -- at several
+ * rates, channel counts and bit depths. Media files given on the command line
+ * (MP3, MP2, AAC, ALAC, ... which have no in-tree encoder) are benchmarked
+ * the same way.
+ *
+ * Each input is demuxed once, up front, into MediaChunks; only
+ * AudioCodec::decode()/flush() are timed, the way DemuxedStream drives them
+ * (or decodeInto() with --into).
+ * Per case it reports:
+ *   - ns/sample: wall time per decoded output sample (all channels counted),
+ *     from the fastest of several passes;
+ *   - realtime factor: seconds of audio decoded per second, on one core;
+ *   - allocations per decode() (or decodeInto()) call;
+ *   - cache misses per sample, where Linux perf counters are available.
+ *
+ * Usage:
+ *   codec_benchmark [options] [media files...]
+ *
+ * Options:
+ *   --seconds N        Length of each synthetic input (default: 10)
+ *   --min-time S       Minimum measuring time per case (default: 1.0)
+ *   --only TEXT        Only run cases whose name contains TEXT
+ *   --int16            Request int16 output (default: float, as playback does)
+ *   --threads N        Decode 64 chunks at a time with decodeBatch() on N
+ *                      threads (0: one per core; default: 1, plain decode())
+ *   --into             Decode with decodeInto() into one reused int16 buffer
+ *   --json FILE        Write the results as JSON
+ *   --baseline FILE    Compare against a previous --json run
+ *   --threshold PCT    Slowdown counted as a regression (default: 10)
+ *   --list             List the cases and exit
+ *   -h, --help         Show this help message
+ *
+ * Exits with status 1 if any case regressed against the baseline.
+ */
+
+#include "psymp3.h"
+#include "alloc_counter.h"
+#include "io/MemoryIOHandler.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <optional>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(HAVE_VORBIS) || defined(HAVE_OPUS)
+#include <ogg/ogg.h>
+#endif
+#ifdef HAVE_VORBIS
+#include <vorbis/vorbisenc.h>
+#endif
+#ifdef HAVE_OPUS
+#include <opus/opus.h>
+#endif
+#ifdef HAVE_G722
+#include <spandsp/telephony.h>
+#include <spandsp/g722.h>
+#endif
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Synthetic signal
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Deterministic music-like test signal
+ *
+ * A few detuned partials with slow amplitude modulation plus a little noise
+ * from a fixed LCG, so predictive codecs see realistic residuals rather than
+ * silence or white noise. Returned as interleaved doubles in [-1, 1).
+ */
+std::vector<double> makeSignal(unsigned int rate, unsigned int channels, double seconds)
+{
+    const size_t frames = static_cast<size_t>(rate * seconds);
+    std::vector<double> out(frames * channels);
+    uint32_t lcg = 0x12345678u;
+    for (size_t i = 0; i < frames; ++i) {
+        const double t = static_cast<double>(i) / rate;
+        for (unsigned int c = 0; c < channels; ++c) {
+            const double f = 110.0 * (c + 1);
+            double v = 0.35 * std::sin(2 * M_PI * f * t)
+                     + 0.20 * std::sin(2 * M_PI * f * 2.01 * t) * (0.5 + 0.5 * std::sin(2 * M_PI * 0.3 * t))
+                     + 0.10 * std::sin(2 * M_PI * (1500.0 + 40.0 * c) * t + std::sin(2 * M_PI * 5.0 * t));
+            lcg = lcg * 1664525u + 1013904223u;
+            v += 0.02 * (static_cast<double>(lcg >> 8) / (1u << 24) - 0.5);
+            out[i * channels + c] = v;
+        }
+    }
+    return out;
+}
+
+int32_t quantize(double v, unsigned int bits)
+{
+    const double scale = static_cast<double>(1u << (bits - 1));
+    const double q = std::floor(v * scale + 0.5);
+    return static_cast<int32_t>(std::clamp(q, -scale, scale - 1));
+}
+
+void putLE(std::vector<uint8_t>& out, uint32_t v, int bytes)
+{
+    for (int i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// WAVE (PCM, float, A-law, µ-law)
+// ---------------------------------------------------------------------------
+
+uint8_t linearToALaw(int16_t pcm)
+{
+    int sign = (pcm >= 0) ? 0x80 : 0x00;
+    int v = (pcm >= 0) ? pcm : -(static_cast<int>(pcm) + 1);
+    v >>= 3;
+    int seg = 0;
+    while (seg < 8 && v > (0x1F << seg)) {
+        ++seg;
+    }
+    uint8_t out;
+    if (seg >= 8) {
+        out = 0x7F;
+    } else {
+        out = static_cast<uint8_t>((seg << 4) | ((seg ? v >> seg : v >> 1) & 0x0F));
+    }
+    return static_cast<uint8_t>((out | sign) ^ 0x55);
+}
+
+uint8_t linearToMuLaw(int16_t pcm)
+{
+    constexpr int kBias = 0x84;
+    int sign = 0;
+    int v = pcm;
+    if (v < 0) {
+        v = -v;
+        sign = 0x80;
+    }
+    v = std::min(v, 32635) + kBias;
+    int exponent = 7;
+    for (int mask = 0x4000; (v & mask) == 0 && exponent > 0; mask >>= 1) {
+        --exponent;
+    }
+    const int mantissa = (v >> (exponent + 3)) & 0x0F;
+    return static_cast<uint8_t>(~(sign | (exponent << 4) | mantissa));
+}
+
+enum class WavSample { Int, Float, ALaw, MuLaw };
+
+std::vector<uint8_t> makeWav(WavSample kind, unsigned int rate, unsigned int channels, unsigned int bits,
+                             double seconds)
+{
+    const auto signal = makeSignal(rate, channels, seconds);
+    std::vector<uint8_t> data;
+    for (double v : signal) {
+        switch (kind) {
+        case WavSample::Int:
+            putLE(data, static_cast<uint32_t>(quantize(v, bits)), bits / 8);
+            break;
+        case WavSample::Float: {
+            const float f = static_cast<float>(v);
+            uint32_t u;
+            std::memcpy(&u, &f, sizeof(u));
+            putLE(data, u, 4);
+            break;
+        }
+        case WavSample::ALaw:
+            data.push_back(linearToALaw(static_cast<int16_t>(quantize(v, 16))));
+            break;
+        case WavSample::MuLaw:
+            data.push_back(linearToMuLaw(static_cast<int16_t>(quantize(v, 16))));
+            break;
+        }
+    }
+    const uint16_t tag = kind == WavSample::Int ? 1 : kind == WavSample::Float ? 3 : kind == WavSample::ALaw ? 6 : 7;
+    const unsigned int block_align = channels * bits / 8;
+    std::vector<uint8_t> out = {'R', 'I', 'F', 'F'};
+    putLE(out, static_cast<uint32_t>(36 + data.size()), 4);
+    out.insert(out.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+    putLE(out, 16, 4);
+    putLE(out, tag, 2);
+    putLE(out, channels, 2);
+    putLE(out, rate, 4);
+    putLE(out, rate * block_align, 4);
+    putLE(out, block_align, 2);
+    putLE(out, bits, 2);
+    out.insert(out.end(), {'d', 'a', 't', 'a'});
+    putLE(out, static_cast<uint32_t>(data.size()), 4);
+    out.insert(out.end(), data.begin(), data.end());
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// FLAC: a small encoder (fixed or LPC subframes, partitioned Rice residual)
+// ---------------------------------------------------------------------------
+
+class BitWriter {
+public:
+    void put(uint64_t value, int bits)
+    {
+        for (int i = bits - 1; i >= 0; --i) {
+            m_acc = static_cast<uint8_t>((m_acc << 1) | ((value >> i) & 1));
+            if (++m_count == 8) {
+                m_bytes.push_back(m_acc);
+                m_acc = 0;
+                m_count = 0;
+            }
+        }
+    }
+    void putSigned(int64_t value, int bits) { put(static_cast<uint64_t>(value) & ((uint64_t{1} << bits) - 1), bits); }
+    void putUnary(uint32_t zeros)
+    {
+        for (; zeros >= 32; zeros -= 32) {
+            put(0, 32);
+        }
+        put(1, static_cast<int>(zeros) + 1);
+    }
+    void align()
+    {
+        if (m_count) {
+            put(0, 8 - m_count);
+        }
+    }
+    std::vector<uint8_t>& bytes() { return m_bytes; }
+
+private:
+    std::vector<uint8_t> m_bytes;
+    uint8_t m_acc = 0;
+    int m_count = 0;
+};
+
+uint8_t crc8(const uint8_t* data, size_t size)
+{
+    uint8_t crc = 0;
+    for (size_t i = 0; i < size; ++i) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; ++b) {
+            crc = static_cast<uint8_t>((crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1);
+        }
+    }
+    return crc;
+}
+
+uint16_t crc16(const uint8_t* data, size_t size)
+{
+    uint16_t crc = 0;
+    for (size_t i = 0; i < size; ++i) {
+        crc ^= static_cast<uint16_t>(data[i] << 8);
+        for (int b = 0; b < 8; ++b) {
+            crc = static_cast<uint16_t>((crc & 0x8000) ? (crc << 1) ^ 0x8005 : crc << 1);
+        }
+    }
+    return crc;
+}
+
+// Quantized LPC coefficients (precision 12) for `x`, by autocorrelation and
+// Levinson-Durbin over a Welch window.
+bool computeLpc(const std::vector<int64_t>& x, int order, std::vector<int32_t>& coefs, int& shift)
+{
+    const size_t n = x.size();
+    std::vector<double> w(n);
+    for (size_t i = 0; i < n; ++i) {
+        const double k = (2.0 * i - (n - 1)) / (n + 1);
+        w[i] = static_cast<double>(x[i]) * (1.0 - k * k);
+    }
+    std::vector<double> ac(order + 1, 0.0);
+    for (int lag = 0; lag <= order; ++lag) {
+        for (size_t i = lag; i < n; ++i) {
+            ac[lag] += w[i] * w[i - lag];
+        }
+    }
+    if (ac[0] <= 0.0) {
+        return false;
+    }
+    std::vector<double> a(order + 1, 0.0), prev(order + 1, 0.0);
+    double err = ac[0] * (1.0 + 1e-9);
+    for (int i = 1; i <= order; ++i) {
+        double acc = ac[i];
+        for (int j = 1; j < i; ++j) {
+            acc -= a[j] * ac[i - j];
+        }
+        const double k = acc / err;
+        prev = a;
+        a[i] = k;
+        for (int j = 1; j < i; ++j) {
+            a[j] = prev[j] - k * prev[i - j];
+        }
+        err *= 1.0 - k * k;
+        if (err <= 0.0) {
+            return false;
+        }
+    }
+    constexpr int kPrecision = 12;
+    double cmax = 0.0;
+    for (int i = 1; i <= order; ++i) {
+        cmax = std::max(cmax, std::fabs(a[i]));
+    }
+    int log2max = 0;
+    std::frexp(cmax, &log2max);
+    shift = std::clamp(kPrecision - 1 - log2max, 0, 15);
+    const int32_t limit = 1 << (kPrecision - 1);
+    coefs.assign(order, 0);
+    double carry = 0.0;
+    for (int i = 0; i < order; ++i) {
+        carry += a[i + 1] * (1 << shift);
+        const int32_t q = std::clamp(static_cast<int32_t>(std::lround(carry)), -limit, limit - 1);
+        carry -= q;
+        coefs[i] = q;
+    }
+    return true;
+}
+
+void writeResidual(BitWriter& bw, const std::vector<int64_t>& residual, size_t block, int order)
+{
+    int partition_order = 4;
+    while (partition_order > 0 && ((block % (size_t{1} << partition_order)) != 0
+                                   || (block >> partition_order) <= static_cast<size_t>(order))) {
+        --partition_order;
+    }
+    bw.put(0, 2); // 4-bit Rice parameters
+    bw.put(partition_order, 4);
+    size_t pos = 0;
+    for (size_t p = 0; p < (size_t{1} << partition_order); ++p) {
+        const size_t count = (block >> partition_order) - (p == 0 ? order : 0);
+        uint64_t sum = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const int64_t r = residual[pos + i];
+            sum += static_cast<uint64_t>(r >= 0 ? 2 * r : -2 * r - 1);
+        }
+        int k = 0;
+        while (k < 14 && (uint64_t{count} << (k + 1)) < sum) {
+            ++k;
+        }
+        bw.put(k, 4);
+        for (size_t i = 0; i < count; ++i) {
+            const int64_t r = residual[pos + i];
+            const uint64_t u = static_cast<uint64_t>(r >= 0 ? 2 * r : -2 * r - 1);
+            bw.putUnary(static_cast<uint32_t>(u >> k));
+            bw.put(u & ((uint64_t{1} << k) - 1), k);
+        }
+        pos += count;
+    }
+}
+
+void writeSubframe(BitWriter& bw, const std::vector<int64_t>& x, int bits, int lpc_order)
+{
+    std::vector<int32_t> coefs;
+    int shift = 0;
+    const bool lpc = lpc_order > 0 && computeLpc(x, lpc_order, coefs, shift);
+    const int order = lpc ? lpc_order : 2;
+    std::vector<int64_t> residual;
+    residual.reserve(x.size());
+    for (size_t i = order; i < x.size(); ++i) {
+        int64_t prediction;
+        if (lpc) {
+            int64_t sum = 0;
+            for (int j = 0; j < order; ++j) {
+                sum += static_cast<int64_t>(coefs[j]) * x[i - 1 - j];
+            }
+            prediction = sum >> shift;
+        } else {
+            prediction = 2 * x[i - 1] - x[i - 2];
+        }
+        residual.push_back(x[i] - prediction);
+    }
+    bw.put(0, 1);
+    bw.put(lpc ? 0x20 | (order - 1) : 0x08 | order, 6);
+    bw.put(0, 1); // no wasted bits
+    for (int i = 0; i < order; ++i) {
+        bw.putSigned(x[i], bits);
+    }
+    if (lpc) {
+        bw.put(12 - 1, 4);
+        bw.putSigned(shift, 5);
+        for (int32_t c : coefs) {
+            bw.putSigned(c, 12);
+        }
+    }
+    writeResidual(bw, residual, x.size(), order);
+}
+
+std::vector<uint8_t> makeFlac(unsigned int rate, unsigned int channels, unsigned int bits, int lpc_order,
+                              bool left_side, double seconds)
+{
+    constexpr size_t kBlock = 4096;
+    const auto signal = makeSignal(rate, channels, seconds);
+    const size_t frames = signal.size() / channels;
+
+    BitWriter bw;
+    bw.put(0x664C6143, 32); // "fLaC"
+    bw.put(0x80, 8);        // last metadata block, STREAMINFO
+    bw.put(34, 24);
+    bw.put(kBlock, 16);
+    bw.put(kBlock, 16);
+    bw.put(0, 24); // frame sizes unknown
+    bw.put(0, 24);
+    bw.put(rate, 20);
+    bw.put(channels - 1, 3);
+    bw.put(bits - 1, 5);
+    bw.put(frames, 36);
+    bw.put(0, 64); // MD5 unknown
+    bw.put(0, 64);
+
+    const bool side = left_side && channels == 2;
+    uint32_t frame_number = 0;
+    for (size_t pos = 0; pos < frames; pos += kBlock, ++frame_number) {
+        const size_t block = std::min(kBlock, frames - pos);
+        const size_t frame_start = bw.bytes().size();
+        bw.put(0xFFF8, 16);
+        bw.put(block == kBlock ? 12 : 7, 4);
+        bw.put(0, 4); // sample rate from STREAMINFO
+        bw.put(side ? 8 : channels - 1, 4);
+        bw.put(0, 3); // sample size from STREAMINFO
+        bw.put(0, 1);
+        // UTF-8 coded frame number
+        if (frame_number < 0x80) {
+            bw.put(frame_number, 8);
+        } else if (frame_number < 0x800) {
+            bw.put(0xC0 | (frame_number >> 6), 8);
+            bw.put(0x80 | (frame_number & 0x3F), 8);
+        } else {
+            bw.put(0xE0 | (frame_number >> 12), 8);
+            bw.put(0x80 | ((frame_number >> 6) & 0x3F), 8);
+            bw.put(0x80 | (frame_number & 0x3F), 8);
+        }
+        if (block != kBlock) {
+            bw.put(block - 1, 16);
+        }
+        auto& bytes = bw.bytes();
+        bw.put(crc8(bytes.data() + frame_start, bytes.size() - frame_start), 8);
+
+        std::vector<std::vector<int64_t>> ch(channels, std::vector<int64_t>(block));
+        for (size_t i = 0; i < block; ++i) {
+            for (unsigned int c = 0; c < channels; ++c) {
+                ch[c][i] = quantize(signal[(pos + i) * channels + c], bits);
+            }
+        }
+        if (side) {
+            for (size_t i = 0; i < block; ++i) {
+                ch[1][i] = ch[0][i] - ch[1][i];
+            }
+        }
+        for (unsigned int c = 0; c < channels; ++c) {
+            writeSubframe(bw, ch[c], static_cast<int>(bits) + (side && c == 1 ? 1 : 0), lpc_order);
+        }
+        bw.align();
+        auto& frame_bytes = bw.bytes();
+        bw.put(crc16(frame_bytes.data() + frame_start, frame_bytes.size() - frame_start), 16);
+    }
+    return std::move(bw.bytes());
+}
+
+// ---------------------------------------------------------------------------
+// Ogg Vorbis / Ogg Opus via the reference encoders
+// ---------------------------------------------------------------------------
+
+#if defined(HAVE_VORBIS) || defined(HAVE_OPUS)
+void appendPages(ogg_stream_state& os, std::vector<uint8_t>& out, bool flush)
+{
+    ogg_page page;
+    while (flush ? ogg_stream_flush(&os, &page) : ogg_stream_pageout(&os, &page)) {
+        out.insert(out.end(), page.header, page.header + page.header_len);
+        out.insert(out.end(), page.body, page.body + page.body_len);
+    }
+}
+#endif
+
+#ifdef HAVE_VORBIS
+std::vector<uint8_t> makeVorbis(unsigned int rate, unsigned int channels, float quality, double seconds)
+{
+    const auto signal = makeSignal(rate, channels, seconds);
+    const size_t frames = signal.size() / channels;
+    std::vector<uint8_t> out;
+
+    vorbis_info vi;
+    vorbis_info_init(&vi);
+    if (vorbis_encode_init_vbr(&vi, channels, rate, quality) != 0) {
+        vorbis_info_clear(&vi);
+        return out;
+    }
+    vorbis_comment vc;
+    vorbis_comment_init(&vc);
+    vorbis_dsp_state vd;
+    vorbis_block vb;
+    vorbis_analysis_init(&vd, &vi);
+    vorbis_block_init(&vd, &vb);
+    ogg_stream_state os;
+    ogg_stream_init(&os, 1);
+
+    ogg_packet header, comments, codebooks;
+    vorbis_analysis_headerout(&vd, &vc, &header, &comments, &codebooks);
+    ogg_stream_packetin(&os, &header);
+    ogg_stream_packetin(&os, &comments);
+    ogg_stream_packetin(&os, &codebooks);
+    appendPages(os, out, true);
+
+    constexpr size_t kChunk = 1024;
+    for (size_t pos = 0; pos <= frames; pos += kChunk) {
+        const size_t n = pos < frames ? std::min(kChunk, frames - pos) : 0;
+        if (n > 0) {
+            float** buffer = vorbis_analysis_buffer(&vd, static_cast<int>(n));
+            for (size_t i = 0; i < n; ++i) {
+                for (unsigned int c = 0; c < channels; ++c) {
+                    buffer[c][i] = static_cast<float>(signal[(pos + i) * channels + c]);
+                }
+            }
+        }
+        vorbis_analysis_wrote(&vd, static_cast<int>(n));
+        while (vorbis_analysis_blockout(&vd, &vb) == 1) {
+            vorbis_analysis(&vb, nullptr);
+            vorbis_bitrate_addblock(&vb);
+            ogg_packet packet;
+            while (vorbis_bitrate_flushpacket(&vd, &packet)) {
+                ogg_stream_packetin(&os, &packet);
+                appendPages(os, out, false);
+            }
+        }
+    }
+    appendPages(os, out, true);
+
+    ogg_stream_clear(&os);
+    vorbis_block_clear(&vb);
+    vorbis_dsp_clear(&vd);
+    vorbis_comment_clear(&vc);
+    vorbis_info_clear(&vi);
+    return out;
+}
+#endif
+
+#ifdef HAVE_OPUS
+std::vector<uint8_t> makeOpus(unsigned int channels, int bitrate, double seconds)
+{
+    constexpr unsigned int kRate = 48000;
+    constexpr int kFrame = 960; // 20 ms
+    const auto signal = makeSignal(kRate, channels, seconds);
+    const size_t frames = signal.size() / channels;
+    std::vector<uint8_t> out;
+
+    int error = 0;
+    OpusEncoder* enc = opus_encoder_create(kRate, static_cast<int>(channels), OPUS_APPLICATION_AUDIO, &error);
+    if (!enc || error != OPUS_OK) {
+        return out;
+    }
+    opus_encoder_ctl(enc, OPUS_SET_BITRATE(bitrate));
+    opus_int32 lookahead = 0;
+    opus_encoder_ctl(enc, OPUS_GET_LOOKAHEAD(&lookahead));
+
+    ogg_stream_state os;
+    ogg_stream_init(&os, 1);
+    std::vector<uint8_t> head = {'O', 'p', 'u', 's', 'H', 'e', 'a', 'd', 1, static_cast<uint8_t>(channels)};
+    putLE(head, static_cast<uint32_t>(lookahead), 2);
+    putLE(head, kRate, 4);
+    putLE(head, 0, 2); // output gain
+    head.push_back(0); // mapping family 0
+    std::vector<uint8_t> tags = {'O', 'p', 'u', 's', 'T', 'a', 'g', 's'};
+    putLE(tags, 5, 4);
+    tags.insert(tags.end(), {'p', 's', 'y', 'm', 'p'});
+    putLE(tags, 0, 4);
+
+    ogg_packet packet{};
+    packet.packet = head.data();
+    packet.bytes = static_cast<long>(head.size());
+    packet.b_o_s = 1;
+    ogg_stream_packetin(&os, &packet);
+    appendPages(os, out, true);
+    packet = ogg_packet{};
+    packet.packet = tags.data();
+    packet.bytes = static_cast<long>(tags.size());
+    packet.packetno = 1;
+    ogg_stream_packetin(&os, &packet);
+    appendPages(os, out, true);
+
+    std::vector<opus_int16> pcm(kFrame * channels);
+    std::vector<unsigned char> encoded(4000);
+    ogg_int64_t granule = lookahead;
+    ogg_int64_t packetno = 2;
+    for (size_t pos = 0; pos < frames; pos += kFrame) {
+        std::fill(pcm.begin(), pcm.end(), 0);
+        const size_t n = std::min<size_t>(kFrame, frames - pos);
+        for (size_t i = 0; i < n * channels; ++i) {
+            pcm[i] = static_cast<opus_int16>(quantize(signal[pos * channels + i], 16));
+        }
+        const opus_int32 bytes = opus_encode(enc, pcm.data(), kFrame, encoded.data(),
+                                             static_cast<opus_int32>(encoded.size()));
+        if (bytes < 0) {
+            break;
+        }
+        granule += kFrame;
+        packet = ogg_packet{};
+        packet.packet = encoded.data();
+        packet.bytes = bytes;
+        packet.granulepos = granule;
+        packet.packetno = packetno++;
+        packet.e_o_s = pos + kFrame >= frames;
+        ogg_stream_packetin(&os, &packet);
+        appendPages(os, out, false);
+    }
+    appendPages(os, out, true);
+    ogg_stream_clear(&os);
+    opus_encoder_destroy(enc);
+    return out;
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// Cases
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief One benchmark input: a codec's StreamInfo and its demuxed chunks
+ */
+struct Case {
+    std::string name;
+    StreamInfo info;
+    std::vector<MediaChunk> chunks;
+    std::string error; // set when the input could not be produced or demuxed
+};
+
+/**
+ * @brief Demuxes a whole container into chunks of its first audio stream
+ */
+void demuxInto(Case& c, std::unique_ptr<IOHandler> handler, const std::string& path_hint)
+{
+    std::unique_ptr<Demuxer> demuxer;
+    try {
+        demuxer = DemuxerFactory::createDemuxer(std::move(handler), path_hint);
+    } catch (const std::exception& e) {
+        c.error = e.what();
+        return;
+    }
+    if (!demuxer || !demuxer->parseContainer()) {
+        c.error = "no demuxer accepted the input";
+        return;
+    }
+    for (const auto& stream : demuxer->getStreams()) {
+        if (stream.codec_type == "audio") {
+            c.info = demuxer->getStreamInfo(stream.stream_id);
+            break;
+        }
+    }
+    if (c.info.stream_id == 0) {
+        c.error = "no audio stream";
+        return;
+    }
+    size_t empty_reads = 0;
+    while (empty_reads < 32) {
+        MediaChunk chunk = demuxer->readChunk(c.info.stream_id);
+        if (chunk.isValid()) {
+            c.chunks.push_back(std::move(chunk));
+            empty_reads = 0;
+        } else if (demuxer->isEOF()) {
+            break;
+        } else {
+            ++empty_reads;
+        }
+    }
+    if (c.chunks.empty()) {
+        c.error = "demuxer produced no chunks";
+    }
+}
+
+Case memoryCase(const std::string& name, const std::vector<uint8_t>& bytes, const std::string& path_hint)
+{
+    Case c;
+    c.name = name;
+    if (bytes.empty()) {
+        c.error = "encoder failed";
+        return c;
+    }
+    demuxInto(c, std::make_unique<PsyMP3::IO::MemoryIOHandler>(bytes.data(), bytes.size(), true), path_hint);
+    return c;
+}
+
+Case fileCase(const std::string& path)
+{
+    Case c;
+    c.name = path.substr(path.find_last_of("/\\") + 1);
+    try {
+        demuxInto(c, std::make_unique<FileIOHandler>(TagLib::String(path.c_str(), TagLib::String::UTF8)), path);
+    } catch (const std::exception& e) {
+        c.error = e.what();
+    }
+    return c;
+}
+
+#ifdef HAVE_G722
+Case g722Case(double seconds)
+{
+    Case c;
+    c.name = "g722-64k-16k-1ch";
+    c.info = StreamInfo(1, "audio", "g722");
+    c.info.sample_rate = 16000;
+    c.info.channels = 1;
+    c.info.bits_per_sample = 16;
+    const auto signal = makeSignal(16000, 1, seconds);
+    std::vector<int16_t> pcm(signal.size());
+    for (size_t i = 0; i < pcm.size(); ++i) {
+        pcm[i] = static_cast<int16_t>(quantize(signal[i], 16));
+    }
+    g722_encode_state_t* enc = g722_encode_init(nullptr, 64000, 0);
+    constexpr size_t kChunkSamples = 640; // 40 ms
+    for (size_t pos = 0; pos < pcm.size(); pos += kChunkSamples) {
+        const size_t n = std::min(kChunkSamples, pcm.size() - pos);
+        std::vector<uint8_t> bytes(n);
+        const int len = g722_encode(enc, bytes.data(), pcm.data() + pos, static_cast<int>(n));
+        bytes.resize(static_cast<size_t>(std::max(len, 0)));
+        c.chunks.emplace_back(1, std::move(bytes));
+    }
+    g722_encode_free(enc);
+    return c;
+}
+#endif
+
+std::vector<Case> syntheticCases(double seconds, const std::string& only)
+{
+    std::vector<Case> cases;
+    const auto add = [&](const std::string& name, const std::function<Case()>& make) {
+        if (only.empty() || name.find(only) != std::string::npos) {
+            cases.push_back(make());
+            cases.back().name = name;
+        }
+    };
+    add("pcm-s16-44k-2ch", [&] { return memoryCase("", makeWav(WavSample::Int, 44100, 2, 16, seconds), "in.wav"); });
+    add("pcm-s24-96k-2ch", [&] { return memoryCase("", makeWav(WavSample::Int, 96000, 2, 24, seconds), "in.wav"); });
+    add("pcm-f32-48k-6ch", [&] { return memoryCase("", makeWav(WavSample::Float, 48000, 6, 32, seconds), "in.wav"); });
+    add("alaw-8k-1ch", [&] { return memoryCase("", makeWav(WavSample::ALaw, 8000, 1, 8, seconds), "in.wav"); });
+    add("mulaw-8k-1ch", [&] { return memoryCase("", makeWav(WavSample::MuLaw, 8000, 1, 8, seconds), "in.wav"); });
+    add("flac-16-44k-2ch-fixed", [&] { return memoryCase("", makeFlac(44100, 2, 16, 0, false, seconds), "in.flac"); });
+    add("flac-16-44k-2ch-lpc8", [&] { return memoryCase("", makeFlac(44100, 2, 16, 8, true, seconds), "in.flac"); });
+    add("flac-24-96k-2ch-lpc12", [&] { return memoryCase("", makeFlac(96000, 2, 24, 12, true, seconds), "in.flac"); });
+    add("flac-16-48k-6ch-lpc8", [&] { return memoryCase("", makeFlac(48000, 6, 16, 8, false, seconds), "in.flac"); });
+    add("flac-24-48k-1ch-lpc32", [&] { return memoryCase("", makeFlac(48000, 1, 24, 32, false, seconds), "in.flac"); });
+#ifdef HAVE_VORBIS
+    add("vorbis-q4-44k-2ch", [&] { return memoryCase("", makeVorbis(44100, 2, 0.4f, seconds), "in.ogg"); });
+    add("vorbis-q4-48k-6ch", [&] { return memoryCase("", makeVorbis(48000, 6, 0.4f, seconds), "in.ogg"); });
+#endif
+#ifdef HAVE_OPUS
+    add("opus-128k-48k-2ch", [&] { return memoryCase("", makeOpus(2, 128000, seconds), "in.opus"); });
+    add("opus-32k-48k-1ch", [&] { return memoryCase("", makeOpus(1, 32000, seconds), "in.opus"); });
+#endif
+#ifdef HAVE_G722
+    add("g722-64k-16k-1ch", [&] { return g722Case(seconds); });
+#endif
+    return cases;
+}
+
+// ---------------------------------------------------------------------------
+// Measurement
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Hardware cache-miss counter for the calling thread, if the kernel
+ *        and permissions allow it
+ */
+class CacheMissCounter {
+public:
+    CacheMissCounter()
+    {
+#ifdef __linux__
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        m_fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+    ~CacheMissCounter()
+    {
+#ifdef __linux__
+        if (m_fd >= 0) {
+            close(m_fd);
+        }
+#endif
+    }
+    bool available() const { return m_fd >= 0; }
+    void start()
+    {
+#ifdef __linux__
+        if (m_fd >= 0) {
+            ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+    uint64_t stop()
+    {
+        uint64_t value = 0;
+#ifdef __linux__
+        if (m_fd >= 0) {
+            ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(m_fd, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) {
+                value = 0;
+            }
+        }
+#endif
+        return value;
+    }
+
+private:
+    int m_fd = -1;
+};
+
+/**
+ * @brief Result of benchmarking one case
+ */
+struct Result {
+    std::string name;
+    std::string codec;
+    uint32_t sample_rate = 0;
+    uint16_t channels = 0;
+    uint16_t bits = 0;
+    bool ok = false;
+    std::string error;
+    uint64_t samples = 0;          // interleaved samples per pass
+    double ns_per_sample = 0.0;
+    double realtime_factor = 0.0;
+    double allocs_per_frame = 0.0;
+    std::optional<double> misses_per_sample;
+};
+
+// Chunks per AudioCodec::decodeBatch() call with --threads
+constexpr size_t kBatchChunks = 64;
+
+// decodeInto() buffer for codecs without a frame size bound
+constexpr size_t kIntoBufferSamples = 1 << 16;
+
+Result measure(const Case& c, double min_time, bool float_output, unsigned threads, bool into,
+               CacheMissCounter& misses)
+{
+    Result r;
+    r.name = c.name;
+    r.codec = c.info.codec_name;
+    r.sample_rate = c.info.sample_rate;
+    r.channels = c.info.channels;
+    r.bits = c.info.bits_per_sample;
+    if (!c.error.empty()) {
+        r.error = c.error;
+        return r;
+    }
+
+    std::vector<std::vector<MediaChunk>> batches;
+    if (threads != 1) {
+        for (size_t first = 0; first < c.chunks.size(); first += kBatchChunks) {
+            const size_t last = std::min(first + kBatchChunks, c.chunks.size());
+            batches.emplace_back(c.chunks.begin() + first, c.chunks.begin() + last);
+        }
+    }
+
+    double best_seconds = 0.0;
+    double total_seconds = 0.0;
+    for (int pass = 0; pass < 3 || total_seconds < min_time; ++pass) {
+        std::unique_ptr<AudioCodec> codec;
+        try {
+            codec = AudioCodecFactory::createCodec(c.info);
+        } catch (const std::exception& e) {
+            r.error = e.what();
+            return r;
+        }
+        if (!codec || !codec->initialize()) {
+            r.error = "no codec for \"" + c.info.codec_name + "\"";
+            return r;
+        }
+        r.codec = codec->getCodecName();
+        codec->setFloatOutput(float_output);
+        std::vector<int16_t> into_buffer;
+        if (into) {
+            into_buffer.resize(std::max(codec->getMaxFrameSamples(), kIntoBufferSamples));
+        }
+
+        uint64_t samples = 0;
+        uint64_t calls = 0;
+        const uint64_t allocs_before = AllocCounter::threadCount();
+        misses.start();
+        const auto start = std::chrono::steady_clock::now();
+        if (into) {
+            for (const auto& chunk : c.chunks) {
+                samples += codec->decodeInto(chunk, into_buffer.data(), into_buffer.size()).samples;
+                ++calls;
+            }
+        } else if (batches.empty()) {
+            for (const auto& chunk : c.chunks) {
+                samples += codec->decode(chunk).getSampleCount();
+                ++calls;
+            }
+        } else {
+            for (const auto& batch : batches) {
+                for (const auto& frame : codec->decodeBatch(batch, threads)) {
+                    samples += frame.getSampleCount();
+                }
+                calls += batch.size();
+            }
+        }
+        samples += codec->flush().getSampleCount();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const uint64_t miss_count = misses.stop();
+        const uint64_t allocs = AllocCounter::threadCount() - allocs_before;
+
+        if (samples == 0) {
+            r.error = "decoded no audio";
+            return r;
+        }
+        total_seconds += seconds;
+        if (pass == 0 || seconds < best_seconds) {
+            best_seconds = seconds;
+            r.samples = samples;
+            r.allocs_per_frame = static_cast<double>(allocs) / static_cast<double>(calls);
+            if (misses.available()) {
+                r.misses_per_sample = static_cast<double>(miss_count) / static_cast<double>(samples);
+            }
+        }
+    }
+    const double audio_seconds = static_cast<double>(r.samples) / std::max<uint16_t>(r.channels, 1)
+                               / std::max<uint32_t>(r.sample_rate, 1);
+    r.ns_per_sample = best_seconds * 1e9 / static_cast<double>(r.samples);
+    r.realtime_factor = audio_seconds / best_seconds;
+    r.ok = true;
+    return r;
+}
+
+// ---------------------------------------------------------------------------
+// Reporting
+// ---------------------------------------------------------------------------
+
+std::string jsonEscape(const std::string& s)
+{
+    std::string out;
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') {
+            out += '\\';
+        }
+        if (static_cast<unsigned char>(ch) >= 0x20) {
+            out += ch;
+        }
+    }
+    return out;
+}
+
+// One case per line, so that readBaseline() can stay a line scanner.
+void writeJson(std::ostream& out, const std::vector<Result>& results)
+{
+    out << "{\n  \"version\": 1,\n  \"cases\": [\n";
+    bool first = true;
+    for (const auto& r : results) {
+        if (!r.ok) {
+            continue;
+        }
+        out << (first ? "" : ",\n") << std::setprecision(6)
+            << "    {\"name\": \"" << jsonEscape(r.name) << "\", \"codec\": \"" << jsonEscape(r.codec) << "\""
+            << ", \"sample_rate\": " << r.sample_rate << ", \"channels\": " << r.channels
+            << ", \"bits\": " << r.bits << ", \"samples\": " << r.samples
+            << ", \"ns_per_sample\": " << r.ns_per_sample << ", \"realtime_factor\": " << r.realtime_factor
+            << ", \"allocs_per_frame\": " << r.allocs_per_frame << ", \"cache_misses_per_sample\": ";
+        if (r.misses_per_sample) {
+            out << *r.misses_per_sample;
+        } else {
+            out << "null";
+        }
+        out << "}";
+        first = false;
+    }
+    out << "\n  ]\n}\n";
+}
+
+// Case name -> ns/sample from a file written by writeJson().
+std::map<std::string, double> readBaseline(const std::string& path)
+{
+    std::map<std::string, double> baseline;
+    std::ifstream in(path);
+    std::string line;
+    const std::string name_key = "\"name\": \"";
+    const std::string ns_key = "\"ns_per_sample\": ";
+    while (std::getline(in, line)) {
+        const size_t name_pos = line.find(name_key);
+        const size_t ns_pos = line.find(ns_key);
+        if (name_pos == std::string::npos || ns_pos == std::string::npos) {
+            continue;
+        }
+        const size_t begin = name_pos + name_key.size();
+        const size_t end = line.find('"', begin);
+        try {
+            baseline[line.substr(begin, end - begin)] = std::stod(line.substr(ns_pos + ns_key.size()));
+        } catch (const std::exception&) {
+        }
+    }
+    return baseline;
+}
+
+void printUsage(const char* program_name)
+{
+    std::cerr << "Usage: " << program_name << " [options] [media files...]\n"
+              << "\n"
+              << "Benchmark AudioCodec decode throughput on synthetic inputs for every\n"
+              << "codec this build can encode, plus any media files given.\n"
+              << "\n"
+              << "Options:\n"
+              << "  --seconds N        Length of each synthetic input (default: 10)\n"
+              << "  --min-time S       Minimum measuring time per case (default: 1.0)\n"
+              << "  --only TEXT        Only run cases whose name contains TEXT\n"
+              << "  --int16            Request int16 output (default: float, as playback does)\n"
+              << "  --threads N        Decode " << kBatchChunks << " chunks at a time with decodeBatch() on N\n"
+              << "                     threads (0: one per core; default: 1, plain decode())\n"
+              << "  --into             Decode with decodeInto() into one reused int16 buffer\n"
+              << "  --json FILE        Write the results as JSON\n"
+              << "  --baseline FILE    Compare against a previous --json run\n"
+              << "  --threshold PCT    Slowdown counted as a regression (default: 10)\n"
+              << "  --list             List the cases and exit\n"
+              << "  -h, --help         Show this help message\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    double seconds = 10.0;
+    double min_time = 1.0;
+    double threshold = 10.0;
+    bool float_output = true;
+    bool list_only = false;
+    unsigned threads = 1;
+    bool into = false;
+    std::string only, json_path, baseline_path;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        try {
+            if (arg == "-h" || arg == "--help") {
+                printUsage(argv[0]);
+                return 0;
+            } else if (arg == "--seconds" && has_value) {
+                seconds = std::max(0.1, std::stod(argv[++i]));
+            } else if (arg == "--min-time" && has_value) {
+                min_time = std::stod(argv[++i]);
+            } else if (arg == "--only" && has_value) {
+                only = argv[++i];
+            } else if (arg == "--int16") {
+                float_output = false;
+            } else if (arg == "--threads" && has_value) {
+                threads = static_cast<unsigned>(std::stoul(argv[++i]));
+            } else if (arg == "--into") {
+                into = true;
+            } else if (arg == "--json" && has_value) {
+                json_path = argv[++i];
+            } else if (arg == "--baseline" && has_value) {
+                baseline_path = argv[++i];
+            } else if (arg == "--threshold" && has_value) {
+                threshold = std::stod(argv[++i]);
+            } else if (arg == "--list") {
+                list_only = true;
+            } else if (arg[0] == '-') {
+                std::cerr << "Unknown option or missing value: " << arg << "\n";
+                printUsage(argv[0]);
+                return 2;
+            } else {
+                files.push_back(arg);
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Invalid value for " << arg << "\n";
+            return 2;
+        }
+    }
+
+    registerAllCodecs();
+    registerAllDemuxers();
+
+    std::vector<Case> cases = syntheticCases(seconds, only);
+    for (const auto& path : files) {
+        cases.push_back(fileCase(path));
+    }
+    if (list_only) {
+        for (const auto& c : cases) {
+            std::cout << c.name << "  " << (c.error.empty() ? c.info.codec_name : "(" + c.error + ")") << "\n";
+        }
+        return 0;
+    }
+
+    CacheMissCounter misses;
+    const auto baseline = baseline_path.empty() ? std::map<std::string, double>{} : readBaseline(baseline_path);
+    if (!baseline_path.empty() && baseline.empty()) {
+        std::cerr << "Warning: no cases read from baseline " << baseline_path << "\n";
+    }
+
+    std::cout << std::left << std::setw(26) << "case" << std::setw(10) << "codec" << std::right
+              << std::setw(12) << "ns/sample" << std::setw(12) << "realtime" << std::setw(13) << "allocs/frame"
+              << std::setw(13) << "misses/smp" << (baseline.empty() ? "" : "   vs baseline") << "\n";
+
+    std::vector<Result> results;
+    int regressions = 0;
+    for (const auto& c : cases) {
+        Result r = measure(c, min_time, float_output, threads, into, misses);
+        std::cout << std::left << std::setw(26) << r.name << std::setw(10) << r.codec << std::right;
+        if (!r.ok) {
+            std::cout << "  skipped: " << r.error << "\n";
+            results.push_back(std::move(r));
+            continue;
+        }
+        std::cout << std::fixed << std::setprecision(2) << std::setw(12) << r.ns_per_sample
+                  << std::setprecision(0) << std::setw(11) << r.realtime_factor << "x"
+                  << std::setprecision(2) << std::setw(13) << r.allocs_per_frame << std::setw(13);
+        if (r.misses_per_sample) {
+            std::cout << std::setprecision(3) << *r.misses_per_sample;
+        } else {
+            std::cout << "n/a";
+        }
+        const auto it = baseline.find(r.name);
+        if (it != baseline.end() && it->second > 0.0) {
+            const double change = (r.ns_per_sample / it->second - 1.0) * 100.0;
+            std::cout << std::showpos << std::setprecision(1) << std::setw(11) << change << "%" << std::noshowpos;
+            if (change > threshold) {
+                std::cout << "  REGRESSION";
+                ++regressions;
+            }
+        }
+        std::cout << std::endl;
+        results.push_back(std::move(r));
+    }
+
+    if (!json_path.empty()) {
+        std::ofstream out(json_path);
+        writeJson(out, results);
+        if (!out) {
+            std::cerr << "Error: could not write " << json_path << "\n";
+            return 2;
+        }
+    }
+    if (regressions > 0) {
+        std::cout << "\n" << regressions << " case" << (regressions == 1 ? "" : "s") << " slower than the baseline by more than "
+                  << threshold << "%\n";
+        return 1;
+    }
+    return 0;
+}
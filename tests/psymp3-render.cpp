@@ -0,0 +1,467 @@
+/*
+ * psymp3-render.cpp - Headless faster-than-realtime renderer and benchmark
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ *
+ * This utility runs any file the player can open through the same path
+ * playback uses -- MediaFile::open() and Stream::getDataFloat(), then
+ * optionally the resampler and the volume/equalizer stage -- without an
+ * audio device, as fast as the CPU allows. Output is written as WAVE or raw
+ * PCM, or discarded for pure throughput measurement.
+ *
+ * Usage:
+ *   psymp3-render [options] input...
+ *
+ * Options:
+ *   -o, --output DIR    Write <DIR>/<input name>.wav (default: discard)
+ *   -r, --raw           Write raw PCM (.pcm) instead of WAVE
+ *   -f, --float         Write 32-bit float instead of 16-bit PCM
+ *   -j, --jobs N        Render N files in parallel (default: one per core)
+ *   -t, --threads N     Decode each file on N threads where the codec can
+ *                       (FLAC; default: 1, 0: one per core)
+ *   -R, --rate HZ       Resample to HZ, as Audio does for a mismatched track
+ *   -V, --volume X      Apply volume X (0.0 - 1.0)
+ *   -e, --eq G1,...,G7  Run the equalizer with these band gains in dB
+ *   -d, --debug         Log all debug channels to psymp3-render_debug.log
+ *   -q, --quiet         Only print the summary
+ *   -h, --help          Show this help message
+ *
+ * Per file it reports the realtime factor (audio duration / wall time) and
+ * the heap allocations made while rendering it; the summary adds aggregate
+ * throughput, the process's peak resident set size and how many tracks
+ * reused a pooled codec.
+ */
+
+#include "psymp3.h"
+#include "alloc_counter.h"
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <atomic>
+#include <thread>
+#include <mutex>
+
+using PsyMP3::DSP::Equalizer;
+using PsyMP3::DSP::Resampler;
+
+// RIFF WAVE header structure
+#pragma pack(push, 1)
+struct WAVHeader {
+    char riff_id[4];           // "RIFF"
+    uint32_t riff_size;        // File size - 8
+    char wave_id[4];           // "WAVE"
+    char fmt_id[4];            // "fmt "
+    uint32_t fmt_size;         // 16
+    uint16_t audio_format;     // 1 = PCM, 3 = IEEE float
+    uint16_t num_channels;
+    uint32_t sample_rate;
+    uint32_t byte_rate;
+    uint16_t block_align;
+    uint16_t bits_per_sample;
+    char data_id[4];           // "data"
+    uint32_t data_size;
+};
+#pragma pack(pop)
+
+/**
+ * @brief Configuration options for psymp3-render
+ */
+struct RenderConfig {
+    std::vector<std::string> inputs;
+    std::string output_dir;       // empty: discard output
+    bool raw_output = false;
+    bool float_output = false;
+    unsigned int jobs = 0;        // 0: one per hardware thread
+    unsigned int threads = 1;     // decode threads per file; 0: one per hardware thread
+    unsigned int rate = 0;        // 0: keep the stream's rate
+    float volume = 1.0f;
+    bool eq = false;
+    float eq_gains[Equalizer::kNumBands] = {};
+    bool debug = false;
+    bool quiet = false;
+};
+
+/**
+ * @brief Outcome of rendering one file
+ */
+struct RenderResult {
+    bool ok = false;
+    std::string error;
+    std::string codec;
+    unsigned int in_rate = 0;
+    unsigned int out_rate = 0;
+    unsigned int channels = 0;
+    uint64_t frames = 0;          // at the output rate
+    double wall_seconds = 0.0;
+    uint64_t allocations = 0;
+    uint64_t allocated_bytes = 0;
+
+    double audioSeconds() const { return out_rate ? static_cast<double>(frames) / out_rate : 0.0; }
+    double realtimeFactor() const { return wall_seconds > 0.0 ? audioSeconds() / wall_seconds : 0.0; }
+};
+
+/**
+ * @brief Print usage information
+ */
+static void printUsage(const char* program_name) {
+    std::cerr << "Usage: " << program_name << " [options] input...\n"
+              << "\n"
+              << "Decode any supported file through the playback pipeline, faster than\n"
+              << "realtime and without an audio device, and report throughput.\n"
+              << "\n"
+              << "Options:\n"
+              << "  -o, --output DIR    Write <DIR>/<input name>.wav (default: discard)\n"
+              << "  -r, --raw           Write raw PCM (.pcm) instead of WAVE\n"
+              << "  -f, --float         Write 32-bit float instead of 16-bit PCM\n"
+              << "  -j, --jobs N        Render N files in parallel (default: one per core)\n"
+              << "  -t, --threads N     Decode each file on N threads where the codec can\n"
+              << "                      (FLAC; default: 1, 0: one per core)\n"
+              << "  -R, --rate HZ       Resample to HZ\n"
+              << "  -V, --volume X      Apply volume X (0.0 - 1.0)\n"
+              << "  -e, --eq G1,...,G7  Run the equalizer with these band gains in dB\n"
+              << "  -d, --debug         Log all debug channels to psymp3-render_debug.log\n"
+              << "  -q, --quiet         Only print the summary\n"
+              << "  -h, --help          Show this help message\n"
+              << "\n"
+              << "Examples:\n"
+              << "  " << program_name << " -j 8 ~/Music/*.flac\n"
+              << "  " << program_name << " -j 1 -t 0 hires.flac\n"
+              << "  " << program_name << " -R 48000 -e 3,0,0,0,0,0,-3 -o out track.opus\n";
+}
+
+/**
+ * @brief Parse command line arguments
+ */
+static bool parseArgs(int argc, char* argv[], RenderConfig& config) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        const auto value = [&](std::string& out) {
+            if (i + 1 >= argc) {
+                std::cerr << "Option " << arg << " needs a value\n";
+                return false;
+            }
+            out = argv[++i];
+            return true;
+        };
+        std::string v;
+
+        try {
+            if (arg == "-h" || arg == "--help") {
+                printUsage(argv[0]);
+                return false;
+            } else if (arg == "-o" || arg == "--output") {
+                if (!value(config.output_dir)) return false;
+            } else if (arg == "-r" || arg == "--raw") {
+                config.raw_output = true;
+            } else if (arg == "-f" || arg == "--float") {
+                config.float_output = true;
+            } else if (arg == "-j" || arg == "--jobs") {
+                if (!value(v)) return false;
+                config.jobs = static_cast<unsigned int>(std::stoul(v));
+            } else if (arg == "-t" || arg == "--threads") {
+                if (!value(v)) return false;
+                config.threads = static_cast<unsigned int>(std::stoul(v));
+            } else if (arg == "-R" || arg == "--rate") {
+                if (!value(v)) return false;
+                config.rate = static_cast<unsigned int>(std::stoul(v));
+            } else if (arg == "-V" || arg == "--volume") {
+                if (!value(v)) return false;
+                config.volume = std::clamp(std::stof(v), 0.0f, 1.0f);
+            } else if (arg == "-e" || arg == "--eq") {
+                if (!value(v)) return false;
+                const auto gains = MediaFile::split(v, ',');
+                if (gains.size() != static_cast<size_t>(Equalizer::kNumBands)) {
+                    std::cerr << "--eq needs " << Equalizer::kNumBands << " comma-separated gains\n";
+                    return false;
+                }
+                for (int band = 0; band < Equalizer::kNumBands; ++band) {
+                    config.eq_gains[band] = std::stof(gains[band]);
+                }
+                config.eq = true;
+            } else if (arg == "-d" || arg == "--debug") {
+                config.debug = true;
+            } else if (arg == "-q" || arg == "--quiet") {
+                config.quiet = true;
+            } else if (arg[0] == '-') {
+                std::cerr << "Unknown option: " << arg << "\n";
+                printUsage(argv[0]);
+                return false;
+            } else {
+                config.inputs.push_back(arg);
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Invalid value for " << arg << ": " << v << "\n";
+            return false;
+        }
+    }
+
+    if (config.inputs.empty()) {
+        std::cerr << "Error: No input file specified\n";
+        printUsage(argv[0]);
+        return false;
+    }
+    if (config.jobs == 0) {
+        config.jobs = std::max(1u, std::thread::hardware_concurrency());
+    }
+    config.jobs = std::min<unsigned int>(config.jobs, static_cast<unsigned int>(config.inputs.size()));
+    return true;
+}
+
+/**
+ * @brief Write a WAVE header; called again at the end with the final size
+ */
+static void writeWAVHeader(std::ostream& out, uint32_t sample_rate, uint16_t channels,
+                           bool float_samples, uint32_t data_size) {
+    WAVHeader header;
+    const uint16_t bits = float_samples ? 32 : 16;
+    std::memcpy(header.riff_id, "RIFF", 4);
+    header.riff_size = 36 + data_size;
+    std::memcpy(header.wave_id, "WAVE", 4);
+    std::memcpy(header.fmt_id, "fmt ", 4);
+    header.fmt_size = 16;
+    header.audio_format = float_samples ? 3 : 1;
+    header.num_channels = channels;
+    header.sample_rate = sample_rate;
+    header.bits_per_sample = bits;
+    header.block_align = channels * (bits / 8);
+    header.byte_rate = sample_rate * header.block_align;
+    std::memcpy(header.data_id, "data", 4);
+    header.data_size = data_size;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+/**
+ * @brief Output path for `input` inside the output directory
+ */
+static std::string outputPath(const RenderConfig& config, const std::string& input) {
+    std::string name = input.substr(input.find_last_of("/\\") + 1);
+    const size_t dot = name.find_last_of('.');
+    if (dot != std::string::npos && dot > 0) {
+        name.resize(dot);
+    }
+    return config.output_dir + "/" + name + (config.raw_output ? ".pcm" : ".wav");
+}
+
+/**
+ * @brief Render one file through decode, resample and volume/EQ
+ */
+static RenderResult render(const RenderConfig& config, const std::string& input) {
+    RenderResult result;
+    const uint64_t allocs_before = AllocCounter::threadCount();
+    const uint64_t bytes_before = AllocCounter::threadBytes();
+    const auto start_time = std::chrono::steady_clock::now();
+
+    std::unique_ptr<Stream> stream;
+    try {
+        stream = MediaFile::open(TagLib::String(input.c_str(), TagLib::String::UTF8));
+    } catch (const std::exception& e) {
+        result.error = e.what();
+        return result;
+    }
+    if (!stream || stream->getRate() == 0 || stream->getChannels() == 0) {
+        result.error = "unsupported or empty stream";
+        return result;
+    }
+    if (auto* demuxed = dynamic_cast<DemuxedStream*>(stream.get())) {
+        result.codec = demuxed->getCodecType();
+        if (config.threads != 1) {
+            demuxed->setParallelDecode(config.threads);
+        }
+    }
+
+    result.in_rate = stream->getRate();
+    result.channels = stream->getChannels();
+    result.out_rate = config.rate ? config.rate : result.in_rate;
+    const int channels = static_cast<int>(result.channels);
+
+    Resampler resampler;
+    resampler.configure(result.in_rate, result.out_rate, result.channels);
+    Equalizer eq;
+    eq.configure(static_cast<int>(result.out_rate), channels);
+    eq.setEnabled(config.eq);
+    for (int band = 0; band < Equalizer::kNumBands; ++band) {
+        eq.setBandGain(band, config.eq_gains[band]);
+    }
+    const bool run_eq = config.eq || config.volume != 1.0f;
+
+    std::ofstream out;
+    if (!config.output_dir.empty()) {
+        out.open(outputPath(config, input), std::ios::binary);
+        if (!out) {
+            result.error = "cannot open " + outputPath(config, input);
+            return result;
+        }
+        if (!config.raw_output) {
+            writeWAVHeader(out, result.out_rate, static_cast<uint16_t>(channels), config.float_output, 0);
+        }
+    }
+
+    // The same chunk size the loudness scanner uses: large enough that
+    // per-call overhead does not dominate, small enough to stay in cache.
+    std::vector<float> chunk(4096 * result.channels);
+    std::vector<float> resampled;
+    std::vector<int16_t> pcm16;
+    uint64_t data_bytes = 0;
+
+    const auto emit = [&](float* samples, size_t frames) {
+        if (run_eq) {
+            eq.process(samples, frames, channels, config.volume);
+        }
+        result.frames += frames;
+        if (!out.is_open()) {
+            return;
+        }
+        const size_t count = frames * result.channels;
+        if (config.float_output) {
+            out.write(reinterpret_cast<const char*>(samples), count * sizeof(float));
+            data_bytes += count * sizeof(float);
+        } else {
+            pcm16.resize(count);
+            for (size_t i = 0; i < count; ++i) {
+                pcm16[i] = static_cast<int16_t>(std::lrintf(std::clamp(samples[i], -1.0f, 1.0f) * 32767.0f));
+            }
+            out.write(reinterpret_cast<const char*>(pcm16.data()), count * sizeof(int16_t));
+            data_bytes += count * sizeof(int16_t);
+        }
+    };
+
+    try {
+        while (!stream->eof()) {
+            const size_t samples = stream->getDataFloat(chunk.size(), chunk.data());
+            if (samples == 0) {
+                break;
+            }
+            const size_t frames = samples / result.channels;
+            if (resampler.isActive()) {
+                resampler.process(chunk.data(), frames, resampled);
+                emit(resampled.data(), resampled.size() / result.channels);
+            } else {
+                emit(chunk.data(), frames);
+            }
+        }
+        if (resampler.isActive()) {
+            resampler.drain(resampled);
+            emit(resampled.data(), resampled.size() / result.channels);
+        }
+    } catch (const std::exception& e) {
+        result.error = e.what();
+        return result;
+    }
+
+    if (out.is_open()) {
+        if (!config.raw_output) {
+            out.seekp(0, std::ios::beg);
+            writeWAVHeader(out, result.out_rate, static_cast<uint16_t>(channels), config.float_output,
+                           static_cast<uint32_t>(std::min<uint64_t>(data_bytes, UINT32_MAX - 36)));
+        }
+        out.close();
+        if (out.fail()) {
+            result.error = "write failed";
+            return result;
+        }
+    }
+
+    stream.reset(); // teardown is part of the cost
+    result.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    result.allocations = AllocCounter::threadCount() - allocs_before;
+    result.allocated_bytes = AllocCounter::threadBytes() - bytes_before;
+    result.ok = true;
+    return result;
+}
+
+static std::string megabytes(uint64_t bytes) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1) << bytes / (1024.0 * 1024.0) << " MiB";
+    return oss.str();
+}
+
+int main(int argc, char* argv[]) {
+    RenderConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        return 1;
+    }
+
+    if (config.debug) {
+        Debug::init("psymp3-render_debug.log", {"all"});
+    }
+    registerAllCodecs();
+    registerAllDemuxers();
+
+    std::vector<RenderResult> results(config.inputs.size());
+    std::atomic<size_t> next{0};
+    std::mutex print_mutex;
+
+    const auto wall_start = std::chrono::steady_clock::now();
+    const auto worker = [&](unsigned int index) {
+        System::setThisThreadName("render-" + std::to_string(index));
+        for (size_t i = next.fetch_add(1); i < config.inputs.size(); i = next.fetch_add(1)) {
+            results[i] = render(config, config.inputs[i]);
+            if (config.quiet) {
+                continue;
+            }
+            const RenderResult& r = results[i];
+            std::lock_guard<std::mutex> lock(print_mutex);
+            if (!r.ok) {
+                std::cerr << "FAIL  " << config.inputs[i] << ": " << r.error << "\n";
+                continue;
+            }
+            std::cout << std::fixed << std::setprecision(1)
+                      << std::setw(8) << r.realtimeFactor() << "x  "
+                      << std::setw(7) << r.audioSeconds() << " s audio in "
+                      << std::setprecision(3) << r.wall_seconds << " s  "
+                      << r.allocations << " allocs (" << megabytes(r.allocated_bytes) << ")  "
+                      << (r.codec.empty() ? "" : r.codec + " ") << r.in_rate << " Hz"
+                      << (r.out_rate != r.in_rate ? "->" + std::to_string(r.out_rate) + " Hz" : "")
+                      << "  " << config.inputs[i] << "\n";
+        }
+    };
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < config.jobs; ++i) {
+        workers.emplace_back(worker, i);
+    }
+    for (auto& t : workers) {
+        t.join();
+    }
+    const double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+
+    size_t ok = 0;
+    double audio_seconds = 0.0;
+    double busy_seconds = 0.0;
+    for (const auto& r : results) {
+        if (r.ok) {
+            ++ok;
+            audio_seconds += r.audioSeconds();
+            busy_seconds += r.wall_seconds;
+        }
+    }
+    auto& tracker = PsyMP3::IO::MemoryTracker::getInstance();
+    tracker.update();
+    const CodecPool::PoolStats pool = CodecPool::getInstance().getStats();
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "\nRendered " << ok << " of " << results.size() << " files with "
+              << config.jobs << " job" << (config.jobs == 1 ? "" : "s") << ": "
+              << audio_seconds << " s of audio in " << std::setprecision(3) << wall_seconds << " s\n"
+              << std::setprecision(1)
+              << "  Aggregate: " << (wall_seconds > 0 ? audio_seconds / wall_seconds : 0.0) << "x realtime\n"
+              << "  Per job:   " << (busy_seconds > 0 ? audio_seconds / busy_seconds : 0.0) << "x realtime\n"
+              << "  Allocations: " << AllocCounter::totalCount() << " (" << megabytes(AllocCounter::totalBytes()) << ")\n"
+              << "  Peak RSS: " << megabytes(tracker.getStats().peak_memory_usage) << "\n"
+              << "  Codecs reused: " << pool.reuses << " of " << pool.acquisitions
+              << " (" << pool.reuse_rate * 100.0 << "%), ~"
+              << std::setprecision(3) << pool.time_saved.count() / 1000.0 << " ms saved\n";
+
+    if (config.debug) {
+        Debug::shutdown();
+    }
+    return ok == results.size() ? 0 : 1;
+}
@@ -0,0 +1,171 @@
+/*
+ * test_aiff_pcm_layout.cpp - AIFF/AIFF-C compression types through ChunkDemuxer into PCMCodec
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef FINAL_BUILD
+#include "psymp3.h"
+#endif
+#include "test_framework.h"
+#include "io/MemoryIOHandler.h"
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+using PsyMP3::Codec::PCM::PCMCodec;
+using PsyMP3::Demuxer::ChunkDemuxer;
+using PsyMP3::IO::MemoryIOHandler;
+using namespace TestFramework;
+
+namespace {
+
+void putBE(std::vector<uint8_t>& out, uint64_t value, size_t bytes)
+{
+    for (size_t i = bytes; i-- > 0;) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void putFourCC(std::vector<uint8_t>& out, const char* fourcc)
+{
+    out.insert(out.end(), fourcc, fourcc + 4);
+}
+
+// Mono 44.1 kHz file holding `data`. `compression` is null for plain AIFF,
+// which has no compression type and so is "NONE".
+std::vector<uint8_t> makeAiff(const char* compression, uint16_t bits, const std::vector<uint8_t>& data)
+{
+    const uint32_t frames = static_cast<uint32_t>(data.size() / (bits / 8));
+
+    std::vector<uint8_t> body;
+    putFourCC(body, compression ? "AIFC" : "AIFF");
+    if (compression) {
+        putFourCC(body, "FVER");
+        putBE(body, 4, 4);
+        putBE(body, 0xA2805140, 4);  // AIFC version 1
+    }
+
+    putFourCC(body, "COMM");
+    putBE(body, compression ? 18 + 4 + 2 : 18, 4);
+    putBE(body, 1, 2);               // channels
+    putBE(body, frames, 4);
+    putBE(body, bits, 2);
+    putBE(body, 0x400E, 2);          // 44100 as an 80-bit extended float
+    putBE(body, 0xAC44000000000000ull, 8);
+    if (compression) {
+        putFourCC(body, compression);
+        putBE(body, 0, 2);           // empty compression name, padded
+    }
+
+    putFourCC(body, "SSND");
+    putBE(body, 8 + data.size(), 4);
+    putBE(body, 0, 4);               // offset
+    putBE(body, 0, 4);               // block size
+    body.insert(body.end(), data.begin(), data.end());
+
+    std::vector<uint8_t> file;
+    putFourCC(file, "FORM");
+    putBE(file, body.size(), 4);
+    file.insert(file.end(), body.begin(), body.end());
+    return file;
+}
+
+std::vector<uint8_t> floatBE(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    std::vector<uint8_t> out;
+    putBE(out, bits, 4);
+    return out;
+}
+
+std::vector<uint8_t> doubleBE(double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    std::vector<uint8_t> out;
+    putBE(out, bits, 8);
+    return out;
+}
+
+std::vector<uint8_t> concat(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b)
+{
+    std::vector<uint8_t> out = a;
+    out.insert(out.end(), b.begin(), b.end());
+    return out;
+}
+
+// Demuxes the file and decodes its one chunk as PCMCodec would in playback
+std::vector<int16_t> decodeAiff(const std::vector<uint8_t>& file, const std::string& label)
+{
+    ChunkDemuxer demuxer(std::make_unique<MemoryIOHandler>(file.data(), file.size()));
+    ASSERT_TRUE(demuxer.parseContainer(), label + ": parseContainer");
+
+    const std::vector<StreamInfo> streams = demuxer.getStreams();
+    ASSERT_EQUALS(1u, streams.size(), label + ": one stream");
+    const StreamInfo& info = streams.front();
+    ASSERT_EQUALS(std::string("pcm"), info.codec_name, label + ": codec name");
+    ASSERT_EQUALS(44100u, info.sample_rate, label + ": sample rate");
+
+    PCMCodec codec(info);
+    ASSERT_TRUE(codec.canDecode(info), label + ": canDecode");
+    ASSERT_TRUE(codec.initialize(), label + ": initialize");
+
+    MediaChunk chunk = demuxer.readChunk(info.stream_id);
+    ASSERT_TRUE(chunk.isValid(), label + ": readChunk");
+    return codec.decode(chunk).samples;
+}
+
+void expectSamples(const std::vector<int16_t>& expected, const std::vector<int16_t>& actual,
+                   const std::string& label)
+{
+    ASSERT_EQUALS(expected.size(), actual.size(), label + ": sample count");
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQUALS(expected[i], actual[i], label + ": sample " + std::to_string(i));
+    }
+}
+
+// 0x1234 and -2, big-endian and byte-swapped
+const std::vector<uint8_t> kS16BE = {0x12, 0x34, 0xFF, 0xFE};
+const std::vector<uint8_t> kS16LE = {0x34, 0x12, 0xFE, 0xFF};
+const std::vector<int16_t> kS16Samples = {0x1234, -2};
+// Floats scale by 32767 and truncate
+const std::vector<int16_t> kFloatSamples = {16383, -16383};
+
+void test_integer_compression_types()
+{
+    expectSamples(kS16Samples, decodeAiff(makeAiff(nullptr, 16, kS16BE), "AIFF"), "AIFF");
+    expectSamples(kS16Samples, decodeAiff(makeAiff("NONE", 16, kS16BE), "NONE"), "NONE");
+    expectSamples(kS16Samples, decodeAiff(makeAiff("twos", 16, kS16BE), "twos"), "twos");
+    expectSamples(kS16Samples, decodeAiff(makeAiff("sowt", 16, kS16LE), "sowt"), "sowt");
+}
+
+void test_float_compression_types()
+{
+    const std::vector<uint8_t> f32 = concat(floatBE(0.5f), floatBE(-0.5f));
+    const std::vector<uint8_t> f64 = concat(doubleBE(0.5), doubleBE(-0.5));
+    expectSamples(kFloatSamples, decodeAiff(makeAiff("fl32", 32, f32), "fl32"), "fl32");
+    expectSamples(kFloatSamples, decodeAiff(makeAiff("FL32", 32, f32), "FL32"), "FL32");
+    expectSamples(kFloatSamples, decodeAiff(makeAiff("fl64", 64, f64), "fl64"), "fl64");
+    expectSamples(kFloatSamples, decodeAiff(makeAiff("FL64", 64, f64), "FL64"), "FL64");
+}
+
+} // namespace
+
+int main()
+{
+    TestSuite suite("AIFF PCM Layout Tests");
+
+    suite.addTest("Integer Compression Types", test_integer_compression_types);
+    suite.addTest("Float Compression Types", test_float_compression_types);
+
+    auto results = suite.runAll();
+    suite.printResults(results);
+    return (suite.getFailureCount(results) == 0) ? 0 : 1;
+}
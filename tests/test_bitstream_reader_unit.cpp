@@ -299,6 +299,80 @@ void test_skip_bits() {
     ASSERT_EQUALS(0xBCu, value, "Should read 0xBC after skipping");
 }
 
+// Helper: append `bits` bits of `value` MSB-first
+static void put_bits(std::vector<uint8_t>& out, uint32_t& bit_count, uint64_t value, uint32_t bits) {
+    for (uint32_t i = bits; i-- > 0;) {
+        if (bit_count % 8 == 0) out.push_back(0);
+        if ((value >> i) & 1) out.back() |= static_cast<uint8_t>(0x80 >> (bit_count % 8));
+        ++bit_count;
+    }
+}
+
+// Test batched Rice decoding against the per-value reader
+void test_rice_codes_batched() {
+    for (uint32_t k : {0u, 1u, 4u, 13u, 30u}) {
+        std::vector<uint8_t> data;
+        uint32_t bit_count = 0;
+        put_bits(data, bit_count, 0x5, 3);  // unaligned start
+        std::vector<int32_t> expected;
+        uint32_t seed = 12345 + k;
+        for (int i = 0; i < 500; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            // Mostly small quotients, with some longer than a 64-bit window
+            uint32_t quotient = (i % 97 == 5) ? 70 + (seed >> 28) : (seed >> 29);
+            uint32_t remainder = k ? (seed >> 3) & ((1u << k) - 1) : 0;
+            uint64_t folded = (static_cast<uint64_t>(quotient) << k) | remainder;
+            if (folded >= 0xFFFFFFFFull) folded = remainder;
+            expected.push_back((folded & 1) ? -static_cast<int32_t>((folded + 1) >> 1)
+                                            : static_cast<int32_t>(folded >> 1));
+            for (uint64_t z = folded >> k; z > 0; --z) put_bits(data, bit_count, 0, 1);
+            put_bits(data, bit_count, 1, 1);
+            put_bits(data, bit_count, folded & ((1ull << k) - 1), k);
+        }
+        put_bits(data, bit_count, 0x2D, 6);  // trailer
+
+        BitstreamReader reader;
+        reader.feedData(data.data(), data.size());
+        uint32_t value;
+        ASSERT_TRUE(reader.readBits(value, 3), "Read leading bits");
+
+        std::vector<int32_t> decoded(expected.size());
+        uint32_t n = reader.readRiceCodes(decoded.data(), static_cast<uint32_t>(decoded.size()), k);
+        ASSERT_TRUE(n > 0, "Batched path decodes the bulk of the data");
+        // Only the tail near the end of the buffer is left to the checked path
+        for (; n < decoded.size(); ++n) {
+            ASSERT_TRUE(reader.readRiceCode(decoded[n], k), "Finish with readRiceCode");
+        }
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_EQUALS(expected[i], decoded[i], "Batched Rice value matches");
+        }
+        ASSERT_TRUE(reader.readBits(value, 6), "Read trailer");
+        ASSERT_EQUALS(0x2Du, value, "Reader positioned after the last value");
+        ASSERT_EQUALS(static_cast<uint64_t>(bit_count), reader.getBitPosition(),
+                      "Bit position accounts for every value");
+    }
+}
+
+// Test that batched Rice decoding stops short of an out-of-range value
+void test_rice_codes_batched_invalid() {
+    std::vector<uint8_t> data;
+    uint32_t bit_count = 0;
+    // k = 30: folded 2 (residual 1), then quotient 3 with an all-ones
+    // remainder, which folds to 0xFFFFFFFF (INT32_MIN) and must be rejected
+    put_bits(data, bit_count, 1, 1);
+    put_bits(data, bit_count, 2, 30);
+    put_bits(data, bit_count, 1, 4);
+    put_bits(data, bit_count, 0x3FFFFFFF, 30);
+    put_bits(data, bit_count, 0, 64);
+
+    BitstreamReader reader;
+    reader.feedData(data.data(), data.size());
+    int32_t decoded[2] = {};
+    ASSERT_EQUALS(1u, reader.readRiceCodes(decoded, 2, 30), "Stops before the invalid value");
+    ASSERT_EQUALS(1, decoded[0], "First value decoded");
+    ASSERT_EQUALS(static_cast<uint64_t>(31), reader.getBitPosition(), "Invalid value not consumed");
+}
+
 int main() {
     // Create test suite
     TestSuite suite("BitstreamReader Unit Tests");
@@ -318,6 +392,8 @@ int main() {
     suite.addTest("Read 32 Bits", test_read_32_bits);
     suite.addTest("Buffer Underflow", test_buffer_underflow);
     suite.addTest("Skip Bits", test_skip_bits);
+    suite.addTest("Batched Rice Codes", test_rice_codes_batched);
+    suite.addTest("Batched Rice Codes Invalid", test_rice_codes_batched_invalid);
     
     // Run all tests
     auto results = suite.runAll();
@@ -147,6 +147,54 @@ void test_multi_channel() {
     ASSERT_EQUALS(1, ch2[0], "Channel 2 unchanged");
 }
 
+// The 32-bit overload (SIMD body plus scalar tail) reconstructs exactly
+// what the 64-bit one does, up to the 31-bit frames it is used for
+void test_32bit_matches_64bit() {
+    ChannelDecorrelator decorrelator;
+    uint32_t seed = 0x1234567u;
+    
+    for (uint32_t bit_depth : {8u, 16u, 24u, 31u}) {
+        for (ChannelAssignment assignment : {ChannelAssignment::LEFT_SIDE,
+                                             ChannelAssignment::RIGHT_SIDE,
+                                             ChannelAssignment::MID_SIDE}) {
+            // Odd length so the scalar tail runs too
+            const uint32_t count = 37;
+            int64_t wide0[count], wide1[count];
+            int32_t narrow0[count], narrow1[count];
+            for (uint32_t i = 0; i < count; ++i) {
+                seed = seed * 1664525u + 1013904223u;
+                const int64_t left = static_cast<int32_t>(seed) >> (32 - bit_depth);
+                seed = seed * 1664525u + 1013904223u;
+                const int64_t right = static_cast<int32_t>(seed) >> (32 - bit_depth);
+                const int64_t side = left - right;
+                if (assignment == ChannelAssignment::LEFT_SIDE) {
+                    wide0[i] = left;
+                    wide1[i] = side;
+                } else if (assignment == ChannelAssignment::RIGHT_SIDE) {
+                    wide0[i] = side;
+                    wide1[i] = right;
+                } else {
+                    wide0[i] = (left + right) >> 1;
+                    wide1[i] = side;
+                }
+                narrow0[i] = static_cast<int32_t>(wide0[i]);
+                narrow1[i] = static_cast<int32_t>(wide1[i]);
+            }
+            
+            int64_t* wide[] = {wide0, wide1};
+            int32_t* narrow[] = {narrow0, narrow1};
+            ASSERT_TRUE(decorrelator.decorrelate(wide, count, 2, assignment),
+                        "Should decorrelate 64-bit");
+            ASSERT_TRUE(decorrelator.decorrelate(narrow, count, 2, assignment),
+                        "Should decorrelate 32-bit");
+            for (uint32_t i = 0; i < count; ++i) {
+                ASSERT_EQUALS(wide0[i], static_cast<int64_t>(narrow0[i]), "Channel 0 matches");
+                ASSERT_EQUALS(wide1[i], static_cast<int64_t>(narrow1[i]), "Channel 1 matches");
+            }
+        }
+    }
+}
+
 int main() {
     // Create test suite
     TestSuite suite("ChannelDecorrelator Unit Tests");
@@ -159,6 +207,7 @@ int main() {
     suite.addTest("Independent Channels", test_independent_channels);
     suite.addTest("Mono Channel", test_mono_channel);
     suite.addTest("Multi-Channel", test_multi_channel);
+    suite.addTest("32-bit Matches 64-bit", test_32bit_matches_64bit);
     
     // Run all tests
     auto results = suite.runAll();
@@ -0,0 +1,177 @@
+/*
+ * test_chunk_pipeline.cpp - Unit tests for the pipelined demux stage
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef FINAL_BUILD
+#include "psymp3.h"
+#endif
+#include "test_framework.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using PsyMP3::Demuxer::ChunkPipeline;
+using namespace TestFramework;
+
+namespace {
+
+// Serves `count` one-chunk-per-index chunks on stream 1, optionally sleeping
+// per read like a network source. Seeking is by chunk index (1 ms = 1 chunk).
+class IndexDemuxer : public Demuxer {
+public:
+    IndexDemuxer(uint32_t count, std::chrono::microseconds read_delay = {})
+        : Demuxer(std::make_unique<IOHandler>()), m_count(count), m_read_delay(read_delay)
+    {
+    }
+
+    bool parseContainer() override { return true; }
+    std::vector<StreamInfo> getStreams() const override { return {}; }
+    StreamInfo getStreamInfo(uint32_t) const override { return StreamInfo{}; }
+    MediaChunk readChunk() override { return readChunk(1); }
+
+    MediaChunk readChunk(uint32_t stream_id) override
+    {
+        if (m_read_delay.count() > 0) {
+            std::this_thread::sleep_for(m_read_delay);
+        }
+        if (stream_id != 1 || m_next >= m_count) {
+            setEOF(true);
+            return MediaChunk{};
+        }
+        m_reads.fetch_add(1);
+        const uint32_t index = m_next++;
+        return MediaChunk(1, std::vector<uint8_t>{static_cast<uint8_t>(index), static_cast<uint8_t>(index >> 8)});
+    }
+
+    bool seekTo(uint64_t timestamp_ms) override
+    {
+        m_next = static_cast<uint32_t>(std::min<uint64_t>(timestamp_ms, m_count));
+        setEOF(m_next >= m_count);
+        return true;
+    }
+
+    bool isEOF() const override { return isEOFAtomic(); }
+    uint64_t getDuration() const override { return m_count; }
+    uint64_t getPosition() const override { return m_next; }
+
+    size_t reads() const { return m_reads.load(); }
+
+private:
+    const uint32_t m_count;
+    const std::chrono::microseconds m_read_delay;
+    uint32_t m_next = 0;
+    std::atomic<size_t> m_reads{0};
+};
+
+uint32_t chunkIndex(const MediaChunk& chunk)
+{
+    return chunk.data[0] | (static_cast<uint32_t>(chunk.data[1]) << 8);
+}
+
+} // namespace
+
+static void testOrderAndEnd()
+{
+    IndexDemuxer demuxer(500);
+    ChunkPipeline pipeline(demuxer, 1);
+    MediaChunk chunk;
+    for (uint32_t i = 0; i < 500; ++i) {
+        ASSERT_TRUE(pipeline.pop(chunk), "every chunk arrives");
+        ASSERT_EQUALS(i, chunkIndex(chunk), "chunks arrive in demux order");
+    }
+    ASSERT_TRUE(!pipeline.pop(chunk), "pop reports the end of the stream");
+    ASSERT_TRUE(pipeline.finished(), "finished once drained at EOF");
+}
+
+static void testBackpressure()
+{
+    IndexDemuxer demuxer(1000);
+    ChunkPipeline pipeline(demuxer, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    // The ring holds kCapacity; the demux thread may hold one more in hand.
+    ASSERT_TRUE(demuxer.reads() <= ChunkPipeline::kCapacity + 1, "read-ahead is bounded by the ring");
+    ASSERT_TRUE(demuxer.reads() >= ChunkPipeline::kCapacity, "the ring fills while the consumer is idle");
+    ASSERT_TRUE(!pipeline.finished(), "not finished mid-stream");
+}
+
+static void testRepositionDropsReadAhead()
+{
+    IndexDemuxer demuxer(1000);
+    ChunkPipeline pipeline(demuxer, 1);
+    MediaChunk chunk;
+    ASSERT_TRUE(pipeline.pop(chunk), "first chunk");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20)); // let the ring fill
+    for (uint32_t target : {700u, 10u, 999u}) {
+        pipeline.reposition(1, [target](Demuxer& d) { d.seekTo(target); });
+        ASSERT_TRUE(pipeline.pop(chunk), "chunk after reposition");
+        ASSERT_EQUALS(target, chunkIndex(chunk), "nothing read before the reposition survives it");
+    }
+    ASSERT_TRUE(!pipeline.pop(chunk), "end after the last chunk");
+
+    // Repositioning after the end restarts reading.
+    pipeline.reposition(1, [](Demuxer& d) { d.seekTo(0); });
+    ASSERT_TRUE(!pipeline.finished(), "reposition clears the end");
+    ASSERT_TRUE(pipeline.pop(chunk), "reading resumes after the end");
+    ASSERT_EQUALS(0u, chunkIndex(chunk), "from the new position");
+}
+
+static void testStopKeepsReadAhead()
+{
+    IndexDemuxer demuxer(200);
+    ChunkPipeline pipeline(demuxer, 1);
+    MediaChunk chunk;
+    ASSERT_TRUE(pipeline.pop(chunk), "first chunk");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    pipeline.stop();
+    uint32_t expected = 1;
+    while (pipeline.tryPop(chunk)) {
+        ASSERT_EQUALS(expected, chunkIndex(chunk), "read-ahead is handed back in order");
+        ++expected;
+    }
+    // Nothing the demuxer produced was lost: the next read continues the run.
+    MediaChunk next = demuxer.readChunk(1);
+    ASSERT_TRUE(next.isValid(), "demuxer still has data");
+    ASSERT_EQUALS(expected, chunkIndex(next), "no chunk was skipped across stop()");
+}
+
+static void testOverlapsSlowReads()
+{
+    // 2 ms per read and 2 ms per "decode": overlapped, 100 chunks take about
+    // 200 ms rather than 400 ms.
+    IndexDemuxer demuxer(100, std::chrono::milliseconds(2));
+    ChunkPipeline pipeline(demuxer, 1);
+    const auto start = std::chrono::steady_clock::now();
+    MediaChunk chunk;
+    size_t count = 0;
+    while (pipeline.pop(chunk)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        ++count;
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    ASSERT_EQUALS(size_t(100), count, "all chunks consumed");
+    ASSERT_TRUE(elapsed < 350, "demux and decode overlap (" + std::to_string(elapsed) + " ms)");
+}
+
+int main()
+{
+    TestSuite suite("ChunkPipeline Unit Tests");
+
+    suite.addTest("Order and end", testOrderAndEnd);
+    suite.addTest("Backpressure", testBackpressure);
+    suite.addTest("Reposition drops read-ahead", testRepositionDropsReadAhead);
+    suite.addTest("Stop keeps read-ahead", testStopKeepsReadAhead);
+    suite.addTest("Overlaps slow reads", testOverlapsSlowReads);
+
+    auto results = suite.runAll();
+    suite.printResults(results);
+
+    return suite.getFailureCount(results) > 0 ? 1 : 0;
+}
@@ -0,0 +1,169 @@
+/*
+ * test_codec_decode_into.cpp - Unit tests for AudioCodec::decodeInto()
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#include "psymp3.h"
+#include "test_framework.h"
+
+using namespace PsyMP3::Codec::MP2;
+using namespace PsyMP3::Codec::MP3;
+using namespace TestFramework;
+
+namespace {
+
+// Float output, to exercise the default decodeInto()'s conversion
+class FloatRampCodec : public AudioCodec {
+public:
+    explicit FloatRampCodec(const StreamInfo& stream_info) : AudioCodec(stream_info) {}
+
+    bool initialize() override { return true; }
+
+    AudioFrame decode(const MediaChunk& chunk) override {
+        AudioFrame frame;
+        frame.sample_rate = 48000;
+        frame.channels = 2;
+        frame.timestamp_samples = chunk.timestamp_samples;
+        frame.float_samples = {0.0f, 0.5f, -0.5f, 1.0f, -1.0f, 2.0f, 0.25f / 32768.0f, 0.75f / 32768.0f};
+        return frame;
+    }
+
+    AudioFrame flush() override { return AudioFrame(); }
+    void reset() override {}
+    std::string getCodecName() const override { return "floatramp"; }
+    bool canDecode(const StreamInfo&) const override { return true; }
+};
+
+// Silent mono 44.1 kHz MPEG-1 Layer III frames at 32 kbps
+std::vector<uint8_t> silentLayer3Frame()
+{
+    std::vector<uint8_t> frame(104, 0);
+    frame[0] = 0xFF;
+    frame[1] = 0xFB;
+    frame[2] = 0x10;
+    frame[3] = 0xC0;
+    return frame;
+}
+
+// Silent stereo 44.1 kHz MPEG-1 Layer II frame at 192 kbps
+std::vector<uint8_t> silentLayer2Frame()
+{
+    std::vector<uint8_t> frame(626, 0);
+    frame[0] = 0xFF;
+    frame[1] = 0xFD;
+    frame[2] = 0xA0;
+    frame[3] = 0x00;
+    return frame;
+}
+
+// decode() and decodeInto() agree, with the buffer at and below getMaxFrameSamples()
+void checkMatchesDecode(AudioCodec& reference, AudioCodec& codec, const std::vector<uint8_t>& data,
+                        const char* name)
+{
+    ASSERT_TRUE(reference.initialize() && codec.initialize(), "Codecs initialize");
+    const size_t max_samples = codec.getMaxFrameSamples();
+    ASSERT_TRUE(max_samples > 0, "Codec decodes into caller buffers");
+
+    std::vector<int16_t> buffer(max_samples + 16, 0x5555);
+    for (uint32_t trim : {0u, 100u}) {
+        MediaChunk chunk;
+        chunk.data = data;
+        chunk.timestamp_samples = 4096;
+        chunk.trim_leading_samples = trim;
+        chunk.trim_trailing_samples = trim / 2;
+
+        const AudioFrame frame = reference.decode(chunk);
+        const DecodedAudio decoded = codec.decodeInto(chunk, buffer.data(), max_samples);
+        ASSERT_TRUE(frame.hasSamples(), name);
+        ASSERT_EQUALS(frame.getSampleCount(), decoded.samples, "Same sample count");
+        ASSERT_EQUALS(frame.channels, decoded.channels, "Same channels");
+        ASSERT_EQUALS(frame.sample_rate, decoded.sample_rate, "Same sample rate");
+        ASSERT_EQUALS(frame.timestamp_samples, decoded.timestamp_samples, "Same timestamp");
+        ASSERT_TRUE(std::equal(frame.samples.begin(), frame.samples.end(), buffer.begin()), "Same samples");
+        ASSERT_EQUALS(0x5555, buffer[max_samples], "Nothing written past capacity");
+
+        // A short buffer gets the front of the frame
+        const DecodedAudio short_decoded = codec.decodeInto(chunk, buffer.data(), 100);
+        ASSERT_EQUALS(static_cast<size_t>(100), short_decoded.samples, "Short buffer is filled");
+        ASSERT_EQUALS(0x5555, buffer[max_samples], "Short buffer is not overrun");
+    }
+}
+
+} // namespace
+
+void test_decoded_audio_trim()
+{
+    std::vector<int16_t> data = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    DecodedAudio decoded;
+    decoded.samples = data.size();
+    decoded.channels = 2;
+
+    decoded.trim(data.data(), 1, 2);
+    ASSERT_EQUALS(static_cast<size_t>(4), decoded.samples, "Three of five frames trimmed");
+    ASSERT_EQUALS(2, data[0], "Leading frame dropped");
+    ASSERT_EQUALS(5, data[3], "Remaining frames moved to the front");
+
+    decoded.trim(data.data(), 1, 1);
+    ASSERT_EQUALS(static_cast<size_t>(0), decoded.samples, "Trimming everything empties it");
+}
+
+void test_default_wraps_decode()
+{
+    StreamInfo info;
+    FloatRampCodec codec(info);
+    MediaChunk chunk;
+    chunk.timestamp_samples = 77;
+    int16_t out[8] = {};
+
+    const DecodedAudio decoded = codec.decodeInto(chunk, out, 8);
+    ASSERT_EQUALS(static_cast<size_t>(8), decoded.samples, "Whole frame written");
+    ASSERT_EQUALS(2, static_cast<int>(decoded.channels), "Channels reported");
+    ASSERT_EQUALS(static_cast<uint64_t>(77), decoded.timestamp_samples, "Timestamp reported");
+    ASSERT_EQUALS(16384, out[1], "Float rounded to 16-bit");
+    ASSERT_EQUALS(32767, out[3], "Full scale clamps");
+    ASSERT_EQUALS(-32768, out[4], "Negative full scale");
+    ASSERT_EQUALS(32767, out[5], "Overrange clamps");
+    ASSERT_EQUALS(0, out[6], "Rounds to nearest");
+    ASSERT_EQUALS(1, out[7], "Rounds to nearest");
+
+    int16_t small[3] = {};
+    ASSERT_EQUALS(static_cast<size_t>(3), codec.decodeInto(chunk, small, 3).samples, "Truncated to capacity");
+}
+
+void test_minimp3_matches_decode()
+{
+    StreamInfo info;
+    info.codec_type = "audio";
+    info.codec_name = "mp3";
+    MiniMP3Codec reference(info);
+    MiniMP3Codec codec(info);
+    checkMatchesDecode(reference, codec, silentLayer3Frame(), "MP3 frame decodes");
+}
+
+void test_mp2_matches_decode()
+{
+    StreamInfo info;
+    info.codec_type = "audio";
+    info.codec_name = "mp2";
+    MP2Codec reference(info);
+    MP2Codec codec(info);
+    checkMatchesDecode(reference, codec, silentLayer2Frame(), "MP2 frame decodes");
+}
+
+int main()
+{
+    TestSuite suite("Codec decodeInto Tests");
+
+    suite.addTest("DecodedAudio Trim", test_decoded_audio_trim);
+    suite.addTest("Default Wraps Decode", test_default_wraps_decode);
+    suite.addTest("MiniMP3 Matches Decode", test_minimp3_matches_decode);
+    suite.addTest("MP2 Matches Decode", test_mp2_matches_decode);
+
+    auto results = suite.runAll();
+    suite.printResults(results);
+    return (suite.getFailureCount(results) == 0) ? 0 : 1;
+}
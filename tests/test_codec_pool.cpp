@@ -0,0 +1,236 @@
+/*
+ * test_codec_pool.cpp - Unit tests for codec reuse across tracks
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#include "psymp3.h"
+#include "test_framework.h"
+
+using namespace PsyMP3::Codec::MP3;
+using namespace TestFramework;
+
+namespace {
+
+// Counts resets; reuse and reset success are up to the test
+class PooledTestCodec : public AudioCodec {
+public:
+    static bool s_reusable;
+    static bool s_reset_succeeds;
+    static int s_resets;
+
+    explicit PooledTestCodec(const StreamInfo& stream_info) : AudioCodec(stream_info) {}
+
+    bool initialize() override { m_initialized = true; return true; }
+    AudioFrame decode(const MediaChunk&) override { return AudioFrame(); }
+    AudioFrame flush() override { return AudioFrame(); }
+    void reset() override {}
+    bool supportsReuse() const override { return s_reusable; }
+    bool resetForStream(const StreamInfo& stream_info) override {
+        s_resets++;
+        m_stream_info = stream_info;
+        return s_reset_succeeds;
+    }
+    std::string getCodecName() const override { return "pooltest"; }
+    bool canDecode(const StreamInfo& stream_info) const override {
+        return stream_info.codec_name == "pooltest";
+    }
+};
+
+bool PooledTestCodec::s_reusable = true;
+bool PooledTestCodec::s_reset_succeeds = true;
+int PooledTestCodec::s_resets = 0;
+
+StreamInfo testStream(uint32_t sample_rate = 44100, uint16_t channels = 2)
+{
+    StreamInfo info;
+    info.codec_type = "audio";
+    info.codec_name = "pooltest";
+    info.sample_rate = sample_rate;
+    info.channels = channels;
+    info.bits_per_sample = 16;
+    return info;
+}
+
+// A fresh pool state for each test
+void resetPool()
+{
+    static bool registered = false;
+    if (!registered) {
+        AudioCodecFactory::registerCodec("pooltest", [](const StreamInfo& info) {
+            return std::unique_ptr<AudioCodec>(std::make_unique<PooledTestCodec>(info));
+        });
+        MiniMP3CodecSupport::registerCodec();
+        registered = true;
+    }
+    PooledTestCodec::s_reusable = true;
+    PooledTestCodec::s_reset_succeeds = true;
+    PooledTestCodec::s_resets = 0;
+    CodecPool::getInstance().setCapacity(4);
+    CodecPool::getInstance().clear();
+}
+
+// Silent mono 44.1 kHz MPEG-1 Layer III frame at 32 kbps
+std::vector<uint8_t> silentLayer3Frame()
+{
+    std::vector<uint8_t> frame(104, 0);
+    frame[0] = 0xFF;
+    frame[1] = 0xFB;
+    frame[2] = 0x10;
+    frame[3] = 0xC0;
+    return frame;
+}
+
+} // namespace
+
+void test_reuse_matching_stream()
+{
+    resetPool();
+    CodecPool& pool = CodecPool::getInstance();
+    const CodecPool::PoolStats before = pool.getStats();
+
+    auto first = pool.acquire(testStream());
+    ASSERT_TRUE(first != nullptr, "Codec constructed");
+    first->setFloatOutput(true);
+    AudioCodec* const instance = first.get();
+    pool.release(std::move(first));
+    ASSERT_EQUALS(static_cast<size_t>(1), pool.getStats().idle, "Released codec waits idle");
+
+    StreamInfo next = testStream();
+    next.duration_samples = 12345;
+    auto second = pool.acquire(next);
+    ASSERT_TRUE(second.get() == instance, "Same instance handed out again");
+    ASSERT_EQUALS(1, PooledTestCodec::s_resets, "Reset for the new stream");
+    ASSERT_EQUALS(static_cast<uint64_t>(12345), second->getStreamInfo().duration_samples, "Takes the new stream");
+    ASSERT_TRUE(!second->wantsFloatOutput(), "Output format back to the default");
+
+    const CodecPool::PoolStats after = pool.getStats();
+    ASSERT_EQUALS(before.acquisitions + 2, after.acquisitions, "Two acquisitions");
+    ASSERT_EQUALS(before.constructions + 1, after.constructions, "One construction");
+    ASSERT_EQUALS(before.reuses + 1, after.reuses, "One reuse");
+    ASSERT_EQUALS(static_cast<size_t>(0), after.idle, "Nothing idle");
+    ASSERT_TRUE(after.reuse_rate > 0.0 && after.reuse_rate <= 1.0, "Reuse rate reported");
+}
+
+void test_no_reuse_across_parameters()
+{
+    resetPool();
+    CodecPool& pool = CodecPool::getInstance();
+
+    auto codec = pool.acquire(testStream(44100, 2));
+    AudioCodec* const instance = codec.get();
+    pool.release(std::move(codec));
+
+    auto other_rate = pool.acquire(testStream(48000, 2));
+    ASSERT_TRUE(other_rate.get() != instance, "Sample rate must match");
+    auto other_channels = pool.acquire(testStream(44100, 1));
+    ASSERT_TRUE(other_channels.get() != instance, "Channels must match");
+    ASSERT_EQUALS(0, PooledTestCodec::s_resets, "Idle codec untouched");
+    ASSERT_EQUALS(static_cast<size_t>(1), pool.getStats().idle, "Idle codec still pooled");
+}
+
+void test_unreusable_codecs()
+{
+    resetPool();
+    CodecPool& pool = CodecPool::getInstance();
+
+    PooledTestCodec::s_reusable = false;
+    pool.release(pool.acquire(testStream()));
+    ASSERT_EQUALS(static_cast<size_t>(0), pool.getStats().idle, "Codec without reuse support is destroyed");
+
+    // A failed reset falls back to a new codec
+    PooledTestCodec::s_reusable = true;
+    PooledTestCodec::s_reset_succeeds = false;
+    auto codec = pool.acquire(testStream());
+    pool.release(std::move(codec));
+    const uint64_t reuses = pool.getStats().reuses;
+    auto fallback = pool.acquire(testStream());
+    ASSERT_TRUE(fallback != nullptr, "New codec after a failed reset");
+    ASSERT_EQUALS(1, PooledTestCodec::s_resets, "Reset was attempted");
+    ASSERT_EQUALS(reuses, pool.getStats().reuses, "Not counted as a reuse");
+    ASSERT_EQUALS(static_cast<size_t>(0), pool.getStats().idle, "Failed codec discarded");
+
+    StreamInfo unknown = testStream();
+    unknown.codec_name = "no-such-codec";
+    ASSERT_TRUE(pool.acquire(unknown) == nullptr, "Unknown codec yields nothing");
+}
+
+void test_capacity()
+{
+    resetPool();
+    CodecPool& pool = CodecPool::getInstance();
+
+    pool.setCapacity(2);
+    std::vector<std::unique_ptr<AudioCodec>> codecs;
+    for (uint32_t rate : {8000u, 16000u, 32000u}) {
+        codecs.push_back(pool.acquire(testStream(rate)));
+    }
+    for (auto& codec : codecs) {
+        pool.release(std::move(codec));
+    }
+    ASSERT_EQUALS(static_cast<size_t>(2), pool.getStats().idle, "Capacity bounds the idle codecs");
+
+    // The least recently released went first
+    auto oldest = pool.acquire(testStream(8000));
+    ASSERT_EQUALS(0, PooledTestCodec::s_resets, "Oldest codec was evicted");
+    auto newest = pool.acquire(testStream(32000));
+    ASSERT_EQUALS(1, PooledTestCodec::s_resets, "Newest codec kept");
+
+    pool.setCapacity(0);
+    ASSERT_EQUALS(static_cast<size_t>(0), pool.getStats().idle, "Zero capacity empties the pool");
+    pool.release(std::move(newest));
+    ASSERT_EQUALS(static_cast<size_t>(0), pool.getStats().idle, "Zero capacity disables pooling");
+}
+
+// A reused decoder decodes exactly like a new one
+void test_minimp3_reuse()
+{
+    resetPool();
+    CodecPool& pool = CodecPool::getInstance();
+    StreamInfo info;
+    info.codec_type = "audio";
+    info.codec_name = "mp3";
+    info.sample_rate = 44100;
+    info.channels = 1;
+
+    MediaChunk chunk;
+    chunk.data = silentLayer3Frame();
+    auto codec = pool.acquire(info);
+    ASSERT_TRUE(codec != nullptr, "MP3 codec constructed");
+    ASSERT_TRUE(codec->supportsReuse(), "MP3 codec is reusable");
+    for (int i = 0; i < 3; ++i) {
+        codec->decode(chunk);
+    }
+    AudioCodec* const instance = codec.get();
+    pool.release(std::move(codec));
+
+    auto reused = pool.acquire(info);
+    ASSERT_TRUE(reused.get() == instance, "MP3 codec reused");
+    MiniMP3Codec fresh(info);
+    ASSERT_TRUE(fresh.initialize(), "Reference initializes");
+    for (int i = 0; i < 3; ++i) {
+        const AudioFrame expected = fresh.decode(chunk);
+        const AudioFrame actual = reused->decode(chunk);
+        ASSERT_TRUE(actual.samples == expected.samples, "Reused codec matches a new one");
+        ASSERT_EQUALS(expected.sample_rate, actual.sample_rate, "Same sample rate");
+    }
+    pool.clear();
+}
+
+int main()
+{
+    TestSuite suite("Codec Pool Tests");
+
+    suite.addTest("Reuse Matching Stream", test_reuse_matching_stream);
+    suite.addTest("No Reuse Across Parameters", test_no_reuse_across_parameters);
+    suite.addTest("Unreusable Codecs", test_unreusable_codecs);
+    suite.addTest("Capacity", test_capacity);
+    suite.addTest("MiniMP3 Reuse", test_minimp3_reuse);
+
+    auto results = suite.runAll();
+    suite.printResults(results);
+    return (suite.getFailureCount(results) == 0) ? 0 : 1;
+}
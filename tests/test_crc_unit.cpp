@@ -0,0 +1,123 @@
+/*
+ * test_crc_unit.cpp - Unit tests for the FLAC CRC-8/CRC-16 utility
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef FINAL_BUILD
+#include "psymp3.h"
+#endif
+#include "test_framework.h"
+#include "core/utility/CRC.h"
+
+#include <vector>
+
+using namespace PsyMP3::Core::Utility;
+using namespace TestFramework;
+
+namespace {
+
+// Bit-at-a-time definitions (RFC 9639 Section 9.1.8 and 9.3)
+uint8_t referenceCRC8(const uint8_t* data, size_t length, uint8_t crc)
+{
+    for (size_t i = 0; i < length; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x07)
+                               : static_cast<uint8_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+uint16_t referenceCRC16(const uint8_t* data, size_t length, uint16_t crc)
+{
+    for (size_t i = 0; i < length; ++i) {
+        crc ^= static_cast<uint16_t>(data[i] << 8);
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x8005)
+                                 : static_cast<uint16_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+std::vector<uint8_t> randomBytes(size_t length)
+{
+    std::vector<uint8_t> bytes(length);
+    uint32_t seed = 0xC0FFEEu + static_cast<uint32_t>(length);
+    for (auto& b : bytes) {
+        seed = seed * 1664525u + 1013904223u;
+        b = static_cast<uint8_t>(seed >> 24);
+    }
+    return bytes;
+}
+
+} // namespace
+
+// Check values for "123456789" (CRC-8/SMBUS and CRC-16/UMTS)
+void test_check_values()
+{
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    ASSERT_EQUALS(0xF4, static_cast<int>(CRC::crc8(check, sizeof(check))), "CRC-8 check value");
+    ASSERT_EQUALS(0xFEE8, static_cast<int>(CRC::crc16(check, sizeof(check))), "CRC-16 check value");
+}
+
+// Every implementation matches the bitwise definition at every length
+// around the slice and fold boundaries, with and without a running CRC
+void test_implementations_match_reference()
+{
+    const bool clmul = CRC::hasCarrylessMultiply();
+    for (size_t length = 0; length <= 300; ++length) {
+        const std::vector<uint8_t> data = randomBytes(length);
+        for (uint16_t initial : {0x0000, 0x8005, 0xFFFF}) {
+            const uint8_t init8 = static_cast<uint8_t>(initial);
+            const uint8_t crc8 = referenceCRC8(data.data(), length, init8);
+            const uint16_t crc16 = referenceCRC16(data.data(), length, initial);
+
+            ASSERT_EQUALS(crc8, CRC::crc8(data.data(), length, init8), "crc8");
+            ASSERT_EQUALS(crc8, CRC::crc8Bytewise(data.data(), length, init8), "crc8Bytewise");
+            ASSERT_EQUALS(crc8, CRC::crc8Slice8(data.data(), length, init8), "crc8Slice8");
+            ASSERT_EQUALS(crc8, CRC::crc8Slice16(data.data(), length, init8), "crc8Slice16");
+            ASSERT_EQUALS(crc16, CRC::crc16(data.data(), length, initial), "crc16");
+            ASSERT_EQUALS(crc16, CRC::crc16Bytewise(data.data(), length, initial), "crc16Bytewise");
+            ASSERT_EQUALS(crc16, CRC::crc16Slice8(data.data(), length, initial), "crc16Slice8");
+            ASSERT_EQUALS(crc16, CRC::crc16Slice16(data.data(), length, initial), "crc16Slice16");
+            if (clmul) {
+                ASSERT_EQUALS(crc8, CRC::crc8Clmul(data.data(), length, init8), "crc8Clmul");
+                ASSERT_EQUALS(crc16, CRC::crc16Clmul(data.data(), length, initial), "crc16Clmul");
+            }
+        }
+    }
+}
+
+// A frame-sized buffer CRCs the same whole or in pieces
+void test_incremental()
+{
+    const std::vector<uint8_t> data = randomBytes(20000);
+    const uint16_t whole = CRC::crc16(data.data(), data.size());
+    ASSERT_EQUALS(referenceCRC16(data.data(), data.size(), 0), whole, "Whole-buffer CRC-16");
+
+    uint16_t pieces = 0;
+    for (size_t offset = 0, step = 1; offset < data.size(); offset += step, step = step * 3 + 1) {
+        const size_t length = std::min(step, data.size() - offset);
+        pieces = CRC::crc16(data.data() + offset, length, pieces);
+    }
+    ASSERT_EQUALS(whole, pieces, "Piecewise CRC-16 matches");
+}
+
+int main()
+{
+    TestSuite suite("CRC Utility Unit Tests");
+
+    suite.addTest("Check Values", test_check_values);
+    suite.addTest("Implementations Match Reference", test_implementations_match_reference);
+    suite.addTest("Incremental", test_incremental);
+
+    auto results = suite.runAll();
+    suite.printResults(results);
+    return (suite.getFailureCount(results) == 0) ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+/*
+ * test_crossfader.cpp - Unit tests for the crossfade gain curves and mixer
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef FINAL_BUILD
+#include "psymp3.h"
+#endif
+#include "test_framework.h"
+
+#include <cmath>
+#include <vector>
+
+using PsyMP3::DSP::Crossfader;
+using namespace TestFramework;
+
+namespace {
+
+bool near(double a, double b, double tol = 1e-5)
+{
+    return std::fabs(a - b) <= tol;
+}
+
+} // namespace
+
+static void testCurveEndpoints()
+{
+    for (auto curve : {Crossfader::Curve::Linear, Crossfader::Curve::EqualPower}) {
+        float gi = 0, go = 0;
+        Crossfader::gains(curve, 0.0, gi, go);
+        ASSERT_TRUE(near(gi, 0.0) && near(go, 1.0), "fade starts on the outgoing track");
+        Crossfader::gains(curve, 1.0, gi, go);
+        ASSERT_TRUE(near(gi, 1.0) && near(go, 0.0), "fade ends on the incoming track");
+        Crossfader::gains(curve, 2.0, gi, go);
+        ASSERT_TRUE(near(gi, 1.0) && near(go, 0.0), "progress is clamped");
+    }
+}
+
+static void testCurveSums()
+{
+    for (int i = 0; i <= 100; ++i) {
+        const double t = i / 100.0;
+        float gi = 0, go = 0;
+        Crossfader::gains(Crossfader::Curve::Linear, t, gi, go);
+        ASSERT_TRUE(near(gi + go, 1.0), "linear keeps constant amplitude");
+        Crossfader::gains(Crossfader::Curve::EqualPower, t, gi, go);
+        ASSERT_TRUE(near(gi * gi + go * go, 1.0), "equal power keeps constant power");
+    }
+}
+
+static void testMixMatchesCurve()
+{
+    // DC inputs make every output sample equal to the gains at its frame.
+    constexpr uint64_t kTotal = 1000;
+    for (int channels : {1, 2, 6, 8}) {
+        for (auto curve : {Crossfader::Curve::Linear, Crossfader::Curve::EqualPower}) {
+            const size_t frames = 1200; // runs past the end of the fade
+            std::vector<float> in(frames * channels, 1.0f);
+            std::vector<float> out(frames * channels, 0.5f);
+            std::vector<float> dst(frames * channels);
+            // Odd block sizes, so the mixer's internal blocks straddle calls.
+            size_t pos = 0;
+            for (size_t n : {37u, 200u, 1u, 500u, 462u}) {
+                Crossfader::mix(dst.data() + pos * channels, in.data() + pos * channels,
+                                out.data() + pos * channels, n, channels, curve, pos, kTotal);
+                pos += n;
+            }
+            bool ok = true;
+            for (size_t f = 0; f < frames && ok; ++f) {
+                float gi = 0, go = 0;
+                Crossfader::gains(curve, static_cast<double>(f) / kTotal, gi, go);
+                const double expected = f >= kTotal ? 1.0 : gi * 1.0 + go * 0.5;
+                for (int c = 0; c < channels; ++c) {
+                    ok = ok && near(dst[f * channels + c], expected, 1e-5);
+                }
+            }
+            ASSERT_TRUE(ok, std::string(Crossfader::curveName(curve)) + " mix follows its curve at " +
+                            std::to_string(channels) + " ch");
+        }
+    }
+}
+
+static void testMixInPlace()
+{
+    std::vector<float> in = {1.0f, -1.0f, 1.0f, -1.0f};
+    const std::vector<float> out = {0.0f, 0.0f, 0.0f, 0.0f};
+    Crossfader::mix(in.data(), in.data(), out.data(), 2, 2, Crossfader::Curve::Linear, 1, 2);
+    ASSERT_TRUE(near(in[0], 0.5) && near(in[1], -0.5) && near(in[2], 1.0) && near(in[3], -1.0),
+                "dst may alias the incoming buffer");
+}
+
+int main()
+{
+    TestSuite suite("Crossfader Unit Tests");
+
+    suite.addTest("Curve endpoints", testCurveEndpoints);
+    suite.addTest("Curve sums", testCurveSums);
+    suite.addTest("Mix follows the curve", testMixMatchesCurve);
+    suite.addTest("Mix in place", testMixInPlace);
+
+    auto results = suite.runAll();
+    suite.printResults(results);
+
+    return suite.getFailureCount(results) > 0 ? 1 : 0;
+}
@@ -0,0 +1,193 @@
+/*
+ * test_equalizer_benchmark.cpp - Accuracy and per-frame cost of the equalizer
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef FINAL_BUILD
+#include "psymp3.h"
+#endif
+#include "test_framework.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using PsyMP3::DSP::Equalizer;
+using namespace TestFramework;
+
+namespace {
+
+constexpr int kRate = 48000;
+constexpr size_t kCallbackFrames = 1024; // a typical SDL callback at 48 kHz
+const float kGainsDb[Equalizer::kNumBands] = {6.0f, -3.0f, 4.5f, -6.0f, 3.0f, -4.5f, 9.0f};
+
+// The per-sample double-precision cascade the block/SIMD implementation
+// replaced, with volume applied as a separate pass: the accuracy reference
+// and the speed baseline.
+class ReferenceEq {
+public:
+    explicit ReferenceEq(int channels) : m_channels(channels)
+    {
+        for (int b = 0; b < Equalizer::kNumBands; ++b) {
+            const double A = std::pow(10.0, kGainsDb[b] / 40.0);
+            const double w0 = 2.0 * M_PI * Equalizer::bandFrequency(b) / kRate;
+            const double alpha = std::sin(w0) / 2.0;
+            const double a0 = 1.0 + alpha / A;
+            m_k[b][0] = (1.0 + alpha * A) / a0;
+            m_k[b][1] = -2.0 * std::cos(w0) / a0;
+            m_k[b][2] = (1.0 - alpha * A) / a0;
+            m_k[b][3] = -2.0 * std::cos(w0) / a0;
+            m_k[b][4] = (1.0 - alpha / A) / a0;
+        }
+    }
+
+    void process(float* samples, size_t frames, float volume)
+    {
+        for (size_t i = 0; i < frames * m_channels; ++i) samples[i] *= volume;
+        for (size_t f = 0; f < frames; ++f) {
+            for (int c = 0; c < m_channels; ++c) {
+                double s = samples[f * m_channels + c];
+                for (int b = 0; b < Equalizer::kNumBands; ++b) {
+                    const double* k = m_k[b];
+                    const double y = k[0] * s + m_z1[c][b];
+                    m_z1[c][b] = k[1] * s - k[3] * y + m_z2[c][b];
+                    m_z2[c][b] = k[2] * s - k[4] * y;
+                    s = y;
+                }
+                samples[f * m_channels + c] = static_cast<float>(s);
+            }
+        }
+    }
+
+private:
+    int m_channels;
+    double m_k[Equalizer::kNumBands][5];
+    double m_z1[8][Equalizer::kNumBands] = {};
+    double m_z2[8][Equalizer::kNumBands] = {};
+};
+
+void configureEq(Equalizer& eq, int channels)
+{
+    eq.configure(kRate, channels);
+    for (int b = 0; b < Equalizer::kNumBands; ++b) eq.setBandGain(b, kGainsDb[b]);
+    eq.setEnabled(true);
+}
+
+// Band-limited noise plus a low tone, at roughly -12 dBFS.
+std::vector<float> makeSignal(size_t frames, int channels)
+{
+    std::vector<float> pcm(frames * channels);
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(-0.15f, 0.15f);
+    for (size_t f = 0; f < frames; ++f) {
+        for (int c = 0; c < channels; ++c) {
+            pcm[f * channels + c] = dist(rng) +
+                0.1f * static_cast<float>(std::sin(2.0 * M_PI * (55.0 + 10 * c) * f / kRate));
+        }
+    }
+    return pcm;
+}
+
+template<typename Fn>
+double nsPerFrame(std::vector<float> pcm, int channels, Fn&& process)
+{
+    const size_t frames = pcm.size() / channels;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t pos = 0; pos + kCallbackFrames <= frames; pos += kCallbackFrames) {
+        process(pcm.data() + pos * channels, kCallbackFrames);
+    }
+    const double elapsed = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start).count();
+    return elapsed / (frames / kCallbackFrames * kCallbackFrames);
+}
+
+void checkAccuracy(int channels)
+{
+    const auto signal = makeSignal(kRate * 2, channels);
+    std::vector<float> ours = signal;
+    std::vector<float> ref = signal;
+    Equalizer eq;
+    configureEq(eq, channels);
+    ReferenceEq reference(channels);
+    for (size_t pos = 0; pos < ours.size(); pos += kCallbackFrames * channels) {
+        const size_t n = std::min(kCallbackFrames, (ours.size() - pos) / channels);
+        eq.process(ours.data() + pos, n, channels, 0.7f);
+        reference.process(ref.data() + pos, n, 0.7f);
+    }
+    double err = 0.0, peak = 0.0;
+    for (size_t i = 0; i < ours.size(); ++i) {
+        err = std::max(err, std::fabs(static_cast<double>(ours[i]) - ref[i]));
+        peak = std::max(peak, std::fabs(static_cast<double>(ref[i])));
+    }
+    const double err_db = 20.0 * std::log10(std::max(err, 1e-30) / peak);
+    std::cout << "    " << channels << " ch: max error " << err_db << " dB re peak" << std::endl;
+    // Intermediate float rounding in the upper bands; 16-bit PCM resolves
+    // about -96 dB.
+    ASSERT_TRUE(err_db < -90.0, "float bands stay at the 16-bit noise floor or below");
+}
+
+void benchmark(int channels)
+{
+    const auto signal = makeSignal(kRate * 10, channels);
+    Equalizer eq;
+    configureEq(eq, channels);
+    ReferenceEq reference(channels);
+    const double ours = nsPerFrame(signal, channels, [&](float* p, size_t n) { eq.process(p, n, channels, 0.7f); });
+    const double ref = nsPerFrame(signal, channels, [&](float* p, size_t n) { reference.process(p, n, 0.7f); });
+    std::cout << "    " << channels << " ch: " << ours << " ns/frame (per-sample double cascade: "
+              << ref << " ns/frame, " << ref / ours << "x)" << std::endl;
+    // 20 us per frame would be realtime at 48 kHz; demand two orders below.
+    ASSERT_TRUE(ours < 200.0, "EQ leaves the callback most of its budget");
+}
+
+} // namespace
+
+static void testAccuracyStereo() { checkAccuracy(2); }
+static void testAccuracySurround() { checkAccuracy(8); }
+static void testBenchmarkStereo() { benchmark(2); }
+static void testBenchmarkSurround() { benchmark(8); }
+
+static void testFlatEqAppliesVolumeOnly()
+{
+    Equalizer eq;
+    eq.configure(kRate, 2);
+    eq.setEnabled(true);
+    std::vector<float> pcm = {0.5f, -0.25f, 1.0f, 0.0f};
+    eq.process(pcm.data(), 2, 2, 0.5f);
+    ASSERT_TRUE(pcm[0] == 0.25f && pcm[1] == -0.125f && pcm[2] == 0.5f && pcm[3] == 0.0f,
+                "flat EQ is a pure gain");
+
+    eq.setEnabled(false);
+    eq.setBandGain(0, 6.0f);
+    eq.process(pcm.data(), 2, 2, 2.0f);
+    ASSERT_TRUE(pcm[0] == 0.5f && pcm[2] == 1.0f, "disabled EQ still applies the volume");
+}
+
+static void testPrecisionSplit()
+{
+    ASSERT_TRUE(!Equalizer::bandUsesFloat(0, 44100), "60 Hz keeps double state at 44.1 kHz");
+    ASSERT_TRUE(Equalizer::bandUsesFloat(Equalizer::kNumBands - 1, 44100), "15 kHz runs in float");
+    ASSERT_TRUE(!Equalizer::bandUsesFloat(2, 192000), "400 Hz needs double at 192 kHz");
+}
+
+int main()
+{
+    TestSuite suite("Equalizer Accuracy and Throughput Benchmark");
+
+    suite.addTest("Flat EQ applies volume only", testFlatEqAppliesVolumeOnly);
+    suite.addTest("Band precision split", testPrecisionSplit);
+    suite.addTest("Accuracy vs double reference, stereo", testAccuracyStereo);
+    suite.addTest("Accuracy vs double reference, 7.1", testAccuracySurround);
+    suite.addTest("ns/frame, stereo", testBenchmarkStereo);
+    suite.addTest("ns/frame, 7.1", testBenchmarkSurround);
+
+    auto results = suite.runAll();
+    suite.printResults(results);
+
+    return suite.getFailureCount(results) > 0 ? 1 : 0;
+}
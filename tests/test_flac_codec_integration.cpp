@@ -502,6 +502,115 @@ private:
     }
 };
 
+/**
+ * @brief Test that batch decoding on worker threads matches decode()
+ */
+class FLACCodecBatchDecodeTest : public TestCase {
+public:
+    FLACCodecBatchDecodeTest() : TestCase("FLACCodec Batch Decode Test") {}
+    
+protected:
+    void runTest() override {
+        const std::string path = FLACTestDataUtils::findAvailableTestFile();
+        if (path.empty()) {
+            std::cout << "No FLAC test file available, skipping batch decode test" << std::endl;
+            return;
+        }
+        
+        auto demuxer = std::make_unique<FLACDemuxer>(std::make_unique<FileIOHandler>(path));
+        ASSERT_TRUE(demuxer->parseContainer(), "Should parse FLAC test file");
+        const StreamInfo stream_info = demuxer->getStreams()[0];
+        
+        std::vector<MediaChunk> chunks;
+        while (!demuxer->isEOF()) {
+            auto chunk = demuxer->readChunk();
+            if (!chunk.isValid()) {
+                break;
+            }
+            chunks.push_back(std::move(chunk));
+        }
+        ASSERT_TRUE(chunks.size() > 1, "Test file should have several frames");
+        
+        auto sequential = std::make_unique<FLACCodec>(stream_info);
+        auto batched = std::make_unique<FLACCodec>(stream_info);
+        ASSERT_TRUE(sequential->initialize(), "Sequential codec should initialize");
+        ASSERT_TRUE(batched->initialize(), "Batch codec should initialize");
+        ASSERT_TRUE(batched->supportsParallelDecode(), "FLAC should decode batches in parallel");
+        
+        // Uneven batches, so workers finish out of order
+        size_t index = 0;
+        for (size_t first = 0, size = 1; first < chunks.size(); first += size, size = size * 2 + 1) {
+            const size_t last = std::min(first + size, chunks.size());
+            const std::vector<MediaChunk> batch(chunks.begin() + first, chunks.begin() + last);
+            const auto frames = batched->decodeBatch(batch, 4);
+            ASSERT_EQUALS(batch.size(), frames.size(), "One frame per chunk");
+            for (const auto& frame : frames) {
+                const AudioFrame expected = sequential->decode(chunks[index++]);
+                ASSERT_TRUE(frame.samples == expected.samples, "Batch frame should match decode()");
+                ASSERT_TRUE(frame.float_samples == expected.float_samples, "Batch frame should match decode()");
+            }
+        }
+        ASSERT_EQUALS(sequential->getCurrentSample(), batched->getCurrentSample(),
+                      "Batch decode should advance the sample position alike");
+        ASSERT_EQUALS(sequential->checkMD5Validation(), batched->checkMD5Validation(),
+                      "Batch decode should feed the MD5 signature in order");
+    }
+};
+
+/**
+ * @brief Test that a codec reset for a new stream decodes like a new codec
+ */
+class FLACCodecReuseTest : public TestCase {
+public:
+    FLACCodecReuseTest() : TestCase("FLACCodec Reuse Test") {}
+    
+protected:
+    void runTest() override {
+        const std::string path = FLACTestDataUtils::findAvailableTestFile();
+        if (path.empty()) {
+            std::cout << "No FLAC test file available, skipping reuse test" << std::endl;
+            return;
+        }
+        
+        auto demuxer = std::make_unique<FLACDemuxer>(std::make_unique<FileIOHandler>(path));
+        ASSERT_TRUE(demuxer->parseContainer(), "Should parse FLAC test file");
+        const StreamInfo stream_info = demuxer->getStreams()[0];
+        
+        std::vector<MediaChunk> chunks;
+        while (!demuxer->isEOF()) {
+            auto chunk = demuxer->readChunk();
+            if (!chunk.isValid()) {
+                break;
+            }
+            chunks.push_back(std::move(chunk));
+        }
+        ASSERT_TRUE(chunks.size() > 1, "Test file should have several frames");
+        
+        // Leave the first stream part-way, with batch workers and a seek behind it
+        auto reused = std::make_unique<FLACCodec>(stream_info);
+        ASSERT_TRUE(reused->initialize(), "Codec should initialize");
+        ASSERT_TRUE(reused->supportsReuse(), "FLAC codec should be reusable");
+        const std::vector<MediaChunk> head(chunks.begin(), chunks.begin() + chunks.size() / 2);
+        reused->decodeBatch(head, 4);
+        reused->reset();
+        reused->decode(chunks.back());
+        ASSERT_TRUE(reused->resetForStream(stream_info), "Codec should reset for the next stream");
+        
+        auto fresh = std::make_unique<FLACCodec>(stream_info);
+        ASSERT_TRUE(fresh->initialize(), "Reference codec should initialize");
+        const auto frames = reused->decodeBatch(chunks, 4);
+        ASSERT_EQUALS(chunks.size(), frames.size(), "One frame per chunk");
+        for (size_t i = 0; i < chunks.size(); i++) {
+            const AudioFrame expected = fresh->decode(chunks[i]);
+            ASSERT_TRUE(frames[i].samples == expected.samples, "Reused codec should match a new one");
+        }
+        ASSERT_EQUALS(fresh->getCurrentSample(), reused->getCurrentSample(),
+                      "Reused codec should start from the first sample");
+        ASSERT_EQUALS(fresh->checkMD5Validation(), reused->checkMD5Validation(),
+                      "Reused codec should validate the whole stream again");
+    }
+};
+
 int main() {
     TestSuite suite("FLAC Codec Integration Tests");
     
@@ -510,6 +619,8 @@ int main() {
     suite.addTest(std::make_unique<FLACCodecThreadSafetyTest>());
     suite.addTest(std::make_unique<FLACCodecSeekingTest>());
     suite.addTest(std::make_unique<FLACCodecErrorRecoveryTest>());
+    suite.addTest(std::make_unique<FLACCodecBatchDecodeTest>());
+    suite.addTest(std::make_unique<FLACCodecReuseTest>());
     
     // Run all tests
     auto results = suite.runAll();
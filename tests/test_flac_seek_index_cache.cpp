@@ -0,0 +1,193 @@
+/*
+ * test_flac_seek_index_cache.cpp - Unit tests for the persistent FLAC frame index
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#include "psymp3.h"
+#include "test_framework.h"
+#include "flac_test_data_utils.h"
+
+#include <fstream>
+#include <unistd.h>
+
+using namespace PsyMP3::Demuxer::FLAC;
+using namespace TestFramework;
+
+namespace {
+
+std::string scratchDirectory()
+{
+    return (std::filesystem::temp_directory_path() /
+            ("psymp3-flac-index-test-" + std::to_string(getpid()))).string();
+}
+
+// Fixed 4096-sample frames with a gap and a variable-size run
+std::vector<FLACFrameIndexEntry> sampleIndex()
+{
+    std::vector<FLACFrameIndexEntry> index;
+    uint64_t offset = 8192;
+    uint64_t sample = 0;
+    for (int i = 0; i < 100; ++i) {
+        index.emplace_back(sample, offset, 4096);
+        sample += 4096;
+        offset += 9000 + (i * 37) % 500;
+    }
+    sample += 4096 * 50;
+    offset += 500000;
+    for (uint32_t block : {1152u, 576u, 4608u, 16u, 65535u}) {
+        index.emplace_back(sample, offset, block);
+        sample += block;
+        offset += 3000;
+    }
+    return index;
+}
+
+bool sameIndex(const std::vector<FLACFrameIndexEntry>& a, const std::vector<FLACFrameIndexEntry>& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].sample_offset != b[i].sample_offset || a[i].file_offset != b[i].file_offset ||
+            a[i].block_size != b[i].block_size) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+void test_encoding_round_trip()
+{
+    const auto index = sampleIndex();
+    const auto payload = FLACSeekIndexCache::encodeEntries(index);
+
+    std::vector<FLACFrameIndexEntry> decoded;
+    ASSERT_TRUE(FLACSeekIndexCache::decodeEntries(payload.data(), payload.size(),
+                                                  static_cast<uint32_t>(index.size()), decoded),
+                "Payload decodes");
+    ASSERT_TRUE(sameIndex(index, decoded), "Decoded index matches");
+
+    // Contiguous fixed-size frames take one varint each
+    ASSERT_TRUE(payload.size() < index.size() * 4, "Payload is compact");
+}
+
+void test_decoding_rejects_bad_payloads()
+{
+    const auto index = sampleIndex();
+    const auto payload = FLACSeekIndexCache::encodeEntries(index);
+    const uint32_t count = static_cast<uint32_t>(index.size());
+    std::vector<FLACFrameIndexEntry> decoded;
+
+    ASSERT_TRUE(!FLACSeekIndexCache::decodeEntries(payload.data(), payload.size() - 1, count, decoded),
+                "Truncated payload is rejected");
+    ASSERT_TRUE(!FLACSeekIndexCache::decodeEntries(payload.data(), payload.size(), count - 1, decoded),
+                "Trailing bytes are rejected");
+
+    // A repeated frame position is not an index
+    std::vector<FLACFrameIndexEntry> repeated = {{0, 100, 4096}, {4096, 100, 4096}};
+    const auto bad = FLACSeekIndexCache::encodeEntries(repeated);
+    ASSERT_TRUE(!FLACSeekIndexCache::decodeEntries(bad.data(), bad.size(), 2, decoded),
+                "Non-increasing offsets are rejected");
+}
+
+void test_save_and_load()
+{
+    const std::string directory = scratchDirectory();
+    std::filesystem::create_directories(directory);
+    const std::string source = directory + "/source.flac";
+    {
+        std::ofstream f(source, std::ios::binary);
+        f << std::string(4096, 'x');
+    }
+    const auto index = sampleIndex();
+
+    FLACSeekIndexCache::setDirectory("");
+    ASSERT_TRUE(!FLACSeekIndexCache::save(source, index), "Caching is off without a directory");
+    ASSERT_TRUE(FLACSeekIndexCache::load(source).empty(), "Nothing loads without a directory");
+
+    FLACSeekIndexCache::setDirectory(directory + "/cache");
+    ASSERT_TRUE(FLACSeekIndexCache::save(source, index), "Index saves");
+    ASSERT_TRUE(sameIndex(index, FLACSeekIndexCache::load(source)), "Saved index loads");
+    ASSERT_TRUE(FLACSeekIndexCache::load(directory + "/other.flac").empty(), "Other files miss");
+
+    {
+        std::ofstream f(source, std::ios::binary | std::ios::app);
+        f << 'y';
+    }
+    ASSERT_TRUE(FLACSeekIndexCache::load(source).empty(), "A changed source misses");
+
+    FLACSeekIndexCache::setDirectory("");
+    std::error_code ec;
+    std::filesystem::remove_all(directory, ec);
+}
+
+// A second open of a file seeks through the index the first one saved
+void test_demuxer_reuses_index()
+{
+    const std::string path = FLACTestDataUtils::findAvailableTestFile();
+    if (path.empty()) {
+        std::cout << "No FLAC test file available, skipping demuxer cache test" << std::endl;
+        return;
+    }
+    const std::string directory = scratchDirectory();
+    FLACSeekIndexCache::setDirectory(directory);
+
+    size_t frames = 0;
+    uint64_t duration_ms = 0;
+    {
+        FLACDemuxer demuxer(std::make_unique<FileIOHandler>(path));
+        demuxer.setSourcePath(path);
+        ASSERT_TRUE(demuxer.parseContainer(), "Should parse FLAC test file");
+        duration_ms = demuxer.getDuration();
+        while (!demuxer.isEOF() && demuxer.readChunk().isValid()) {
+            ++frames;
+        }
+    }
+    const auto saved = FLACSeekIndexCache::load(path);
+    ASSERT_EQUALS(frames, saved.size(), "Every frame read is saved");
+
+    {
+        FLACDemuxer demuxer(std::make_unique<FileIOHandler>(path));
+        demuxer.setSourcePath(path);
+        ASSERT_TRUE(demuxer.parseContainer(), "Should parse FLAC test file again");
+        const uint64_t target_ms = duration_ms / 2;
+        ASSERT_TRUE(demuxer.seekTo(target_ms), "Seek succeeds");
+        const MediaChunk chunk = demuxer.readChunk();
+        ASSERT_TRUE(chunk.isValid(), "A frame follows the seek");
+
+        const StreamInfo info = demuxer.getStreams()[0];
+        const uint64_t target = target_ms * info.sample_rate / 1000;
+        bool indexed = false;
+        for (const auto& entry : saved) {
+            if (entry.sample_offset == chunk.timestamp_samples && entry.file_offset == chunk.file_offset) {
+                indexed = entry.sample_offset <= target && target < entry.sample_offset + entry.block_size;
+                break;
+            }
+        }
+        ASSERT_TRUE(indexed, "Seek lands on the indexed frame holding the target");
+    }
+
+    FLACSeekIndexCache::setDirectory("");
+    std::error_code ec;
+    std::filesystem::remove_all(directory, ec);
+}
+
+int main()
+{
+    TestSuite suite("FLAC Seek Index Cache Tests");
+
+    suite.addTest("Encoding Round Trip", test_encoding_round_trip);
+    suite.addTest("Decoding Rejects Bad Payloads", test_decoding_rejects_bad_payloads);
+    suite.addTest("Save And Load", test_save_and_load);
+    suite.addTest("Demuxer Reuses Index", test_demuxer_reuses_index);
+
+    auto results = suite.runAll();
+    suite.printResults(results);
+    return (suite.getFailureCount(results) == 0) ? 0 : 1;
+}
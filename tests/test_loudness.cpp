@@ -0,0 +1,333 @@
+/*
+ * test_loudness.cpp - Unit tests for the loudness meter, cache and scanner
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef FINAL_BUILD
+#include "psymp3.h"
+#endif
+#include "test_framework.h"
+
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using PsyMP3::Core::LoudnessCache;
+using PsyMP3::Core::LoudnessScanner;
+using PsyMP3::DSP::LoudnessMeter;
+using namespace TestFramework;
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+double toDb(double linear)
+{
+    return 20.0 * std::log10(linear);
+}
+
+// A sine (1 kHz unless given) peaking at `dbfs`, on every channel.
+std::vector<float> sine(unsigned int rate, int channels, double seconds, double dbfs,
+                        double freq = 1000.0, double phase = 0.0)
+{
+    const double amp = std::pow(10.0, dbfs / 20.0);
+    const size_t frames = static_cast<size_t>(rate * seconds);
+    std::vector<float> pcm(frames * channels);
+    for (size_t f = 0; f < frames; ++f) {
+        const float v = static_cast<float>(amp * std::sin(2.0 * kPi * freq * f / rate + phase));
+        for (int c = 0; c < channels; ++c) {
+            pcm[f * channels + c] = v;
+        }
+    }
+    return pcm;
+}
+
+double measureLufs(const std::vector<float>& pcm, unsigned int rate, int channels, size_t block = 1000)
+{
+    LoudnessMeter meter;
+    meter.configure(rate, channels);
+    const size_t frames = pcm.size() / channels;
+    for (size_t f = 0; f < frames; f += block) {
+        meter.process(pcm.data() + f * channels, std::min(block, frames - f));
+    }
+    return meter.integratedLufs();
+}
+
+// Deterministic noise, `seconds` long, decoded in whatever chunk sizes the
+// reader asks for.
+class NoiseStream : public Stream {
+public:
+    NoiseStream(unsigned int rate, unsigned int channels, double seconds, float level, unsigned int seed)
+        : m_rng(seed), m_dist(0.0f, level)
+    {
+        m_rate = rate;
+        m_channels = static_cast<int>(channels);
+        m_left = static_cast<size_t>(rate * seconds) * channels;
+        m_eof = false;
+    }
+    size_t getData(size_t len, void* buf) override
+    {
+        std::vector<float> tmp(len / sizeof(int16_t));
+        const size_t got = getDataFloat(tmp.size(), tmp.data());
+        auto* out = static_cast<int16_t*>(buf);
+        for (size_t i = 0; i < got; ++i) {
+            out[i] = static_cast<int16_t>(std::clamp(tmp[i], -1.0f, 1.0f) * 32767.0f);
+        }
+        return got * sizeof(int16_t);
+    }
+    size_t getDataFloat(size_t count, float* buf) override
+    {
+        const size_t n = std::min(count, m_left);
+        for (size_t i = 0; i < n; ++i) {
+            buf[i] = m_dist(m_rng);
+        }
+        m_left -= n;
+        m_eof = m_left == 0;
+        return n;
+    }
+    void seekTo(unsigned long) override {}
+    bool eof() override { return m_eof; }
+
+private:
+    std::mt19937 m_rng;
+    std::normal_distribution<float> m_dist;
+    size_t m_left = 0;
+};
+
+std::filesystem::path scratchDir()
+{
+    auto dir = std::filesystem::temp_directory_path() / ("psymp3-loudness-test-" + std::to_string(::getpid()));
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+void writeFile(const std::filesystem::path& path, const std::string& contents)
+{
+    std::ofstream f(path, std::ios::out | std::ios::trunc | std::ios::binary);
+    f << contents;
+}
+
+} // namespace
+
+static void testCalibration()
+{
+    // EBU Tech 3341 case 1: a stereo 1 kHz sine at -23 dBFS reads -23 LUFS,
+    // at any sample rate.
+    for (unsigned int rate : {44100u, 48000u, 96000u}) {
+        const double lufs = measureLufs(sine(rate, 2, 20.0, -23.0), rate, 2);
+        ASSERT_TRUE(std::fabs(lufs + 23.0) < 0.1,
+                    "1 kHz at -23 dBFS reads -23 LUFS at " + std::to_string(rate) + " Hz, got " + std::to_string(lufs));
+    }
+    // Channel energies add: one channel of it is 3 dB quieter.
+    const double mono = measureLufs(sine(48000, 1, 20.0, -23.0), 48000, 1);
+    ASSERT_TRUE(std::fabs(mono + 26.0) < 0.1, "mono reads 3 dB below stereo");
+}
+
+static void testBlockSizeIndependence()
+{
+    const auto pcm = sine(48000, 2, 10.0, -20.0, 440.0);
+    const double a = measureLufs(pcm, 48000, 2, 1);
+    const double b = measureLufs(pcm, 48000, 2, 4096);
+    const double c = measureLufs(pcm, 48000, 2, 4799);
+    ASSERT_TRUE(std::fabs(a - b) < 1e-9 && std::fabs(b - c) < 1e-9, "result does not depend on block sizes");
+}
+
+static void testGating()
+{
+    // Silence is below the absolute gate; appending it must not pull the
+    // integrated loudness down (only the few blocks straddling the end of
+    // the tone count, a few hundredths of a LU).
+    auto pcm = sine(48000, 2, 10.0, -23.0);
+    const double tone_only = measureLufs(pcm, 48000, 2);
+    pcm.resize(pcm.size() * 3, 0.0f);
+    const double with_silence = measureLufs(pcm, 48000, 2);
+    ASSERT_TRUE(std::fabs(tone_only - with_silence) < 0.1, "silence is gated out");
+
+    // A passage 20 dB down is below the relative gate (-10 LU).
+    auto loud = sine(48000, 2, 10.0, -20.0);
+    const auto quiet = sine(48000, 2, 10.0, -40.0);
+    loud.insert(loud.end(), quiet.begin(), quiet.end());
+    ASSERT_TRUE(std::fabs(measureLufs(loud, 48000, 2) + 20.0) < 0.1, "quiet passage is gated out");
+
+    LoudnessMeter meter;
+    meter.configure(48000, 2);
+    std::vector<float> zeros(48000 * 2 * 5, 0.0f);
+    meter.process(zeros.data(), 48000 * 5);
+    ASSERT_EQUALS(LoudnessMeter::kSilenceLufs, meter.integratedLufs(), "digital silence reports the floor");
+}
+
+static void testTruePeak()
+{
+    // fs/4 sampled at 45 degrees: every sample is at 0.707 of the waveform
+    // peak, which only the oversampled reading sees.
+    LoudnessMeter meter;
+    meter.configure(48000, 1);
+    const auto pcm = sine(48000, 1, 1.0, 0.0, 12000.0, kPi / 4.0);
+    meter.process(pcm.data(), pcm.size());
+    ASSERT_TRUE(std::fabs(toDb(meter.samplePeak()) + 3.01) < 0.05, "sample peak misses the crest");
+    ASSERT_TRUE(std::fabs(toDb(meter.truePeak())) < 0.3, "true peak finds the inter-sample crest");
+    ASSERT_TRUE(meter.truePeak() >= meter.samplePeak(), "true peak is never below sample peak");
+}
+
+static void testChannelWeights()
+{
+    ASSERT_EQUALS(1.0, LoudnessMeter::channelWeight(0, 2), "stereo fronts are unweighted");
+    ASSERT_EQUALS(0.0, LoudnessMeter::channelWeight(3, 6), "5.1 LFE is excluded");
+    ASSERT_EQUALS(1.41, LoudnessMeter::channelWeight(4, 6), "5.1 surrounds are boosted");
+}
+
+static void testPlaybackGain()
+{
+    LoudnessCache::Entry entry;
+    entry.integrated_lufs = -24.0;
+    entry.true_peak = 0.25;
+    ASSERT_TRUE(std::fabs(toDb(LoudnessCache::playbackGain(entry)) - 6.0) < 1e-3, "quiet track is raised to -18 LUFS");
+    entry.true_peak = 0.9;
+    ASSERT_TRUE(std::fabs(LoudnessCache::playbackGain(entry) - 1.0 / 0.9) < 1e-5, "gain is limited by the true peak");
+    entry.integrated_lufs = -8.0;
+    ASSERT_TRUE(std::fabs(toDb(LoudnessCache::playbackGain(entry)) + 10.0) < 1e-3, "loud track is lowered");
+}
+
+static void testCacheRoundTrip()
+{
+    const auto dir = scratchDir();
+    const auto track = dir / "track one.flac";
+    writeFile(track, "audio");
+    const std::string cache_path = (dir / "cache.txt").string();
+
+    LoudnessCache::Entry entry;
+    entry.integrated_lufs = -14.25;
+    entry.true_peak = 0.97;
+    {
+        LoudnessCache cache(cache_path);
+        ASSERT_EQUALS(size_t(0), cache.load(), "missing cache file loads empty");
+        ASSERT_TRUE(cache.store(track.string(), entry), "stores a measured file");
+        ASSERT_TRUE(!cache.store((dir / "missing.flac").string(), entry), "cannot store a missing file");
+        ASSERT_TRUE(cache.save(), "saves");
+    }
+    LoudnessCache cache(cache_path);
+    ASSERT_EQUALS(size_t(1), cache.load(), "reloads the entry");
+    auto hit = cache.lookup(track.string());
+    ASSERT_TRUE(hit && hit->integrated_lufs == entry.integrated_lufs && hit->true_peak == entry.true_peak,
+                "entry survives a round trip exactly");
+
+    // Same size, new mtime: a re-tagged or re-encoded file is re-measured.
+    std::filesystem::last_write_time(track, std::filesystem::last_write_time(track) + std::chrono::seconds(5));
+    ASSERT_TRUE(!cache.lookup(track.string()), "modified file misses");
+    ASSERT_TRUE(cache.store(track.string(), entry), "re-measured file is stored");
+    writeFile(track, "longer audio");
+    ASSERT_TRUE(!cache.lookup(track.string()), "resized file misses");
+
+    writeFile(cache_path, "not a cache\n");
+    ASSERT_EQUALS(size_t(0), cache.load(), "foreign file is ignored");
+    std::filesystem::remove_all(dir);
+}
+
+static void testScannerParallel()
+{
+    // Real files so the cache can stat them; their contents are irrelevant,
+    // the factory synthesizes a stream per path.
+    const auto dir = scratchDir();
+    std::vector<std::string> paths;
+    for (int i = 0; i < 8; ++i) {
+        const auto path = dir / ("track" + std::to_string(i) + ".wav");
+        writeFile(path, std::to_string(i));
+        paths.push_back(path.string());
+    }
+    auto factory = [](const std::string& path) -> std::unique_ptr<Stream> {
+        const unsigned int index = static_cast<unsigned int>(path[path.size() - 5] - '0');
+        return std::make_unique<NoiseStream>(48000, 2, 30.0, 0.02f * (index + 1), index);
+    };
+
+    auto scan = [&](unsigned int threads, std::vector<LoudnessCache::Entry>& results) {
+        const std::string cache_path = (dir / ("cache" + std::to_string(threads) + ".txt")).string();
+        LoudnessCache cache(cache_path);
+        const auto start = std::chrono::steady_clock::now();
+        {
+            LoudnessScanner scanner(cache, factory, threads);
+            ASSERT_EQUALS(paths.size(), scanner.enqueue(paths), "all files are queued");
+            ASSERT_EQUALS(size_t(0), scanner.enqueue(paths), "queued files are not queued twice");
+            scanner.waitIdle();
+            const auto progress = scanner.progress();
+            ASSERT_TRUE(progress.idle && progress.done == paths.size() && progress.failed == 0,
+                        "every file is measured");
+            ASSERT_EQUALS(size_t(0), scanner.enqueue(paths), "measured files are skipped");
+        }
+        const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        for (const auto& path : paths) {
+            auto entry = cache.lookup(path);
+            ASSERT_TRUE(entry.has_value(), "result is cached");
+            results.push_back(entry.value_or(LoudnessCache::Entry{}));
+        }
+        LoudnessCache reloaded(cache_path);
+        ASSERT_EQUALS(paths.size(), reloaded.load(), "scanner saved the cache when idle");
+        return secs;
+    };
+
+    std::vector<LoudnessCache::Entry> serial, parallel;
+    const double t1 = scan(1, serial);
+    const double tn = scan(4, parallel);
+    std::cout << "  8 tracks x 30 s: 1 thread " << t1 << " s, 4 threads " << tn
+              << " s (" << t1 / tn << "x)" << std::endl;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        ASSERT_TRUE(serial[i].integrated_lufs == parallel[i].integrated_lufs &&
+                    serial[i].true_peak == parallel[i].true_peak,
+                    "thread count does not change results");
+    }
+    // Louder noise measures louder: 20*log10((i+2)/(i+1)) LU apart.
+    for (size_t i = 1; i < paths.size(); ++i) {
+        const double expected = toDb(static_cast<double>(i + 1) / i);
+        ASSERT_TRUE(std::fabs(serial[i].integrated_lufs - serial[i - 1].integrated_lufs - expected) < 0.05,
+                    "level steps are measured");
+    }
+    std::filesystem::remove_all(dir);
+}
+
+static void testScannerCancel()
+{
+    const auto dir = scratchDir();
+    std::vector<std::string> paths;
+    for (int i = 0; i < 4; ++i) {
+        const auto path = dir / ("long" + std::to_string(i) + ".wav");
+        writeFile(path, "x");
+        paths.push_back(path.string());
+    }
+    LoudnessCache cache((dir / "cache.txt").string());
+    LoudnessScanner scanner(cache, [](const std::string&) -> std::unique_ptr<Stream> {
+        return std::make_unique<NoiseStream>(48000, 2, 3600.0, 0.1f, 1);
+    }, 2);
+    scanner.enqueue(paths);
+    scanner.cancel();
+    scanner.waitIdle();
+    ASSERT_EQUALS(size_t(0), cache.size(), "cancelled scans store nothing");
+    ASSERT_EQUALS(size_t(0), scanner.enqueue({"http://example.com/stream.mp3"}), "network streams are not scanned");
+    std::filesystem::remove_all(dir);
+}
+
+int main()
+{
+    TestSuite suite("Loudness Unit Tests");
+
+    suite.addTest("Calibration", testCalibration);
+    suite.addTest("Block size independence", testBlockSizeIndependence);
+    suite.addTest("Gating", testGating);
+    suite.addTest("True peak", testTruePeak);
+    suite.addTest("Channel weights", testChannelWeights);
+    suite.addTest("Playback gain", testPlaybackGain);
+    suite.addTest("Cache round trip", testCacheRoundTrip);
+    suite.addTest("Scanner parallel", testScannerParallel);
+    suite.addTest("Scanner cancel", testScannerCancel);
+
+    auto results = suite.runAll();
+    suite.printResults(results);
+
+    return suite.getFailureCount(results) > 0 ? 1 : 0;
+}
@@ -0,0 +1,182 @@
+/*
+ * test_mp3_frame_index.cpp - Unit tests for MP3 frame-index seeking and gapless trimming
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#include "psymp3.h"
+#include "test_framework.h"
+
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+
+using namespace PsyMP3::Demuxer::MP3;
+using namespace PsyMP3::Codec::MP3;
+using namespace TestFramework;
+
+namespace {
+
+constexpr uint32_t kSampleRate = 44100;
+constexpr uint32_t kFrameSamples = 1152;
+
+// MPEG-1 Layer III bitrates (kbps) by index
+constexpr uint32_t kBitrates[] = {0, 32, 40, 48, 56, 64, 80, 96, 112, 128};
+
+// A silent mono 44.1 kHz Layer III frame. All side information is zero but
+// main_data_begin, so the frame decodes only with that many bytes of earlier
+// main data in the bit reservoir.
+std::vector<uint8_t> silentFrame(uint8_t bitrate_index, uint16_t main_data_begin)
+{
+    std::vector<uint8_t> frame(144 * kBitrates[bitrate_index] * 1000 / kSampleRate, 0);
+    frame[0] = 0xFF;
+    frame[1] = 0xFB;
+    frame[2] = static_cast<uint8_t>(bitrate_index << 4);
+    frame[3] = 0xC0;
+    frame[4] = static_cast<uint8_t>(main_data_begin >> 1);
+    frame[5] = static_cast<uint8_t>((main_data_begin & 1) << 7);
+    return frame;
+}
+
+// Variable-bitrate frames drawing on as much reservoir as the stream has
+void appendFrames(std::vector<uint8_t>& file, size_t count)
+{
+    uint32_t reservoir = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const auto frame = silentFrame(static_cast<uint8_t>(1 + (i * 7) % 5),
+                                       static_cast<uint16_t>(std::min<uint32_t>(reservoir, 511)));
+        reservoir += static_cast<uint32_t>(frame.size()) - 4 - 17;
+        file.insert(file.end(), frame.begin(), frame.end());
+    }
+}
+
+// A 128 kbps Xing frame with a TOC and a LAME tag
+std::vector<uint8_t> xingFrame(uint32_t frames, uint32_t bytes, uint16_t delay, uint16_t padding)
+{
+    std::vector<uint8_t> frame = silentFrame(9, 0);
+    size_t pos = 4 + 17;
+    auto put32 = [&](uint32_t value) {
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            frame[pos++] = static_cast<uint8_t>(value >> shift);
+        }
+    };
+    memcpy(&frame[pos], "Xing", 4);
+    pos += 4;
+    put32(0x0F);
+    put32(frames);
+    put32(bytes);
+    for (int i = 0; i < 100; ++i) {
+        frame[pos++] = static_cast<uint8_t>(i * 256 / 100);
+    }
+    put32(0);
+    memcpy(&frame[pos], "LAME3.100", 9);
+    frame[pos + 21] = static_cast<uint8_t>(delay >> 4);
+    frame[pos + 22] = static_cast<uint8_t>(((delay & 0x0F) << 4) | (padding >> 8));
+    frame[pos + 23] = static_cast<uint8_t>(padding);
+    return frame;
+}
+
+std::string writeScratchFile(const std::string& name, const std::vector<uint8_t>& bytes)
+{
+    const std::string path = (std::filesystem::temp_directory_path() /
+                              ("psymp3-mp3-index-" + std::to_string(getpid()) + "-" + name)).string();
+    std::ofstream f(path, std::ios::binary);
+    f.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return path;
+}
+
+std::unique_ptr<MP3NullDemuxer> openDemuxer(const std::string& path)
+{
+    auto demuxer = std::make_unique<MP3NullDemuxer>(std::make_unique<FileIOHandler>(path));
+    demuxer->setSourcePath(path);
+    ASSERT_TRUE(demuxer->parseContainer(), "Should parse synthetic MP3");
+    for (int i = 0; i < 500 && !demuxer->isFrameIndexComplete(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(demuxer->isFrameIndexComplete(), "Frame index completes");
+    return demuxer;
+}
+
+// Sample frames the codec outputs from the current position to the end
+uint64_t decodeToEnd(MP3NullDemuxer& demuxer, MiniMP3Codec& codec)
+{
+    uint64_t samples = 0;
+    while (!demuxer.isEOF()) {
+        const MediaChunk chunk = demuxer.readChunk();
+        if (!chunk.isValid()) {
+            break;
+        }
+        samples += codec.decode(chunk).getSampleFrameCount();
+    }
+    return samples;
+}
+
+} // namespace
+
+// Every seek into a VBR stream without a TOC lands on its exact sample
+void test_index_seek_is_sample_exact()
+{
+    std::vector<uint8_t> file;
+    appendFrames(file, 400);
+    const uint64_t total = 400ull * kFrameSamples;
+    const std::string path = writeScratchFile("vbr.mp3", file);
+
+    auto demuxer = openDemuxer(path);
+    ASSERT_EQUALS(total * 1000 / kSampleRate, demuxer->getDuration(), "Duration comes from the index");
+
+    MiniMP3Codec codec(demuxer->getStreams()[0]);
+    ASSERT_TRUE(codec.initialize(), "Codec initializes");
+    for (uint64_t target_ms : {0ull, 1ull, 2500ull, 5000ull, 9999ull}) {
+        ASSERT_TRUE(demuxer->seekTo(target_ms), "Seek succeeds");
+        codec.reset();
+        const uint64_t target = target_ms * kSampleRate / 1000;
+        ASSERT_EQUALS(target, demuxer->getGranulePosition(1), "Seek reports the target sample");
+        ASSERT_EQUALS(total - target, decodeToEnd(*demuxer, codec), "Output starts at the target");
+    }
+
+    unlink(path.c_str());
+}
+
+// LAME encoder delay and padding are trimmed, before and after seeks
+void test_lame_gapless_trim()
+{
+    constexpr uint16_t delay = 576;
+    constexpr uint16_t padding = 1200;
+    std::vector<uint8_t> frames;
+    appendFrames(frames, 300);
+    std::vector<uint8_t> file = xingFrame(300, static_cast<uint32_t>(frames.size()), delay, padding);
+    file.insert(file.end(), frames.begin(), frames.end());
+    const uint64_t total = 300ull * kFrameSamples - delay - padding;
+    const std::string path = writeScratchFile("lame.mp3", file);
+
+    auto demuxer = openDemuxer(path);
+    ASSERT_EQUALS(total, demuxer->getStreams()[0].duration_samples, "Length excludes delay and padding");
+
+    MiniMP3Codec codec(demuxer->getStreams()[0]);
+    ASSERT_TRUE(codec.initialize(), "Codec initializes");
+    ASSERT_EQUALS(total, decodeToEnd(*demuxer, codec), "Full decode is gapless");
+
+    for (uint64_t target_ms : {0ull, 3000ull, 7000ull}) {
+        ASSERT_TRUE(demuxer->seekTo(target_ms), "Seek succeeds");
+        codec.reset();
+        const uint64_t target = target_ms * kSampleRate / 1000;
+        ASSERT_EQUALS(total - target, decodeToEnd(*demuxer, codec), "Output starts at the target");
+    }
+
+    unlink(path.c_str());
+}
+
+int main()
+{
+    TestSuite suite("MP3 Frame Index Tests");
+
+    suite.addTest("Index Seek Is Sample Exact", test_index_seek_is_sample_exact);
+    suite.addTest("LAME Gapless Trim", test_lame_gapless_trim);
+
+    auto results = suite.runAll();
+    suite.printResults(results);
+    return (suite.getFailureCount(results) == 0) ? 0 : 1;
+}
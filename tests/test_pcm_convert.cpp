@@ -0,0 +1,304 @@
+/*
+ * test_pcm_convert.cpp - Unit tests for the PCM and G.711 to int16 conversion kernels
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef FINAL_BUILD
+#include "psymp3.h"
+#endif
+#include "test_framework.h"
+#include "core/utility/PCMConvert.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace PsyMP3::Core::Utility;
+using namespace TestFramework;
+
+namespace {
+
+const PCMLayout kLayouts[] = {
+    PCMLayout::U8,    PCMLayout::S8,    PCMLayout::S16LE, PCMLayout::S16BE,
+    PCMLayout::S24LE, PCMLayout::S24BE, PCMLayout::S32LE, PCMLayout::S32BE,
+    PCMLayout::F32LE, PCMLayout::F32BE, PCMLayout::F64LE, PCMLayout::F64BE,
+};
+
+bool isFloatLayout(PCMLayout layout)
+{
+    return layout == PCMLayout::F32LE || layout == PCMLayout::F32BE ||
+           layout == PCMLayout::F64LE || layout == PCMLayout::F64BE;
+}
+
+bool isBigEndianLayout(PCMLayout layout)
+{
+    return layout == PCMLayout::S16BE || layout == PCMLayout::S24BE || layout == PCMLayout::S32BE ||
+           layout == PCMLayout::F32BE || layout == PCMLayout::F64BE;
+}
+
+uint32_t nextRandom(uint32_t& seed)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return seed;
+}
+
+// Nominal-range floats with out-of-range, boundary and non-finite values mixed in
+double randomFloatSample(uint32_t& seed, bool with_nan)
+{
+    const double specials[] = {0.0, -0.0, 1.0, -1.0, 1.0001, -1.0001, 1.0 / 32767.0, -1.0 / 32767.0,
+                               0.99999, 1e30, -1e30, std::numeric_limits<double>::infinity(),
+                               -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN()};
+    const size_t count = sizeof(specials) / sizeof(specials[0]) - (with_nan ? 0 : 1);
+    const uint32_t r = nextRandom(seed);
+    if ((r >> 28) == 0) {
+        return specials[(r >> 8) % count];
+    }
+    return (static_cast<double>(r >> 8) / 16777216.0 - 0.5) * 2.5;
+}
+
+// Samples in the given layout: random bytes, or random values for float layouts
+std::vector<uint8_t> randomInput(PCMLayout layout, size_t samples, uint32_t seed, bool with_nan = true)
+{
+    const size_t width = PCMConvert::bytesPerSample(layout);
+    std::vector<uint8_t> bytes(samples * width);
+    for (size_t i = 0; i < samples; ++i) {
+        uint8_t* p = bytes.data() + i * width;
+        if (!isFloatLayout(layout)) {
+            for (size_t b = 0; b < width; ++b) {
+                p[b] = static_cast<uint8_t>(nextRandom(seed) >> 24);
+            }
+            continue;
+        }
+        const double value = randomFloatSample(seed, with_nan);
+        if (width == 4) {
+            const float f = static_cast<float>(value);
+            std::memcpy(p, &f, 4);
+        } else {
+            std::memcpy(p, &value, 8);
+        }
+        if (isBigEndianLayout(layout)) {
+            std::reverse(p, p + width);
+        }
+    }
+    return bytes;
+}
+
+// The conversions PCMCodec::convertSamples() did before PCMConvert, for
+// the layouts it handled
+std::vector<int16_t> legacyConvert(PCMLayout layout, const std::vector<uint8_t>& in)
+{
+    const size_t samples = in.size() / PCMConvert::bytesPerSample(layout);
+    const uint8_t* input_ptr = in.data();
+    std::vector<int16_t> out(samples);
+    switch (layout) {
+        case PCMLayout::U8:
+            for (size_t i = 0; i < samples; ++i) {
+                out[i] = static_cast<int16_t>((static_cast<int32_t>(input_ptr[i]) - 128) * 256);
+            }
+            break;
+        case PCMLayout::S16LE:
+            std::memcpy(out.data(), input_ptr, samples * sizeof(int16_t));
+            break;
+        case PCMLayout::S24LE:
+            for (size_t i = 0; i < samples; ++i) {
+                uint32_t raw = (static_cast<uint32_t>(input_ptr[i*3 + 2]) << 16) |
+                               (static_cast<uint32_t>(input_ptr[i*3 + 1]) << 8) |
+                                static_cast<uint32_t>(input_ptr[i*3]);
+                int32_t sample24 = (raw & 0x800000u) ? static_cast<int32_t>(raw | 0xFF000000u)
+                                                     : static_cast<int32_t>(raw);
+                out[i] = static_cast<int16_t>(sample24 >> 8);
+            }
+            break;
+        case PCMLayout::S32LE:
+            for (size_t i = 0; i < samples; ++i) {
+                int32_t sample32;
+                std::memcpy(&sample32, &input_ptr[i*4], sizeof(int32_t));
+                out[i] = static_cast<int16_t>(sample32 >> 16);
+            }
+            break;
+        case PCMLayout::F32LE:
+            for (size_t i = 0; i < samples; ++i) {
+                float sample_float;
+                std::memcpy(&sample_float, &input_ptr[i*4], sizeof(float));
+                sample_float = std::clamp(sample_float, -1.0f, 1.0f);
+                out[i] = static_cast<int16_t>(sample_float * 32767.0f);
+            }
+            break;
+        default:
+            break;
+    }
+    return out;
+}
+
+struct Implementation {
+    PCMConvert::ToInt16Fn toInt16;
+    PCMConvert::LookupToInt16Fn lookupToInt16;
+    const char* name;
+};
+
+std::vector<Implementation> implementations()
+{
+    std::vector<Implementation> impls = {
+        {PCMConvert::toInt16, PCMConvert::lookupToInt16, "dispatched"},
+        {PCMConvert::toInt16SSE2, PCMConvert::lookupToInt16SSE2, "sse2"},
+        {PCMConvert::toInt16NEON, PCMConvert::lookupToInt16NEON, "neon"},
+    };
+    if (SampleConvert::hasAVX2()) {
+        impls.push_back({PCMConvert::toInt16AVX2, PCMConvert::lookupToInt16AVX2, "avx2"});
+    }
+    return impls;
+}
+
+} // namespace
+
+// The scalar reference matches the conversions the PCM codec used to do
+void test_scalar_matches_legacy()
+{
+    for (PCMLayout layout : {PCMLayout::U8, PCMLayout::S16LE, PCMLayout::S24LE, PCMLayout::S32LE,
+                             PCMLayout::F32LE}) {
+        // Casting NaN to an integer was undefined before, so leave it out
+        const std::vector<uint8_t> in = randomInput(layout, 5000, 11, false);
+        std::vector<int16_t> out(5000);
+        PCMConvert::toInt16Scalar(in.data(), out.size(), layout, out.data());
+        ASSERT_TRUE(out == legacyConvert(layout, in), "Scalar matches the legacy conversion");
+    }
+}
+
+void test_conversion_values()
+{
+    int16_t out[4] = {};
+    const uint8_t u8[] = {0x00, 0x80, 0xFF, 0x7F};
+    PCMConvert::toInt16Scalar(u8, 4, PCMLayout::U8, out);
+    ASSERT_EQUALS(-32768, out[0], "U8 minimum");
+    ASSERT_EQUALS(0, out[1], "U8 midpoint");
+    ASSERT_EQUALS(32512, out[2], "U8 maximum");
+    PCMConvert::toInt16Scalar(u8, 4, PCMLayout::S8, out);
+    ASSERT_EQUALS(0, out[0], "S8 zero");
+    ASSERT_EQUALS(-32768, out[1], "S8 minimum");
+    ASSERT_EQUALS(-256, out[2], "S8 minus one");
+
+    const uint8_t s24be[] = {0x12, 0x34, 0x56, 0x80, 0x00, 0x01};
+    PCMConvert::toInt16Scalar(s24be, 2, PCMLayout::S24BE, out);
+    ASSERT_EQUALS(0x1234, out[0], "S24BE keeps the top bytes");
+    ASSERT_EQUALS(-32768, out[1], "S24BE sign");
+
+    const uint8_t s32be[] = {0xFF, 0xFE, 0x12, 0x34};
+    PCMConvert::toInt16Scalar(s32be, 1, PCMLayout::S32BE, out);
+    ASSERT_EQUALS(-2, out[0], "S32BE keeps the top bytes");
+
+    const double doubles[] = {0.5, -2.0, std::numeric_limits<double>::quiet_NaN(), -1.0 / 65534.0};
+    PCMConvert::toInt16Scalar(reinterpret_cast<const uint8_t*>(doubles), 4, PCMLayout::F64LE, out);
+    ASSERT_EQUALS(16383, out[0], "F64 scales by 32767 and truncates");
+    ASSERT_EQUALS(-32767, out[1], "F64 clamps");
+    ASSERT_EQUALS(0, out[2], "NaN is silent");
+    ASSERT_EQUALS(0, out[3], "F64 truncates toward zero");
+
+    const uint8_t f32be[] = {0xBF, 0x00, 0x00, 0x00};
+    PCMConvert::toInt16Scalar(f32be, 1, PCMLayout::F32BE, out);
+    ASSERT_EQUALS(-16383, out[0], "F32BE");
+}
+
+// A big-endian layout reads byte-reversed samples the same as its
+// little-endian twin
+void test_byte_orders()
+{
+    const std::pair<PCMLayout, PCMLayout> twins[] = {
+        {PCMLayout::S16LE, PCMLayout::S16BE}, {PCMLayout::S24LE, PCMLayout::S24BE},
+        {PCMLayout::S32LE, PCMLayout::S32BE}, {PCMLayout::F32LE, PCMLayout::F32BE},
+        {PCMLayout::F64LE, PCMLayout::F64BE},
+    };
+    for (const auto& twin : twins) {
+        const size_t width = PCMConvert::bytesPerSample(twin.first);
+        std::vector<uint8_t> little = randomInput(twin.first, 333, 5);
+        std::vector<uint8_t> big = little;
+        for (size_t i = 0; i < big.size(); i += width) {
+            std::reverse(big.begin() + i, big.begin() + i + width);
+        }
+        std::vector<int16_t> expected(333);
+        std::vector<int16_t> out(333);
+        PCMConvert::toInt16Scalar(little.data(), 333, twin.first, expected.data());
+        PCMConvert::toInt16Scalar(big.data(), 333, twin.second, out.data());
+        ASSERT_TRUE(out == expected, "Byte order");
+    }
+}
+
+// Every implementation matches the scalar reference for every layout,
+// across vector boundaries and from unaligned input
+void test_implementations_match_scalar()
+{
+    const std::vector<Implementation> impls = implementations();
+    for (PCMLayout layout : kLayouts) {
+        const size_t width = PCMConvert::bytesPerSample(layout);
+        for (size_t samples : {0, 1, 7, 8, 9, 15, 16, 17, 18, 31, 32, 33, 47, 100, 1000, 4099}) {
+            // One byte of offset leaves the samples unaligned
+            std::vector<uint8_t> buffer(1 + samples * width);
+            const std::vector<uint8_t> in = randomInput(layout, samples, static_cast<uint32_t>(samples * 7 + width));
+            std::copy(in.begin(), in.end(), buffer.begin() + 1);
+
+            std::vector<int16_t> expected(samples + 1, 0x5555);
+            PCMConvert::toInt16Scalar(buffer.data() + 1, samples, layout, expected.data());
+            ASSERT_EQUALS(0x5555, expected.back(), "Scalar stays in bounds");
+            for (const auto& impl : impls) {
+                std::vector<int16_t> out(samples + 1, 0x5555);
+                impl.toInt16(buffer.data() + 1, samples, layout, out.data());
+                ASSERT_TRUE(out == expected, impl.name);
+            }
+        }
+    }
+}
+
+// Table lookups match, for every code and on both sides of the size where
+// the vector paths start
+void test_lookup_matches_scalar()
+{
+    int16_t alaw[256];
+    int16_t ulaw[256];
+    for (int code = 0; code < 256; ++code) {
+        alaw[code] = G711::alaw2linear(static_cast<uint8_t>(code));
+        ulaw[code] = G711::ulaw2linear(static_cast<uint8_t>(code));
+    }
+
+    const std::vector<Implementation> impls = implementations();
+    for (const int16_t* table : {alaw, ulaw}) {
+        for (size_t samples : {0, 1, 16, 255, 256, 257, 272, 1000, 4099}) {
+            std::vector<uint8_t> in(samples + 1);
+            uint32_t seed = static_cast<uint32_t>(samples);
+            for (size_t i = 0; i < in.size(); ++i) {
+                // Every code appears once in order, then at random
+                in[i] = i < 256 ? static_cast<uint8_t>(i) : static_cast<uint8_t>(nextRandom(seed) >> 24);
+            }
+            std::vector<int16_t> expected(samples + 1, 0x5555);
+            PCMConvert::lookupToInt16Scalar(in.data() + 1, samples, table, expected.data());
+            for (size_t i = 0; i < samples; ++i) {
+                ASSERT_EQUALS(table[in[i + 1]], expected[i], "Scalar lookup");
+            }
+            ASSERT_EQUALS(0x5555, expected.back(), "Scalar stays in bounds");
+            for (const auto& impl : impls) {
+                std::vector<int16_t> out(samples + 1, 0x5555);
+                impl.lookupToInt16(in.data() + 1, samples, table, out.data());
+                ASSERT_TRUE(out == expected, impl.name);
+            }
+        }
+    }
+}
+
+int main()
+{
+    TestSuite suite("PCM Conversion Unit Tests");
+
+    std::cout << "Implementation: " << PCMConvert::implementation() << std::endl;
+    suite.addTest("Scalar Matches Legacy", test_scalar_matches_legacy);
+    suite.addTest("Conversion Values", test_conversion_values);
+    suite.addTest("Byte Orders", test_byte_orders);
+    suite.addTest("Implementations Match Scalar", test_implementations_match_scalar);
+    suite.addTest("Lookup Matches Scalar", test_lookup_matches_scalar);
+
+    auto results = suite.runAll();
+    suite.printResults(results);
+    return (suite.getFailureCount(results) == 0) ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+/*
+ * test_pcm_history.cpp - Unit tests for the decoded-PCM seek history window
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef FINAL_BUILD
+#include "psymp3.h"
+#endif
+#include "test_framework.h"
+
+#include <vector>
+
+using PsyMP3::Core::PcmHistory;
+using namespace TestFramework;
+
+namespace {
+
+// Stereo frames whose left sample is the frame number and right its negation.
+std::vector<float> frames(uint64_t first, size_t count)
+{
+    std::vector<float> out;
+    for (size_t i = 0; i < count; ++i) {
+        out.push_back(static_cast<float>(first + i));
+        out.push_back(-static_cast<float>(first + i));
+    }
+    return out;
+}
+
+void append(PcmHistory& h, uint64_t first, size_t count)
+{
+    const auto data = frames(first, count);
+    h.append(data.data(), data.size());
+}
+
+} // namespace
+
+static void testDisabledByDefault()
+{
+    PcmHistory h;
+    std::vector<float> out;
+    ASSERT_TRUE(!h.enabled(), "no capacity, no history");
+    append(h, 0, 10);
+    ASSERT_TRUE(!h.copyFrom(0, out), "nothing is held while disabled");
+}
+
+static void testWindowBounds()
+{
+    PcmHistory h;
+    h.configure(2, 100);
+    append(h, 0, 60);
+    ASSERT_EQUALS(uint64_t(0), h.beginFrame(), "begins at the first frame");
+    ASSERT_EQUALS(uint64_t(60), h.endFrame(), "ends after the last frame");
+
+    append(h, 60, 70); // wraps
+    ASSERT_EQUALS(uint64_t(30), h.beginFrame(), "oldest frames are overwritten");
+    ASSERT_EQUALS(uint64_t(130), h.endFrame(), "end follows the appends");
+
+    std::vector<float> out;
+    ASSERT_TRUE(!h.copyFrom(29, out), "frame before the window");
+    ASSERT_TRUE(!h.copyFrom(131, out), "frame after the window");
+    ASSERT_TRUE(h.copyFrom(130, out), "the end itself is a valid, empty replay");
+    ASSERT_TRUE(out.empty(), "nothing after the end");
+}
+
+static void testCopyAcrossWrap()
+{
+    PcmHistory h;
+    h.configure(2, 100);
+    append(h, 0, 130);
+    std::vector<float> out;
+    ASSERT_TRUE(h.copyFrom(40, out), "frame inside the window");
+    ASSERT_TRUE(out == frames(40, 90), "replay is the appended audio, in order, across the wrap");
+}
+
+static void testOversizedAppend()
+{
+    PcmHistory h;
+    h.configure(2, 100);
+    append(h, 0, 250);
+    ASSERT_EQUALS(uint64_t(150), h.beginFrame(), "only the newest capacity survives");
+    std::vector<float> out;
+    ASSERT_TRUE(h.copyFrom(150, out), "oldest surviving frame");
+    ASSERT_TRUE(out == frames(150, 100), "contents are the tail of the append");
+}
+
+static void testResetRebases()
+{
+    PcmHistory h;
+    h.configure(2, 100);
+    append(h, 0, 50);
+    h.reset(1000);
+    std::vector<float> out;
+    ASSERT_TRUE(!h.copyFrom(10, out), "audio before a reset is gone");
+    append(h, 1000, 20);
+    ASSERT_EQUALS(uint64_t(1000), h.beginFrame(), "window restarts at the reset frame");
+    ASSERT_TRUE(h.copyFrom(1005, out), "frame after the reset");
+    ASSERT_TRUE(out == frames(1005, 15), "addressed by absolute frame");
+}
+
+static void testReconfigureKeepsNewest()
+{
+    PcmHistory h;
+    h.configure(2, 100);
+    append(h, 0, 90);
+
+    h.configure(2, 30);
+    ASSERT_EQUALS(uint64_t(30), h.capacityFrames(), "shrunk");
+    ASSERT_EQUALS(uint64_t(60), h.beginFrame(), "shrinking keeps the newest frames");
+    ASSERT_EQUALS(uint64_t(90), h.endFrame(), "end is unchanged");
+
+    h.configure(2, 200);
+    append(h, 90, 10);
+    std::vector<float> out;
+    ASSERT_TRUE(h.copyFrom(60, out), "growing keeps what was held");
+    ASSERT_TRUE(out == frames(60, 40), "and appends continue after it");
+
+    h.configure(1, 200);
+    ASSERT_TRUE(!h.copyFrom(60, out), "a channel change drops the contents");
+    h.configure(1, 0);
+    ASSERT_TRUE(!h.enabled(), "zero capacity disables");
+}
+
+int main()
+{
+    TestSuite suite("PcmHistory Unit Tests");
+
+    suite.addTest("Disabled by default", testDisabledByDefault);
+    suite.addTest("Window bounds", testWindowBounds);
+    suite.addTest("Copy across wrap", testCopyAcrossWrap);
+    suite.addTest("Oversized append", testOversizedAppend);
+    suite.addTest("Reset rebases", testResetRebases);
+    suite.addTest("Reconfigure keeps newest", testReconfigureKeepsNewest);
+
+    auto results = suite.runAll();
+    suite.printResults(results);
+
+    return suite.getFailureCount(results) > 0 ? 1 : 0;
+}
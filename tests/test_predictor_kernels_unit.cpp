@@ -0,0 +1,224 @@
+/*
+ * test_predictor_kernels_unit.cpp - Unit tests for FLAC predictor kernels
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ */
+
+#ifndef FINAL_BUILD
+#include "psymp3.h"
+#endif
+
+#include "test_framework.h"
+#include "codecs/flac/PredictorKernels.h"
+
+using namespace PsyMP3::Codec::FLAC;
+using namespace TestFramework;
+
+namespace {
+
+uint32_t g_seed = 0x2468ACE1u;
+
+int32_t randomBits(uint32_t bits) {
+    g_seed = g_seed * 1664525u + 1013904223u;
+    uint64_t wide = (static_cast<uint64_t>(g_seed) << 32) | (g_seed * 2654435761u);
+    int64_t value = static_cast<int64_t>(wide) >> (64 - bits);
+    return static_cast<int32_t>(value);
+}
+
+// Warm-up samples at full bit depth and small residuals, the shape of a
+// real subframe (valid inputs never clamp).
+void makeInput(uint32_t order, uint32_t count, uint32_t bit_depth,
+               std::vector<int64_t>& samples, std::vector<int32_t>& residuals) {
+    samples.assign(order + count, 0);
+    residuals.resize(count);
+    for (uint32_t i = 0; i < order; ++i) {
+        samples[i] = randomBits(bit_depth < 32 ? bit_depth : 32);
+    }
+    for (auto& r : residuals) {
+        r = randomBits(bit_depth > 8 ? bit_depth - 6 : 2);
+    }
+}
+
+} // namespace
+
+// Every specialized LPC kernel matches the reference, with both
+// accumulator widths and across the order/precision/bit-depth space.
+void test_lpc_kernels_match_reference() {
+    for (uint32_t bit_depth : {8u, 16u, 17u, 24u, 25u, 32u, 33u}) {
+        for (uint32_t precision : {4u, 12u, 15u}) {
+            for (uint32_t order = 1; order <= 32; ++order) {
+                std::vector<int32_t> coeffs(order);
+                for (auto& c : coeffs) c = randomBits(precision);
+                const int32_t shift = static_cast<int32_t>(order % 16);
+
+                std::vector<int64_t> expected, actual;
+                std::vector<int32_t> residuals;
+                makeInput(order, 300, bit_depth, expected, residuals);
+                actual = expected;
+
+                applyLPCReference(expected.data(), residuals.data(), coeffs.data(),
+                                  300, order, shift, bit_depth);
+                LPCKernel kernel = selectLPCKernel(order, precision, bit_depth);
+                ASSERT_TRUE(kernel != nullptr, "Kernel selected");
+                kernel(actual.data(), residuals.data(), coeffs.data(), 300, order,
+                       shift, bit_depth);
+                ASSERT_TRUE(expected == actual, "LPC kernel matches reference");
+            }
+        }
+    }
+}
+
+// Every FIXED kernel matches the reference.
+void test_fixed_kernels_match_reference() {
+    for (uint32_t bit_depth : {4u, 16u, 24u, 27u, 28u, 32u, 33u}) {
+        for (uint32_t order = 0; order <= 4; ++order) {
+            std::vector<int64_t> expected, actual;
+            std::vector<int32_t> residuals;
+            makeInput(order, 500, bit_depth, expected, residuals);
+            actual = expected;
+
+            applyFixedReference(expected.data(), residuals.data(), 500, order, bit_depth);
+            FixedKernel kernel = selectFixedKernel(order, bit_depth);
+            ASSERT_TRUE(kernel != nullptr, "Kernel selected");
+            kernel(actual.data(), residuals.data(), 500, order, bit_depth);
+            ASSERT_TRUE(expected == actual, "FIXED kernel matches reference");
+        }
+    }
+}
+
+// Crafted input that drives the prediction out of range clamps exactly as
+// the reference does, with the narrow accumulator in use.
+void test_kernels_clamp_like_reference() {
+    const uint32_t bit_depth = 16;
+    const int32_t coeffs[8] = {2047, 2047, 2047, 2047, -2048, 2047, 2047, 2047};
+    std::vector<int64_t> expected(8 + 64, 32767), actual;
+    std::vector<int32_t> residuals(64, 30000);
+    actual = expected;
+
+    applyLPCReference(expected.data(), residuals.data(), coeffs, 64, 8, 0, bit_depth);
+    selectLPCKernel(8, 12, bit_depth)(actual.data(), residuals.data(), coeffs, 64, 8, 0,
+                                      bit_depth);
+    ASSERT_TRUE(expected == actual, "Clamped LPC output matches reference");
+
+    std::vector<int64_t> fixed_expected(4 + 64, -32768), fixed_actual;
+    fixed_expected[3] = 32767;
+    fixed_actual = fixed_expected;
+    applyFixedReference(fixed_expected.data(), residuals.data(), 64, 4, bit_depth);
+    selectFixedKernel(4, bit_depth)(fixed_actual.data(), residuals.data(), 64, 4, bit_depth);
+    ASSERT_TRUE(fixed_expected == fixed_actual, "Clamped FIXED output matches reference");
+}
+
+// The int32_t-sample kernels match the int64_t reference for every subframe
+// bit depth a 32-bit buffer can hold.
+void test_32bit_kernels_match_reference() {
+    for (uint32_t bit_depth : {8u, 16u, 17u, 24u, 25u, 32u}) {
+        for (uint32_t order = 1; order <= 32; ++order) {
+            std::vector<int32_t> coeffs(order);
+            for (auto& c : coeffs) c = randomBits(14);
+            const int32_t shift = static_cast<int32_t>(order % 16);
+
+            std::vector<int64_t> expected;
+            std::vector<int32_t> residuals;
+            makeInput(order, 300, bit_depth, expected, residuals);
+            std::vector<int32_t> actual(expected.begin(), expected.end());
+
+            applyLPCReference(expected.data(), residuals.data(), coeffs.data(),
+                              300, order, shift, bit_depth);
+            selectLPCKernel32(order, 14, bit_depth)(actual.data(), residuals.data(),
+                                                     coeffs.data(), 300, order,
+                                                     shift, bit_depth);
+            ASSERT_TRUE(std::equal(expected.begin(), expected.end(), actual.begin()),
+                        "32-bit LPC kernel matches reference");
+        }
+        for (uint32_t order = 0; order <= 4; ++order) {
+            std::vector<int64_t> expected;
+            std::vector<int32_t> residuals;
+            makeInput(order, 500, bit_depth, expected, residuals);
+            std::vector<int32_t> actual(expected.begin(), expected.end());
+
+            applyFixedReference(expected.data(), residuals.data(), 500, order, bit_depth);
+            selectFixedKernel32(order, bit_depth)(actual.data(), residuals.data(), 500,
+                                                  order, bit_depth);
+            ASSERT_TRUE(std::equal(expected.begin(), expected.end(), actual.begin()),
+                        "32-bit FIXED kernel matches reference");
+        }
+    }
+}
+
+// Worst-case inputs right at the narrow-accumulator limit: every warm-up
+// sample and coefficient at its most negative value, so each product is the
+// largest positive one. bit_depth + precision + ceil(log2(order)) == 32 is the
+// widest case that still selects the 32-bit accumulator, and the kernels
+// SubframeDecoder uses there must match the 64-bit reference.
+void test_narrow_accumulator_at_boundary() {
+    struct Case { uint32_t bit_depth, precision, order; };
+    const Case cases[] = {{16, 15, 2}, {18, 12, 4}, {17, 12, 8}, {20, 8, 16},
+                          {24, 3, 32}, {21, 9, 3}, {22, 5, 12}};
+    for (const Case& c : cases) {
+        const int64_t sample_min = -(INT64_C(1) << (c.bit_depth - 1));
+        const int32_t coeff_min = -(1 << (c.precision - 1));
+        const std::vector<int32_t> coeffs(c.order, coeff_min);
+        std::vector<int32_t> residuals(64, 0);
+        for (size_t i = 0; i < residuals.size(); i += 2) {
+            residuals[i] = static_cast<int32_t>(sample_min);
+        }
+        for (int32_t shift : {0, 15}) {
+            std::vector<int64_t> expected(c.order + 64, sample_min), actual;
+            actual = expected;
+            std::vector<int32_t> actual32(expected.begin(), expected.end());
+
+            applyLPCReference(expected.data(), residuals.data(), coeffs.data(), 64,
+                              c.order, shift, c.bit_depth);
+            selectLPCKernel(c.order, c.precision, c.bit_depth)(
+                actual.data(), residuals.data(), coeffs.data(), 64, c.order, shift,
+                c.bit_depth);
+            selectLPCKernel32(c.order, c.precision, c.bit_depth)(
+                actual32.data(), residuals.data(), coeffs.data(), 64, c.order, shift,
+                c.bit_depth);
+            ASSERT_TRUE(expected == actual, "LPC kernel matches reference at the 32-bit limit");
+            ASSERT_TRUE(std::equal(expected.begin(), expected.end(), actual32.begin()),
+                        "32-bit LPC kernel matches reference at the 32-bit limit");
+        }
+    }
+
+    // FIXED uses the narrow accumulator up to 27 bits. Alternating extremes
+    // give the largest order-2..4 predictions.
+    const uint32_t bit_depth = 27;
+    const int64_t sample_max = (INT64_C(1) << (bit_depth - 1)) - 1;
+    const int64_t sample_min = -(INT64_C(1) << (bit_depth - 1));
+    for (uint32_t order = 1; order <= 4; ++order) {
+        std::vector<int64_t> expected(order + 64);
+        for (size_t i = 0; i < expected.size(); ++i) {
+            expected[i] = (i % 2) ? sample_max : sample_min;
+        }
+        std::vector<int32_t> residuals(64);
+        for (size_t i = 0; i < residuals.size(); ++i) {
+            residuals[i] = static_cast<int32_t>((i % 2) ? sample_min : sample_max);
+        }
+        std::vector<int64_t> actual = expected;
+        std::vector<int32_t> actual32(expected.begin(), expected.end());
+
+        applyFixedReference(expected.data(), residuals.data(), 64, order, bit_depth);
+        selectFixedKernel(order, bit_depth)(actual.data(), residuals.data(), 64, order,
+                                            bit_depth);
+        selectFixedKernel32(order, bit_depth)(actual32.data(), residuals.data(), 64, order,
+                                              bit_depth);
+        ASSERT_TRUE(expected == actual, "FIXED kernel matches reference at 27 bits");
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(), actual32.begin()),
+                    "32-bit FIXED kernel matches reference at 27 bits");
+    }
+}
+
+int main() {
+    TestSuite suite("FLAC Predictor Kernel Unit Tests");
+
+    suite.addTest("LPC Kernels Match Reference", test_lpc_kernels_match_reference);
+    suite.addTest("FIXED Kernels Match Reference", test_fixed_kernels_match_reference);
+    suite.addTest("Kernels Clamp Like Reference", test_kernels_clamp_like_reference);
+    suite.addTest("32-bit Kernels Match Reference", test_32bit_kernels_match_reference);
+    suite.addTest("Narrow Accumulator At Boundary", test_narrow_accumulator_at_boundary);
+
+    auto results = suite.runAll();
+    suite.printResults(results);
+    return (suite.getFailureCount(results) == 0) ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+/*
+ * test_read_ahead_policy.cpp - Unit tests for the decoder read-ahead policy
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef FINAL_BUILD
+#include "psymp3.h"
+#endif
+#include "test_framework.h"
+
+#include <iostream>
+
+using PsyMP3::Core::ReadAheadPolicy;
+using namespace TestFramework;
+
+namespace {
+
+constexpr uint64_t kMs = 1000000; // ns
+
+// Feed `count` chunks of kChunkMs audio, each costing `cpu_ms` on-CPU and
+// `wall_ms` in total.
+void feedChunks(ReadAheadPolicy& policy, int count, double cpu_ms, double wall_ms)
+{
+    for (int i = 0; i < count; ++i) {
+        policy.recordChunk(ReadAheadPolicy::kChunkMs * kMs,
+                           static_cast<uint64_t>(cpu_ms * kMs),
+                           static_cast<uint64_t>(wall_ms * kMs));
+    }
+}
+
+} // namespace
+
+static void testSourceBounds()
+{
+    const auto local = ReadAheadPolicy::boundsForSource("/music/album/01.flac");
+    const auto file_uri = ReadAheadPolicy::boundsForSource("FILE:///music/01.flac");
+    const auto http = ReadAheadPolicy::boundsForSource("https://radio.example/stream.ogg");
+    ASSERT_EQUALS(ReadAheadPolicy::kLocalBounds.max_ms, local.max_ms, "plain path is local");
+    ASSERT_EQUALS(ReadAheadPolicy::kLocalBounds.max_ms, file_uri.max_ms, "file:// is local");
+    ASSERT_EQUALS(ReadAheadPolicy::kRemoteBounds.max_ms, http.max_ms, "https:// is remote");
+}
+
+static void testChunkIsWholeFramesAndScalesWithChannels()
+{
+    const size_t stereo = ReadAheadPolicy::chunkSamplesFor(48000, 2);
+    const size_t surround = ReadAheadPolicy::chunkSamplesFor(48000, 8);
+    ASSERT_EQUALS(static_cast<size_t>(0), surround % 8, "8-channel chunk is frame-aligned");
+    ASSERT_EQUALS(stereo * 4, surround, "chunk is a fixed duration regardless of channel count");
+}
+
+static void testCheapLocalDecodeSettlesAtMinimum()
+{
+    ReadAheadPolicy policy;
+    policy.configure(48000, 2, ReadAheadPolicy::kLocalBounds);
+    feedChunks(policy, 500, 0.05, 0.06);
+    ASSERT_EQUALS(ReadAheadPolicy::kLocalBounds.min_ms, policy.targetMs(), "PCM-cheap decode keeps the minimum");
+    ASSERT_EQUALS(static_cast<size_t>(48000 * ReadAheadPolicy::kLocalBounds.min_ms / 1000 * 2),
+                  policy.targetSamples(), "target is expressed in whole frames");
+}
+
+static void testExpensiveDecodeGrowsTarget()
+{
+    ReadAheadPolicy policy;
+    policy.configure(48000, 2, ReadAheadPolicy::kLocalBounds);
+    feedChunks(policy, 200, 15.0, 15.5); // 75% of real time
+    std::cout << "    decode cost " << policy.decodeCost() << " -> target "
+              << policy.targetMs() << " ms" << std::endl;
+    ASSERT_TRUE(policy.targetMs() > ReadAheadPolicy::kLocalBounds.min_ms * 2,
+                "a codec near real time gets a deeper queue");
+    ASSERT_TRUE(policy.targetMs() <= ReadAheadPolicy::kLocalBounds.max_ms, "still bounded");
+}
+
+static void testNetworkStallGrowsThenDecays()
+{
+    ReadAheadPolicy policy;
+    policy.configure(44100, 2, ReadAheadPolicy::kRemoteBounds);
+    feedChunks(policy, 10, 1.0, 1.5);
+    const unsigned int calm = policy.targetMs();
+
+    feedChunks(policy, 1, 1.0, 400.0); // one 400 ms HTTP stall
+    const unsigned int stalled = policy.targetMs();
+    std::cout << "    calm " << calm << " ms, after stall " << stalled
+              << " ms (peak stall " << policy.peakStallMs() << " ms)" << std::endl;
+    ASSERT_TRUE(stalled >= 1200, "queue grows to cover several such stalls");
+    ASSERT_TRUE(policy.peakStallMs() > 390.0, "stall is attributed to I/O, not decode");
+
+    // A minute of smooth decoding afterwards: six half-lives.
+    feedChunks(policy, 3000, 1.0, 1.5);
+    ASSERT_EQUALS(calm, policy.targetMs(), "the peak decays once the network recovers");
+}
+
+static void testCeilingCapsLaterStreams()
+{
+    ReadAheadPolicy policy;
+    policy.configure(48000, 2, ReadAheadPolicy::kLocalBounds);
+    policy.setCeiling(policy.bounds().max_ms);
+    policy.configure(48000, 2, ReadAheadPolicy::kRemoteBounds);
+    ASSERT_EQUALS(ReadAheadPolicy::kLocalBounds.max_ms, policy.bounds().max_ms,
+                  "a network stream swapped into a local-sized queue is capped");
+    feedChunks(policy, 1, 1.0, 2000.0);
+    ASSERT_EQUALS(ReadAheadPolicy::kLocalBounds.max_ms, policy.targetMs(), "target never exceeds the ceiling");
+}
+
+static void testDrainRate()
+{
+    ReadAheadPolicy policy;
+    policy.configure(48000, 2, ReadAheadPolicy::kRemoteBounds);
+    feedChunks(policy, 1, 1.0, 60.0);
+    const unsigned int nominal = policy.targetMs();
+
+    // The device consumes twice the nominal rate for a while.
+    uint64_t frames = 0;
+    uint64_t now = 0;
+    for (int i = 0; i < 40; ++i) {
+        policy.recordDrain(frames, now);
+        frames += 9600; // 200 ms of 48 kHz in 100 ms
+        now += 100 * kMs;
+    }
+    std::cout << "    drain ratio " << policy.drainRatio() << std::endl;
+    ASSERT_TRUE(policy.drainRatio() > 1.8, "measured drain rate tracks the device");
+    ASSERT_TRUE(policy.targetMs() > nominal * 3 / 2, "a faster drain deepens the queue");
+
+    // A forward seek jumps the position; it must not register as a drain.
+    const double before = policy.drainRatio();
+    policy.recordDrain(frames + 48000 * 60, now + 100 * kMs);
+    ASSERT_TRUE(policy.drainRatio() == before, "position jumps are ignored");
+
+    // Paused: no frames played.
+    policy.recordDrain(frames + 48000 * 60, now + 300 * kMs);
+    ASSERT_TRUE(policy.drainRatio() == before, "idle spans are ignored");
+}
+
+int main()
+{
+    TestSuite suite("ReadAheadPolicy Unit Tests");
+
+    suite.addTest("Bounds follow the source", testSourceBounds);
+    suite.addTest("Chunk is whole frames of fixed duration", testChunkIsWholeFramesAndScalesWithChannels);
+    suite.addTest("Cheap local decode settles at the minimum", testCheapLocalDecodeSettlesAtMinimum);
+    suite.addTest("Expensive decode grows the target", testExpensiveDecodeGrowsTarget);
+    suite.addTest("Network stall grows then decays", testNetworkStallGrowsThenDecays);
+    suite.addTest("Ceiling caps later streams", testCeilingCapsLaterStreams);
+    suite.addTest("Drain rate is measured", testDrainRate);
+
+    auto results = suite.runAll();
+    suite.printResults(results);
+
+    return suite.getFailureCount(results) > 0 ? 1 : 0;
+}
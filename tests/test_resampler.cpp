@@ -0,0 +1,166 @@
+/*
+ * test_resampler.cpp - Unit tests for the polyphase sample-rate converter
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef FINAL_BUILD
+#include "psymp3.h"
+#endif
+#include "test_framework.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using PsyMP3::DSP::Resampler;
+using namespace TestFramework;
+
+namespace {
+
+constexpr double kTwoPi = 6.283185307179586;
+
+std::vector<int16_t> makeSine(unsigned rate, unsigned channels, double freq,
+                              double amplitude, size_t frames)
+{
+    std::vector<int16_t> pcm(frames * channels);
+    for (size_t i = 0; i < frames; ++i) {
+        const double v = amplitude * std::sin(kTwoPi * freq * static_cast<double>(i) / rate);
+        for (unsigned c = 0; c < channels; ++c) {
+            pcm[i * channels + c] = static_cast<int16_t>(std::lrint(c == 0 ? v : -v));
+        }
+    }
+    return pcm;
+}
+
+std::vector<int16_t> resampleAll(Resampler& rs, const std::vector<int16_t>& in,
+                                 unsigned channels, size_t chunk_frames)
+{
+    std::vector<int16_t> all;
+    std::vector<int16_t> out;
+    const size_t frames = in.size() / channels;
+    for (size_t pos = 0; pos < frames; pos += chunk_frames) {
+        const size_t n = std::min(chunk_frames, frames - pos);
+        rs.process(in.data() + pos * channels, n, out);
+        all.insert(all.end(), out.begin(), out.end());
+    }
+    rs.drain(out);
+    all.insert(all.end(), out.begin(), out.end());
+    return all;
+}
+
+// Largest deviation from an ideal sine at the output rate, ignoring the
+// filter's start-up and tail regions.
+double maxSineError(const std::vector<int16_t>& out, unsigned rate, unsigned channels,
+                    double freq, double amplitude)
+{
+    const size_t frames = out.size() / channels;
+    double worst = 0.0;
+    for (size_t i = 200; i + 200 < frames; ++i) {
+        const double ideal = amplitude * std::sin(kTwoPi * freq * static_cast<double>(i) / rate);
+        worst = std::max(worst, std::fabs(out[i * channels] - ideal));
+        worst = std::max(worst, std::fabs(out[i * channels + 1] + ideal));
+    }
+    return worst;
+}
+
+} // namespace
+
+static void testInactiveIsPassthrough()
+{
+    Resampler rs;
+    rs.configure(48000, 48000, 2);
+    ASSERT_FALSE(rs.isActive(), "equal rates leave the resampler inactive");
+
+    std::vector<int16_t> in = {1, -1, 2, -2, 3, -3};
+    std::vector<int16_t> out;
+    rs.process(in.data(), 3, out);
+    ASSERT_TRUE(out == in, "inactive resampler copies input through");
+}
+
+static void testOutputLength()
+{
+    Resampler rs;
+    rs.configure(44100, 48000, 2);
+    ASSERT_TRUE(rs.isActive(), "44.1k -> 48k is active");
+
+    const size_t in_frames = 44100;
+    const auto in = makeSine(44100, 2, 440.0, 8000.0, in_frames);
+    const auto out = resampleAll(rs, in, 2, 4096);
+    ASSERT_EQUALS(static_cast<size_t>(48000), out.size() / 2,
+                  "one second in produces one second out, tail included");
+}
+
+static void testUpsampledSineIsAccurate()
+{
+    Resampler rs;
+    rs.configure(44100, 48000, 2);
+    const auto in = makeSine(44100, 2, 1000.0, 10000.0, 22050);
+    const auto out = resampleAll(rs, in, 2, 1024);
+    const double err = maxSineError(out, 48000, 2, 1000.0, 10000.0);
+    std::cout << "    44.1k->48k 1 kHz max error: " << err << " LSB" << std::endl;
+    ASSERT_TRUE(err < 4.0, "1 kHz tone survives 44.1k -> 48k (error under 4 LSB of 10000)");
+}
+
+static void testCappedPhaseSineIsAccurate()
+{
+    // 44101 -> 48000 reduces to 48000/44101: far more phases than kMaxPhases.
+    Resampler rs;
+    rs.configure(44101, 48000, 2);
+    const auto in = makeSine(44101, 2, 1000.0, 10000.0, 22050);
+    const auto out = resampleAll(rs, in, 2, 777);
+    const double err = maxSineError(out, 48000, 2, 1000.0, 10000.0);
+    std::cout << "    44.101k->48k 1 kHz max error: " << err << " LSB" << std::endl;
+    ASSERT_TRUE(err < 4.0, "quantized-phase ratio stays accurate");
+}
+
+static void testDownsamplingRejectsAliases()
+{
+    // 23.5 kHz is representable at 48k but above the 22.05 kHz Nyquist of the
+    // output; it must be filtered out rather than fold back to 20.6 kHz.
+    Resampler rs;
+    rs.configure(48000, 44100, 2);
+    const auto in = makeSine(48000, 2, 23500.0, 16000.0, 48000);
+    const auto out = resampleAll(rs, in, 2, 4096);
+
+    double energy = 0.0;
+    size_t count = 0;
+    for (size_t i = 400; i + 400 < out.size(); ++i, ++count) {
+        energy += static_cast<double>(out[i]) * out[i];
+    }
+    const double rms = std::sqrt(energy / count);
+    std::cout << "    48k->44.1k 23.5 kHz residual RMS: " << rms << std::endl;
+    ASSERT_TRUE(rms < 16000.0 * 0.01, "out-of-band tone attenuated by more than 40 dB");
+}
+
+static void testChunkingDoesNotChangeOutput()
+{
+    const auto in = makeSine(44100, 2, 3000.0, 12000.0, 10000);
+    Resampler a;
+    Resampler b;
+    a.configure(44100, 48000, 2);
+    b.configure(44100, 48000, 2);
+    const auto whole = resampleAll(a, in, 2, 10000);
+    const auto split = resampleAll(b, in, 2, 37);
+    ASSERT_TRUE(whole == split, "output is independent of block size");
+}
+
+int main()
+{
+    TestSuite suite("Resampler Unit Tests");
+
+    suite.addTest("Inactive resampler is passthrough", testInactiveIsPassthrough);
+    suite.addTest("Output length matches the ratio", testOutputLength);
+    suite.addTest("Upsampled sine is accurate", testUpsampledSineIsAccurate);
+    suite.addTest("Capped-phase ratio is accurate", testCappedPhaseSineIsAccurate);
+    suite.addTest("Downsampling rejects aliases", testDownsamplingRejectsAliases);
+    suite.addTest("Chunking does not change output", testChunkingDoesNotChangeOutput);
+
+    auto results = suite.runAll();
+    suite.printResults(results);
+
+    return suite.getFailureCount(results) > 0 ? 1 : 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * test_resampler_benchmark.cpp - Throughput benchmark for the polyphase resampler
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef FINAL_BUILD
+#include "psymp3.h"
+#endif
+#include "test_framework.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using PsyMP3::DSP::Resampler;
+using namespace TestFramework;
+
+// Reports throughput as a realtime factor on one core: seconds of audio
+// converted per second of wall-clock time, on a single thread. The decoder
+// thread resamples at most one stream at a time, so this is the headroom the
+// stage leaves it.
+static double measureRealtimeFactor(unsigned in_rate, unsigned out_rate, unsigned channels)
+{
+    constexpr double kAudioSeconds = 20.0;
+    constexpr size_t kChunkFrames = 2048; // Audio's decode chunk at stereo
+
+    const size_t frames = static_cast<size_t>(in_rate * kAudioSeconds);
+    std::vector<int16_t> in(frames * channels);
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> dist(-20000, 20000);
+    for (auto& s : in) s = static_cast<int16_t>(dist(rng));
+
+    Resampler rs;
+    rs.configure(in_rate, out_rate, channels);
+    std::vector<int16_t> out;
+    size_t produced = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t pos = 0; pos < frames; pos += kChunkFrames) {
+        const size_t n = std::min(kChunkFrames, frames - pos);
+        rs.process(in.data() + pos * channels, n, out);
+        produced += out.size();
+    }
+    rs.drain(out);
+    produced += out.size();
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const double rtf = kAudioSeconds / elapsed;
+    std::cout << "    " << in_rate << " -> " << out_rate << " Hz, " << channels << " ch ("
+              << rs.kernelName() << "): " << static_cast<long>(rtf) << "x realtime per core ("
+              << produced / channels << " frames out)" << std::endl;
+    return rtf;
+}
+
+static void testCdToDat()
+{
+    ASSERT_TRUE(measureRealtimeFactor(44100, 48000, 2) > 10.0, "44.1k -> 48k stereo well above realtime");
+}
+
+static void testDatToCd()
+{
+    ASSERT_TRUE(measureRealtimeFactor(48000, 44100, 2) > 10.0, "48k -> 44.1k stereo well above realtime");
+}
+
+static void testHiResToCd()
+{
+    ASSERT_TRUE(measureRealtimeFactor(96000, 44100, 2) > 5.0, "96k -> 44.1k stereo well above realtime");
+}
+
+static void testSurround()
+{
+    ASSERT_TRUE(measureRealtimeFactor(44100, 48000, 6) > 5.0, "44.1k -> 48k 5.1 well above realtime");
+}
+
+int main()
+{
+    TestSuite suite("Resampler Throughput Benchmark");
+
+    suite.addTest("44.1k -> 48k stereo", testCdToDat);
+    suite.addTest("48k -> 44.1k stereo", testDatToCd);
+    suite.addTest("96k -> 44.1k stereo", testHiResToCd);
+    suite.addTest("44.1k -> 48k 5.1", testSurround);
+
+    auto results = suite.runAll();
+    suite.printResults(results);
+
+    return suite.getFailureCount(results) > 0 ? 1 : 0;
+}
@@ -0,0 +1,172 @@
+/*
+ * test_sample_convert.cpp - Unit tests for the float to int16 conversion kernels
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef FINAL_BUILD
+#include "psymp3.h"
+#endif
+#include "test_framework.h"
+#include "core/utility/SampleConvert.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace PsyMP3::Core::Utility;
+using namespace TestFramework;
+
+namespace {
+
+// Full-scale noise with out-of-range, half-LSB and non-finite samples mixed in
+std::vector<float> randomSamples(size_t count, uint32_t seed)
+{
+    const float specials[] = {0.0f, 1.0f, -1.0f, 1.5f / 32768.0f, 2.5f / 32768.0f, -0.5f / 32768.0f,
+                              32767.5f / 32768.0f, std::numeric_limits<float>::quiet_NaN(),
+                              std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()};
+    std::vector<float> samples(count);
+    for (size_t i = 0; i < count; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        if ((seed >> 28) == 0) {
+            samples[i] = specials[(seed >> 8) % (sizeof(specials) / sizeof(specials[0]))];
+        } else {
+            samples[i] = (static_cast<float>(seed >> 8) / 16777216.0f - 0.5f) * 3.0f;
+        }
+    }
+    return samples;
+}
+
+struct Implementation {
+    SampleConvert::PlanarFloatToInt16Fn fn;
+    const char* name;
+};
+
+} // namespace
+
+void test_conversion_values()
+{
+    ASSERT_EQUALS(0, SampleConvert::floatToInt16(0.0f), "Zero");
+    ASSERT_EQUALS(16384, SampleConvert::floatToInt16(0.5f), "Half scale");
+    ASSERT_EQUALS(32767, SampleConvert::floatToInt16(1.0f), "Full scale clamps");
+    ASSERT_EQUALS(-32768, SampleConvert::floatToInt16(-1.0f), "Negative full scale");
+    ASSERT_EQUALS(-32768, SampleConvert::floatToInt16(-7.0f), "Underrange clamps");
+    ASSERT_EQUALS(2, SampleConvert::floatToInt16(1.5f / 32768.0f), "Ties round to even");
+    ASSERT_EQUALS(2, SampleConvert::floatToInt16(2.5f / 32768.0f), "Ties round to even");
+    ASSERT_EQUALS(0, SampleConvert::floatToInt16(std::numeric_limits<float>::quiet_NaN()), "NaN is silent");
+    ASSERT_EQUALS(32767, SampleConvert::floatToInt16(std::numeric_limits<float>::infinity()), "Infinity clamps");
+
+    const float in[] = {0.25f, -0.25f, 0.5f};
+    int16_t out[3] = {};
+    SampleConvert::floatToInt16(in, 3, out, 0.5f);
+    ASSERT_EQUALS(4096, out[0], "Gain applied");
+    ASSERT_EQUALS(-4096, out[1], "Gain applied");
+    ASSERT_EQUALS(8192, out[2], "Gain applied");
+}
+
+// Every implementation matches the scalar reference across block and vector
+// boundaries, channel layouts, gains and dither
+void test_implementations_match_scalar()
+{
+    std::vector<Implementation> implementations = {
+        {SampleConvert::planarFloatToInt16, "dispatched"},
+        {SampleConvert::planarFloatToInt16SSE2, "sse2"},
+        {SampleConvert::planarFloatToInt16NEON, "neon"},
+    };
+    if (SampleConvert::hasAVX2()) {
+        implementations.push_back({SampleConvert::planarFloatToInt16AVX2, "avx2"});
+    }
+
+    for (unsigned channels : {1u, 2u, 3u, 6u, 8u}) {
+        for (size_t frames : {0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 100, 700, 1500}) {
+            std::vector<std::vector<float>> data;
+            std::vector<const float*> planes;
+            for (unsigned c = 0; c < channels; ++c) {
+                data.push_back(randomSamples(frames, static_cast<uint32_t>(frames * 31 + c)));
+                planes.push_back(data.back().data());
+            }
+            for (float gain : {1.0f, 0.5f, 3.7f}) {
+                for (bool dithered : {false, true}) {
+                    Dither reference_dither;
+                    std::vector<int16_t> expected(frames * channels + 1, 0x5555);
+                    SampleConvert::planarFloatToInt16Scalar(planes.data(), frames, channels, expected.data(),
+                                                            gain, dithered ? &reference_dither : nullptr);
+                    ASSERT_EQUALS(0x5555, expected.back(), "Scalar stays in bounds");
+
+                    for (const auto& impl : implementations) {
+                        Dither dither;
+                        std::vector<int16_t> out(frames * channels + 1, 0x5555);
+                        impl.fn(planes.data(), frames, channels, out.data(), gain, dithered ? &dither : nullptr);
+                        ASSERT_TRUE(out == expected, impl.name);
+                        ASSERT_EQUALS(reference_dither.state, dither.state, "Dither state advances alike");
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Interleaved input is one plane
+void test_interleaved_matches_planar()
+{
+    const std::vector<float> in = randomSamples(999, 7);
+    const float* plane = in.data();
+    std::vector<int16_t> expected(in.size());
+    std::vector<int16_t> out(in.size());
+    SampleConvert::planarFloatToInt16Scalar(&plane, in.size(), 1, expected.data());
+    SampleConvert::floatToInt16(in.data(), in.size(), out.data());
+    ASSERT_TRUE(out == expected, "floatToInt16 matches");
+}
+
+// Dither stays within one LSB and decorrelates the rounding error
+void test_dither()
+{
+    const std::vector<float> in(4096, 0.3f / 32768.0f);
+    std::vector<int16_t> out(in.size());
+    Dither dither;
+    SampleConvert::floatToInt16(in.data(), in.size(), out.data(), 1.0f, &dither);
+
+    double sum = 0.0;
+    size_t nonzero = 0;
+    for (int16_t s : out) {
+        ASSERT_TRUE(s >= -1 && s <= 1, "Within one LSB");
+        sum += s;
+        nonzero += s != 0;
+    }
+    ASSERT_TRUE(nonzero > 0, "Sub-LSB signal survives");
+    ASSERT_TRUE(std::fabs(sum / out.size() - 0.3) < 0.05, "Mean follows the signal");
+
+    // The same state gives the same noise
+    Dither again;
+    std::vector<int16_t> repeat(in.size());
+    SampleConvert::floatToInt16(in.data(), in.size(), repeat.data(), 1.0f, &again);
+    ASSERT_TRUE(repeat == out, "Dither is deterministic");
+
+    // Noise continues across calls, whatever their sizes
+    Dither pieces;
+    std::vector<int16_t> split(in.size());
+    for (size_t offset = 0, step = 1; offset < in.size(); offset += step, step = step * 3 + 1) {
+        const size_t length = std::min(step, in.size() - offset);
+        SampleConvert::floatToInt16(in.data() + offset, length, split.data() + offset, 1.0f, &pieces);
+    }
+    ASSERT_TRUE(split == out, "Piecewise dither matches");
+    ASSERT_EQUALS(dither.state, pieces.state, "Piecewise dither state matches");
+}
+
+int main()
+{
+    TestSuite suite("Sample Conversion Unit Tests");
+
+    std::cout << "Implementation: " << SampleConvert::implementation() << std::endl;
+    suite.addTest("Conversion Values", test_conversion_values);
+    suite.addTest("Implementations Match Scalar", test_implementations_match_scalar);
+    suite.addTest("Interleaved Matches Planar", test_interleaved_matches_planar);
+    suite.addTest("Dither", test_dither);
+
+    auto results = suite.runAll();
+    suite.printResults(results);
+    return (suite.getFailureCount(results) == 0) ? 0 : 1;
+}
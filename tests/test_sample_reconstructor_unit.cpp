@@ -202,6 +202,75 @@ void test_sample_validation() {
     ASSERT_EQUALS(0, static_cast<int>(output[2]), "Zero value");
 }
 
+// Test 24-bit float output keeps the bits the 16-bit path rounds away
+void test_24bit_float_output() {
+    SampleReconstructor reconstructor;
+    
+    // 0x000001 is one 24-bit LSB: zero after downscaling to 16 bits, but
+    // exactly 2^-23 as float.
+    int32_t ch0[] = {8388607, -8388608, 1};
+    int32_t ch1[] = {4194304, 0, -1};
+    int32_t* channels[] = {ch0, ch1};
+    
+    float output[6];
+    memset(output, 0, sizeof(output));
+    
+    reconstructor.reconstructSamplesFloat(output, channels, 3, 2, 24);
+    
+    ASSERT_TRUE(output[0] == 8388607.0f / 8388608.0f, "24-bit max maps just below 1.0");
+    ASSERT_TRUE(output[1] == 0.5f, "Interleaved ch1 half scale");
+    ASSERT_TRUE(output[2] == -1.0f, "24-bit min maps to -1.0");
+    ASSERT_TRUE(output[4] == 1.0f / 8388608.0f, "Single 24-bit LSB survives");
+    ASSERT_TRUE(output[5] == -1.0f / 8388608.0f, "Negative LSB survives");
+}
+
+// Whole mono/stereo blocks (vectorized where available) convert exactly
+// like one sample frame at a time, including rounding and saturation
+void test_block_matches_per_sample() {
+    SampleReconstructor reconstructor;
+    
+    const uint32_t count = 23;  // Not a multiple of the vector width
+    int32_t ch0[count], ch1[count];
+    uint32_t seed = 0x9E3779B9u;
+    for (uint32_t i = 0; i < count; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        ch0[i] = static_cast<int32_t>(seed);
+        ch1[i] = static_cast<int32_t>(seed * 2654435761u) >> (i % 31);
+    }
+    ch0[0] = INT32_MIN;
+    ch0[1] = INT32_MAX;
+    ch1[2] = -128;
+    ch1[3] = 127;
+    
+    for (uint32_t bit_depth = 4; bit_depth <= 32; ++bit_depth) {
+        for (uint32_t channel_count = 1; channel_count <= 2; ++channel_count) {
+            int32_t* channels[] = {ch0, ch1};
+            int16_t block[count * 2];
+            reconstructor.reconstructSamples(block, channels, count, channel_count, bit_depth);
+            
+            float block_float[count * 2];
+            reconstructor.reconstructSamplesFloat(block_float, channels, count,
+                                                  channel_count, bit_depth);
+            
+            for (uint32_t i = 0; i < count; ++i) {
+                int32_t* one[] = {ch0 + i, ch1 + i};
+                int16_t expected[2];
+                float expected_float[2];
+                reconstructor.reconstructSamples(expected, one, 1, channel_count, bit_depth);
+                reconstructor.reconstructSamplesFloat(expected_float, one, 1,
+                                                      channel_count, bit_depth);
+                for (uint32_t ch = 0; ch < channel_count; ++ch) {
+                    ASSERT_EQUALS(static_cast<int>(expected[ch]),
+                                  static_cast<int>(block[i * channel_count + ch]),
+                                  "Block output matches per-sample output");
+                    ASSERT_TRUE(expected_float[ch] == block_float[i * channel_count + ch],
+                                "Block float output matches per-sample output");
+                }
+            }
+        }
+    }
+}
+
 int main() {
     // Create test suite
     TestSuite suite("SampleReconstructor Unit Tests");
@@ -216,6 +285,8 @@ int main() {
     suite.addTest("Stereo Interleaving", test_stereo_interleaving);
     suite.addTest("Multi-Channel Interleaving", test_multi_channel_interleaving);
     suite.addTest("Sample Validation", test_sample_validation);
+    suite.addTest("24-bit Float Output", test_24bit_float_output);
+    suite.addTest("Block Matches Per-Sample", test_block_matches_per_sample);
     
     // Run all tests
     auto results = suite.runAll();
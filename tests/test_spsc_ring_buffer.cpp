@@ -0,0 +1,172 @@
+/*
+ * test_spsc_ring_buffer.cpp - Unit tests for the lock-free SPSC ring buffer
+ * This file is part of PsyMP3.
+ * Copyright © 2026 Kirn Gill <segin2005@gmail.com>
+ *
+ * PsyMP3 is free software. You may redistribute and/or modify it under
+ * the terms of the ISC License <https://opensource.org/licenses/ISC>
+ */
+
+#ifndef FINAL_BUILD
+#include "psymp3.h"
+#endif
+#include "test_framework.h"
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using PsyMP3::Core::SPSCRingBuffer;
+using namespace TestFramework;
+
+static void testCapacityRoundsUp()
+{
+    SPSCRingBuffer<int16_t> ring(1000);
+    ASSERT_EQUALS(static_cast<size_t>(1024), ring.capacity(), "capacity rounds up to a power of two");
+    ASSERT_TRUE(ring.empty(), "new ring is empty");
+    ASSERT_EQUALS(static_cast<size_t>(1024), ring.writeAvailable(), "new ring is all free space");
+}
+
+static void testWriteReadWrapAround()
+{
+    SPSCRingBuffer<int16_t> ring(8);
+    std::vector<int16_t> in = {1, 2, 3, 4, 5, 6};
+    std::vector<int16_t> out(8, 0);
+
+    ASSERT_EQUALS(static_cast<size_t>(6), ring.write(in.data(), in.size()), "first write fits");
+    ASSERT_EQUALS(static_cast<size_t>(4), ring.read(out.data(), 4), "partial read");
+    ASSERT_EQUALS(static_cast<int16_t>(4), out[3], "read preserves order");
+
+    // Write index is at 6 of 8: this write wraps.
+    std::vector<int16_t> in2 = {7, 8, 9, 10, 11, 12};
+    ASSERT_EQUALS(static_cast<size_t>(6), ring.write(in2.data(), in2.size()), "wrapping write fits");
+    ASSERT_EQUALS(static_cast<size_t>(0), ring.writeAvailable(), "ring is full");
+    ASSERT_EQUALS(static_cast<size_t>(0), ring.write(in.data(), 1), "write into a full ring is refused");
+
+    ASSERT_EQUALS(static_cast<size_t>(8), ring.read(out.data(), 8), "wrapping read");
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_EQUALS(static_cast<int16_t>(5 + i), out[i], "wrapped data is contiguous and ordered");
+    }
+    ASSERT_TRUE(ring.empty(), "ring drained");
+}
+
+static void testFlushDiscardsOnlyEarlierData()
+{
+    SPSCRingBuffer<int16_t> ring(16);
+    std::vector<int16_t> stale = {1, 1, 1, 1};
+    std::vector<int16_t> fresh = {2, 3};
+    std::vector<int16_t> out(16, 0);
+
+    ring.write(stale.data(), stale.size());
+    ring.flush();
+    ring.write(fresh.data(), fresh.size());
+
+    ASSERT_EQUALS(static_cast<size_t>(2), ring.size(), "flushed data is not readable");
+    // Flushed data keeps holding space until the consumer skips it.
+    ASSERT_EQUALS(static_cast<size_t>(10), ring.writeAvailable(), "flushed data still occupies space");
+
+    bool flushed = false;
+    ASSERT_EQUALS(static_cast<size_t>(2), ring.read(out.data(), 16, &flushed), "only post-flush data is read");
+    ASSERT_TRUE(flushed, "read reports the flush it applied");
+    ASSERT_EQUALS(static_cast<int16_t>(2), out[0], "first post-flush sample");
+    ASSERT_EQUALS(static_cast<int16_t>(3), out[1], "second post-flush sample");
+    ASSERT_EQUALS(static_cast<size_t>(16), ring.writeAvailable(), "space reclaimed after the consumer ran");
+
+    ring.read(out.data(), 16, &flushed);
+    ASSERT_FALSE(flushed, "a flush is reported once");
+}
+
+static void testZeroLengthReadAppliesFlush()
+{
+    SPSCRingBuffer<int16_t> ring(8);
+    std::vector<int16_t> data = {1, 2, 3};
+    ring.write(data.data(), data.size());
+    ring.flush();
+
+    int16_t out[1] = {0};
+    bool flushed = false;
+    ASSERT_EQUALS(static_cast<size_t>(0), ring.read(out, 0, &flushed), "zero-length read");
+    ASSERT_TRUE(flushed, "zero-length read still applies the flush");
+    ASSERT_EQUALS(static_cast<size_t>(8), ring.writeAvailable(), "flushed space reclaimed");
+}
+
+static void testWriteRegionInPlace()
+{
+    SPSCRingBuffer<int16_t> ring(8);
+    std::vector<int16_t> in = {1, 2, 3, 4, 5};
+    std::vector<int16_t> out(8, 0);
+    ring.write(in.data(), in.size());
+    ring.read(out.data(), 4);
+
+    // Write index at 5 of 8, 7 free: the region wraps after 3.
+    auto region = ring.writeRegion(6);
+    ASSERT_EQUALS(static_cast<size_t>(3), region.first_count, "first piece runs to the end of the array");
+    ASSERT_EQUALS(static_cast<size_t>(3), region.second_count, "second piece wraps to the start");
+    for (size_t i = 0; i < region.first_count; ++i) region.first[i] = static_cast<int16_t>(10 + i);
+    for (size_t i = 0; i < region.second_count; ++i) region.second[i] = static_cast<int16_t>(13 + i);
+    ASSERT_EQUALS(static_cast<size_t>(1), ring.size(), "an uncommitted region is not readable");
+
+    ring.commitWrite(5); // keep only part of what was filled
+    ASSERT_EQUALS(static_cast<size_t>(6), ring.size(), "committed elements are readable");
+    ASSERT_EQUALS(static_cast<size_t>(6), ring.read(out.data(), 8), "read committed data");
+    const int16_t expected[] = {5, 10, 11, 12, 13, 14};
+    for (int i = 0; i < 6; ++i) {
+        ASSERT_EQUALS(expected[i], out[i], "region data reads back in order across the wrap");
+    }
+    ASSERT_EQUALS(static_cast<size_t>(8), ring.writeRegion(100).size(), "region is capped by free space");
+}
+
+static void testConcurrentProducerConsumer()
+{
+    // One producer and one consumer stream a counting sequence through a small
+    // ring; any lost, duplicated or torn element breaks the sequence.
+    constexpr uint32_t kTotal = 1u << 20;
+    SPSCRingBuffer<uint32_t> ring(256);
+    bool ordered = true;
+
+    std::thread producer([&ring]() {
+        uint32_t next = 0;
+        uint32_t chunk[37];
+        while (next < kTotal) {
+            uint32_t n = 0;
+            while (n < 37 && next + n < kTotal) { chunk[n] = next + n; ++n; }
+            size_t done = 0;
+            while (done < n) {
+                done += ring.write(chunk + done, n - done);
+                if (done < n) std::this_thread::yield();
+            }
+            next += n;
+        }
+    });
+
+    uint32_t expected = 0;
+    uint32_t chunk[53];
+    while (expected < kTotal) {
+        size_t n = ring.read(chunk, 53);
+        for (size_t i = 0; i < n; ++i) {
+            if (chunk[i] != expected++) ordered = false;
+        }
+        if (n == 0) std::this_thread::yield();
+    }
+    producer.join();
+
+    ASSERT_TRUE(ordered, "sequence survives the ring intact");
+    ASSERT_TRUE(ring.empty(), "ring drained after the run");
+}
+
+int main()
+{
+    TestSuite suite("SPSCRingBuffer Unit Tests");
+
+    suite.addTest("Capacity rounds up", testCapacityRoundsUp);
+    suite.addTest("Write/read with wrap-around", testWriteReadWrapAround);
+    suite.addTest("Flush discards only earlier data", testFlushDiscardsOnlyEarlierData);
+    suite.addTest("Zero-length read applies flush", testZeroLengthReadAppliesFlush);
+    suite.addTest("Write region filled in place", testWriteRegionInPlace);
+    suite.addTest("Concurrent producer/consumer", testConcurrentProducerConsumer);
+
+    auto results = suite.runAll();
+    suite.printResults(results);
+
+    return suite.getFailureCount(results) > 0 ? 1 : 0;
+}
@@ -218,6 +218,32 @@ void test_side_channel_bit_depth() {
                 "Should decode side channel with adjusted bit depth");
 }
 
+// Test 32-bit output buffers: a 31-bit frame's 32-bit side channel fits,
+// a 32-bit frame's 33-bit side channel does not and is refused
+void test_32bit_output_buffer() {
+    BitstreamReader reader;
+    ResidualDecoder residual(&reader);
+    SubframeDecoder decoder(&reader, &residual);
+    
+    uint8_t data[] = {
+        0x00,                   // Subframe header (CONSTANT)
+        0x80, 0x00, 0x00, 0x00  // Constant value (32-bit side channel)
+    };
+    reader.feedData(data, sizeof(data));
+    
+    int32_t output[4];
+    memset(output, 0, sizeof(output));
+    
+    ASSERT_TRUE(decoder.decodeSubframe(output, 4, 31, true),
+                "Should decode 31-bit side channel into 32-bit buffer");
+    for (int i = 0; i < 4; i++) {
+        ASSERT_EQUALS(INT32_MIN, output[i], "Most negative 32-bit side sample");
+    }
+    
+    ASSERT_FALSE(decoder.decodeSubframe(output, 4, 32, false),
+                 "32-bit frames need 64-bit buffers");
+}
+
 // Test LPC predictor structure
 void test_lpc_predictor_structure() {
     BitstreamReader reader;
@@ -399,6 +425,7 @@ int main() {
     suite.addTest("FIXED Predictor Order 1 Full", test_fixed_predictor_full_decoding);
     suite.addTest("Wasted Bits", test_wasted_bits);
     suite.addTest("Side Channel Bit Depth", test_side_channel_bit_depth);
+    suite.addTest("32-bit Output Buffer", test_32bit_output_buffer);
     suite.addTest("LPC Predictor Structure", test_lpc_predictor_structure);
     suite.addTest("LPC Subframe Decoding", test_lpc_subframe_decoding);
     suite.addTest("LPC Subframe Full", test_lpc_subframe_full);